@@ -0,0 +1,119 @@
+// ============================================================================
+// 定长标量数组批量解码/编码基准：逐元素（原 array_inline 模板生成的代码）vs 批量（deserialize_array_bulk）
+// 逐元素：每个元素一次长度检查 + 结果对象，push_back 到临时 vector 后整体拷贝给结果
+// 批量：一次长度检查，resize 后 memcpy + 向量化字节交换，直接写入结果
+// 元素类型 uint16 / int32 / float，大端线上格式，元素数 64 / 1024 / 8192（波形载荷）
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework array_bench.cpp -o array_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <cstdio>
+
+using namespace protocol_parser;
+
+namespace {
+
+// 元素解析/序列化：与 unsigned_int / signed_int / float 模板生成的调用一致
+DeserializeStatus read_element(DeserializeContext& ctx, uint16_t& value) {
+    return deserialize_unsigned_int_generic<uint16_t>(ctx, value);
+}
+DeserializeStatus read_element(DeserializeContext& ctx, int32_t& value) {
+    return deserialize_signed_int_generic<int32_t>(ctx, value);
+}
+DeserializeStatus read_element(DeserializeContext& ctx, float& value) {
+    return deserialize_float_generic<float>(ctx, value);
+}
+SerializeStatus write_element(SerializeContext& ctx, uint16_t value) {
+    return serialize_unsigned_int_generic<uint16_t>(ctx, value);
+}
+SerializeStatus write_element(SerializeContext& ctx, int32_t value) {
+    return serialize_signed_int_generic<int32_t>(ctx, value);
+}
+SerializeStatus write_element(SerializeContext& ctx, float value) {
+    return serialize_float_generic<float>(ctx, value);
+}
+
+// 原模板生成的逐元素解析：push_back 到临时 vector，再整体拷贝给结果
+template<typename T>
+DeserializeStatus decode_per_element(DeserializeContext& ctx, size_t array_count, std::vector<T>& target) {
+    std::vector<T> array;
+    for (size_t i = 0; i < array_count; ++i) {
+        T element;
+        DeserializeStatus res = read_element(ctx, element);
+        if (!res.is_success()) return res;
+        array.push_back(element);
+    }
+    target = array;
+    return DeserializeStatus::success(array_count * sizeof(T));
+}
+
+// 原模板生成的逐元素序列化
+template<typename T>
+SerializeStatus encode_per_element(SerializeContext& ctx, const std::vector<T>& array) {
+    for (size_t i = 0; i < array.size(); ++i) {
+        SerializeStatus res = write_element(ctx, array[i]);
+        if (!res.is_success()) return res;
+    }
+    return SerializeStatus::success(array.size() * sizeof(T));
+}
+
+template<typename T>
+int run(const char* type_name, size_t count) {
+    const size_t bytes = count * sizeof(T);
+    const std::vector<uint8_t> wire = bench::make_random_bytes(bytes, static_cast<uint32_t>(count + sizeof(T)));
+    std::vector<T> a;
+    std::vector<T> b;
+    DeserializeContext ca(wire.data(), wire.size(), BIG_ENDIAN);
+    DeserializeContext cb(wire.data(), wire.size(), BIG_ENDIAN);
+    decode_per_element(ca, count, a);
+    deserialize_array_bulk<T>(cb, count, b, BIG_ENDIAN);
+    std::vector<uint8_t> out_a(bytes);
+    std::vector<uint8_t> out_b(bytes);
+    SerializeContext sa(out_a.data(), out_a.size(), BIG_ENDIAN);
+    SerializeContext sb(out_b.data(), out_b.size(), BIG_ENDIAN);
+    encode_per_element(sa, a);
+    serialize_array_bulk<T>(sb, b, BIG_ENDIAN);
+    if (std::memcmp(a.data(), b.data(), bytes) != 0 || out_a != wire || out_b != wire) {
+        std::printf("MISMATCH: %s x %zu\n", type_name, count);
+        return 1;
+    }
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%s x %zu (big endian)", type_name, count);
+    bench::print_header(title);
+    bench::print_throughput("decode per element", bytes, bench::measure([&]() {
+        DeserializeContext ctx(wire.data(), wire.size(), BIG_ENDIAN);
+        decode_per_element(ctx, count, a);
+        bench::do_not_optimize(a[0]);
+    }));
+    bench::print_throughput("decode bulk", bytes, bench::measure([&]() {
+        DeserializeContext ctx(wire.data(), wire.size(), BIG_ENDIAN);
+        deserialize_array_bulk<T>(ctx, count, b, BIG_ENDIAN);
+        bench::do_not_optimize(b[0]);
+    }));
+    bench::print_throughput("encode per element", bytes, bench::measure([&]() {
+        SerializeContext ctx(out_a.data(), out_a.size(), BIG_ENDIAN);
+        encode_per_element(ctx, a);
+        bench::do_not_optimize(out_a[0]);
+    }));
+    bench::print_throughput("encode bulk", bytes, bench::measure([&]() {
+        SerializeContext ctx(out_b.data(), out_b.size(), BIG_ENDIAN);
+        serialize_array_bulk<T>(ctx, b, BIG_ENDIAN);
+        bench::do_not_optimize(out_b[0]);
+    }));
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    const size_t kCounts[] = { 64, 1024, 8192 };
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(kCounts) / sizeof(kCounts[0]); ++i) {
+        failures += run<uint16_t>("uint16", kCounts[i]);
+        failures += run<int32_t>("int32", kCounts[i]);
+        failures += run<float>("float", kCounts[i]);
+    }
+    return failures == 0 ? 0 : 1;
+}
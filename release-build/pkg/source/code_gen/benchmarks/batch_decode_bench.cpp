@@ -0,0 +1,298 @@
+// ============================================================================
+// 录制文件并行批量解码基准：单线程 StreamFramer 顺序处理 vs BatchDecoder（1..N 个线程）
+// 帧格式同 pipeline_bench.cpp：EB 90 | 帧长(2B 大端) | MessageID(2B) | 序号(4B) | 10~50 个 uint32 字段 | CRC-32(4B)
+// 录制内容约 32 MB：1% 的帧 CRC 错误；另一组在帧间插入噪声（25% 为同步字首字节，含伪同步字），
+// CRC 错误的帧按伪同步字处理（StreamFramer::reject / reject_failed）
+// 逐项核对帧数、解码成功/失败数、字段和、丢弃字节数，并检查输出按序号递增（无重复、无乱序）
+// 编译: g++ -std=c++11 -O2 -pthread -I../protocol_parser_framework batch_decode_bench.cpp -o batch_decode_bench
+// ============================================================================
+#include "protocol_batch_decode.h"
+#include "protocol_checksum.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+using namespace protocol_parser;
+
+namespace {
+
+const uint8_t kSync[2] = { 0xEB, 0x90 };
+const size_t kRecordingBytes = 32u << 20;
+
+struct DecodedFrame {
+    uint32_t sequence;
+    uint64_t sum;
+};
+
+FrameSpec make_spec() {
+    FrameSpec spec = { kSync, 2, 2, 2, BIG_ENDIAN, 0, 0, 1024 };
+    return spec;
+}
+
+Checksum_CRC<uint32_t> make_crc32() {
+    Checksum_CRC<uint32_t> crc(0x04C11DB7UL);
+    crc.set_init(0xFFFFFFFFUL);
+    crc.set_xor_out(0xFFFFFFFFUL);
+    crc.set_ref_in(true);
+    crc.set_ref_out(true);
+    return crc;
+}
+
+struct Decoder {
+    Checksum_CRC<uint32_t> crc;
+
+    Decoder() : crc(make_crc32()) {}
+
+    DeserializeStatus operator()(const uint8_t* data, size_t length, DecodedFrame& result) {
+        if (length < 14) {
+            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Frame too short", length);
+        }
+        const uint32_t expected = read_fixed_order<LITTLE_ENDIAN, uint32_t>(data + length - 4);
+        if (static_cast<uint32_t>(crc.calculate(data, length - 4)) != expected) {
+            return DeserializeStatus::failure(INVALID_CHECKSUM, "CRC mismatch", length - 4);
+        }
+        result.sequence = read_fixed_order<BIG_ENDIAN, uint32_t>(data + 6);
+        uint64_t sum = 0;
+        for (size_t offset = 10; offset + 4 <= length - 4; offset += 4) {
+            sum += read_fixed_order<BIG_ENDIAN, uint32_t>(data + offset);
+        }
+        result.sum = sum;
+        return DeserializeStatus::success(length);
+    }
+};
+
+std::vector<uint8_t> make_recording(bool noise) {
+    Checksum_CRC<uint32_t> crc = make_crc32();
+    std::vector<uint8_t> bytes;
+    bytes.reserve(kRecordingBytes + 1024);
+    std::vector<uint8_t> frame;
+    uint32_t state = noise ? 77u : 1u;
+    for (uint32_t seq = 0; bytes.size() < kRecordingBytes; ++seq) {
+        state = state * 1664525u + 1013904223u;
+        if (noise && (state >> 12) % 4 == 0) {
+            const size_t noise_length = (state >> 20) % 32;
+            for (size_t i = 0; i < noise_length; ++i) {
+                state = state * 1664525u + 1013904223u;
+                const uint8_t value = static_cast<uint8_t>(state >> 24);
+                bytes.push_back((value & 3) == 0 ? kSync[0] : ((value & 3) == 1 ? kSync[1] : value));
+            }
+        }
+        const size_t field_count = 10 + (state >> 8) % 41;
+        const size_t length = 10 + field_count * 4 + 4;
+        frame.assign(length, 0);
+        frame[0] = kSync[0];
+        frame[1] = kSync[1];
+        write_fixed_order<BIG_ENDIAN, uint16_t>(frame.data() + 2, static_cast<uint16_t>(length));
+        write_fixed_order<BIG_ENDIAN, uint16_t>(frame.data() + 4, static_cast<uint16_t>(state >> 20));
+        write_fixed_order<BIG_ENDIAN, uint32_t>(frame.data() + 6, seq);
+        for (size_t f = 0; f < field_count; ++f) {
+            state = state * 1664525u + 1013904223u;
+            write_fixed_order<BIG_ENDIAN, uint32_t>(frame.data() + 10 + f * 4, state);
+        }
+        uint32_t checksum = static_cast<uint32_t>(crc.calculate(frame.data(), length - 4));
+        if ((state >> 4) % 100 == 0) {
+            checksum ^= 1;  // 1% CRC 错误
+        }
+        write_fixed_order<LITTLE_ENDIAN, uint32_t>(frame.data() + length - 4, checksum);
+        bytes.insert(bytes.end(), frame.begin(), frame.end());
+    }
+    return bytes;
+}
+
+struct Totals {
+    uint64_t frames;
+    uint64_t decoded;
+    uint64_t failed;
+    uint64_t sum;
+    uint64_t bytes_discarded;
+    uint64_t order_errors;
+};
+
+// 按序号检查输出顺序：解码成功的帧序号严格递增
+struct OrderCheck {
+    bool started;
+    uint32_t last;
+    uint64_t errors;
+
+    OrderCheck() : started(false), last(0), errors(0) {}
+
+    void add(uint32_t sequence) {
+        if (started && sequence <= last) {
+            ++errors;
+        }
+        started = true;
+        last = sequence;
+    }
+};
+
+// 基线：单线程 StreamFramer 按 64KB 分段写入，CRC 错误时 reject
+Totals run_serial(const std::vector<uint8_t>& recording, bool reject_failed) {
+    Totals totals = { 0, 0, 0, 0, 0, 0 };
+    Decoder decode;
+    DecodedFrame result;
+    OrderCheck order;
+    StreamFramer framer(make_spec());
+    uint64_t framed = 0;
+    for (size_t offset = 0; offset < recording.size();) {
+        size_t available = 0;
+        uint8_t* area = framer.write_area(available);
+        size_t n = recording.size() - offset;
+        n = n < available ? n : available;
+        n = n < 65536 ? n : 65536;
+        std::memcpy(area, recording.data() + offset, n);
+        offset += n;
+        framer.commit(n);
+        framer.drain([&](const FrameSpan& frame) {
+            if (decode(frame.data, frame.length, result).is_success()) {
+                ++totals.decoded;
+                totals.sum += result.sum;
+                order.add(result.sequence);
+            } else if (reject_failed) {
+                return false;
+            } else {
+                ++totals.failed;
+            }
+            ++totals.frames;
+            framed += frame.length;
+            return true;
+        });
+    }
+    totals.bytes_discarded = recording.size() - framed;
+    totals.order_errors = order.errors;
+    return totals;
+}
+
+// 每块一个 sink：累计本块结果，记录首尾序号供合并时检查块间顺序
+struct ChunkSink {
+    uint64_t decoded;
+    uint64_t failed;
+    uint64_t sum;
+    OrderCheck order;
+    uint32_t first;
+
+    ChunkSink() : decoded(0), failed(0), sum(0), first(0) {}
+
+    void operator()(const BatchDecodeItem<DecodedFrame>& item) {
+        if (item.status.is_success()) {
+            if (!order.started) {
+                first = item.result.sequence;
+            }
+            ++decoded;
+            sum += item.result.sum;
+            order.add(item.result.sequence);
+        } else {
+            ++failed;
+        }
+    }
+};
+
+Totals run_batch(const std::vector<uint8_t>& recording, const BatchDecodeConfig& config, BatchDecodeStats& stats) {
+    Totals totals = { 0, 0, 0, 0, 0, 0 };
+    OrderCheck order;
+    BatchDecoder<DecodedFrame> decoder(make_spec(), config);
+    stats = decoder.run<ChunkSink>(recording.data(), recording.size(), Decoder(), [&](ChunkSink& chunk) {
+        totals.decoded += chunk.decoded;
+        totals.failed += chunk.failed;
+        totals.sum += chunk.sum;
+        totals.order_errors += chunk.order.errors;
+        if (chunk.order.started) {
+            order.add(chunk.first);
+            order.last = chunk.order.last;
+        }
+    });
+    totals.frames = stats.frames;
+    totals.bytes_discarded = stats.bytes_discarded;
+    totals.order_errors += order.errors;
+    return totals;
+}
+
+bool check(const char* name, const Totals& totals, const Totals& expected) {
+    if (totals.frames != expected.frames || totals.decoded != expected.decoded ||
+        totals.failed != expected.failed || totals.sum != expected.sum ||
+        totals.bytes_discarded != expected.bytes_discarded || totals.order_errors != 0) {
+        std::printf("MISMATCH: %s (frames %llu/%llu, decoded %llu/%llu, failed %llu/%llu, "
+                    "discarded %llu/%llu, order errors %llu)\n", name,
+                    static_cast<unsigned long long>(totals.frames), static_cast<unsigned long long>(expected.frames),
+                    static_cast<unsigned long long>(totals.decoded), static_cast<unsigned long long>(expected.decoded),
+                    static_cast<unsigned long long>(totals.failed), static_cast<unsigned long long>(expected.failed),
+                    static_cast<unsigned long long>(totals.bytes_discarded),
+                    static_cast<unsigned long long>(expected.bytes_discarded),
+                    static_cast<unsigned long long>(totals.order_errors));
+        return false;
+    }
+    return true;
+}
+
+void print_rate(const char* name, size_t bytes, uint64_t frames, double seconds, double baseline) {
+    bench::print_throughput(name, bytes, seconds);
+    std::printf("        %.2f Mframes/s, speedup x%.2f\n", frames / seconds / 1e6, baseline / seconds);
+}
+
+int run_recording(const char* title, const std::vector<uint8_t>& recording, bool reject_failed,
+                  const std::vector<size_t>& worker_counts) {
+    int failures = 0;
+    bench::print_header(title);
+    const Totals expected = run_serial(recording, reject_failed);
+    std::printf("%zu bytes, %llu frames (%llu CRC errors), %llu bytes discarded\n", recording.size(),
+                static_cast<unsigned long long>(expected.frames), static_cast<unsigned long long>(expected.failed),
+                static_cast<unsigned long long>(expected.bytes_discarded));
+    const double baseline = bench::measure([&]() {
+        Totals t = run_serial(recording, reject_failed);
+        bench::do_not_optimize(t);
+    });
+    print_rate("StreamFramer serial", recording.size(), expected.frames, baseline, baseline);
+
+    // 自动块大小，另加 64KB 小块（接缝更多）验证结果
+    const size_t chunk_sizes[] = { 0, 65536 };
+    for (size_t c = 0; c < 2; ++c) {
+        for (size_t i = 0; i < worker_counts.size(); ++i) {
+            BatchDecodeConfig config;
+            config.workers = worker_counts[i];
+            config.chunk_size = chunk_sizes[c];
+            config.reject_failed = reject_failed;
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "batch %zu thread(s)%s", config.workers, c == 0 ? "" : ", 64KB");
+            BatchDecodeStats stats;
+            if (!check(name, run_batch(recording, config, stats), expected)) {
+                ++failures;
+                continue;
+            }
+            const double seconds = bench::measure([&]() {
+                Totals t = run_batch(recording, config, stats);
+                bench::do_not_optimize(t);
+            });
+            print_rate(name, recording.size(), expected.frames, seconds, baseline);
+            std::printf("        %zu chunks, %zu redone, %zu stolen\n", stats.chunks, stats.chunks_redone, stats.steals);
+        }
+    }
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    std::printf("hardware threads: %u\n", hardware);
+
+    // 线程数 1, 2, 4 ... 直到硬件线程数
+    const size_t max_workers = hardware > 1 ? hardware : 1;
+    std::vector<size_t> worker_counts;
+    for (size_t w = 1; w <= max_workers; w *= 2) {
+        worker_counts.push_back(w);
+    }
+    if (worker_counts.back() != max_workers) {
+        worker_counts.push_back(max_workers);
+    }
+    if (hardware <= 1) {
+        worker_counts.push_back(2);  // 核数不足时仍验证多线程结果（超额订阅，无加速）
+    }
+
+    int failures = 0;
+    failures += run_recording("Clean recording, 1% CRC errors", make_recording(false), false, worker_counts);
+    failures += run_recording("Noisy recording, false syncs, reject on CRC error", make_recording(true), true,
+                              worker_counts);
+    return failures == 0 ? 0 : 1;
+}
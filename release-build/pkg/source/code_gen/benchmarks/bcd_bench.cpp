@@ -0,0 +1,257 @@
+// ============================================================================
+// 压缩 BCD 编解码基准（protocol_common.h 的 bcd_detail / *_bcd_* 函数）
+// 1. 字段级：3 / 6 / 9 / 16 字节 BCD 字段（表号、终端号、IMSI 等），每轮 1024 个字段
+//    - 解析：原模板（逐字符 += 到临时字符串再整体拷贝）vs deserialize_bcd_generic()（SWAR/SSE2 解包到
+//      目标字符串）vs deserialize_bcd_uint()（直接得到 uint64_t，≤ 9 字节）
+//    - 序列化：原模板（"0" + 串 逐位补零、逐字符验证）vs serialize_bcd_generic() vs
+//      serialize_bcd_digits()（定长字符数组）vs serialize_bcd_uint()（整数）；输入为不带前导零的数字串
+// 2. 批量：4 KB BCD 与 8 KB 数字串互转，逐字节 vs bcd_detail::decode_digits() / encode_digits()
+// 逐项核对各实现的输出一致
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework bcd_bench.cpp -o bcd_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace protocol_parser;
+
+namespace {
+
+const size_t kFields = 1024;
+
+// 原模板实现：逐字符追加到临时字符串，再拷贝给输出
+bool legacy_deserialize(const uint8_t* ptr, size_t byte_length, std::string& out_value) {
+    std::string bcd_str;
+    bcd_str.reserve(byte_length * 2);
+    for (size_t i = 0; i < byte_length; ++i) {
+        uint8_t high = (ptr[i] >> 4) & 0x0F;
+        uint8_t low = ptr[i] & 0x0F;
+        if (high > 9 || low > 9) {
+            return false;
+        }
+        bcd_str += static_cast<char>('0' + high);
+        bcd_str += static_cast<char>('0' + low);
+    }
+    out_value = bcd_str;
+    return true;
+}
+
+// 原模板实现：逐位在前面拼接 "0" 补齐，再逐字符验证
+bool legacy_serialize(const std::string& value, size_t byte_length, uint8_t* ptr) {
+    size_t required_digits = byte_length * 2;
+    if (value.length() > required_digits) {
+        return false;
+    }
+    std::string padded_value = value;
+    while (padded_value.length() < required_digits) {
+        padded_value = "0" + padded_value;
+    }
+    for (size_t i = 0; i < byte_length; ++i) {
+        char high_char = padded_value[i * 2];
+        char low_char = padded_value[i * 2 + 1];
+        if (high_char < '0' || high_char > '9' || low_char < '0' || low_char > '9') {
+            return false;
+        }
+        ptr[i] = static_cast<uint8_t>(((high_char - '0') << 4) | (low_char - '0'));
+    }
+    return true;
+}
+
+// 随机合法 BCD 字段；约一半带前导零（数值位数少于字段位数）
+std::vector<uint8_t> make_fields(size_t byte_length) {
+    std::vector<uint8_t> data(kFields * byte_length);
+    uint32_t state = 7;
+    for (size_t f = 0; f < kFields; ++f) {
+        for (size_t i = 0; i < byte_length; ++i) {
+            state = state * 1664525u + 1013904223u;
+            const uint32_t pair = (state >> 16) % 100;
+            data[f * byte_length + i] = static_cast<uint8_t>(((pair / 10) << 4) | (pair % 10));
+        }
+        if (f % 2 == 0) {
+            data[f * byte_length] = 0;
+        }
+    }
+    return data;
+}
+
+bool bench_field(size_t byte_length) {
+    const std::vector<uint8_t> wire = make_fields(byte_length);
+    const size_t bytes = wire.size();
+    const bool integer_mode = byte_length <= BCD_UINT_MAX_BYTES;
+
+    // 各实现的解析结果
+    std::vector<std::string> legacy_out(kFields), generic_out(kFields);
+    std::vector<uint64_t> uint_out(kFields);
+    for (size_t f = 0; f < kFields; ++f) {
+        legacy_deserialize(wire.data() + f * byte_length, byte_length, legacy_out[f]);
+    }
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%zu 字节 BCD 字段 x %zu", byte_length, kFields);
+    bench::print_header(title);
+
+    double t = bench::measure([&]() {
+        for (size_t f = 0; f < kFields; ++f) {
+            legacy_deserialize(wire.data() + f * byte_length, byte_length, legacy_out[f]);
+        }
+        bench::do_not_optimize(legacy_out);
+    });
+    bench::print_throughput("decode legacy", bytes, t);
+
+    t = bench::measure([&]() {
+        DeserializeContext ctx(wire.data(), wire.size());
+        for (size_t f = 0; f < kFields; ++f) {
+            deserialize_bcd_generic(ctx, generic_out[f], byte_length);
+        }
+        bench::do_not_optimize(generic_out);
+    });
+    bench::print_throughput("decode generic", bytes, t);
+
+    if (integer_mode) {
+        t = bench::measure([&]() {
+            DeserializeContext ctx(wire.data(), wire.size());
+            for (size_t f = 0; f < kFields; ++f) {
+                deserialize_bcd_uint(ctx, uint_out[f], byte_length);
+            }
+            bench::do_not_optimize(uint_out);
+        });
+        bench::print_throughput("decode uint", bytes, t);
+    }
+
+    bool ok = true;
+    for (size_t f = 0; f < kFields; ++f) {
+        ok = ok && generic_out[f] == legacy_out[f];
+        if (integer_mode) {
+            ok = ok && uint_out[f] == std::strtoull(legacy_out[f].c_str(), nullptr, 10);
+        }
+    }
+
+    // 序列化输入：去掉前导零的数字串（与整数形式一致）
+    std::vector<std::string> digits(kFields);
+    for (size_t f = 0; f < kFields; ++f) {
+        const size_t first = legacy_out[f].find_first_not_of('0');
+        digits[f] = first == std::string::npos ? std::string() : legacy_out[f].substr(first);
+    }
+    std::vector<uint8_t> out(bytes);
+
+    t = bench::measure([&]() {
+        for (size_t f = 0; f < kFields; ++f) {
+            legacy_serialize(digits[f], byte_length, out.data() + f * byte_length);
+        }
+        bench::do_not_optimize(out);
+    });
+    bench::print_throughput("encode legacy", bytes, t);
+    ok = ok && out == wire;
+
+    std::fill(out.begin(), out.end(), 0xEE);
+    t = bench::measure([&]() {
+        SerializeContext ctx(out.data(), out.size());
+        for (size_t f = 0; f < kFields; ++f) {
+            serialize_bcd_generic(ctx, digits[f], byte_length);
+        }
+        bench::do_not_optimize(out);
+    });
+    bench::print_throughput("encode generic", bytes, t);
+    ok = ok && out == wire;
+
+    std::fill(out.begin(), out.end(), 0xEE);
+    t = bench::measure([&]() {
+        SerializeContext ctx(out.data(), out.size());
+        for (size_t f = 0; f < kFields; ++f) {
+            serialize_bcd_digits(ctx, digits[f].data(), digits[f].size(), byte_length);
+        }
+        bench::do_not_optimize(out);
+    });
+    bench::print_throughput("encode digits", bytes, t);
+    ok = ok && out == wire;
+
+    if (integer_mode) {
+        std::fill(out.begin(), out.end(), 0xEE);
+        t = bench::measure([&]() {
+            SerializeContext ctx(out.data(), out.size());
+            for (size_t f = 0; f < kFields; ++f) {
+                serialize_bcd_uint(ctx, uint_out[f], byte_length);
+            }
+            bench::do_not_optimize(out);
+        });
+        bench::print_throughput("encode uint", bytes, t);
+        ok = ok && out == wire;
+    }
+
+    if (!ok) {
+        std::printf("MISMATCH (%zu bytes)\n", byte_length);
+    }
+    return ok;
+}
+
+bool bench_bulk() {
+    const size_t byte_length = 4096;
+    const std::vector<uint8_t> wire = make_fields(byte_length / kFields);
+    std::vector<char> text(byte_length * 2), reference(byte_length * 2);
+    std::vector<uint8_t> packed(byte_length);
+
+    bench::print_header("批量 4096 字节 BCD");
+
+    double t = bench::measure([&]() {
+        for (size_t i = 0; i < byte_length; ++i) {
+            const uint8_t high = static_cast<uint8_t>(wire[i] >> 4);
+            const uint8_t low = static_cast<uint8_t>(wire[i] & 0x0F);
+            if (high > 9 || low > 9) {
+                break;
+            }
+            reference[i * 2] = static_cast<char>('0' + high);
+            reference[i * 2 + 1] = static_cast<char>('0' + low);
+        }
+        bench::do_not_optimize(reference);
+    });
+    bench::print_throughput("unpack per-byte", byte_length, t);
+
+    t = bench::measure([&]() {
+        bcd_detail::decode_digits(wire.data(), byte_length, text.data());
+        bench::do_not_optimize(text);
+    });
+    bench::print_throughput("decode_digits", byte_length, t);
+    bool ok = text == reference;
+
+    t = bench::measure([&]() {
+        for (size_t i = 0; i < byte_length; ++i) {
+            const char high = reference[i * 2];
+            const char low = reference[i * 2 + 1];
+            if (high < '0' || high > '9' || low < '0' || low > '9') {
+                break;
+            }
+            packed[i] = static_cast<uint8_t>(((high - '0') << 4) | (low - '0'));
+        }
+        bench::do_not_optimize(packed);
+    });
+    bench::print_throughput("pack per-byte", byte_length, t);
+
+    std::fill(packed.begin(), packed.end(), 0xEE);
+    t = bench::measure([&]() {
+        bcd_detail::encode_digits(reference.data(), byte_length, packed.data());
+        bench::do_not_optimize(packed);
+    });
+    bench::print_throughput("encode_digits", byte_length, t);
+    ok = ok && packed == wire;
+
+    if (!ok) {
+        std::printf("MISMATCH (bulk)\n");
+    }
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ok = bench_field(3) && ok;
+    ok = bench_field(6) && ok;
+    ok = bench_field(9) && ok;
+    ok = bench_field(16) && ok;
+    ok = bench_bulk() && ok;
+    return ok ? 0 : 1;
+}
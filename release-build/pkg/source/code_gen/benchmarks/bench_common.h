@@ -0,0 +1,75 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+
+namespace bench {
+
+// ============================================================================
+// 计时与结果输出
+// ============================================================================
+
+// 防止编译器把基准循环优化掉
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline double now_seconds() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 以最少 min_seconds 的时长反复执行 fn，返回单次平均耗时（秒）
+template<typename Fn>
+inline double measure(Fn fn, double min_seconds = 0.2) {
+    // 预热
+    fn();
+
+    size_t iterations = 1;
+    for (;;) {
+        const double start = now_seconds();
+        for (size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        const double elapsed = now_seconds() - start;
+        if (elapsed >= min_seconds) {
+            return elapsed / static_cast<double>(iterations);
+        }
+        iterations *= (elapsed > 0.0 && elapsed * 10 > min_seconds) ? 2 : 10;
+    }
+}
+
+// 伪随机测试数据（固定种子，保证各次运行一致）
+inline std::vector<uint8_t> make_random_bytes(size_t length, uint32_t seed = 12345) {
+    std::vector<uint8_t> data(length);
+    uint32_t state = seed;
+    for (size_t i = 0; i < length; ++i) {
+        state = state * 1664525u + 1013904223u;
+        data[i] = static_cast<uint8_t>(state >> 24);
+    }
+    return data;
+}
+
+inline void print_header(const char* title) {
+    std::printf("\n=== %s ===\n", title);
+}
+
+// 单行结果：名称、数据长度、单次耗时、吞吐
+inline void print_throughput(const char* name, size_t bytes, double seconds) {
+    std::printf("%-28s %10zu B %12.1f ns %10.3f GB/s\n",
+                name, bytes, seconds * 1e9, static_cast<double>(bytes) / seconds / 1e9);
+}
+
+} // namespace bench
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,184 @@
+// ============================================================================
+// 位级读写基准：逐位循环 vs BitReader（64 位窗口装载）/ BitWriter（64 位累积器）
+// 1. 位填充写入：原 write_padding_bits_generic 的逐位实现 vs 首尾按位 + 中间 memset
+// 2. 非字节对齐字段读取：按位拼接 vs BitReader，字段宽度 5 / 12 / 23 / 61 位连续排列
+// 3. 非字节对齐字段写入：逐位写 vs BitWriter
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework bit_bench.cpp -o bit_bench
+//       （加 -mbmi2 或 -march=native 启用 BZHI / PEXT / PDEP 路径）
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <cstdio>
+
+using namespace protocol_parser;
+
+namespace {
+
+// 原实现：逐位写入填充
+void padding_bitwise(uint8_t* buffer, size_t bit_position, size_t bit_count, bool one) {
+    size_t current_offset = bit_position >> 3;
+    uint8_t current_bit = static_cast<uint8_t>(bit_position & 7);
+    while (bit_count > 0) {
+        uint8_t* ptr = buffer + current_offset;
+        if (one) {
+            *ptr |= (1 << (7 - current_bit));
+        } else {
+            *ptr &= ~(1 << (7 - current_bit));
+        }
+        current_bit++;
+        if (current_bit == 8) {
+            current_bit = 0;
+            current_offset++;
+        }
+        bit_count--;
+    }
+}
+
+// 逐位读取 count 位（MSB 优先）
+uint64_t read_bitwise(const uint8_t* data, size_t bit_position, unsigned count) {
+    uint64_t value = 0;
+    for (unsigned i = 0; i < count; ++i) {
+        const size_t bit = bit_position + i;
+        value = (value << 1) | ((data[bit >> 3] >> (7 - (bit & 7))) & 1u);
+    }
+    return value;
+}
+
+// 逐位写入 value 的低 count 位（MSB 优先）
+void write_bitwise(uint8_t* buffer, size_t bit_position, uint64_t value, unsigned count) {
+    for (unsigned i = 0; i < count; ++i) {
+        const size_t bit = bit_position + i;
+        const uint8_t mask = static_cast<uint8_t>(1u << (7 - (bit & 7)));
+        if ((value >> (count - 1 - i)) & 1u) {
+            buffer[bit >> 3] |= mask;
+        } else {
+            buffer[bit >> 3] &= static_cast<uint8_t>(~mask);
+        }
+    }
+}
+
+// 比较 [0, end_bit) 内的位（BitWriter 可能改写写入位置之后的字节）
+bool same_bits(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, size_t end_bit) {
+    for (size_t bit = 0; bit < end_bit; ++bit) {
+        if (((a[bit >> 3] ^ b[bit >> 3]) >> (7 - (bit & 7))) & 1u) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int run_padding() {
+    bench::print_header("Bit padding (start at bit 3)");
+    const size_t kSizes[] = { 5, 60, 500, 4000 };
+    std::vector<uint8_t> a(1024, 0x5A);
+    std::vector<uint8_t> b(1024, 0x5A);
+    for (size_t i = 0; i < sizeof(kSizes) / sizeof(kSizes[0]); ++i) {
+        const size_t bits = kSizes[i];
+        padding_bitwise(a.data(), 3, bits, true);
+        BitWriter writer(b.data(), b.size(), 3);
+        writer.fill(bits, true);
+        writer.flush();
+        if (!same_bits(a, b, 3 + bits)) {
+            std::printf("MISMATCH: padding %zu bits\n", bits);
+            return 1;
+        }
+
+        char name[64];
+        const size_t bytes = (bits + 7) / 8;
+        std::snprintf(name, sizeof(name), "bitwise  %4zu bits", bits);
+        bench::print_throughput(name, bytes, bench::measure([&]() {
+            padding_bitwise(a.data(), 3, bits, true);
+            bench::do_not_optimize(a[0]);
+        }));
+        std::snprintf(name, sizeof(name), "BitWriter %4zu bits", bits);
+        bench::print_throughput(name, bytes, bench::measure([&]() {
+            BitWriter w(b.data(), b.size(), 3);
+            w.fill(bits, true);
+            w.flush();
+            bench::do_not_optimize(b[0]);
+        }));
+    }
+    return 0;
+}
+
+int run_fields(unsigned width) {
+    const size_t kFields = 4096;
+    const size_t total_bits = kFields * width;
+    std::vector<uint8_t> data = bench::make_random_bytes((total_bits + 7) / 8 + 1, width);
+    std::vector<uint8_t> out_a(data.size(), 0);
+    std::vector<uint8_t> out_b(data.size(), 0);
+
+    uint64_t expected = 0;
+    for (size_t f = 0; f < kFields; ++f) {
+        expected += read_bitwise(data.data(), f * width, width);
+    }
+    uint64_t actual = 0;
+    BitReader reader(data.data(), data.size());
+    for (size_t f = 0; f < kFields; ++f) {
+        actual += reader.read(width);
+    }
+    for (size_t f = 0; f < kFields; ++f) {
+        write_bitwise(out_a.data(), f * width, f * 0x9E3779B97F4A7C15ULL, width);
+    }
+    BitWriter check_writer(out_b.data(), out_b.size());
+    for (size_t f = 0; f < kFields; ++f) {
+        check_writer.write(f * 0x9E3779B97F4A7C15ULL, width);
+    }
+    check_writer.flush();
+    if (actual != expected || !same_bits(out_a, out_b, total_bits)) {
+        std::printf("MISMATCH: %u-bit fields\n", width);
+        return 1;
+    }
+
+    char title[64];
+    std::snprintf(title, sizeof(title), "%zu unaligned %u-bit fields", kFields, width);
+    bench::print_header(title);
+    const size_t bytes = total_bits / 8;
+    bench::print_throughput("read bitwise", bytes, bench::measure([&]() {
+        uint64_t sum = 0;
+        for (size_t f = 0; f < kFields; ++f) {
+            sum += read_bitwise(data.data(), f * width, width);
+        }
+        bench::do_not_optimize(sum);
+    }));
+    bench::print_throughput("read BitReader", bytes, bench::measure([&]() {
+        uint64_t sum = 0;
+        BitReader r(data.data(), data.size());
+        for (size_t f = 0; f < kFields; ++f) {
+            sum += r.read(width);
+        }
+        bench::do_not_optimize(sum);
+    }));
+    bench::print_throughput("write bitwise", bytes, bench::measure([&]() {
+        for (size_t f = 0; f < kFields; ++f) {
+            write_bitwise(out_a.data(), f * width, f, width);
+        }
+        bench::do_not_optimize(out_a[0]);
+    }));
+    bench::print_throughput("write BitWriter", bytes, bench::measure([&]() {
+        BitWriter w(out_b.data(), out_b.size());
+        for (size_t f = 0; f < kFields; ++f) {
+            w.write(f, width);
+        }
+        w.flush();
+        bench::do_not_optimize(out_b[0]);
+    }));
+    return 0;
+}
+
+} // namespace
+
+int main() {
+#if defined(PROTOCOL_BITS_BMI2)
+    std::printf("BMI2: enabled\n");
+#else
+    std::printf("BMI2: disabled (compile with -mbmi2 to enable)\n");
+#endif
+    int failures = run_padding();
+    const unsigned kWidths[] = { 5, 12, 23, 61 };
+    for (size_t i = 0; i < sizeof(kWidths) / sizeof(kWidths[0]); ++i) {
+        failures += run_fields(kWidths[i]);
+    }
+    return failures == 0 ? 0 : 1;
+}
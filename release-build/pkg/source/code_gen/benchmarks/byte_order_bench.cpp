@@ -0,0 +1,332 @@
+// ============================================================================
+// 字节序读写基准：运行期字节序 vs 编译期字节序
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework byte_order_bench.cpp -o byte_order_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <cstdio>
+
+using namespace protocol_parser;
+
+namespace {
+
+// ============================================================================
+// 旧实现（逐字节反转 + 每次读写都做运行期字节序检测 + 带 std::string 的结果对象），作为对照
+// ============================================================================
+namespace legacy {
+
+inline bool is_system_little_endian() {
+    uint16_t test = 0x0001;
+    volatile uint8_t first = *reinterpret_cast<uint8_t*>(&test);
+    return first == 0x01;
+}
+
+template<typename T>
+inline T reverse_bytes(T value) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T) / 2; ++i) {
+        std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    }
+    T result;
+    std::memcpy(&result, bytes, sizeof(T));
+    return result;
+}
+
+template<typename T>
+inline DeserializeResult read(DeserializeContext& ctx, T& out_value) {
+    if (!ctx.has_bytes(sizeof(T))) {
+        return DeserializeResult(INSUFFICIENT_DATA, "Not enough data", 0);
+    }
+    T value;
+    std::memcpy(&value, ctx.data + ctx.offset, sizeof(T));
+    bool need_swap = (ctx.byte_order == BIG_ENDIAN && is_system_little_endian()) ||
+                     (ctx.byte_order == LITTLE_ENDIAN && !is_system_little_endian());
+    if (need_swap) {
+        value = reverse_bytes(value);
+    }
+    out_value = value;
+    ctx.advance(sizeof(T));
+    return DeserializeResult(SUCCESS, "", sizeof(T));
+}
+
+template<typename T>
+inline SerializeResult write(SerializeContext& ctx, T value) {
+    if (!ctx.has_space(sizeof(T))) {
+        return SerializeResult(BUFFER_OVERFLOW, "Not enough space", 0);
+    }
+    bool need_swap = (ctx.byte_order == BIG_ENDIAN && is_system_little_endian()) ||
+                     (ctx.byte_order == LITTLE_ENDIAN && !is_system_little_endian());
+    if (need_swap) {
+        value = reverse_bytes(value);
+    }
+    std::memcpy(ctx.buffer + ctx.offset, &value, sizeof(T));
+    ctx.advance(sizeof(T));
+    return SerializeResult(SUCCESS, "", sizeof(T));
+}
+
+} // namespace legacy
+
+// ============================================================================
+// 三种字段读写策略（与生成代码的调用形式一致）
+// ============================================================================
+
+struct LegacyPolicy {
+    static const char* name() { return "legacy (byte loop)"; }
+    template<typename T> static DeserializeResult read(DeserializeContext& ctx, T& v) { return legacy::read(ctx, v); }
+    template<typename T> static SerializeResult write(SerializeContext& ctx, T v) { return legacy::write(ctx, v); }
+};
+
+// 字段类别标签：0 无符号整数 / 1 有符号整数 / 2 浮点
+template<typename T>
+struct ScalarKind : std::integral_constant<int,
+    std::is_floating_point<T>::value ? 2 : (std::is_signed<T>::value ? 1 : 0)> {};
+
+struct RuntimePolicy {
+    static const char* name() { return "runtime byte order"; }
+    template<typename T> static DeserializeStatus read(DeserializeContext& ctx, T& v) { return read(ctx, v, ScalarKind<T>()); }
+    template<typename T> static SerializeStatus write(SerializeContext& ctx, T v) { return write(ctx, v, ScalarKind<T>()); }
+
+private:
+    template<typename T> static DeserializeStatus read(DeserializeContext& ctx, T& v, std::integral_constant<int, 0>) { return deserialize_unsigned_int_generic<T>(ctx, v); }
+    template<typename T> static DeserializeStatus read(DeserializeContext& ctx, T& v, std::integral_constant<int, 1>) { return deserialize_signed_int_generic<T>(ctx, v); }
+    template<typename T> static DeserializeStatus read(DeserializeContext& ctx, T& v, std::integral_constant<int, 2>) { return deserialize_float_generic<T>(ctx, v); }
+    template<typename T> static SerializeStatus write(SerializeContext& ctx, T v, std::integral_constant<int, 0>) { return serialize_unsigned_int_generic<T>(ctx, v); }
+    template<typename T> static SerializeStatus write(SerializeContext& ctx, T v, std::integral_constant<int, 1>) { return serialize_signed_int_generic<T>(ctx, v); }
+    template<typename T> static SerializeStatus write(SerializeContext& ctx, T v, std::integral_constant<int, 2>) { return serialize_float_generic<T>(ctx, v); }
+};
+
+template<ByteOrder Order>
+struct FixedPolicy {
+    static const char* name() { return "compile-time byte order"; }
+    template<typename T> static DeserializeStatus read(DeserializeContext& ctx, T& v) { return deserialize_scalar_fixed<Order, T>(ctx, v); }
+    template<typename T> static SerializeStatus write(SerializeContext& ctx, T v) { return serialize_scalar_fixed<Order, T>(ctx, v); }
+};
+
+// ============================================================================
+// 典型报文 Raw 结构（字段组合与生成代码的 _Raw 相同，线上共 38 字节）
+// ============================================================================
+struct SampleRaw {
+    uint8_t  header;
+    uint16_t length;
+    uint32_t message_id;
+    int16_t  temperature;
+    int32_t  altitude;
+    float    speed;
+    double   latitude;
+    uint64_t timestamp;
+    uint32_t sequence;
+    uint8_t  flags;
+
+    bool operator==(const SampleRaw& o) const {
+        return header == o.header && length == o.length && message_id == o.message_id &&
+               temperature == o.temperature && altitude == o.altitude &&
+               std::memcmp(&speed, &o.speed, sizeof(speed)) == 0 &&
+               std::memcmp(&latitude, &o.latitude, sizeof(latitude)) == 0 &&
+               timestamp == o.timestamp && sequence == o.sequence && flags == o.flags;
+    }
+};
+
+const size_t kFrameSize = 38;
+
+#define BENCH_READ(field) \
+    { if (!Policy::read(ctx, raw.field).is_success()) return false; }
+#define BENCH_WRITE(field) \
+    { if (!Policy::write(ctx, raw.field).is_success()) return false; }
+
+template<typename Policy>
+bool parse_sample(const uint8_t* buffer, size_t len, ByteOrder byte_order, SampleRaw& raw) {
+    DeserializeContext ctx(buffer, len, byte_order);
+    BENCH_READ(header)
+    BENCH_READ(length)
+    BENCH_READ(message_id)
+    BENCH_READ(temperature)
+    BENCH_READ(altitude)
+    BENCH_READ(speed)
+    BENCH_READ(latitude)
+    BENCH_READ(timestamp)
+    BENCH_READ(sequence)
+    BENCH_READ(flags)
+    return true;
+}
+
+template<typename Policy>
+bool serialize_sample(const SampleRaw& raw, uint8_t* buffer, size_t size, ByteOrder byte_order) {
+    SerializeContext ctx(buffer, size, byte_order);
+    BENCH_WRITE(header)
+    BENCH_WRITE(length)
+    BENCH_WRITE(message_id)
+    BENCH_WRITE(temperature)
+    BENCH_WRITE(altitude)
+    BENCH_WRITE(speed)
+    BENCH_WRITE(latitude)
+    BENCH_WRITE(timestamp)
+    BENCH_WRITE(sequence)
+    BENCH_WRITE(flags)
+    return true;
+}
+
+#undef BENCH_READ
+#undef BENCH_WRITE
+
+// ============================================================================
+// 仅取数层对比：去掉结果对象构造，只衡量 load + 字节序处理本身
+// ============================================================================
+
+struct LegacyLoad {
+    static const char* name() { return "legacy load"; }
+    template<typename T>
+    static T load(const uint8_t* p, ByteOrder order) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        bool need_swap = (order == BIG_ENDIAN && legacy::is_system_little_endian()) ||
+                         (order == LITTLE_ENDIAN && !legacy::is_system_little_endian());
+        return need_swap ? legacy::reverse_bytes(value) : value;
+    }
+};
+
+struct RuntimeLoad {
+    static const char* name() { return "read_with_byte_order"; }
+    template<typename T>
+    static T load(const uint8_t* p, ByteOrder order) { return read_with_byte_order<T>(p, order); }
+};
+
+template<ByteOrder Order>
+struct FixedLoad {
+    static const char* name() { return "read_fixed_order"; }
+    template<typename T>
+    static T load(const uint8_t* p, ByteOrder) { return read_fixed_order<Order, T>(p); }
+};
+
+#define BENCH_LOAD(field) \
+    raw.field = Load::template load<decltype(raw.field)>(p, order); p += sizeof(raw.field);
+
+template<typename Load>
+void load_sample(const uint8_t* p, ByteOrder order, SampleRaw& raw) {
+    BENCH_LOAD(header)
+    BENCH_LOAD(length)
+    BENCH_LOAD(message_id)
+    BENCH_LOAD(temperature)
+    BENCH_LOAD(altitude)
+    BENCH_LOAD(speed)
+    BENCH_LOAD(latitude)
+    BENCH_LOAD(timestamp)
+    BENCH_LOAD(sequence)
+    BENCH_LOAD(flags)
+}
+
+#undef BENCH_LOAD
+
+const size_t kFrameCount = 4096;
+
+template<typename Policy>
+int run_policy(const std::vector<uint8_t>& frames, ByteOrder order,
+               const std::vector<SampleRaw>& expected) {
+    int mismatches = 0;
+    std::vector<SampleRaw> parsed(kFrameCount);
+    std::vector<uint8_t> output(frames.size());
+
+    for (size_t i = 0; i < kFrameCount; ++i) {
+        parse_sample<Policy>(frames.data() + i * kFrameSize, kFrameSize, order, parsed[i]);
+        if (!expected.empty() && !(parsed[i] == expected[i])) {
+            ++mismatches;
+        }
+        serialize_sample<Policy>(parsed[i], output.data() + i * kFrameSize, kFrameSize, order);
+    }
+    if (output != frames) {
+        ++mismatches;
+    }
+    if (mismatches != 0) {
+        std::printf("MISMATCH: %s\n", Policy::name());
+    }
+
+    const double parse_seconds = bench::measure([&]() {
+        for (size_t i = 0; i < kFrameCount; ++i) {
+            parse_sample<Policy>(frames.data() + i * kFrameSize, kFrameSize, order, parsed[i]);
+        }
+        bench::do_not_optimize(parsed);
+    });
+    const double serialize_seconds = bench::measure([&]() {
+        for (size_t i = 0; i < kFrameCount; ++i) {
+            serialize_sample<Policy>(parsed[i], output.data() + i * kFrameSize, kFrameSize, order);
+        }
+        bench::do_not_optimize(output);
+    });
+
+    std::printf("%-26s parse %7.2f ns/frame %7.3f GB/s | serialize %7.2f ns/frame %7.3f GB/s\n",
+                Policy::name(),
+                parse_seconds * 1e9 / kFrameCount, frames.size() / parse_seconds / 1e9,
+                serialize_seconds * 1e9 / kFrameCount, frames.size() / serialize_seconds / 1e9);
+    return mismatches;
+}
+
+template<typename Load>
+int run_load(const std::vector<uint8_t>& frames, ByteOrder order,
+             const std::vector<SampleRaw>& expected) {
+    int mismatches = 0;
+    std::vector<SampleRaw> parsed(kFrameCount);
+    for (size_t i = 0; i < kFrameCount; ++i) {
+        load_sample<Load>(frames.data() + i * kFrameSize, order, parsed[i]);
+        if (!(parsed[i] == expected[i])) {
+            ++mismatches;
+        }
+    }
+    if (mismatches != 0) {
+        std::printf("MISMATCH: %s\n", Load::name());
+    }
+
+    const double seconds = bench::measure([&]() {
+        for (size_t i = 0; i < kFrameCount; ++i) {
+            load_sample<Load>(frames.data() + i * kFrameSize, order, parsed[i]);
+        }
+        bench::do_not_optimize(parsed);
+    });
+    std::printf("%-26s load  %7.2f ns/frame %7.3f GB/s\n",
+                Load::name(), seconds * 1e9 / kFrameCount, frames.size() / seconds / 1e9);
+    return mismatches;
+}
+
+// 运行期字节序经 volatile 传入，避免编译器把"运行期"路径常量折叠成编译期路径
+volatile int g_opaque_order = 0;
+
+template<ByteOrder Order>
+int run_order(const char* title) {
+    bench::print_header(title);
+    const std::vector<uint8_t> frames = bench::make_random_bytes(kFrameCount * kFrameSize);
+
+    // 以旧实现的解析结果为参照
+    std::vector<SampleRaw> expected(kFrameCount);
+    for (size_t i = 0; i < kFrameCount; ++i) {
+        parse_sample<LegacyPolicy>(frames.data() + i * kFrameSize, kFrameSize, Order, expected[i]);
+    }
+
+    g_opaque_order = static_cast<int>(Order);
+    const ByteOrder order = static_cast<ByteOrder>(g_opaque_order);
+
+    int mismatches = 0;
+    mismatches += run_policy<LegacyPolicy>(frames, order, expected);
+    mismatches += run_policy<RuntimePolicy>(frames, order, expected);
+    mismatches += run_policy<FixedPolicy<Order> >(frames, order, expected);
+    mismatches += run_load<LegacyLoad>(frames, order, expected);
+    mismatches += run_load<RuntimeLoad>(frames, order, expected);
+    mismatches += run_load<FixedLoad<Order> >(frames, order, expected);
+    return mismatches;
+}
+
+} // namespace
+
+int main() {
+    std::printf("Host byte order: %s, frame size %zu B, %zu frames per iteration\n",
+                is_system_little_endian() ? "little" : "big", kFrameSize, kFrameCount);
+
+    int mismatches = 0;
+    mismatches += run_order<BIG_ENDIAN>("Big-endian wire format");
+    mismatches += run_order<LITTLE_ENDIAN>("Little-endian wire format");
+
+    if (mismatches != 0) {
+        std::printf("\n%d mismatches against legacy implementation\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,949 @@
+// ============================================================================
+// 抓包读取与回放基准（protocol_capture.h / protocol_replay.h）
+// 内存中合成录制文件，逐条核对 CaptureReader + extract_payload() 的载荷与时间戳：
+// 1. pcap：微秒/纳秒时间戳 × 大端/小端，以太网帧含 802.1Q / QinQ 标签、IPv6 扩展头、TCP 选项、
+//    ARP 与纯 ACK，另测 snaplen 截断和文件末尾的半条记录
+// 2. pcapng：两个 Section（小端 + 大端），各接口 if_tsresol 不同（10^-n 与 2^-n 秒），EPB + SPB，
+//    夹杂需跳过的非报文块，末尾截断
+// 3. 长度前缀文件：1/2/4 字节长度、大小端、长度含/不含前缀本身，含空记录与末尾截断
+// 4. load_replay_messages() 的统计和 replay_messages() 多线程按槽位计数
+// 最后在约 20 万条报文的文件上测遍历 + 载荷提取的每条耗时（pcap 经 MappedFile 映射临时文件）
+// 编译: g++ -std=c++11 -O2 -pthread -I../protocol_parser_framework capture_bench.cpp -o capture_bench
+// ============================================================================
+#include "protocol_capture.h"
+#include "protocol_replay.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace protocol_parser;
+
+namespace {
+
+typedef std::vector<uint8_t> Bytes;
+
+const uint16_t kUdpPort = 9000;
+const uint16_t kTcpPort = 9001;
+const uint64_t kNanosPerSecond = 1000000000ULL;
+const uint64_t kBaseTime = 1700000000ULL * kNanosPerSecond;   // 2023-11-14
+
+// ============================================================================
+// 字节写入
+// ============================================================================
+void put8(Bytes& out, uint8_t value) {
+    out.push_back(value);
+}
+
+void put16(Bytes& out, uint16_t value, bool big = true) {
+    if (big) {
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    } else {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+}
+
+void put32(Bytes& out, uint32_t value, bool big = true) {
+    if (big) {
+        put16(out, static_cast<uint16_t>(value >> 16), true);
+        put16(out, static_cast<uint16_t>(value), true);
+    } else {
+        put16(out, static_cast<uint16_t>(value), false);
+        put16(out, static_cast<uint16_t>(value >> 16), false);
+    }
+}
+
+void append(Bytes& out, const Bytes& data) {
+    out.insert(out.end(), data.begin(), data.end());
+}
+
+void pad4(Bytes& out) {
+    while (out.size() % 4 != 0) {
+        out.push_back(0);
+    }
+}
+
+// ============================================================================
+// 报文构造
+// 每条报文记录期望的解码结果：时间戳、链路类型、载荷与 extract_payload() 状态
+// ============================================================================
+enum PacketKind {
+    KIND_UDP4,            // 以太网 / IPv4 / UDP
+    KIND_UDP4_VLAN,       // 802.1Q 单标签
+    KIND_UDP4_QINQ,       // 802.1ad 外层 + 802.1Q 内层
+    KIND_TCP4,            // IPv4 / TCP，12 字节选项
+    KIND_UDP6,            // IPv6 + Hop-by-Hop 扩展头 / UDP
+    KIND_TCP4_ACK,        // 无载荷的 TCP ACK
+    KIND_ARP,             // 非 IP（原始 IP 链路上换成 ICMP）
+    KIND_COUNT
+};
+
+struct Packet {
+    Bytes frame;                 // 写入文件的捕获字节
+    size_t original_length;
+    uint32_t link_type;
+    uint64_t ticks;              // pcapng 中的时间戳刻度（按所属接口的 if_tsresol）
+    uint32_t interface_id;       // pcapng 接口序号
+    bool simple;                 // pcapng 中写为 SPB（无时间戳）
+    uint64_t timestamp_ns;       // 期望的 CaptureRecord::timestamp_ns
+    Bytes payload;               // 期望的应用层载荷（不考虑端口过滤与 skip）
+    PayloadStatus status;        // 不过滤时期望的提取结果
+    int port;                    // 目的端口（非 UDP/TCP 为 -1）
+
+    Packet()
+        : original_length(0), link_type(LINKTYPE_ETHERNET), ticks(0), interface_id(0), simple(false)
+        , timestamp_ns(0), status(PAYLOAD_OK), port(-1) {}
+};
+
+Bytes make_payload(size_t index) {
+    Bytes payload(1 + (index * 37) % 300);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<uint8_t>(index * 131 + i * 7);
+    }
+    return payload;
+}
+
+Bytes udp_segment(const Bytes& payload) {
+    Bytes out;
+    put16(out, 40000);
+    put16(out, kUdpPort);
+    put16(out, static_cast<uint16_t>(8 + payload.size()));
+    put16(out, 0);
+    append(out, payload);
+    return out;
+}
+
+Bytes tcp_segment(const Bytes& payload) {
+    Bytes out;
+    put16(out, 40001);
+    put16(out, kTcpPort);
+    put32(out, 0x01020304u);                   // seq
+    put32(out, 0x05060708u);                   // ack
+    put8(out, 8 << 4);                         // 数据偏移 32 字节
+    put8(out, payload.empty() ? 0x10 : 0x18);  // ACK / PSH+ACK
+    put16(out, 65535);
+    put16(out, 0);
+    put16(out, 0);
+    const uint8_t options[12] = { 1, 1, 8, 10, 0, 0, 0, 1, 0, 0, 0, 2 };   // NOP NOP Timestamp
+    out.insert(out.end(), options, options + sizeof(options));
+    append(out, payload);
+    return out;
+}
+
+Bytes ipv4_packet(uint8_t protocol, const Bytes& segment) {
+    Bytes out;
+    put8(out, 0x45);
+    put8(out, 0);
+    put16(out, static_cast<uint16_t>(20 + segment.size()));
+    put16(out, 0x1234);
+    put16(out, 0x4000);                        // DF
+    put8(out, 64);
+    put8(out, protocol);
+    put16(out, 0);
+    put32(out, 0x0A000001u);
+    put32(out, 0x0A000002u);
+    append(out, segment);
+    return out;
+}
+
+Bytes ipv6_packet(const Bytes& segment) {
+    Bytes out;
+    put32(out, 0x60000000u);
+    put16(out, static_cast<uint16_t>(8 + segment.size()));
+    put8(out, 0);                              // Hop-by-Hop
+    put8(out, 64);
+    for (int i = 0; i < 32; ++i) {
+        put8(out, static_cast<uint8_t>(i));
+    }
+    const uint8_t hop_by_hop[8] = { 17, 0, 1, 4, 0, 0, 0, 0 };   // next = UDP，PadN
+    out.insert(out.end(), hop_by_hop, hop_by_hop + sizeof(hop_by_hop));
+    append(out, segment);
+    return out;
+}
+
+Bytes ethernet_frame(const uint16_t* tags, size_t tag_count, uint16_t ethertype, const Bytes& body) {
+    Bytes out;
+    for (int i = 0; i < 12; ++i) {
+        put8(out, static_cast<uint8_t>(0x10 + i));
+    }
+    for (size_t t = 0; t < tag_count; ++t) {
+        put16(out, tags[t]);
+        put16(out, static_cast<uint16_t>(100 + t));   // VLAN ID
+    }
+    put16(out, ethertype);
+    append(out, body);
+    while (out.size() < 60) {                  // 最小帧填充，须由 IP/UDP 长度去掉
+        out.push_back(0);
+    }
+    return out;
+}
+
+Packet make_packet(size_t index, PacketKind kind, uint32_t link_type) {
+    Packet packet;
+    packet.link_type = link_type;
+    packet.payload = make_payload(index);
+    Bytes ip;
+    uint16_t ethertype = capture_detail::ETHERTYPE_IPV4;
+    switch (kind) {
+        case KIND_TCP4:
+            ip = ipv4_packet(capture_detail::IP_PROTO_TCP, tcp_segment(packet.payload));
+            packet.port = kTcpPort;
+            break;
+        case KIND_TCP4_ACK:
+            packet.payload.clear();
+            ip = ipv4_packet(capture_detail::IP_PROTO_TCP, tcp_segment(packet.payload));
+            packet.port = kTcpPort;
+            packet.status = PAYLOAD_EMPTY;
+            break;
+        case KIND_UDP6:
+            ip = ipv6_packet(udp_segment(packet.payload));
+            ethertype = capture_detail::ETHERTYPE_IPV6;
+            packet.port = kUdpPort;
+            break;
+        case KIND_ARP:
+            packet.payload.clear();
+            if (link_type == LINKTYPE_ETHERNET) {
+                ip.assign(28, 0x01);
+                ethertype = 0x0806;
+                packet.status = PAYLOAD_NOT_IP;
+            } else {
+                ip = ipv4_packet(1, Bytes(16, 0x08));   // ICMP
+                packet.status = PAYLOAD_NOT_TRANSPORT;
+            }
+            break;
+        default:
+            ip = ipv4_packet(capture_detail::IP_PROTO_UDP, udp_segment(packet.payload));
+            packet.port = kUdpPort;
+            break;
+    }
+    if (link_type == LINKTYPE_ETHERNET) {
+        const uint16_t vlan[1] = { capture_detail::ETHERTYPE_VLAN };
+        const uint16_t qinq[2] = { capture_detail::ETHERTYPE_QINQ, capture_detail::ETHERTYPE_VLAN };
+        if (kind == KIND_UDP4_VLAN) {
+            packet.frame = ethernet_frame(vlan, 1, ethertype, ip);
+        } else if (kind == KIND_UDP4_QINQ) {
+            packet.frame = ethernet_frame(qinq, 2, ethertype, ip);
+        } else {
+            packet.frame = ethernet_frame(nullptr, 0, ethertype, ip);
+        }
+    } else {
+        packet.frame = ip;
+    }
+    packet.original_length = packet.frame.size();
+    return packet;
+}
+
+std::vector<Packet> make_packets(size_t count, size_t first_index, uint32_t link_type) {
+    std::vector<Packet> packets;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t index = first_index + i;
+        packets.push_back(make_packet(index, static_cast<PacketKind>(index % KIND_COUNT), link_type));
+    }
+    return packets;
+}
+
+// snaplen 截断：只保留前 snaplen 字节，原始长度不变
+Packet snap(Packet packet, size_t snaplen, size_t header_bytes) {
+    packet.frame.resize(snaplen);
+    if (snaplen <= header_bytes) {
+        packet.status = PAYLOAD_TRUNCATED;
+        packet.payload.clear();
+    } else {
+        packet.payload.resize(snaplen - header_bytes);
+    }
+    return packet;
+}
+
+// ============================================================================
+// 文件写入
+// ============================================================================
+
+// pcap：时间戳取自 timestamp_ns（微秒文件要求其为整微秒）
+Bytes write_pcap(const std::vector<Packet>& packets, bool big, bool nanosecond, uint32_t link_type) {
+    Bytes out;
+    put32(out, nanosecond ? capture_detail::PCAP_MAGIC_NS : capture_detail::PCAP_MAGIC_US, big);
+    put16(out, 2, big);
+    put16(out, 4, big);
+    put32(out, 0, big);
+    put32(out, 0, big);
+    put32(out, 262144, big);
+    put32(out, link_type, big);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const Packet& packet = packets[i];
+        const uint64_t fraction = packet.timestamp_ns % kNanosPerSecond;
+        put32(out, static_cast<uint32_t>(packet.timestamp_ns / kNanosPerSecond), big);
+        put32(out, static_cast<uint32_t>(nanosecond ? fraction : fraction / 1000), big);
+        put32(out, static_cast<uint32_t>(packet.frame.size()), big);
+        put32(out, static_cast<uint32_t>(packet.original_length), big);
+        append(out, packet.frame);
+    }
+    return out;
+}
+
+// pcapng 块：type + 总长度 + 正文（补齐到 4 字节）+ 总长度
+void put_block(Bytes& out, uint32_t type, const Bytes& body, bool big) {
+    Bytes padded = body;
+    pad4(padded);
+    const uint32_t total = static_cast<uint32_t>(12 + padded.size());
+    put32(out, type, big);
+    put32(out, total, big);
+    append(out, padded);
+    put32(out, total, big);
+}
+
+void put_option(Bytes& body, uint16_t code, const Bytes& value, bool big) {
+    put16(body, code, big);
+    put16(body, static_cast<uint16_t>(value.size()), big);
+    append(body, value);
+    pad4(body);
+}
+
+void put_section_header(Bytes& out, bool big) {
+    Bytes body;
+    put32(body, capture_detail::PCAPNG_BYTE_ORDER_MAGIC, big);
+    put16(body, 1, big);
+    put16(body, 0, big);
+    put32(body, 0xFFFFFFFFu, big);             // Section 长度未知
+    put32(body, 0xFFFFFFFFu, big);
+    const char application[] = "capture_bench";
+    put_option(body, 4, Bytes(application, application + sizeof(application) - 1), big);   // shb_userappl
+    put_option(body, 0, Bytes(), big);
+    put_block(out, capture_detail::PCAPNG_SHB, body, big);
+}
+
+// tsresol < 0 表示不写 if_tsresol（默认微秒）；if_name 放在 if_tsresol 之前，验证选项遍历
+void put_interface(Bytes& out, uint16_t link_type, int tsresol, bool big) {
+    Bytes body;
+    put16(body, link_type, big);
+    put16(body, 0, big);
+    put32(body, 262144, big);
+    const char name[] = "eth0";
+    put_option(body, 2, Bytes(name, name + sizeof(name) - 1), big);   // if_name
+    if (tsresol >= 0) {
+        put_option(body, 9, Bytes(1, static_cast<uint8_t>(tsresol)), big);
+    }
+    put_option(body, 0, Bytes(), big);
+    put_block(out, capture_detail::PCAPNG_IDB, body, big);
+}
+
+void put_packet_block(Bytes& out, const Packet& packet, bool big) {
+    Bytes body;
+    if (packet.simple) {
+        put32(body, static_cast<uint32_t>(packet.original_length), big);
+        append(body, packet.frame);
+        put_block(out, capture_detail::PCAPNG_SPB, body, big);
+        return;
+    }
+    put32(body, packet.interface_id, big);
+    put32(body, static_cast<uint32_t>(packet.ticks >> 32), big);
+    put32(body, static_cast<uint32_t>(packet.ticks), big);
+    put32(body, static_cast<uint32_t>(packet.frame.size()), big);
+    put32(body, static_cast<uint32_t>(packet.original_length), big);
+    append(body, packet.frame);
+    pad4(body);
+    if (packet.frame.size() % 3 == 0) {
+        const char comment[] = "epb comment";
+        put_option(body, 1, Bytes(comment, comment + sizeof(comment) - 1), big);   // opt_comment
+        put_option(body, 0, Bytes(), big);
+    }
+    put_block(out, capture_detail::PCAPNG_EPB, body, big);
+}
+
+// 参考换算：if_tsresol 刻度 → 纳秒（整数运算，与 scale_timestamp() 的实现无关）
+uint64_t ticks_to_ns(uint64_t ticks, int tsresol) {
+    if (tsresol < 0) {
+        return ticks * 1000;
+    }
+    if ((tsresol & 0x80) != 0) {
+        const unsigned shift = tsresol & 0x7F;
+        const uint64_t mask = (1ULL << shift) - 1;
+        return (ticks >> shift) * kNanosPerSecond + (((ticks & mask) * kNanosPerSecond) >> shift);
+    }
+    uint64_t factor = 1;
+    if (tsresol <= 9) {
+        for (int i = tsresol; i < 9; ++i) factor *= 10;
+        return ticks * factor;
+    }
+    for (int i = 9; i < tsresol; ++i) factor *= 10;
+    return ticks / factor;
+}
+
+// 长度前缀文件
+Bytes write_length_prefixed(const std::vector<Packet>& packets, const LengthPrefixSpec& spec) {
+    Bytes out;
+    const bool big = spec.byte_order != LITTLE_ENDIAN;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const size_t value = packets[i].frame.size() + (spec.includes_prefix ? spec.prefix_bytes : 0);
+        if (spec.prefix_bytes == 1) {
+            put8(out, static_cast<uint8_t>(value));
+        } else if (spec.prefix_bytes == 2) {
+            put16(out, static_cast<uint16_t>(value), big);
+        } else {
+            put32(out, static_cast<uint32_t>(value), big);
+        }
+        append(out, packets[i].frame);
+    }
+    return out;
+}
+
+std::vector<Packet> make_records(size_t count, size_t max_length) {
+    std::vector<Packet> records;
+    for (size_t i = 0; i < count; ++i) {
+        Packet record;
+        record.link_type = LINKTYPE_PAYLOAD;
+        record.frame = make_payload(i * 5 + 3);
+        if (record.frame.size() > max_length) {
+            record.frame.resize(max_length);
+        }
+        if (i % 9 == 4) {
+            record.frame.clear();              // 空记录
+            record.status = PAYLOAD_EMPTY;
+        }
+        record.original_length = record.frame.size();
+        record.payload = record.frame;
+        records.push_back(record);
+    }
+    return records;
+}
+
+// ============================================================================
+// 核对
+// ============================================================================
+PayloadStatus expected_status(const Packet& packet, const PayloadOptions& options, Bytes& payload) {
+    payload.clear();
+    if (packet.status != PAYLOAD_OK && packet.status != PAYLOAD_EMPTY) {
+        return packet.status;
+    }
+    if (packet.link_type != LINKTYPE_PAYLOAD && options.port >= 0 && packet.port != options.port) {
+        return PAYLOAD_FILTERED;
+    }
+    if (packet.status == PAYLOAD_EMPTY) {
+        return PAYLOAD_EMPTY;
+    }
+    if (packet.payload.size() <= options.skip) {
+        return PAYLOAD_TRUNCATED;
+    }
+    payload.assign(packet.payload.begin() + static_cast<std::ptrdiff_t>(options.skip), packet.payload.end());
+    return PAYLOAD_OK;
+}
+
+struct Expectation {
+    CaptureFormat format;
+    LengthPrefixSpec prefix;
+    PayloadOptions options;
+    size_t truncated;
+    size_t skipped_blocks;
+
+    Expectation() : format(CAPTURE_PCAP), truncated(0), skipped_blocks(0) {}
+};
+
+int check_capture(const char* name, const Bytes& file, const std::vector<Packet>& packets,
+                  const Expectation& expect) {
+    int failures = 0;
+    CaptureReader reader(file.data(), file.size(), CAPTURE_AUTO, expect.prefix);
+    if (reader.format() != expect.format) {
+        std::printf("MISMATCH: %s detected as %s\n", name, capture_format_name(reader.format()));
+        return 1;
+    }
+    size_t count = 0;
+    size_t payloads = 0;
+    CaptureRecord record;
+    while (reader.next(record)) {
+        const size_t i = count++;
+        if (i >= packets.size()) {
+            continue;
+        }
+        const Packet& packet = packets[i];
+        if (record.timestamp_ns != packet.timestamp_ns || record.link_type != packet.link_type ||
+            record.length != packet.frame.size() || record.original_length != packet.original_length ||
+            (record.length != 0 && std::memcmp(record.data, packet.frame.data(), record.length) != 0)) {
+            if (failures++ < 3) {
+                std::printf("MISMATCH: %s record %zu (timestamp %llu, expected %llu; length %zu/%zu)\n", name, i,
+                            static_cast<unsigned long long>(record.timestamp_ns),
+                            static_cast<unsigned long long>(packet.timestamp_ns), record.length, record.original_length);
+            }
+            continue;
+        }
+        Bytes expected;
+        const PayloadStatus want = expected_status(packet, expect.options, expected);
+        const uint8_t* out = nullptr;
+        size_t out_length = 0;
+        const PayloadStatus got = extract_payload(record, expect.options, out, out_length);
+        if (got != want) {
+            if (failures++ < 3) {
+                std::printf("MISMATCH: %s record %zu payload status %s, expected %s\n", name, i,
+                            payload_status_name(got), payload_status_name(want));
+            }
+            continue;
+        }
+        if (got != PAYLOAD_OK) {
+            continue;
+        }
+        // 载荷须指向文件内部（不拷贝），内容与构造时一致
+        const bool inside = out >= file.data() && out + out_length <= file.data() + file.size();
+        if (!inside || out_length != expected.size() || std::memcmp(out, expected.data(), out_length) != 0) {
+            if (failures++ < 3) {
+                std::printf("MISMATCH: %s record %zu payload (%zu bytes, expected %zu)\n", name, i,
+                            out_length, expected.size());
+            }
+            continue;
+        }
+        ++payloads;
+    }
+    if (!reader.ok()) {
+        std::printf("MISMATCH: %s reader error: %s\n", name, reader.error().c_str());
+        ++failures;
+    }
+    if (count != packets.size() || reader.truncated() != expect.truncated ||
+        reader.skipped_blocks() != expect.skipped_blocks) {
+        std::printf("MISMATCH: %s %zu records (expected %zu), truncated %zu (expected %zu), skipped %zu (expected %zu)\n",
+                    name, count, packets.size(), reader.truncated(), expect.truncated,
+                    reader.skipped_blocks(), expect.skipped_blocks);
+        ++failures;
+    }
+    if (failures == 0) {
+        std::printf("%-44s %6zu records %6zu payloads  ok\n", name, count, payloads);
+    }
+    return failures;
+}
+
+// ============================================================================
+// 合成文件
+// ============================================================================
+
+// pcap：timestamp_ns 步长按时间戳精度取（微秒文件取整微秒，纳秒文件带亚微秒部分）
+std::vector<Packet> pcap_packets(size_t count, bool nanosecond) {
+    std::vector<Packet> packets = make_packets(count, 0, LINKTYPE_ETHERNET);
+    const uint64_t step = nanosecond ? 1234567 : 1234000;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].timestamp_ns = kBaseTime + 999999000 + i * step;   // 第 1 条之后跨秒
+    }
+    return packets;
+}
+
+int check_pcap() {
+    int failures = 0;
+    bench::print_header("pcap");
+    for (int variant = 0; variant < 4; ++variant) {
+        const bool big = (variant & 1) != 0;
+        const bool nanosecond = (variant & 2) != 0;
+        char name[64];
+        std::snprintf(name, sizeof(name), "pcap %s-endian %s", big ? "big" : "little", nanosecond ? "ns" : "us");
+        const std::vector<Packet> packets = pcap_packets(500, nanosecond);
+        const Bytes file = write_pcap(packets, big, nanosecond, LINKTYPE_ETHERNET);
+        Expectation expect;
+        failures += check_capture(name, file, packets, expect);
+
+        // 同一文件按端口过滤并跳过 2 字节应用层封装头
+        expect.options.port = kUdpPort;
+        expect.options.skip = 2;
+        std::snprintf(name, sizeof(name), "pcap %s-endian %s --port --skip", big ? "big" : "little",
+                      nanosecond ? "ns" : "us");
+        failures += check_capture(name, file, packets, expect);
+    }
+
+    // snaplen 截断：原始长度保留，载荷只有已捕获部分；头部不全时为 PAYLOAD_TRUNCATED
+    {
+        std::vector<Packet> packets;
+        const size_t udp_header = 14 + 20 + 8;
+        for (size_t i = 0; i < 60; ++i) {
+            Packet packet = make_packet(i * 7 + 200, KIND_UDP4, LINKTYPE_ETHERNET);
+            packet.timestamp_ns = kBaseTime + i * 1000;
+            packets.push_back(packet.frame.size() > 64 ? snap(packet, i % 2 == 0 ? 64 : 40, udp_header) : packet);
+        }
+        Packet tagged = make_packet(301, KIND_UDP4_QINQ, LINKTYPE_ETHERNET);
+        tagged.timestamp_ns = kBaseTime + 60 * 1000;
+        packets.push_back(snap(tagged, 16, udp_header + 8));   // 截在 VLAN 标签内
+        Packet ipv6 = make_packet(302, KIND_UDP6, LINKTYPE_ETHERNET);
+        ipv6.timestamp_ns = kBaseTime + 61 * 1000;
+        packets.push_back(snap(ipv6, 50, 14 + 48 + 8));         // 截在扩展头内
+        const Bytes file = write_pcap(packets, false, false, LINKTYPE_ETHERNET);
+        failures += check_capture("pcap snaplen 64/40", file, packets, Expectation());
+    }
+
+    // 文件末尾的半条记录：前面的记录照常返回，truncated() 为 1 且不是错误
+    {
+        const std::vector<Packet> packets = pcap_packets(40, true);
+        const Bytes file = write_pcap(packets, true, true, LINKTYPE_ETHERNET);
+        Expectation expect;
+        expect.truncated = 1;
+        const std::vector<Packet> kept(packets.begin(), packets.end() - 1);
+        failures += check_capture("pcap cut inside last record", Bytes(file.begin(), file.end() - 5), kept, expect);
+        failures += check_capture("pcap cut inside last header",
+                                  Bytes(file.begin(), file.end() - static_cast<std::ptrdiff_t>(packets.back().frame.size()) - 6),
+                                  kept, expect);
+    }
+
+    // 原始 IP 链路（无以太网头）
+    {
+        std::vector<Packet> packets = make_packets(70, 0, LINKTYPE_RAW);
+        for (size_t i = 0; i < packets.size(); ++i) {
+            packets[i].timestamp_ns = kBaseTime + i * 5000;
+        }
+        failures += check_capture("pcap LINKTYPE_RAW", write_pcap(packets, false, false, LINKTYPE_RAW),
+                                  packets, Expectation());
+    }
+    return failures;
+}
+
+// pcapng：Section 1 小端（接口 0 默认微秒 / 接口 1 纳秒），Section 2 大端
+// （接口 0 原始 IP 2^-20 秒 / 接口 1 毫秒 / 接口 2 皮秒），每个 Section 末尾一条 SPB
+struct PcapngFile {
+    Bytes file;
+    std::vector<Packet> packets;
+    size_t skipped_blocks;
+    size_t last_block_bytes;
+};
+
+PcapngFile build_pcapng(size_t per_section) {
+    PcapngFile result;
+    result.skipped_blocks = 0;
+    result.last_block_bytes = 0;
+    struct Interface {
+        uint16_t link_type;
+        int tsresol;
+    };
+    const Interface section1[] = { { LINKTYPE_ETHERNET, -1 }, { LINKTYPE_ETHERNET, 9 } };
+    const Interface section2[] = { { LINKTYPE_RAW, 0x80 | 20 }, { LINKTYPE_ETHERNET, 3 }, { LINKTYPE_ETHERNET, 12 } };
+    const Interface* sections[2] = { section1, section2 };
+    const size_t interface_counts[2] = { 2, 3 };
+    size_t index = 0;
+    for (int s = 0; s < 2; ++s) {
+        const bool big = (s == 1);
+        put_section_header(result.file, big);
+        for (size_t i = 0; i < interface_counts[s]; ++i) {
+            put_interface(result.file, sections[s][i].link_type, sections[s][i].tsresol, big);
+        }
+        // 非报文块（Name Resolution、自定义块）计入 skipped_blocks()
+        Bytes name_resolution;
+        put16(name_resolution, 0, big);
+        put16(name_resolution, 0, big);
+        put_block(result.file, 4, name_resolution, big);
+        put_block(result.file, 0x00000BADu, Bytes(5, 0xEE), big);
+        result.skipped_blocks += 2;
+
+        for (size_t i = 0; i <= per_section; ++i, ++index) {
+            const bool simple = (i == per_section);
+            const uint32_t interface_id = simple ? 0 : static_cast<uint32_t>(i % interface_counts[s]);
+            const Interface& interface = sections[s][interface_id];
+            Packet packet = make_packet(index, static_cast<PacketKind>(index % KIND_COUNT), interface.link_type);
+            packet.interface_id = interface_id;
+            packet.simple = simple;
+            if (!simple) {
+                // 各接口的刻度从不同起点递增，带非整数秒部分
+                const uint64_t seconds = kBaseTime / kNanosPerSecond + i;
+                switch (interface.tsresol) {
+                    case -1: packet.ticks = seconds * 1000000ULL + i * 137; break;
+                    case 9: packet.ticks = seconds * kNanosPerSecond + i * 123457; break;
+                    case 3: packet.ticks = seconds * 1000ULL + i * 7; break;
+                    case 12: packet.ticks = (1000 + i) * 1000000000000ULL + i * 987654321ULL; break;   // 皮秒刻度从纪元算会溢出
+                    default: packet.ticks = (seconds << 20) + i * 4099; break;
+                }
+                packet.timestamp_ns = ticks_to_ns(packet.ticks, interface.tsresol);
+            }
+            const size_t before = result.file.size();
+            put_packet_block(result.file, packet, big);
+            result.last_block_bytes = result.file.size() - before;
+            result.packets.push_back(packet);
+        }
+    }
+    return result;
+}
+
+int check_pcapng() {
+    int failures = 0;
+    bench::print_header("pcapng");
+    const PcapngFile built = build_pcapng(300);
+    Expectation expect;
+    expect.format = CAPTURE_PCAPNG;
+    expect.skipped_blocks = built.skipped_blocks;
+    failures += check_capture("pcapng 2 sections, EPB + SPB", built.file, built.packets, expect);
+
+    expect.options.port = kTcpPort;
+    failures += check_capture("pcapng 2 sections --port", built.file, built.packets, expect);
+
+    // 末尾块被截断
+    expect.options = PayloadOptions();
+    expect.truncated = 1;
+    const std::vector<Packet> kept(built.packets.begin(), built.packets.end() - 1);
+    failures += check_capture("pcapng cut inside last block",
+                              Bytes(built.file.begin(), built.file.end() - 3), kept, expect);
+    failures += check_capture("pcapng cut inside last block header",
+                              Bytes(built.file.begin(),
+                                    built.file.end() - static_cast<std::ptrdiff_t>(built.last_block_bytes) + 8),
+                              kept, expect);
+
+    // 新 Section 清空接口表：第 2 个 Section 引用不存在的接口须报错
+    {
+        Bytes file;
+        put_section_header(file, false);
+        put_interface(file, LINKTYPE_ETHERNET, -1, false);
+        put_interface(file, LINKTYPE_ETHERNET, -1, false);
+        put_section_header(file, true);
+        put_interface(file, LINKTYPE_ETHERNET, -1, true);
+        Packet packet = make_packet(0, KIND_UDP4, LINKTYPE_ETHERNET);
+        packet.interface_id = 1;
+        put_packet_block(file, packet, true);
+        CaptureReader reader(file.data(), file.size());
+        CaptureRecord record;
+        if (reader.next(record) || reader.ok()) {
+            std::printf("MISMATCH: pcapng interface from previous section accepted\n");
+            ++failures;
+        } else {
+            std::printf("%-44s %s\n", "pcapng stale interface rejected", reader.error().c_str());
+        }
+    }
+    return failures;
+}
+
+int check_length_prefixed() {
+    int failures = 0;
+    bench::print_header("length-prefixed");
+    struct Variant {
+        size_t prefix_bytes;
+        ByteOrder byte_order;
+        bool includes_prefix;
+    };
+    const Variant variants[] = {
+        { 1, BIG_ENDIAN, false }, { 2, LITTLE_ENDIAN, false }, { 2, BIG_ENDIAN, true },
+        { 4, BIG_ENDIAN, false }, { 4, LITTLE_ENDIAN, true }
+    };
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+        Expectation expect;
+        expect.format = CAPTURE_LENGTH_PREFIXED;
+        expect.prefix.prefix_bytes = variants[v].prefix_bytes;
+        expect.prefix.byte_order = variants[v].byte_order;
+        expect.prefix.includes_prefix = variants[v].includes_prefix;
+        const std::vector<Packet> records = make_records(400, variants[v].prefix_bytes == 1 ? 250 : 100000);
+        const Bytes file = write_length_prefixed(records, expect.prefix);
+        char name[64];
+        std::snprintf(name, sizeof(name), "length-prefixed %zu-byte %s%s", variants[v].prefix_bytes,
+                      variants[v].byte_order == BIG_ENDIAN ? "big" : "little",
+                      variants[v].includes_prefix ? " inclusive" : "");
+        failures += check_capture(name, file, records, expect);
+
+        expect.options.skip = 3;
+        std::snprintf(name, sizeof(name), "length-prefixed %zu-byte --skip 3", variants[v].prefix_bytes);
+        failures += check_capture(name, file, records, expect);
+
+        expect.options.skip = 0;
+        expect.truncated = 1;
+        const std::vector<Packet> kept(records.begin(), records.end() - 1);
+        std::snprintf(name, sizeof(name), "length-prefixed %zu-byte cut", variants[v].prefix_bytes);
+        failures += check_capture(name, Bytes(file.begin(), file.end() - 1), kept, expect);
+    }
+    return failures;
+}
+
+// ============================================================================
+// 回放：装载统计与多线程计数
+// ============================================================================
+
+// 槽位取载荷首字节 % 3；奇数长度的报文视为解码成功，偶数长度返回 INVALID_VALUE
+struct CountingDecoder {
+    ParseError operator()(const uint8_t* data, size_t length, size_t& slot) {
+        slot = length == 0 ? 3 : data[0] % 3;
+        return (length & 1) != 0 ? SUCCESS : INVALID_VALUE;
+    }
+};
+
+int check_replay() {
+    int failures = 0;
+    bench::print_header("replay");
+    const PcapngFile built = build_pcapng(300);
+    ReplayOptions options;
+    options.path = "synthetic.pcapng";
+    std::vector<ReplayMessage> messages;
+    ReplayCaptureStats stats;
+    std::string error;
+    if (!load_replay_messages(built.file.data(), built.file.size(), options, messages, stats, error)) {
+        std::printf("MISMATCH: load_replay_messages: %s\n", error.c_str());
+        return 1;
+    }
+
+    size_t status_counts[PAYLOAD_STATUS_COUNT] = {};
+    uint64_t payload_bytes = 0;
+    uint64_t first = 0;
+    uint64_t last = 0;
+    std::vector<Bytes> payloads;
+    for (size_t i = 0; i < built.packets.size(); ++i) {
+        Bytes payload;
+        const PayloadStatus status = expected_status(built.packets[i], options.payload, payload);
+        ++status_counts[status];
+        if (status == PAYLOAD_OK) {
+            payload_bytes += payload.size();
+            payloads.push_back(payload);
+        }
+        const uint64_t ts = built.packets[i].timestamp_ns;
+        if (ts != 0) {
+            first = (first == 0 || ts < first) ? ts : first;
+            last = ts > last ? ts : last;
+        }
+    }
+    bool same = messages.size() == payloads.size();
+    for (size_t i = 0; same && i < messages.size(); ++i) {
+        same = messages[i].length == payloads[i].size() &&
+               std::memcmp(messages[i].data, payloads[i].data(), messages[i].length) == 0;
+    }
+    if (!same || stats.records != built.packets.size() || stats.payload_bytes != payload_bytes ||
+        std::memcmp(stats.payload_status, status_counts, sizeof(status_counts)) != 0 ||
+        stats.first_timestamp_ns != first || stats.last_timestamp_ns != last ||
+        stats.skipped_blocks != built.skipped_blocks || stats.format != CAPTURE_PCAPNG) {
+        std::printf("MISMATCH: load_replay_messages statistics (%zu messages, expected %zu)\n",
+                    messages.size(), payloads.size());
+        ++failures;
+    } else {
+        std::printf("%-44s %6zu records %6zu messages  ok\n", "load_replay_messages", stats.records, messages.size());
+    }
+
+    // --limit
+    {
+        options.limit = 17;
+        std::vector<ReplayMessage> limited;
+        ReplayCaptureStats limited_stats;
+        load_replay_messages(built.file.data(), built.file.size(), options, limited, limited_stats, error);
+        if (limited.size() != 17 || limited[16].data != messages[16].data) {
+            std::printf("MISMATCH: load_replay_messages --limit 17 returned %zu\n", limited.size());
+            ++failures;
+        }
+        options.limit = 0;
+    }
+
+    // 各线程各 passes 遍；按槽位和结果的计数与单线程逐条累加一致
+    const char* const slot_names[] = { "slot0", "slot1", "slot2", "empty" };
+    ReplaySlotStats expected[4];
+    for (size_t i = 0; i < messages.size(); ++i) {
+        size_t slot = 0;
+        const ParseError result = CountingDecoder()(messages[i].data, messages[i].length, slot);
+        ++expected[slot].messages;
+        expected[slot].bytes += messages[i].length;
+        ++expected[slot].results[result];
+    }
+    const size_t thread_counts[] = { 1, 2, 3 };
+    for (size_t t = 0; t < 3; ++t) {
+        const size_t passes = 2;
+        const ReplayReport report = replay_messages<CountingDecoder>(messages, slot_names, 4, thread_counts[t], passes, 1);
+        bool match = report.total.messages == messages.size() * passes && report.threads == thread_counts[t];
+        for (size_t s = 0; match && s < 4; ++s) {
+            match = report.slots[s].messages == expected[s].messages * passes &&
+                    report.slots[s].bytes == expected[s].bytes * passes &&
+                    report.slots[s].results[SUCCESS] == expected[s].results[SUCCESS] * passes &&
+                    report.slots[s].results[INVALID_VALUE] == expected[s].results[INVALID_VALUE] * passes;
+        }
+        if (!match) {
+            std::printf("MISMATCH: replay_messages with %zu thread(s)\n", thread_counts[t]);
+            ++failures;
+        } else {
+            std::printf("replay_messages %zu thread(s)%-25s %6llu messages  ok\n", thread_counts[t], "",
+                        static_cast<unsigned long long>(report.total.messages));
+        }
+        if (t == 0) {
+            const std::string json = report.to_json(options, stats);
+            if (json.find("\"messages\":") == std::string::npos || json.find("\"INVALID_VALUE\"") == std::string::npos) {
+                std::printf("MISMATCH: report JSON %s\n", json.c_str());
+                ++failures;
+            }
+        }
+    }
+    return failures;
+}
+
+// ============================================================================
+// 吞吐
+// ============================================================================
+struct ScanResult {
+    size_t records;
+    size_t payloads;
+    uint64_t payload_bytes;
+};
+
+ScanResult scan(const uint8_t* data, size_t size, const LengthPrefixSpec& prefix, bool extract) {
+    ScanResult result = { 0, 0, 0 };
+    CaptureReader reader(data, size, CAPTURE_AUTO, prefix);
+    CaptureRecord record;
+    const PayloadOptions options;
+    while (reader.next(record)) {
+        ++result.records;
+        if (!extract) {
+            result.payload_bytes += record.length;
+            continue;
+        }
+        const uint8_t* out = nullptr;
+        size_t out_length = 0;
+        if (extract_payload(record, options, out, out_length) == PAYLOAD_OK) {
+            ++result.payloads;
+            result.payload_bytes += out_length;
+        }
+    }
+    return result;
+}
+
+void run_throughput(const char* name, const uint8_t* data, size_t size, const LengthPrefixSpec& prefix) {
+    const ScanResult reference = scan(data, size, prefix, true);
+    const double read = bench::measure([&]() { bench::do_not_optimize(scan(data, size, prefix, false)); });
+    const double extract = bench::measure([&]() { bench::do_not_optimize(scan(data, size, prefix, true)); });
+    const double records = static_cast<double>(reference.records);
+    std::printf("%-28s %8zu records %8.2f ns/record (read) %8.2f ns/record (read + extract) %7.3f GB/s\n",
+                name, reference.records, read / records * 1e9, extract / records * 1e9,
+                static_cast<double>(size) / extract / 1e9);
+}
+
+int run_benchmarks() {
+    int failures = 0;
+    bench::print_header("throughput");
+    const size_t count = 200000;
+
+    // pcap：写入临时文件后经 MappedFile 映射
+    const std::vector<Packet> packets = pcap_packets(count, true);
+    const Bytes pcap = write_pcap(packets, false, true, LINKTYPE_ETHERNET);
+    char path[] = "/tmp/capture_bench_XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0) {
+        std::printf("warning: cannot create temporary file, reading pcap from memory\n");
+        run_throughput("pcap (memory)", pcap.data(), pcap.size(), LengthPrefixSpec());
+    } else {
+        const bool written = ::write(fd, pcap.data(), pcap.size()) == static_cast<ssize_t>(pcap.size());
+        ::close(fd);
+        MappedFile file;
+        std::string error;
+        if (!written || !file.open(path, error) || file.size() != pcap.size() ||
+            std::memcmp(file.data(), pcap.data(), pcap.size()) != 0) {
+            std::printf("MISMATCH: MappedFile contents of %s %s\n", path, error.c_str());
+            ++failures;
+        } else {
+            run_throughput("pcap (MappedFile)", file.data(), file.size(), LengthPrefixSpec());
+        }
+        file.close();
+        ::unlink(path);
+    }
+
+    const PcapngFile pcapng = build_pcapng(count / 2);
+    run_throughput("pcapng", pcapng.file.data(), pcapng.file.size(), LengthPrefixSpec());
+
+    LengthPrefixSpec prefix;
+    prefix.prefix_bytes = 2;
+    const std::vector<Packet> records = make_records(count, 100000);
+    const Bytes prefixed = write_length_prefixed(records, prefix);
+    run_throughput("length-prefixed", prefixed.data(), prefixed.size(), prefix);
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+    failures += check_pcap();
+    failures += check_pcapng();
+    failures += check_length_prefixed();
+    failures += check_replay();
+    failures += run_benchmarks();
+    if (failures != 0) {
+        std::printf("\n%d check(s) failed\n", failures);
+    }
+    return failures == 0 ? 0 : 1;
+}
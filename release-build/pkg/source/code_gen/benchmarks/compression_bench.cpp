@@ -0,0 +1,219 @@
+// ============================================================================
+// 整数变长编码与块压缩基准
+// 1. varint 解码：逐字节 LEB128 vs decode_varint（1~2 字节逐字节判断，更长的 8 字节装载 + 续位掩码），
+//    取值小于 2^14 / 2^32 / 2^64 三种分布
+// 2. uint32 数组（4096 个元素）：逐元素 varint vs Stream-VByte 编码/解码（x86 上 SSSE3 pshufb 解码）
+// 3. LZ4 块：遥测样式报文序列（重复的帧头 + 缓变数值）与随机数据的压缩/解压吞吐和压缩率
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework compression_bench.cpp -o compression_bench
+// ============================================================================
+#include "protocol_compression.h"
+#include "bench_common.h"
+
+#include <cstdio>
+
+using namespace protocol_parser;
+
+namespace {
+
+// 逐字节 LEB128 解码（常见手写实现）
+size_t decode_varint_bytewise(const uint8_t* data, size_t length, uint64_t& out_value) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < length && i < VARINT_MAX_BYTES; ++i) {
+        value |= static_cast<uint64_t>(data[i] & 0x7F) << (7 * i);
+        if ((data[i] & 0x80) == 0) {
+            out_value = value;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+std::vector<uint32_t> make_values(size_t count, unsigned max_bits, uint32_t seed) {
+    std::vector<uint32_t> values(count);
+    uint32_t state = seed;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const unsigned bits = 1 + (state >> 24) % max_bits;
+        state = state * 1664525u + 1013904223u;
+        values[i] = bits >= 32 ? state : (state & ((1u << bits) - 1));
+    }
+    return values;
+}
+
+int run_varint(const char* title, unsigned max_bits) {
+    const size_t kCount = 4096;
+    // 取值位数在 1..max_bits 间均匀分布（max_bits > 32 时高位另取一组随机数）
+    const std::vector<uint32_t> low = make_values(kCount, max_bits < 32 ? max_bits : 32, max_bits);
+    const std::vector<uint32_t> high = make_values(kCount, 32, max_bits + 1);
+    std::vector<uint64_t> values(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        values[i] = low[i];
+        if (max_bits > 32 && (high[i] & 1u)) {
+            values[i] |= static_cast<uint64_t>(high[i] >> (64 - max_bits)) << 32;
+        }
+    }
+    std::vector<uint8_t> encoded(kCount * VARINT_MAX_BYTES + 8);
+    size_t length = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+        length += encode_varint(values[i], encoded.data() + length);
+    }
+
+    uint64_t expected = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+        expected += values[i];
+    }
+    uint64_t slow_sum = 0;
+    uint64_t fast_sum = 0;
+    for (size_t pos = 0; pos < length;) {
+        uint64_t value = 0;
+        pos += decode_varint_bytewise(encoded.data() + pos, length - pos, value);
+        slow_sum += value;
+    }
+    for (size_t pos = 0; pos < length;) {
+        uint64_t value = 0;
+        pos += decode_varint(encoded.data() + pos, length - pos, value);
+        fast_sum += value;
+    }
+    if (slow_sum != expected || fast_sum != expected) {
+        std::printf("MISMATCH: varint %s\n", title);
+        return 1;
+    }
+
+    bench::print_header(title);
+    std::printf("        %zu values, %zu bytes (%.2f B/value)\n", kCount, length, static_cast<double>(length) / kCount);
+    bench::print_throughput("decode bytewise", length, bench::measure([&]() {
+        uint64_t sum = 0;
+        for (size_t pos = 0; pos < length;) {
+            uint64_t value = 0;
+            pos += decode_varint_bytewise(encoded.data() + pos, length - pos, value);
+            sum += value;
+        }
+        bench::do_not_optimize(sum);
+    }));
+    bench::print_throughput("decode_varint", length, bench::measure([&]() {
+        uint64_t sum = 0;
+        for (size_t pos = 0; pos < length;) {
+            uint64_t value = 0;
+            pos += decode_varint(encoded.data() + pos, length - pos, value);
+            sum += value;
+        }
+        bench::do_not_optimize(sum);
+    }));
+    return 0;
+}
+
+int run_streamvbyte(const char* title, unsigned max_bits) {
+    const size_t kCount = 4096;
+    const std::vector<uint32_t> values = make_values(kCount, max_bits, max_bits + 100);
+    std::vector<uint8_t> varint_bytes(kCount * VARINT_MAX_BYTES + 8);
+    std::vector<uint8_t> svb_bytes(streamvbyte_max_size(kCount));
+    std::vector<uint32_t> decoded(kCount);
+
+    size_t varint_length = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+        varint_length += encode_varint(values[i], varint_bytes.data() + varint_length);
+    }
+    const size_t svb_length = streamvbyte_encode(values.data(), kCount, svb_bytes.data(), svb_bytes.size());
+    if (streamvbyte_decode(svb_bytes.data(), svb_length, decoded.data(), kCount) != svb_length || decoded != values) {
+        std::printf("MISMATCH: Stream-VByte %s\n", title);
+        return 1;
+    }
+
+    bench::print_header(title);
+    std::printf("        varint %zu bytes, Stream-VByte %zu bytes\n", varint_length, svb_length);
+    const size_t raw_bytes = kCount * sizeof(uint32_t);
+    bench::print_throughput("varint encode", raw_bytes, bench::measure([&]() {
+        size_t pos = 0;
+        for (size_t i = 0; i < kCount; ++i) {
+            pos += encode_varint(values[i], varint_bytes.data() + pos);
+        }
+        bench::do_not_optimize(varint_bytes[pos - 1]);
+    }));
+    bench::print_throughput("Stream-VByte encode", raw_bytes, bench::measure([&]() {
+        const size_t n = streamvbyte_encode(values.data(), kCount, svb_bytes.data(), svb_bytes.size());
+        bench::do_not_optimize(n);
+    }));
+    bench::print_throughput("varint decode", raw_bytes, bench::measure([&]() {
+        size_t pos = 0;
+        for (size_t i = 0; i < kCount; ++i) {
+            uint64_t value = 0;
+            pos += decode_varint(varint_bytes.data() + pos, varint_length - pos, value);
+            decoded[i] = static_cast<uint32_t>(value);
+        }
+        bench::do_not_optimize(decoded[kCount - 1]);
+    }));
+    bench::print_throughput("Stream-VByte decode", raw_bytes, bench::measure([&]() {
+        const size_t n = streamvbyte_decode(svb_bytes.data(), svb_length, decoded.data(), kCount);
+        bench::do_not_optimize(n);
+    }));
+    return 0;
+}
+
+// 遥测样式报文序列：固定帧头 + 序号 + 缓变的 16 个 int16 测量值 + 状态字
+std::vector<uint8_t> make_telemetry(size_t frames) {
+    std::vector<uint8_t> data;
+    int16_t channels[16] = { 0 };
+    uint32_t state = 1;
+    for (size_t f = 0; f < frames; ++f) {
+        uint8_t frame[48] = { 0xEB, 0x90, 0x00, 0x30, 0x01, 0x02 };
+        write_fixed_order<BIG_ENDIAN, uint32_t>(frame + 6, static_cast<uint32_t>(f));
+        for (size_t c = 0; c < 16; ++c) {
+            state = state * 1664525u + 1013904223u;
+            channels[c] = static_cast<int16_t>(channels[c] + static_cast<int>((state >> 28) & 3) - 1);
+            write_fixed_order<BIG_ENDIAN, int16_t>(frame + 10 + c * 2, channels[c]);
+        }
+        frame[42] = (f % 100 == 0) ? 0x80 : 0x00;
+        data.insert(data.end(), frame, frame + sizeof(frame));
+    }
+    return data;
+}
+
+int run_lz4(const char* title, const std::vector<uint8_t>& input) {
+    std::vector<uint32_t> table(LZ4_HASH_TABLE_SIZE, 0);
+    std::vector<uint8_t> compressed(lz4_compress_bound(input.size()));
+    std::vector<uint8_t> output(input.size());
+    size_t compressed_length = 0;
+    size_t output_length = 0;
+    if (!lz4_compress_block(input.data(), input.size(), compressed.data(), compressed.size(),
+                            table.data(), compressed_length).is_success() ||
+        !lz4_decompress_block(compressed.data(), compressed_length, output.data(), output.size(),
+                              output_length).is_success() ||
+        output_length != input.size() || output != input) {
+        std::printf("MISMATCH: LZ4 %s\n", title);
+        return 1;
+    }
+
+    bench::print_header(title);
+    std::printf("        %zu -> %zu bytes (ratio %.2f)\n", input.size(), compressed_length,
+                static_cast<double>(input.size()) / compressed_length);
+    bench::print_throughput("LZ4 compress", input.size(), bench::measure([&]() {
+        size_t n = 0;
+        lz4_compress_block(input.data(), input.size(), compressed.data(), compressed.size(), table.data(), n);
+        bench::do_not_optimize(n);
+    }));
+    bench::print_throughput("LZ4 decompress", input.size(), bench::measure([&]() {
+        size_t n = 0;
+        lz4_decompress_block(compressed.data(), compressed_length, output.data(), output.size(), n);
+        bench::do_not_optimize(n);
+    }));
+    return 0;
+}
+
+} // namespace
+
+int main() {
+#if defined(PROTOCOL_COMPRESSION_X86)
+    std::printf("SSSE3: %s\n", cpu_detail::cpu_features().ssse3 ? "available" : "not available");
+#else
+    std::printf("SSSE3: disabled\n");
+#endif
+    int failures = 0;
+    failures += run_varint("varint decode, values < 2^14", 14);
+    failures += run_varint("varint decode, values < 2^32", 32);
+    failures += run_varint("varint decode, values < 2^64", 64);
+    failures += run_streamvbyte("4096 x uint32, values < 2^12", 12);
+    failures += run_streamvbyte("4096 x uint32, values < 2^32", 32);
+    failures += run_lz4("LZ4, 64KB telemetry frames", make_telemetry(65536 / 48));
+    failures += run_lz4("LZ4, 64KB random bytes", bench::make_random_bytes(65536));
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// ============================================================================
+// CRC 引擎吞吐基准
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework crc_bench.cpp -o crc_bench
+// ============================================================================
+#include "protocol_checksum.h"
+#include "bench_common.h"
+
+#include <cstdio>
+
+using namespace protocol_parser;
+
+namespace {
+
+struct EngineCase {
+    const char* name;
+    CrcEngine engine;
+};
+
+const EngineCase kEngines[] = {
+    { "bitwise",  CRC_ENGINE_BITWISE },
+    { "table",    CRC_ENGINE_TABLE },
+    { "slice-4",  CRC_ENGINE_SLICE_4 },
+    { "slice-8",  CRC_ENGINE_SLICE_8 },
+    { "clmul",    CRC_ENGINE_CLMUL },
+    { "sse4.2",   CRC_ENGINE_SSE42 },
+    { "auto",     CRC_ENGINE_AUTO }
+};
+
+const size_t kSizes[] = { 64, 1024, 16 * 1024, 64 * 1024 };
+
+template<typename T>
+int run_algorithm(const char* title, Checksum_CRC<T> checker, bool sse42_applicable) {
+    bench::print_header(title);
+    int mismatches = 0;
+
+    for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+        const std::vector<uint8_t> data = bench::make_random_bytes(kSizes[s]);
+        const T expected = checker.calculate_bitwise(data.data(), data.size());
+
+        for (size_t e = 0; e < sizeof(kEngines) / sizeof(kEngines[0]); ++e) {
+            if (kEngines[e].engine == CRC_ENGINE_SSE42 && !sse42_applicable) {
+                continue;
+            }
+            // 逐位算法在大数据上太慢，只测小尺寸
+            if (kEngines[e].engine == CRC_ENGINE_BITWISE && kSizes[s] > 1024) {
+                continue;
+            }
+
+            checker.set_engine(kEngines[e].engine);
+            if (checker.calculate(data.data(), data.size()) != expected) {
+                std::printf("MISMATCH: %s / %s / %zu\n", title, kEngines[e].name, kSizes[s]);
+                ++mismatches;
+            }
+
+            T sink = 0;
+            const double seconds = bench::measure([&]() {
+                sink ^= checker.calculate(data.data(), data.size());
+                bench::do_not_optimize(sink);
+            });
+            bench::print_throughput(kEngines[e].name, data.size(), seconds);
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main() {
+    const cpu_detail::CpuFeatures& features = cpu_detail::cpu_features();
+    std::printf("CPU features: sse4.2=%d pclmul=%d\n", features.sse42 ? 1 : 0, features.pclmul ? 1 : 0);
+
+    int mismatches = 0;
+
+    Checksum_CRC<uint32_t> crc32(0x04C11DB7UL);
+    crc32.set_init(0xFFFFFFFFUL);
+    crc32.set_xor_out(0xFFFFFFFFUL);
+    crc32.set_ref_in(true);
+    crc32.set_ref_out(true);
+    mismatches += run_algorithm("CRC-32 (IEEE 802.3)", crc32, false);
+
+    Checksum_CRC<uint32_t> crc32c(0x1EDC6F41UL);
+    crc32c.set_init(0xFFFFFFFFUL);
+    crc32c.set_xor_out(0xFFFFFFFFUL);
+    crc32c.set_ref_in(true);
+    crc32c.set_ref_out(true);
+    mismatches += run_algorithm("CRC-32C (Castagnoli)", crc32c, true);
+
+    Checksum_CRC<uint32_t> crc32_bzip2(0x04C11DB7UL);
+    crc32_bzip2.set_init(0xFFFFFFFFUL);
+    crc32_bzip2.set_xor_out(0xFFFFFFFFUL);
+    mismatches += run_algorithm("CRC-32/BZIP2 (non-reflected)", crc32_bzip2, false);
+
+    Checksum_CRC<uint64_t> crc64(0x42F0E1EBA9EA3693ULL);
+    crc64.set_init(~0ULL);
+    crc64.set_xor_out(~0ULL);
+    crc64.set_ref_in(true);
+    crc64.set_ref_out(true);
+    mismatches += run_algorithm("CRC-64/XZ", crc64, false);
+
+    mismatches += run_algorithm("CRC-16/MODBUS", Checksum_CRC<uint16_t>(Checksum_CRC16_Modbus()), false);
+
+    if (mismatches != 0) {
+        std::printf("\n%d mismatches against bitwise reference\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,458 @@
+// ============================================================================
+// 分发器基准：switch + make_shared（旧分发器）/ switch + 临时对象移入 union（Tagged Union）
+//             vs 表驱动分发（稠密跳转表 / 完美哈希 / 有序表）解码到调用方存储
+// 256 种报文类型，MessageID 分布：连续、稀疏 16 位、稀疏 + Zipf 频率（含 1% 未知 ID）
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework dispatch_bench.cpp -o dispatch_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <algorithm>
+
+using namespace protocol_parser;
+
+// ============================================================================
+// 堆分配计数（替换全局 operator new，统计每帧分配次数）
+// ============================================================================
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    void* ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+// ============================================================================
+// 报文定义：MessageID(2) + 序号(4) + 时间戳(4) + 4 个 int32 数值 = 26 字节
+// 各报文类型按 I % 4 解码 1~4 个数值字段，模拟不同子协议的解码函数
+// ============================================================================
+const unsigned kTypeCount = 256;
+const size_t kFrameSize = 26;
+const size_t kTrafficFrames = 8192;
+
+constexpr uint16_t dense_id(unsigned i) {
+    return static_cast<uint16_t>(0x0100u + i);
+}
+
+// 乘以奇数在 mod 2^16 下是双射，256 个 ID 互不相同且分散在整个 16 位空间
+constexpr uint16_t sparse_id(unsigned i) {
+    return static_cast<uint16_t>((i * 40503u + 0x1234u) & 0xFFFFu);
+}
+
+inline uint16_t read_uint16_be(const uint8_t* p) { return read_fixed_order<BIG_ENDIAN, uint16_t>(p); }
+inline uint32_t read_uint32_be(const uint8_t* p) { return read_fixed_order<BIG_ENDIAN, uint32_t>(p); }
+inline void write_uint16_be(uint8_t* p, uint16_t v) { write_fixed_order<BIG_ENDIAN, uint16_t>(p, v); }
+inline void write_uint32_be(uint8_t* p, uint32_t v) { write_fixed_order<BIG_ENDIAN, uint32_t>(p, v); }
+
+struct MessageBase {
+    virtual ~MessageBase() {}
+};
+
+struct MessageResult : MessageBase {
+    uint16_t id;
+    uint32_t seq;
+    uint32_t timestamp;
+    int32_t values[4];
+    uint8_t value_count;
+};
+
+template<unsigned I>
+inline DeserializeStatus decode_message(const uint8_t* data, size_t length, MessageResult& out) {
+    const size_t value_count = I % 4 + 1;
+    if (length < 10 + value_count * 4) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "frame too short", length);
+    }
+    out.id = read_uint16_be(data);
+    out.seq = read_uint32_be(data + 2);
+    out.timestamp = read_uint32_be(data + 6);
+    for (size_t v = 0; v < value_count; ++v) {
+        out.values[v] = static_cast<int32_t>(read_uint32_be(data + 10 + v * 4));
+    }
+    out.value_count = static_cast<uint8_t>(value_count);
+    return DeserializeStatus::success(10 + value_count * 4);
+}
+
+uint64_t checksum_of(const MessageResult& msg) {
+    uint64_t sum = msg.id + msg.seq + msg.timestamp;
+    for (uint8_t v = 0; v < msg.value_count; ++v) {
+        sum += static_cast<uint32_t>(msg.values[v]);
+    }
+    return sum;
+}
+
+// 256 路展开（switch 分支与处理函数表）
+#define REP4(M, b)   M(b) M(b + 1) M(b + 2) M(b + 3)
+#define REP16(M, b)  REP4(M, b) REP4(M, b + 4) REP4(M, b + 8) REP4(M, b + 12)
+#define REP64(M, b)  REP16(M, b) REP16(M, b + 16) REP16(M, b + 32) REP16(M, b + 48)
+#define REP256(M, b) REP64(M, b) REP64(M, b + 64) REP64(M, b + 128) REP64(M, b + 192)
+
+// ============================================================================
+// 旧分发器（dispatcher.cpp.template）：switch + 每帧 make_shared
+// ============================================================================
+#define SHARED_CASE(ID_FN, i)                                                   \
+    case ID_FN(i): {                                                            \
+        std::shared_ptr<MessageResult> msg = std::make_shared<MessageResult>(); \
+        DeserializeStatus res = decode_message<i>(data, length, *msg);         \
+        if (res.is_success()) {                                                 \
+            out = msg;                                                          \
+        }                                                                       \
+        return res;                                                             \
+    }
+#define SHARED_CASE_DENSE(i) SHARED_CASE(dense_id, i)
+#define SHARED_CASE_SPARSE(i) SHARED_CASE(sparse_id, i)
+
+DeserializeStatus switch_shared_dense(const uint8_t* data, size_t length, std::shared_ptr<MessageBase>& out) {
+    switch (read_uint16_be(data)) {
+        REP256(SHARED_CASE_DENSE, 0)
+    default:
+        return DeserializeStatus::failure(INVALID_VALUE, "Unknown MessageID", 0);
+    }
+}
+
+DeserializeStatus switch_shared_sparse(const uint8_t* data, size_t length, std::shared_ptr<MessageBase>& out) {
+    switch (read_uint16_be(data)) {
+        REP256(SHARED_CASE_SPARSE, 0)
+    default:
+        return DeserializeStatus::failure(INVALID_VALUE, "Unknown MessageID", 0);
+    }
+}
+
+// ============================================================================
+// 调用方存储：每种报文一个槽位（对应生成代码中的 <P>DispatchStorage）
+// ============================================================================
+struct DispatchStorage {
+    unsigned message_type;  // 0 = 未知，否则为 类型序号 + 1
+    MessageResult results[kTypeCount];
+};
+
+// Tagged Union 分发器：switch + 解码到临时对象后移入 union 成员
+#define UNION_CASE(ID_FN, i)                                              \
+    case ID_FN(i): {                                                      \
+        MessageResult temp;                                               \
+        DeserializeStatus res = decode_message<i>(data, length, temp);   \
+        if (res.is_success()) {                                           \
+            storage.results[i] = std::move(temp);                         \
+            storage.message_type = i + 1;                                 \
+        }                                                                 \
+        return res;                                                       \
+    }
+#define UNION_CASE_DENSE(i) UNION_CASE(dense_id, i)
+#define UNION_CASE_SPARSE(i) UNION_CASE(sparse_id, i)
+
+DeserializeStatus switch_union_dense(const uint8_t* data, size_t length, DispatchStorage& storage) {
+    switch (read_uint16_be(data)) {
+        REP256(UNION_CASE_DENSE, 0)
+    default:
+        storage.message_type = 0;
+        return DeserializeStatus::failure(INVALID_VALUE, "Unknown MessageID", 0);
+    }
+}
+
+DeserializeStatus switch_union_sparse(const uint8_t* data, size_t length, DispatchStorage& storage) {
+    switch (read_uint16_be(data)) {
+        REP256(UNION_CASE_SPARSE, 0)
+    default:
+        storage.message_type = 0;
+        return DeserializeStatus::failure(INVALID_VALUE, "Unknown MessageID", 0);
+    }
+}
+
+// 表驱动分发：每种报文一个解码函数，直接写入存储槽位
+typedef DeserializeStatus (*DecodeHandler)(const uint8_t*, size_t, DispatchStorage&);
+
+template<unsigned I>
+DeserializeStatus decode_into(const uint8_t* data, size_t length, DispatchStorage& storage) {
+    DeserializeStatus res = decode_message<I>(data, length, storage.results[I]);
+    if (res.is_success()) {
+        storage.message_type = I + 1;
+    }
+    return res;
+}
+
+#define HANDLER_ENTRY(i) &decode_into<i>,
+const DecodeHandler kHandlers[kTypeCount] = { REP256(HANDLER_ENTRY, 0) };
+
+// ============================================================================
+// 分发表构造（与 nodegen/dispatch-table.js 相同的算法，基准中在启动时构造）
+// ============================================================================
+struct HashedTable {
+    unsigned slot_bits;
+    unsigned bucket_bits;
+    std::vector<uint32_t> seeds;
+    std::vector<DispatchSlot<DecodeHandler> > slots;
+};
+
+unsigned ceil_log2(size_t n) {
+    unsigned bits = 0;
+    while ((static_cast<size_t>(1) << bits) < n) {
+        ++bits;
+    }
+    return bits;
+}
+
+bool build_hashed_table(const std::vector<DispatchSlot<DecodeHandler> >& entries, HashedTable& table) {
+    const unsigned key_bits = std::max(1u, ceil_log2(entries.size()));
+    table.bucket_bits = key_bits - 1;
+    for (table.slot_bits = key_bits; table.slot_bits <= key_bits + 2; ++table.slot_bits) {
+        const size_t bucket_count = static_cast<size_t>(1) << table.bucket_bits;
+        std::vector<std::vector<size_t> > buckets(bucket_count);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            size_t bucket = table.bucket_bits == 0 ? 0
+                : static_cast<size_t>(dispatch_hash(entries[i].id, 0) >> (64 - table.bucket_bits));
+            buckets[bucket].push_back(i);
+        }
+        std::vector<size_t> order(bucket_count);
+        for (size_t b = 0; b < bucket_count; ++b) {
+            order[b] = b;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        DispatchSlot<DecodeHandler> empty = { 0, nullptr };
+        table.seeds.assign(bucket_count, 0);
+        table.slots.assign(static_cast<size_t>(1) << table.slot_bits, empty);
+        bool ok = true;
+        for (size_t o = 0; o < bucket_count && ok; ++o) {
+            const std::vector<size_t>& bucket = buckets[order[o]];
+            if (bucket.empty()) {
+                break;
+            }
+            bool placed = false;
+            for (uint32_t seed = 0; seed < (1u << 16) && !placed; ++seed) {
+                std::vector<size_t> positions;
+                for (size_t k = 0; k < bucket.size(); ++k) {
+                    size_t slot = static_cast<size_t>(dispatch_hash(entries[bucket[k]].id, seed) >> (64 - table.slot_bits));
+                    if (table.slots[slot].handler != nullptr ||
+                        std::find(positions.begin(), positions.end(), slot) != positions.end()) {
+                        break;
+                    }
+                    positions.push_back(slot);
+                }
+                if (positions.size() == bucket.size()) {
+                    for (size_t k = 0; k < bucket.size(); ++k) {
+                        table.slots[positions[k]] = entries[bucket[k]];
+                    }
+                    table.seeds[order[o]] = seed;
+                    placed = true;
+                }
+            }
+            ok = placed;
+        }
+        if (ok) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// 流量：按分布生成 kTrafficFrames 帧
+// ============================================================================
+struct Traffic {
+    const char* name;
+    bool sparse_ids;
+    std::vector<uint8_t> bytes;
+    std::vector<size_t> offsets;
+};
+
+Traffic make_traffic(const char* name, bool sparse_ids, bool zipf, double unknown_ratio) {
+    Traffic traffic;
+    traffic.name = name;
+    traffic.sparse_ids = sparse_ids;
+
+    // Zipf(s = 1.1) 频率：少数报文类型（心跳、位置上报）占据大部分流量
+    std::vector<double> cumulative(kTypeCount);
+    double total = 0.0;
+    for (unsigned i = 0; i < kTypeCount; ++i) {
+        total += zipf ? 1.0 / std::pow(static_cast<double>(i + 1), 1.1) : 1.0;
+        cumulative[i] = total;
+    }
+
+    uint32_t state = 7;
+    for (size_t f = 0; f < kTrafficFrames; ++f) {
+        state = state * 1664525u + 1013904223u;
+        const double pick = (state >> 8) / 16777216.0 * total;
+        unsigned type = static_cast<unsigned>(
+            std::lower_bound(cumulative.begin(), cumulative.end(), pick) - cumulative.begin());
+        type = std::min(type, kTypeCount - 1);
+        // 类型序号打乱，避免热门类型恰好集中在 ID 空间一端
+        type = (type * 167u + 13u) % kTypeCount;
+
+        state = state * 1664525u + 1013904223u;
+        const bool unknown = (state >> 8) / 16777216.0 < unknown_ratio;
+        uint16_t id = sparse_ids ? sparse_id(type) : dense_id(type);
+        if (unknown) {
+            id = static_cast<uint16_t>(id ^ 0x5A5Au);  // 不在报文表中的 ID（下方校验）
+        }
+
+        traffic.offsets.push_back(traffic.bytes.size());
+        uint8_t frame[kFrameSize];
+        write_uint16_be(frame, id);
+        write_uint32_be(frame + 2, static_cast<uint32_t>(f));
+        write_uint32_be(frame + 6, state);
+        for (size_t v = 0; v < 4; ++v) {
+            state = state * 1664525u + 1013904223u;
+            write_uint32_be(frame + 10 + v * 4, state);
+        }
+        traffic.bytes.insert(traffic.bytes.end(), frame, frame + kFrameSize);
+    }
+    return traffic;
+}
+
+// ============================================================================
+// 分发方式
+// ============================================================================
+struct Tables {
+    std::vector<DecodeHandler> dense;
+    uint64_t dense_base;
+    HashedTable hashed;
+    std::vector<DispatchSlot<DecodeHandler> > sorted;
+};
+
+enum Method { SWITCH_SHARED, SWITCH_UNION, DENSE_TABLE, HASHED_TABLE, SORTED_TABLE };
+
+const char* method_name(Method method) {
+    switch (method) {
+    case SWITCH_SHARED: return "switch + make_shared";
+    case SWITCH_UNION:  return "switch + temp -> union";
+    case DENSE_TABLE:   return "dense jump table";
+    case HASHED_TABLE:  return "perfect hash table";
+    case SORTED_TABLE:  return "sorted table (binary)";
+    }
+    return "?";
+}
+
+// 对整段流量执行一次分发，返回已解码报文的校验和
+uint64_t run_traffic(Method method, const Traffic& traffic, const Tables& tables, DispatchStorage& storage) {
+    uint64_t sum = 0;
+    const uint8_t* base = traffic.bytes.data();
+    for (size_t f = 0; f < traffic.offsets.size(); ++f) {
+        const uint8_t* data = base + traffic.offsets[f];
+        if (method == SWITCH_SHARED) {
+            std::shared_ptr<MessageBase> msg;
+            DeserializeStatus res = traffic.sparse_ids ? switch_shared_sparse(data, kFrameSize, msg)
+                                                       : switch_shared_dense(data, kFrameSize, msg);
+            if (res.is_success()) {
+                sum += checksum_of(static_cast<const MessageResult&>(*msg));
+            }
+            continue;
+        }
+
+        DeserializeStatus res;
+        if (method == SWITCH_UNION) {
+            res = traffic.sparse_ids ? switch_union_sparse(data, kFrameSize, storage)
+                                     : switch_union_dense(data, kFrameSize, storage);
+        } else {
+            storage.message_type = 0;
+            const uint64_t key = read_uint16_be(data);
+            DecodeHandler handler;
+            if (method == DENSE_TABLE) {
+                handler = lookup_dense_handler(tables.dense.data(), tables.dense.size(), tables.dense_base, key);
+            } else if (method == HASHED_TABLE) {
+                handler = lookup_hashed_handler(tables.hashed.slots.data(), tables.hashed.slot_bits,
+                                                tables.hashed.seeds.data(), tables.hashed.bucket_bits, key);
+            } else {
+                handler = lookup_sorted_handler(tables.sorted.data(), tables.sorted.size(), key);
+            }
+            res = handler != nullptr ? handler(data, kFrameSize, storage)
+                                     : DeserializeStatus::failure(INVALID_VALUE, "Unknown MessageID", 0);
+        }
+        if (res.is_success()) {
+            sum += checksum_of(storage.results[storage.message_type - 1]);
+        }
+    }
+    return sum;
+}
+
+int run_case(const Traffic& traffic, const Tables& tables, const Method* methods, size_t method_count) {
+    bench::print_header(traffic.name);
+    // 存储体积较大（256 个槽位），与生成代码的建议用法一致：长期持有一个实例
+    std::unique_ptr<DispatchStorage> storage(new DispatchStorage());
+    const uint64_t expected = run_traffic(SWITCH_SHARED, traffic, tables, *storage);
+    int failures = 0;
+
+    for (size_t m = 0; m < method_count; ++m) {
+        const Method method = methods[m];
+        if (run_traffic(method, traffic, tables, *storage) != expected) {
+            std::printf("MISMATCH: %s / %s\n", method_name(method), traffic.name);
+            ++failures;
+            continue;
+        }
+
+        const size_t before = g_allocations;
+        run_traffic(method, traffic, tables, *storage);
+        const double allocs = static_cast<double>(g_allocations - before) / static_cast<double>(kTrafficFrames);
+
+        const double seconds = bench::measure([&]() {
+            uint64_t sum = run_traffic(method, traffic, tables, *storage);
+            bench::do_not_optimize(sum);
+        });
+        std::printf("%-26s %8.2f ns/frame %6.2f allocs/frame\n",
+                    method_name(method), seconds * 1e9 / static_cast<double>(kTrafficFrames), allocs);
+    }
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    Tables dense_tables;
+    dense_tables.dense_base = dense_id(0);
+    dense_tables.dense.assign(kHandlers, kHandlers + kTypeCount);
+
+    Tables sparse_tables;
+    sparse_tables.dense_base = 0;
+    for (unsigned i = 0; i < kTypeCount; ++i) {
+        DispatchSlot<DecodeHandler> entry = { sparse_id(i), kHandlers[i] };
+        sparse_tables.sorted.push_back(entry);
+    }
+    if (!build_hashed_table(sparse_tables.sorted, sparse_tables.hashed)) {
+        std::printf("FAILED: perfect hash construction\n");
+        return 1;
+    }
+    std::sort(sparse_tables.sorted.begin(), sparse_tables.sorted.end(),
+              [](const DispatchSlot<DecodeHandler>& a, const DispatchSlot<DecodeHandler>& b) { return a.id < b.id; });
+    std::printf("%u message types, %zu-byte frames, %zu frames per pass; perfect hash: %zu slots, %zu seeds\n",
+                kTypeCount, kFrameSize, kTrafficFrames,
+                sparse_tables.hashed.slots.size(), sparse_tables.hashed.seeds.size());
+
+    // 未知 ID 必须确实不在报文表中，否则校验和比较失去意义
+    for (unsigned i = 0; i < kTypeCount; ++i) {
+        const uint16_t probe = static_cast<uint16_t>(sparse_id(i) ^ 0x5A5Au);
+        if (lookup_sorted_handler(sparse_tables.sorted.data(), sparse_tables.sorted.size(), probe) != nullptr) {
+            std::printf("FAILED: unknown-ID probe 0x%04X collides with a known ID\n", probe);
+            return 1;
+        }
+    }
+
+    const Method dense_methods[] = { SWITCH_SHARED, SWITCH_UNION, DENSE_TABLE };
+    const Method sparse_methods[] = { SWITCH_SHARED, SWITCH_UNION, HASHED_TABLE, SORTED_TABLE };
+
+    int failures = 0;
+    failures += run_case(make_traffic("Contiguous IDs 0x0100-0x01FF, uniform", false, false, 0.0),
+                         dense_tables, dense_methods, 3);
+    failures += run_case(make_traffic("Sparse 16-bit IDs, uniform", true, false, 0.0),
+                         sparse_tables, sparse_methods, 4);
+    failures += run_case(make_traffic("Sparse 16-bit IDs, Zipf(1.1) + 1% unknown", true, true, 0.01),
+                         sparse_tables, sparse_methods, 4);
+    return failures == 0 ? 0 : 1;
+}
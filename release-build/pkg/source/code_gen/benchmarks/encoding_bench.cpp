@@ -0,0 +1,317 @@
+// ============================================================================
+// 字符串编码基准（protocol_encoding.h）
+// 1. ASCII 检查：逐字节判断最高位 vs ascii_prefix_length()（SSE2，每次 64 字节）
+// 2. UTF-8 验证：逐字符分支判断的常见写法 vs utf8_error_offset()（SSSE3 查表），纯 ASCII / 中文 / 中英混合
+// 3. GBK ↔ UTF-8：iconv（glibc）vs gbk_to_utf8() / utf8_to_gbk()，中文 / 中英混合 / 纯 ASCII
+// 4. 字段级：32 字节定长 String 字段的 deserialize_string_generic()，ASCII / UTF-8 / GBK 编码
+// 文本长度 32 B（典型字段）与 64 KB；GBK 文本从映射表随机取字，逐项核对往返结果与 iconv 输出
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework encoding_bench.cpp -o encoding_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <string>
+
+#if defined(__GLIBC__)
+#include <iconv.h>
+#define ENCODING_BENCH_ICONV 1
+#endif
+
+using namespace protocol_parser;
+
+namespace {
+
+struct Corpus {
+    const char* name;
+    std::vector<uint8_t> gbk;
+    std::vector<uint8_t> utf8;
+};
+
+// 中文字符占比 chinese_percent，其余为可打印 ASCII；中文从 GBK 映射表随机取
+Corpus make_corpus(const char* name, size_t length, unsigned chinese_percent, uint32_t seed) {
+    Corpus corpus;
+    corpus.name = name;
+    uint32_t state = seed;
+    while (corpus.gbk.size() + 2 <= length) {
+        state = state * 1664525u + 1013904223u;
+        if ((state >> 8) % 100 < chinese_percent) {
+            // 常用汉字区 0xB0~0xF7（GB2312 一、二级汉字）
+            uint8_t lead = 0;
+            uint8_t trail = 0;
+            do {
+                state = state * 1664525u + 1013904223u;
+                lead = static_cast<uint8_t>(0xB0 + (state >> 16) % 0x48);
+                trail = static_cast<uint8_t>(0xA1 + (state >> 24) % 0x5E);
+            } while (encoding_detail::gbk_decode_pair(lead, trail) == 0);
+            corpus.gbk.push_back(lead);
+            corpus.gbk.push_back(trail);
+        } else {
+            corpus.gbk.push_back(static_cast<uint8_t>(0x20 + (state >> 24) % 0x5F));
+        }
+    }
+    corpus.utf8.resize(gbk_to_utf8_max_length(corpus.gbk.size()));
+    const TranscodeStatus status = gbk_to_utf8(corpus.gbk.data(), corpus.gbk.size(),
+                                               corpus.utf8.data(), corpus.utf8.size());
+    corpus.utf8.resize(status.produced);
+    return corpus;
+}
+
+// 常见写法：逐字节判断
+size_t ascii_prefix_bytewise(const uint8_t* data, size_t length) {
+    size_t i = 0;
+    while (i < length && (data[i] & 0x80) == 0) {
+        ++i;
+    }
+    return i;
+}
+
+// 常见写法：按首字节判断序列长度，逐个检查续字节和范围
+size_t utf8_error_branchy(const uint8_t* data, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        const uint8_t c = data[i];
+        size_t n = 0;
+        uint32_t code_point = 0;
+        if (c < 0x80) {
+            ++i;
+            continue;
+        } else if ((c & 0xE0) == 0xC0) {
+            n = 2;
+            code_point = c & 0x1F;
+        } else if ((c & 0xF0) == 0xE0) {
+            n = 3;
+            code_point = c & 0x0F;
+        } else if ((c & 0xF8) == 0xF0) {
+            n = 4;
+            code_point = c & 0x07;
+        } else {
+            return i;
+        }
+        if (i + n > length) {
+            return i;
+        }
+        for (size_t k = 1; k < n; ++k) {
+            if ((data[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+            code_point = (code_point << 6) | (data[i + k] & 0x3F);
+        }
+        if ((n == 2 && code_point < 0x80) || (n == 3 && code_point < 0x800) || (n == 4 && code_point < 0x10000) ||
+            code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+            return i;
+        }
+        i += n;
+    }
+    return length;
+}
+
+#if defined(ENCODING_BENCH_ICONV)
+size_t iconv_convert(iconv_t cd, const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    char* src = const_cast<char*>(reinterpret_cast<const char*>(in.data()));
+    size_t src_left = in.size();
+    char* dst = reinterpret_cast<char*>(out.data());
+    size_t dst_left = out.size();
+    iconv(cd, nullptr, nullptr, nullptr, nullptr);
+    if (iconv(cd, &src, &src_left, &dst, &dst_left) == static_cast<size_t>(-1)) {
+        return static_cast<size_t>(-1);
+    }
+    return out.size() - dst_left;
+}
+#endif
+
+void print_speedup(const char* name, size_t bytes, double seconds, double baseline) {
+    bench::print_throughput(name, bytes, seconds);
+    std::printf("        speedup x%.2f\n", baseline / seconds);
+}
+
+int run_validation(const Corpus& ascii, const std::vector<Corpus>& corpora) {
+    int failures = 0;
+    bench::print_header("ASCII check");
+    {
+        const std::vector<uint8_t>& text = ascii.utf8;
+        if (ascii_prefix_length(text.data(), text.size()) != ascii_prefix_bytewise(text.data(), text.size())) {
+            std::printf("MISMATCH: ascii_prefix_length\n");
+            ++failures;
+        }
+        const double baseline = bench::measure([&]() {
+            bench::do_not_optimize(ascii_prefix_bytewise(text.data(), text.size()));
+        });
+        const double simd = bench::measure([&]() {
+            bench::do_not_optimize(ascii_prefix_length(text.data(), text.size()));
+        });
+        bench::print_throughput("bytewise", text.size(), baseline);
+        print_speedup("ascii_prefix_length", text.size(), simd, baseline);
+    }
+
+    bench::print_header("UTF-8 validation");
+    for (size_t c = 0; c < corpora.size(); ++c) {
+        const std::vector<uint8_t>& text = corpora[c].utf8;
+        std::printf("-- %s\n", corpora[c].name);
+        if (utf8_error_offset(text.data(), text.size()) != text.size() ||
+            utf8_error_branchy(text.data(), text.size()) != text.size()) {
+            std::printf("MISMATCH: valid text rejected\n");
+            ++failures;
+        }
+        // 末尾截断的序列必须被拒绝
+        if (text.size() > 1 && text.back() >= 0x80 &&
+            utf8_error_offset(text.data(), text.size() - 1) == text.size() - 1) {
+            std::printf("MISMATCH: truncated text accepted\n");
+            ++failures;
+        }
+        const double baseline = bench::measure([&]() {
+            bench::do_not_optimize(utf8_error_branchy(text.data(), text.size()));
+        });
+        const double simd = bench::measure([&]() {
+            bench::do_not_optimize(utf8_error_offset(text.data(), text.size()));
+        });
+        bench::print_throughput("branchy per character", text.size(), baseline);
+        print_speedup("utf8_error_offset", text.size(), simd, baseline);
+    }
+    return failures;
+}
+
+int run_transcoding(const std::vector<Corpus>& corpora) {
+    int failures = 0;
+#if defined(ENCODING_BENCH_ICONV)
+    iconv_t to_utf8 = iconv_open("UTF-8", "GBK");
+    iconv_t to_gbk = iconv_open("GBK", "UTF-8");
+    const bool have_iconv = to_utf8 != reinterpret_cast<iconv_t>(-1) && to_gbk != reinterpret_cast<iconv_t>(-1);
+#endif
+    for (size_t c = 0; c < corpora.size(); ++c) {
+        const Corpus& corpus = corpora[c];
+        std::vector<uint8_t> utf8(gbk_to_utf8_max_length(corpus.gbk.size()));
+        std::vector<uint8_t> gbk(utf8_to_gbk_max_length(corpus.utf8.size()));
+        char title[96];
+        std::snprintf(title, sizeof(title), "GBK <-> UTF-8, %s", corpus.name);
+        bench::print_header(title);
+
+        const TranscodeStatus decoded = gbk_to_utf8(corpus.gbk.data(), corpus.gbk.size(), utf8.data(), utf8.size());
+        const TranscodeStatus encoded = utf8_to_gbk(corpus.utf8.data(), corpus.utf8.size(), gbk.data(), gbk.size());
+        if (!decoded.ok() || !encoded.ok() || encoded.produced != corpus.gbk.size() ||
+            std::memcmp(gbk.data(), corpus.gbk.data(), corpus.gbk.size()) != 0 ||
+            !is_valid_utf8(utf8.data(), decoded.produced)) {
+            std::printf("MISMATCH: round trip\n");
+            ++failures;
+            continue;
+        }
+        const double decode = bench::measure([&]() {
+            bench::do_not_optimize(gbk_to_utf8(corpus.gbk.data(), corpus.gbk.size(), utf8.data(), utf8.size()));
+        });
+        const double encode = bench::measure([&]() {
+            bench::do_not_optimize(utf8_to_gbk(corpus.utf8.data(), corpus.utf8.size(), gbk.data(), gbk.size()));
+        });
+#if defined(ENCODING_BENCH_ICONV)
+        if (have_iconv) {
+            std::vector<uint8_t> out(corpus.gbk.size() * 3 + 16);
+            const size_t n = iconv_convert(to_utf8, corpus.gbk, out);
+            if (n != decoded.produced || std::memcmp(out.data(), utf8.data(), n) != 0) {
+                std::printf("MISMATCH: gbk_to_utf8 differs from iconv\n");
+                ++failures;
+            }
+            const double iconv_decode = bench::measure([&]() {
+                bench::do_not_optimize(iconv_convert(to_utf8, corpus.gbk, out));
+            });
+            const double iconv_encode = bench::measure([&]() {
+                bench::do_not_optimize(iconv_convert(to_gbk, corpus.utf8, out));
+            });
+            bench::print_throughput("iconv GBK -> UTF-8", corpus.gbk.size(), iconv_decode);
+            print_speedup("gbk_to_utf8", corpus.gbk.size(), decode, iconv_decode);
+            bench::print_throughput("iconv UTF-8 -> GBK", corpus.utf8.size(), iconv_encode);
+            print_speedup("utf8_to_gbk", corpus.utf8.size(), encode, iconv_encode);
+            continue;
+        }
+#endif
+        bench::print_throughput("gbk_to_utf8", corpus.gbk.size(), decode);
+        bench::print_throughput("utf8_to_gbk", corpus.utf8.size(), encode);
+    }
+#if defined(ENCODING_BENCH_ICONV)
+    if (have_iconv) {
+        iconv_close(to_utf8);
+        iconv_close(to_gbk);
+    }
+#endif
+    return failures;
+}
+
+// 32 字节定长字段：内容 + 0 填充
+int run_fields() {
+    bench::print_header("32-byte fixed String field, deserialize_string_generic");
+    const size_t kField = 32;
+    const size_t kFields = 1024;
+    const Corpus ascii = make_corpus("ascii", kField * kFields, 0, 7);
+    const Corpus chinese = make_corpus("chinese", kField * kFields, 100, 8);
+
+    struct Case {
+        const char* name;
+        const std::vector<uint8_t>* text;
+        StringEncoding encoding;
+    };
+    const Case cases[] = {
+        { "ASCII (no check)", &ascii.gbk, STRING_ENCODING_ASCII },
+        { "UTF-8, ASCII content", &ascii.utf8, STRING_ENCODING_UTF8 },
+        { "UTF-8, Chinese content", &chinese.utf8, STRING_ENCODING_UTF8 },
+        { "GBK, ASCII content", &ascii.gbk, STRING_ENCODING_GBK },
+        { "GBK, Chinese content", &chinese.gbk, STRING_ENCODING_GBK },
+    };
+    int failures = 0;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        // 每个字段取 24~30 字节内容（在字符边界截断），其余补 0
+        std::vector<uint8_t> wire(kField * kFields, 0);
+        const std::vector<uint8_t>& text = *cases[c].text;
+        size_t source = 0;
+        for (size_t f = 0; f < kFields; ++f) {
+            const size_t want = 24 + f % 7;
+            size_t take = 0;
+            while (take < want && source + take < text.size()) {
+                size_t n = 1;
+                if (text[source + take] >= 0x80) {
+                    n = cases[c].encoding == STRING_ENCODING_GBK ? 2
+                        : encoding_detail::utf8_sequence_length(text.data(), text.size(), source + take);
+                }
+                if (take + n > want) {
+                    break;
+                }
+                take += n;
+            }
+            std::memcpy(wire.data() + f * kField, text.data() + source, take);
+            source += take;
+        }
+        std::string value;
+        value.reserve(64);
+        bool ok = true;
+        const double seconds = bench::measure([&]() {
+            DeserializeContext ctx(wire.data(), wire.size());
+            for (size_t f = 0; f < kFields; ++f) {
+                ok = deserialize_string_generic(ctx, value, kField, cases[c].encoding).is_success() && ok;
+            }
+            bench::do_not_optimize(value);
+        }) / kFields;
+        if (!ok) {
+            std::printf("MISMATCH: %s rejected\n", cases[c].name);
+            ++failures;
+        }
+        std::printf("%-28s %12.2f ns/field\n", cases[c].name, seconds * 1e9);
+    }
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+    const size_t sizes[] = { 32, 65536 };
+    for (size_t s = 0; s < 2; ++s) {
+        const size_t size = sizes[s];
+        std::printf("\n##### %zu-byte text #####\n", size);
+        const Corpus ascii = make_corpus("pure ASCII", size, 0, 1);
+        std::vector<Corpus> corpora;
+        corpora.push_back(ascii);
+        corpora.push_back(make_corpus("Chinese", size, 100, 2));
+        corpora.push_back(make_corpus("mixed (30% Chinese)", size, 30, 3));
+        failures += run_validation(ascii, corpora);
+        failures += run_transcoding(corpora);
+    }
+    failures += run_fields();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+// ============================================================================
+// 流式分帧基准：逐字节查找 + vector 拷贝/erase 的常见手写实现 vs StreamFramer
+// 同步字 EB 90 + 2 字节大端帧长，帧长 24~512 字节，帧间按比例插入噪声
+// （噪声中大量出现同步字首字节 0xEB，但不含完整同步字），按 TCP(1460B) / 串口(64B) 分块写入
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework framer_bench.cpp -o framer_bench
+// ============================================================================
+#include "protocol_framer.h"
+#include "bench_common.h"
+
+#include <cstdio>
+
+using namespace protocol_parser;
+
+namespace {
+
+const uint8_t kSync[2] = { 0xEB, 0x90 };
+const size_t kStreamFrames = 4096;
+
+FrameSpec make_spec() {
+    FrameSpec spec = { kSync, 2, 2, 2, BIG_ENDIAN, 0, 0, 1024 };
+    return spec;
+}
+
+struct Stream {
+    std::vector<uint8_t> bytes;
+    size_t frame_count;
+    uint64_t frame_checksum;  // 全部帧的 (长度 + 首尾字节) 之和，用于结果比对
+};
+
+uint64_t frame_checksum(const uint8_t* frame, size_t length) {
+    return length + frame[4] + frame[length - 1];
+}
+
+// noise_percent：噪声字节占总字节数的百分比
+Stream make_stream(unsigned noise_percent) {
+    Stream stream;
+    stream.frame_count = kStreamFrames;
+    stream.frame_checksum = 0;
+    uint32_t state = 99;
+    std::vector<uint8_t> frame;
+
+    for (size_t f = 0; f < kStreamFrames; ++f) {
+        state = state * 1664525u + 1013904223u;
+        const size_t length = 24 + (state >> 8) % 489;
+        frame.assign(length, 0);
+        frame[0] = kSync[0];
+        frame[1] = kSync[1];
+        write_with_byte_order<uint16_t>(frame.data() + 2, static_cast<uint16_t>(length), BIG_ENDIAN);
+        for (size_t i = 4; i < length; ++i) {
+            state = state * 1664525u + 1013904223u;
+            frame[i] = static_cast<uint8_t>(state >> 24);
+        }
+        stream.frame_checksum += frame_checksum(frame.data(), length);
+
+        // 帧前噪声：长度使噪声占比约为 noise_percent
+        if (noise_percent > 0) {
+            state = state * 1664525u + 1013904223u;
+            const size_t noise = length * noise_percent / (100 - noise_percent) * ((state >> 8) % 200) / 100;
+            for (size_t i = 0; i < noise; ++i) {
+                state = state * 1664525u + 1013904223u;
+                uint8_t byte = static_cast<uint8_t>(state >> 24);
+                if ((state >> 8) % 4 == 0) {
+                    byte = kSync[0];  // 噪声中频繁出现同步字首字节
+                }
+                // 避免噪声中出现完整同步字（保证结果可比对）
+                if (byte == kSync[1] && !stream.bytes.empty() && stream.bytes.back() == kSync[0]) {
+                    byte = 0x00;
+                }
+                stream.bytes.push_back(byte);
+            }
+        }
+        stream.bytes.insert(stream.bytes.end(), frame.begin(), frame.end());
+    }
+    return stream;
+}
+
+// ============================================================================
+// 常见手写实现：vector 追加、逐字节查找同步字、帧拷贝到新 vector、erase 已消费数据
+// ============================================================================
+struct NaiveFramer {
+    std::vector<uint8_t> buffer;
+
+    template<typename Fn>
+    void push(const uint8_t* data, size_t length, Fn on_frame) {
+        buffer.insert(buffer.end(), data, data + length);
+        size_t pos = 0;
+        for (;;) {
+            while (pos + 1 < buffer.size() && !(buffer[pos] == kSync[0] && buffer[pos + 1] == kSync[1])) {
+                ++pos;
+            }
+            if (pos + 4 > buffer.size()) {
+                break;
+            }
+            const size_t length_field = (static_cast<size_t>(buffer[pos + 2]) << 8) | buffer[pos + 3];
+            if (length_field < 4 || length_field > 1024) {
+                ++pos;
+                continue;
+            }
+            if (pos + length_field > buffer.size()) {
+                break;
+            }
+            std::vector<uint8_t> frame(buffer.begin() + static_cast<std::ptrdiff_t>(pos),
+                                       buffer.begin() + static_cast<std::ptrdiff_t>(pos + length_field));
+            on_frame(frame.data(), frame.size());
+            pos += length_field;
+        }
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+};
+
+struct Totals {
+    size_t frames;
+    uint64_t checksum;
+};
+
+Totals run_naive(const Stream& stream, size_t chunk) {
+    Totals totals = { 0, 0 };
+    NaiveFramer framer;
+    for (size_t pos = 0; pos < stream.bytes.size(); pos += chunk) {
+        const size_t n = std::min(chunk, stream.bytes.size() - pos);
+        framer.push(stream.bytes.data() + pos, n, [&](const uint8_t* frame, size_t length) {
+            ++totals.frames;
+            totals.checksum += frame_checksum(frame, length);
+        });
+    }
+    return totals;
+}
+
+Totals run_framer(const Stream& stream, size_t chunk, StreamFramer& framer) {
+    Totals totals = { 0, 0 };
+    framer.reset();
+    for (size_t pos = 0; pos < stream.bytes.size(); pos += chunk) {
+        const size_t n = std::min(chunk, stream.bytes.size() - pos);
+        size_t written = 0;
+        while (written < n) {
+            written += framer.push(stream.bytes.data() + pos + written, n - written);
+            framer.drain([&](const FrameSpan& frame) {
+                ++totals.frames;
+                totals.checksum += frame_checksum(frame.data, frame.length);
+                return true;
+            });
+        }
+    }
+    return totals;
+}
+
+int run_case(unsigned noise_percent, size_t chunk) {
+    const Stream stream = make_stream(noise_percent);
+    StreamFramer framer(make_spec());
+    char name[64];
+
+    const Totals naive = run_naive(stream, chunk);
+    const Totals fast = run_framer(stream, chunk, framer);
+    const FramerStats stats = framer.stats();
+    if (naive.frames != stream.frame_count || naive.checksum != stream.frame_checksum ||
+        fast.frames != stream.frame_count || fast.checksum != stream.frame_checksum) {
+        std::printf("MISMATCH: noise %u%% chunk %zu (naive %zu frames, framer %zu frames, expected %zu)\n",
+                    noise_percent, chunk, naive.frames, fast.frames, stream.frame_count);
+        return 1;
+    }
+
+    std::snprintf(name, sizeof(name), "naive   noise %2u%% chunk %4zu", noise_percent, chunk);
+    bench::print_throughput(name, stream.bytes.size(), bench::measure([&]() {
+        Totals t = run_naive(stream, chunk);
+        bench::do_not_optimize(t);
+    }));
+    std::snprintf(name, sizeof(name), "framer  noise %2u%% chunk %4zu", noise_percent, chunk);
+    bench::print_throughput(name, stream.bytes.size(), bench::measure([&]() {
+        Totals t = run_framer(stream, chunk, framer);
+        bench::do_not_optimize(t);
+    }));
+    std::printf("        frames %zu, discarded %llu B, resyncs %llu\n", fast.frames,
+                static_cast<unsigned long long>(stats.bytes_discarded),
+                static_cast<unsigned long long>(stats.resyncs));
+    return 0;
+}
+
+// 同步字查找本身：逐字节 vs find_sync_pattern（噪声中 25% 为同步字首字节）
+int run_scan() {
+    std::vector<uint8_t> noise = bench::make_random_bytes(64 * 1024, 7);
+    for (size_t i = 0; i < noise.size(); i += 4) {
+        noise[i] = kSync[0];
+    }
+    for (size_t i = 1; i < noise.size(); ++i) {
+        if (noise[i - 1] == kSync[0] && noise[i] == kSync[1]) {
+            noise[i] = 0;
+        }
+    }
+    noise[noise.size() - 2] = kSync[0];
+    noise[noise.size() - 1] = kSync[1];
+
+    const uint8_t* expected = noise.data() + noise.size() - 2;
+    if (find_sync_pattern(noise.data(), noise.size(), kSync, 2) != expected) {
+        std::printf("MISMATCH: find_sync_pattern\n");
+        return 1;
+    }
+
+    bench::print_throughput("scan byte loop", noise.size(), bench::measure([&]() {
+        size_t pos = 0;
+        while (pos + 1 < noise.size() && !(noise[pos] == kSync[0] && noise[pos + 1] == kSync[1])) {
+            ++pos;
+        }
+        bench::do_not_optimize(pos);
+    }));
+    bench::print_throughput("scan find_sync_pattern", noise.size(), bench::measure([&]() {
+        const uint8_t* found = find_sync_pattern(noise.data(), noise.size(), kSync, 2);
+        bench::do_not_optimize(found);
+    }));
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+
+    bench::print_header("Sync word search (64 KB noise, 25% first-byte hits)");
+    failures += run_scan();
+
+    const unsigned kNoise[] = { 0, 5, 30 };
+    const size_t kChunks[] = { 1460, 64 };
+    for (size_t c = 0; c < sizeof(kChunks) / sizeof(kChunks[0]); ++c) {
+        bench::print_header(kChunks[c] == 1460 ? "TCP segments (1460 B)" : "Serial reads (64 B)");
+        for (size_t n = 0; n < sizeof(kNoise) / sizeof(kNoise[0]); ++n) {
+            failures += run_case(kNoise[n], kChunks[c]);
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+// ============================================================================
+// 惰性视图基准：整帧 Raw 解码后过滤 vs <Protocol>View 只读过滤所需字段
+// 报文（大端）：同步字(2) | MessageID(2) | 序号(4) | 时间戳(8) | 24 个 uint32 | 6 个 float
+//               | 名称(定长 16) | 备注('\0' 结尾，8~40 字节) | 状态(2) | CRC-16/MODBUS(2)，约 190 字节
+// 过滤条件：MessageID 命中（约 10%）时读取序号并转发；另测读取变长备注之后字段（需建立偏移索引）
+// 视图类与 lazyView 生成的代码结构一致
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework lazy_view_bench.cpp -o lazy_view_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "protocol_checksum.h"
+#include "bench_common.h"
+
+#include <cstdio>
+
+using namespace protocol_parser;
+
+namespace {
+
+const size_t kFrames = 1024;
+const size_t kMeasurements = 24;
+const size_t kFloats = 6;
+const size_t kNameLength = 16;
+const uint16_t kWantedId = 7;
+
+Checksum_CRC<uint16_t> make_crc16() {
+    Checksum_CRC<uint16_t> crc(0x8005);
+    crc.set_init(0xFFFF);
+    crc.set_xor_out(0);
+    crc.set_ref_in(true);
+    crc.set_ref_out(true);
+    return crc;
+}
+
+// 整帧解码的目标（Raw 层形式，字符串为零拷贝视图，已是默认模式下最省的解码）
+struct GatewayRaw {
+    uint16_t sync;
+    uint16_t message_id;
+    uint32_t sequence;
+    uint64_t timestamp;
+    uint32_t measurements[kMeasurements];
+    float gains[kFloats];
+    StringView name;
+    StringView note;
+    uint16_t status;
+    uint16_t crc;
+};
+
+// 与 Raw 层逐字段解析一致：每个字段各自检查剩余长度、推进偏移
+DeserializeStatus parse_full(const uint8_t* data, size_t length, GatewayRaw& raw, bool verify_crc) {
+    DeserializeContext ctx(data, length, BIG_ENDIAN);
+    DeserializeStatus res = deserialize_unsigned_int_fixed<BIG_ENDIAN, uint16_t>(ctx, raw.sync);
+    if (!res.is_success()) return res;
+    res = deserialize_unsigned_int_fixed<BIG_ENDIAN, uint16_t>(ctx, raw.message_id);
+    if (!res.is_success()) return res;
+    res = deserialize_unsigned_int_fixed<BIG_ENDIAN, uint32_t>(ctx, raw.sequence);
+    if (!res.is_success()) return res;
+    res = deserialize_unsigned_int_fixed<BIG_ENDIAN, uint64_t>(ctx, raw.timestamp);
+    if (!res.is_success()) return res;
+    for (size_t i = 0; i < kMeasurements; ++i) {
+        res = deserialize_unsigned_int_fixed<BIG_ENDIAN, uint32_t>(ctx, raw.measurements[i]);
+        if (!res.is_success()) return res;
+    }
+    for (size_t i = 0; i < kFloats; ++i) {
+        res = deserialize_float_fixed<BIG_ENDIAN, float>(ctx, raw.gains[i]);
+        if (!res.is_success()) return res;
+    }
+    res = deserialize_string_view(ctx, raw.name, kNameLength);
+    if (!res.is_success()) return res;
+    res = deserialize_string_view(ctx, raw.note, 0);
+    if (!res.is_success()) return res;
+    res = deserialize_unsigned_int_fixed<BIG_ENDIAN, uint16_t>(ctx, raw.status);
+    if (!res.is_success()) return res;
+    if (verify_crc) {
+        const size_t end = ctx.offset;
+        res = deserialize_unsigned_int_fixed<BIG_ENDIAN, uint16_t>(ctx, raw.crc);
+        if (!res.is_success()) return res;
+        Checksum_CRC<uint16_t> checker = make_crc16();
+        checker.update(data, end);
+        if (static_cast<uint16_t>(checker.finalize()) != raw.crc) {
+            return DeserializeStatus::failure(INVALID_CHECKSUM, "Checksum verification failed", end);
+        }
+    }
+    return DeserializeStatus::success(ctx.offset);
+}
+
+// ============================================================================
+// 惰性视图（lazyView 生成代码的形式；VerifyCrc 为 false 时对应无 Checksum 字段的协议）
+// ============================================================================
+template<ByteOrder Order, bool VerifyCrc>
+class GatewayViewOrder {
+public:
+    static const size_t MIN_SIZE = 16 + kMeasurements * 4 + kFloats * 4 + kNameLength + 1 + 2 + 2;
+
+    GatewayViewOrder() : data_(nullptr), length_(0), index_built_(false) {}
+
+    DeserializeStatus bind(const uint8_t* data, size_t length) {
+        data_ = nullptr;
+        length_ = 0;
+        index_built_ = false;
+        if (data == nullptr || length < MIN_SIZE) {
+            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for view", length);
+        }
+        data_ = data;
+        length_ = length;
+        if (VerifyCrc) {
+            const DeserializeStatus index_status = build_index();
+            if (!index_status.is_success()) {
+                data_ = nullptr;
+                return index_status;
+            }
+            Checksum_CRC<uint16_t> checker = make_crc16();
+            const size_t begin = 0;
+            const size_t end = index_[0] + 2;
+            checker.update(data + begin, end - begin);
+            const uint16_t expected = read_fixed_order<Order, uint16_t>(data + index_[0] + 2);
+            if (static_cast<uint16_t>(checker.finalize()) != expected) {
+                data_ = nullptr;
+                return DeserializeStatus::failure(INVALID_CHECKSUM, "Checksum verification failed", index_[0] + 2, 11);
+            }
+        }
+        return DeserializeStatus::success(MIN_SIZE);
+    }
+
+    const DeserializeStatus& build_index() const {
+        if (!index_built_) {
+            index_status_ = scan_index();
+            index_built_ = true;
+        }
+        return index_status_;
+    }
+
+    uint16_t message_id() const {
+        return read_fixed_order<Order, uint16_t>(data_ + 2);
+    }
+
+    uint32_t sequence() const {
+        return read_fixed_order<Order, uint32_t>(data_ + 4);
+    }
+
+    uint16_t status() const {
+        if (!build_index().is_success()) return uint16_t();
+        return read_fixed_order<Order, uint16_t>(data_ + index_[0]);
+    }
+
+private:
+    DeserializeStatus scan_index() const {
+        const size_t begin = 16 + kMeasurements * 4 + kFloats * 4 + kNameLength;
+        const void* terminator = begin < length_ ? std::memchr(data_ + begin, '\0', length_ - begin) : nullptr;
+        if (terminator == nullptr) {
+            return DeserializeStatus::failure(INVALID_FORMAT, "Variable-length string missing null terminator", begin);
+        }
+        index_[0] = static_cast<size_t>(static_cast<const uint8_t*>(terminator) - data_) + 1;
+        if (index_[0] + 4 > length_) {
+            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for view", length_);
+        }
+        return DeserializeStatus::success(index_[0] + 4);
+    }
+
+    const uint8_t* data_;
+    size_t length_;
+    mutable size_t index_[1];
+    mutable bool index_built_;
+    mutable DeserializeStatus index_status_;
+};
+
+struct Frames {
+    std::vector<uint8_t> bytes;
+    std::vector<FrameSpan> spans;
+    size_t total_bytes;
+};
+
+Frames make_frames() {
+    Frames frames;
+    frames.total_bytes = 0;
+    Checksum_CRC<uint16_t> crc = make_crc16();
+    std::vector<size_t> offsets;
+    uint32_t state = 2024;
+    for (size_t f = 0; f < kFrames; ++f) {
+        const size_t begin = frames.bytes.size();
+        offsets.push_back(begin);
+        std::vector<uint8_t>& b = frames.bytes;
+        b.resize(begin + 16);
+        state = state * 1664525u + 1013904223u;
+        write_fixed_order<BIG_ENDIAN, uint16_t>(&b[begin], 0xEB90);
+        write_fixed_order<BIG_ENDIAN, uint16_t>(&b[begin + 2], static_cast<uint16_t>((state >> 12) % 10 == 0 ? kWantedId : 100 + (state >> 20) % 50));
+        write_fixed_order<BIG_ENDIAN, uint32_t>(&b[begin + 4], static_cast<uint32_t>(f));
+        write_fixed_order<BIG_ENDIAN, uint64_t>(&b[begin + 8], 1700000000000ULL + f);
+        for (size_t i = 0; i < kMeasurements + kFloats; ++i) {
+            state = state * 1664525u + 1013904223u;
+            b.resize(b.size() + 4);
+            write_fixed_order<BIG_ENDIAN, uint32_t>(&b[b.size() - 4], state >> 2);
+        }
+        const char name[kNameLength] = { 'S', 'T', 'A', 'T', 'I', 'O', 'N', '-', 'A', '1' };
+        b.insert(b.end(), name, name + kNameLength);
+        const size_t note_length = 8 + (state >> 24) % 33;
+        for (size_t i = 0; i < note_length; ++i) {
+            b.push_back(static_cast<uint8_t>('a' + i % 26));
+        }
+        b.push_back(0);
+        b.resize(b.size() + 2);
+        write_fixed_order<BIG_ENDIAN, uint16_t>(&b[b.size() - 2], static_cast<uint16_t>(f & 0xFF));
+        const uint16_t checksum = static_cast<uint16_t>(crc.calculate(&b[begin], b.size() - begin));
+        b.resize(b.size() + 2);
+        write_fixed_order<BIG_ENDIAN, uint16_t>(&b[b.size() - 2], checksum);
+    }
+    offsets.push_back(frames.bytes.size());
+    for (size_t f = 0; f < kFrames; ++f) {
+        FrameSpan span = { frames.bytes.data() + offsets[f], offsets[f + 1] - offsets[f] };
+        frames.spans.push_back(span);
+    }
+    frames.total_bytes = frames.bytes.size();
+    return frames;
+}
+
+struct Totals {
+    size_t forwarded;
+    uint64_t sum;
+};
+
+Totals filter_full(const Frames& frames, bool verify_crc, bool read_status) {
+    Totals totals = { 0, 0 };
+    GatewayRaw raw;
+    for (size_t f = 0; f < frames.spans.size(); ++f) {
+        if (!parse_full(frames.spans[f].data, frames.spans[f].length, raw, verify_crc).is_success()) {
+            continue;
+        }
+        if (read_status) {
+            totals.sum += raw.status;
+        } else if (raw.message_id == kWantedId) {
+            ++totals.forwarded;
+            totals.sum += raw.sequence;
+        }
+    }
+    return totals;
+}
+
+template<bool VerifyCrc>
+Totals filter_view(const Frames& frames, bool read_status) {
+    Totals totals = { 0, 0 };
+    GatewayViewOrder<BIG_ENDIAN, VerifyCrc> view;
+    for (size_t f = 0; f < frames.spans.size(); ++f) {
+        if (!view.bind(frames.spans[f].data, frames.spans[f].length).is_success()) {
+            continue;
+        }
+        if (read_status) {
+            totals.sum += view.status();
+        } else if (view.message_id() == kWantedId) {
+            ++totals.forwarded;
+            totals.sum += view.sequence();
+        }
+    }
+    return totals;
+}
+
+int run_case(const Frames& frames, const char* title, bool verify_crc, bool read_status) {
+    bench::print_header(title);
+    const Totals expected = filter_full(frames, verify_crc, read_status);
+    const Totals view = verify_crc ? filter_view<true>(frames, read_status) : filter_view<false>(frames, read_status);
+    if (view.forwarded != expected.forwarded || view.sum != expected.sum) {
+        std::printf("MISMATCH: %s (forwarded %zu/%zu)\n", title, view.forwarded, expected.forwarded);
+        return 1;
+    }
+
+    const double full_seconds = bench::measure([&]() {
+        Totals t = filter_full(frames, verify_crc, read_status);
+        bench::do_not_optimize(t);
+    });
+    const double view_seconds = bench::measure([&]() {
+        Totals t = verify_crc ? filter_view<true>(frames, read_status) : filter_view<false>(frames, read_status);
+        bench::do_not_optimize(t);
+    });
+    bench::print_throughput("full Raw decode", frames.total_bytes, full_seconds);
+    bench::print_throughput("lazy view", frames.total_bytes, view_seconds);
+    std::printf("        %.1f ns/frame vs %.1f ns/frame, speedup x%.2f\n",
+                full_seconds * 1e9 / kFrames, view_seconds * 1e9 / kFrames, full_seconds / view_seconds);
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    const Frames frames = make_frames();
+    std::printf("%zu frames, %zu bytes\n", kFrames, frames.total_bytes);
+
+    int failures = 0;
+    failures += run_case(frames, "Filter on MessageID (no checksum)", false, false);
+    failures += run_case(frames, "Filter on MessageID + CRC-16 validation", true, false);
+    failures += run_case(frames, "Read field after variable string (offset index, no checksum)", false, true);
+    return failures == 0 ? 0 : 1;
+}
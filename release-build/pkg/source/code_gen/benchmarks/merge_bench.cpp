@@ -0,0 +1,217 @@
+// ============================================================================
+// 多路按时间归并基准（protocol_merge.h）
+// K = 2/4/8/16 路输入共 100 万条 32 字节报文，各路时间戳递增并带局部乱序（相邻交换，< max_delay），
+// 按 64 条一批轮流到达（模拟多链路接收）
+// 1. 常见写法：全部输入共用一个 std::priority_queue，每次按各路低水位线性求安全时间
+// 2. StreamMerger：每路一个有序环形缓冲区 + 两棵胜者树（最早报文 / 低水位）
+// 3. StreamMerger，time_of_day 输入（当天纳秒数，跨零点），含 TimeOfDayPromoter 提升
+// 时间戳全局唯一，逐条核对两种实现的输出顺序（滚动哈希）和条数
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework merge_bench.cpp -o merge_bench
+// ============================================================================
+#include "protocol_merge.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <queue>
+
+using namespace protocol_parser;
+
+namespace {
+
+const size_t kMessages = 1000000;
+const size_t kBatch = 64;
+const uint64_t kMaxDelay = 200000;   // 200 us
+const uint64_t kDayStart = 20000ull * protocol_timestamp::NANOS_PER_DAY;
+
+struct Message {
+    uint64_t timestamp;
+    uint32_t link;
+    uint32_t sequence;
+    uint64_t payload[2];
+};
+
+struct Arrival {
+    uint32_t link;
+    Message message;
+};
+
+// 各路报文按批轮流到达；时间戳全局唯一（i * K + link）
+std::vector<Arrival> make_arrivals(size_t links, uint64_t base) {
+    std::vector<std::vector<Message> > per_link(links);
+    const size_t per = kMessages / links;
+    uint32_t state = 99;
+    for (size_t k = 0; k < links; ++k) {
+        for (size_t i = 0; i < per; ++i) {
+            Message m;
+            m.timestamp = base + (i * links + k) * 1000;   // 平均每路间隔 K us
+            m.link = static_cast<uint32_t>(k);
+            m.sequence = static_cast<uint32_t>(i);
+            m.payload[0] = i;
+            m.payload[1] = k;
+            per_link[k].push_back(m);
+        }
+        for (size_t i = 1; i < per; ++i) {
+            state = state * 1664525u + 1013904223u;
+            if ((state >> 24) % 4 == 0) {
+                std::swap(per_link[k][i], per_link[k][i - 1]);   // 局部乱序
+            }
+        }
+    }
+    std::vector<Arrival> arrivals;
+    arrivals.reserve(per * links);
+    for (size_t i = 0; i < per; i += kBatch) {
+        for (size_t k = 0; k < links; ++k) {
+            for (size_t j = i; j < i + kBatch && j < per; ++j) {
+                Arrival a;
+                a.link = static_cast<uint32_t>(k);
+                a.message = per_link[k][j];
+                arrivals.push_back(a);
+            }
+        }
+    }
+    return arrivals;
+}
+
+struct Digest {
+    uint64_t count;
+    uint64_t hash;
+    uint64_t last;
+    uint64_t order_errors;
+
+    Digest() : count(0), hash(0), last(0), order_errors(0) {}
+
+    void add(uint64_t timestamp) {
+        if (timestamp < last) {
+            ++order_errors;
+        }
+        last = timestamp;
+        hash = hash * 1099511628211ull + timestamp;
+        ++count;
+    }
+};
+
+// 常见写法：全局优先队列 + 线性求安全时间
+struct HeapEntry {
+    uint64_t timestamp;
+    uint32_t link;
+    Message message;
+
+    bool operator<(const HeapEntry& other) const { return timestamp > other.timestamp; }
+};
+
+Digest run_priority_queue(const std::vector<Arrival>& arrivals, size_t links) {
+    Digest digest;
+    std::priority_queue<HeapEntry> heap;
+    std::vector<uint64_t> max_seen(links, 0);
+    for (size_t i = 0; i < arrivals.size(); ++i) {
+        const Arrival& a = arrivals[i];
+        HeapEntry entry;
+        entry.timestamp = a.message.timestamp;
+        entry.link = a.link;
+        entry.message = a.message;
+        heap.push(entry);
+        if (a.message.timestamp > max_seen[a.link]) {
+            max_seen[a.link] = a.message.timestamp;
+        }
+        uint64_t safe = ~0ull;
+        for (size_t k = 0; k < links; ++k) {
+            const uint64_t bound = max_seen[k] > kMaxDelay ? max_seen[k] - kMaxDelay : 0;
+            safe = bound < safe ? bound : safe;
+        }
+        while (!heap.empty() && heap.top().timestamp <= safe) {
+            digest.add(heap.top().timestamp);
+            heap.pop();
+        }
+    }
+    while (!heap.empty()) {
+        digest.add(heap.top().timestamp);
+        heap.pop();
+    }
+    return digest;
+}
+
+Digest run_merger(const std::vector<Arrival>& arrivals, size_t links, bool time_of_day, MergeStats& stats) {
+    Digest digest;
+    MergeInputConfig config;
+    config.window = 4096;
+    config.max_delay = kMaxDelay;
+    config.time_of_day = time_of_day;
+    config.day_start = kDayStart;
+    StreamMerger<Message> merger(links, config);
+    uint64_t promoted_errors = 0;
+    auto sink = [&](const MergedItem<Message>& item) {
+        if (item.timestamp != item.item.timestamp) {
+            ++promoted_errors;
+        }
+        digest.add(item.timestamp);
+    };
+    for (size_t i = 0; i < arrivals.size(); ++i) {
+        const Arrival& a = arrivals[i];
+        const uint64_t timestamp = time_of_day
+            ? (a.message.timestamp - kDayStart) % protocol_timestamp::NANOS_PER_DAY
+            : a.message.timestamp;
+        merger.push(a.link, timestamp, a.message, sink);
+    }
+    merger.flush(sink);
+    stats = merger.stats();
+    digest.order_errors += promoted_errors + stats.late;
+    return digest;
+}
+
+bool check(const char* name, const Digest& digest, const Digest& expected) {
+    if (digest.count != expected.count || digest.hash != expected.hash || digest.order_errors != 0) {
+        std::printf("MISMATCH: %s (count %llu/%llu, order errors %llu)\n", name,
+                    static_cast<unsigned long long>(digest.count), static_cast<unsigned long long>(expected.count),
+                    static_cast<unsigned long long>(digest.order_errors));
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+    const size_t link_counts[] = { 2, 4, 8, 16 };
+    for (size_t c = 0; c < 4; ++c) {
+        const size_t links = link_counts[c];
+        char title[64];
+        std::snprintf(title, sizeof(title), "%zu links, %zu messages", links, kMessages / links * links);
+        bench::print_header(title);
+
+        const std::vector<Arrival> arrivals = make_arrivals(links, 1000000);
+        const Digest expected = run_priority_queue(arrivals, links);
+        if (expected.order_errors != 0) {
+            std::printf("MISMATCH: priority_queue order\n");
+            ++failures;
+        }
+        MergeStats stats;
+        if (!check("StreamMerger", run_merger(arrivals, links, false, stats), expected)) {
+            ++failures;
+        }
+        const double n = static_cast<double>(arrivals.size());
+        const double baseline = bench::measure([&]() {
+            bench::do_not_optimize(run_priority_queue(arrivals, links));
+        }) / n;
+        const double merger = bench::measure([&]() {
+            bench::do_not_optimize(run_merger(arrivals, links, false, stats));
+        }) / n;
+        std::printf("%-28s %12.2f ns/message\n", "priority_queue + scan", baseline * 1e9);
+        std::printf("%-28s %12.2f ns/message  (max buffered %zu, forced %llu)\n", "StreamMerger", merger * 1e9,
+                    stats.max_buffered, static_cast<unsigned long long>(stats.forced));
+
+        // 跨零点：从零点前 0.3 s 开始（各路时间戳为当天纳秒数）
+        const std::vector<Arrival> midnight = make_arrivals(
+            links, kDayStart + protocol_timestamp::NANOS_PER_DAY - 300000000ull);
+        const Digest midnight_expected = run_priority_queue(midnight, links);
+        if (!check("StreamMerger time_of_day", run_merger(midnight, links, true, stats), midnight_expected)) {
+            ++failures;
+        }
+        const double promoted = bench::measure([&]() {
+            bench::do_not_optimize(run_merger(midnight, links, true, stats));
+        }) / n;
+        std::printf("%-28s %12.2f ns/message  (rollovers %llu)\n", "StreamMerger time_of_day", promoted * 1e9,
+                    static_cast<unsigned long long>(stats.rollovers));
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,269 @@
+// ============================================================================
+// 多核解码流水线基准：单线程（分帧 + 解码在调用线程）vs DecodePipeline（1..N 个解码线程）
+// 帧格式：EB 90 | 帧长(2B 大端) | MessageID(2B) | 流内序号(4B) | 10~50 个 uint32 字段 | CRC-32(4B)
+// 解码：校验 CRC-32 后逐字段读取（模拟分发器解码的开销），1% 的帧 CRC 错误
+// 4 个内存字节源（4 条流），按 1460B 分段读取；ordered 模式下校验每条流的输出顺序
+// 编译: g++ -std=c++11 -O2 -pthread -I../protocol_parser_framework pipeline_bench.cpp -o pipeline_bench
+// ============================================================================
+#include "protocol_pipeline.h"
+#include "protocol_checksum.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <thread>
+
+using namespace protocol_parser;
+
+namespace {
+
+const uint8_t kSync[2] = { 0xEB, 0x90 };
+const size_t kStreams = 4;
+const size_t kFramesPerStream = 25000;
+
+struct DecodedFrame {
+    uint16_t message_id;
+    uint32_t sequence;
+    uint64_t sum;
+};
+
+FrameSpec make_spec() {
+    FrameSpec spec = { kSync, 2, 2, 2, BIG_ENDIAN, 0, 0, 1024 };
+    return spec;
+}
+
+Checksum_CRC<uint32_t> make_crc32() {
+    Checksum_CRC<uint32_t> crc(0x04C11DB7UL);
+    crc.set_init(0xFFFFFFFFUL);
+    crc.set_xor_out(0xFFFFFFFFUL);
+    crc.set_ref_in(true);
+    crc.set_ref_out(true);
+    return crc;
+}
+
+struct Decoder {
+    Checksum_CRC<uint32_t> crc;
+
+    Decoder() : crc(make_crc32()) {}
+
+    DeserializeStatus operator()(const uint8_t* data, size_t length, DecodedFrame& result) {
+        if (length < 14) {
+            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Frame too short", length);
+        }
+        const uint32_t expected = read_fixed_order<LITTLE_ENDIAN, uint32_t>(data + length - 4);
+        if (static_cast<uint32_t>(crc.calculate(data, length - 4)) != expected) {
+            return DeserializeStatus::failure(INVALID_CHECKSUM, "CRC mismatch", length - 4);
+        }
+        result.message_id = read_fixed_order<BIG_ENDIAN, uint16_t>(data + 4);
+        result.sequence = read_fixed_order<BIG_ENDIAN, uint32_t>(data + 6);
+        uint64_t sum = 0;
+        for (size_t offset = 10; offset + 4 <= length - 4; offset += 4) {
+            sum += read_fixed_order<BIG_ENDIAN, uint32_t>(data + offset);
+        }
+        result.sum = sum;
+        return DeserializeStatus::success(length);
+    }
+};
+
+struct Expected {
+    uint64_t decoded;
+    uint64_t failed;
+    uint64_t sum;
+};
+
+std::vector<uint8_t> make_stream(uint32_t seed, Expected& expected) {
+    Checksum_CRC<uint32_t> crc = make_crc32();
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> frame;
+    uint32_t state = seed;
+    for (uint32_t seq = 0; seq < kFramesPerStream; ++seq) {
+        state = state * 1664525u + 1013904223u;
+        const size_t field_count = 10 + (state >> 8) % 41;
+        const size_t length = 10 + field_count * 4 + 4;
+        frame.assign(length, 0);
+        frame[0] = kSync[0];
+        frame[1] = kSync[1];
+        write_fixed_order<BIG_ENDIAN, uint16_t>(frame.data() + 2, static_cast<uint16_t>(length));
+        write_fixed_order<BIG_ENDIAN, uint16_t>(frame.data() + 4, static_cast<uint16_t>(state >> 20));
+        write_fixed_order<BIG_ENDIAN, uint32_t>(frame.data() + 6, seq);
+        uint64_t sum = 0;
+        for (size_t f = 0; f < field_count; ++f) {
+            state = state * 1664525u + 1013904223u;
+            write_fixed_order<BIG_ENDIAN, uint32_t>(frame.data() + 10 + f * 4, state);
+            sum += state;
+        }
+        uint32_t checksum = static_cast<uint32_t>(crc.calculate(frame.data(), length - 4));
+        if ((state >> 4) % 100 == 0) {
+            checksum ^= 1;  // 1% CRC 错误
+            ++expected.failed;
+        } else {
+            ++expected.decoded;
+            expected.sum += sum;
+        }
+        write_fixed_order<LITTLE_ENDIAN, uint32_t>(frame.data() + length - 4, checksum);
+        bytes.insert(bytes.end(), frame.begin(), frame.end());
+    }
+    return bytes;
+}
+
+struct Totals {
+    uint64_t decoded;
+    uint64_t failed;
+    uint64_t sum;
+    uint64_t order_errors;
+};
+
+// 基线：调用线程上分帧 + 解码
+Totals run_inline(const std::vector<std::vector<uint8_t> >& streams) {
+    Totals totals = { 0, 0, 0, 0 };
+    Decoder decode;
+    DecodedFrame result;
+    StreamFramer framer(make_spec());
+    for (size_t s = 0; s < streams.size(); ++s) {
+        framer.reset();
+        MemorySource source(streams[s].data(), streams[s].size(), 1460);
+        for (;;) {
+            size_t available = 0;
+            uint8_t* area = framer.write_area(available);
+            const size_t n = source.read(area, available);
+            if (n == 0) {
+                break;
+            }
+            framer.commit(n);
+            framer.drain([&](const FrameSpan& frame) {
+                if (decode(frame.data, frame.length, result).is_success()) {
+                    ++totals.decoded;
+                    totals.sum += result.sum;
+                } else {
+                    ++totals.failed;
+                }
+                return true;
+            });
+        }
+    }
+    return totals;
+}
+
+Totals run_pipeline(const std::vector<std::vector<uint8_t> >& streams, const PipelineConfig& config) {
+    Totals totals = { 0, 0, 0, 0 };
+    std::vector<std::unique_ptr<MemorySource> > owned;
+    std::vector<ByteSource*> sources;
+    for (size_t s = 0; s < streams.size(); ++s) {
+        owned.push_back(std::unique_ptr<MemorySource>(new MemorySource(streams[s].data(), streams[s].size(), 1460)));
+        sources.push_back(owned.back().get());
+    }
+    std::vector<uint64_t> next_sequence(streams.size(), 0);
+
+    DecodePipeline<DecodedFrame> pipeline(make_spec(), config);
+    pipeline.run(sources.data(), sources.size(), Decoder(), [&](const PipelineItem<DecodedFrame>& item) {
+        if (config.ordered) {
+            // 帧内序号与流内到达序号一致（无丢帧），逐条核对输出顺序
+            const uint32_t wire_sequence = read_fixed_order<BIG_ENDIAN, uint32_t>(item.frame.data() + 6);
+            if (item.sequence != next_sequence[item.stream]++ || wire_sequence != item.sequence) {
+                ++totals.order_errors;
+            }
+        }
+        if (item.status.is_success()) {
+            ++totals.decoded;
+            totals.sum += item.result.sum;
+        } else {
+            ++totals.failed;
+        }
+    });
+    return totals;
+}
+
+bool check(const char* name, const Totals& totals, const Expected& expected) {
+    if (totals.decoded != expected.decoded || totals.failed != expected.failed ||
+        totals.sum != expected.sum || totals.order_errors != 0) {
+        std::printf("MISMATCH: %s (decoded %llu/%llu, failed %llu/%llu, order errors %llu)\n", name,
+                    static_cast<unsigned long long>(totals.decoded), static_cast<unsigned long long>(expected.decoded),
+                    static_cast<unsigned long long>(totals.failed), static_cast<unsigned long long>(expected.failed),
+                    static_cast<unsigned long long>(totals.order_errors));
+        return false;
+    }
+    return true;
+}
+
+void print_rate(const char* name, size_t bytes, size_t frames, double seconds, double baseline) {
+    bench::print_throughput(name, bytes, seconds);
+    std::printf("        %.2f Mframes/s, speedup x%.2f\n", frames / seconds / 1e6, baseline / seconds);
+}
+
+} // namespace
+
+int main() {
+    Expected expected = { 0, 0, 0 };
+    std::vector<std::vector<uint8_t> > streams;
+    size_t total_bytes = 0;
+    for (size_t s = 0; s < kStreams; ++s) {
+        streams.push_back(make_stream(static_cast<uint32_t>(s * 7919 + 1), expected));
+        total_bytes += streams.back().size();
+    }
+    const size_t total_frames = kStreams * kFramesPerStream;
+    int failures = 0;
+
+    const unsigned hardware = std::thread::hardware_concurrency();
+    std::printf("hardware threads: %u, %zu streams, %zu frames, %zu bytes\n",
+                hardware, kStreams, total_frames, total_bytes);
+
+    bench::print_header("Single thread (framer + decode inline)");
+    if (!check("inline", run_inline(streams), expected)) {
+        ++failures;
+    }
+    const double baseline = bench::measure([&]() {
+        Totals t = run_inline(streams);
+        bench::do_not_optimize(t);
+    });
+    print_rate("inline", total_bytes, total_frames, baseline, baseline);
+
+    // 解码线程数 1, 2, 4 ... 直到硬件线程数（接收、输出各占一个线程）
+    const size_t max_workers = hardware > 2 ? hardware - 2 : 1;
+    std::vector<size_t> worker_counts;
+    for (size_t w = 1; w <= max_workers; w *= 2) {
+        worker_counts.push_back(w);
+    }
+    if (worker_counts.back() != max_workers) {
+        worker_counts.push_back(max_workers);
+    }
+    if (hardware <= 2) {
+        worker_counts.push_back(2);  // 核数不足时仍验证多线程结果（超额订阅，无加速）
+    }
+
+    const WorkQueueMode modes[] = { WORK_QUEUE_SPSC, WORK_QUEUE_MPMC };
+    for (size_t m = 0; m < 2; ++m) {
+        for (int ordered = 1; ordered >= 0; --ordered) {
+            char title[64];
+            std::snprintf(title, sizeof(title), "Pipeline %s, %s", modes[m] == WORK_QUEUE_SPSC ? "SPSC" : "MPMC",
+                          ordered ? "ordered" : "unordered");
+            bench::print_header(title);
+            for (size_t i = 0; i < worker_counts.size(); ++i) {
+                PipelineConfig config;
+                config.workers = worker_counts[i];
+                config.work_queue = modes[m];
+                config.ordered = ordered != 0;
+                config.read_chunk = 1460;
+                // 接收线程绑定 CPU 0，解码线程依次绑定 1..N（硬件线程不足时不绑定）
+                if (hardware >= config.workers + 2) {
+                    config.ingest_cpu = 0;
+                    config.output_cpu = static_cast<int>(config.workers + 1);
+                    for (size_t w = 0; w < config.workers; ++w) {
+                        config.worker_cpus.push_back(static_cast<int>(w + 1));
+                    }
+                }
+
+                char name[64];
+                std::snprintf(name, sizeof(name), "workers %zu", config.workers);
+                if (!check(name, run_pipeline(streams, config), expected)) {
+                    ++failures;
+                    continue;
+                }
+                const double seconds = bench::measure([&]() {
+                    Totals t = run_pipeline(streams, config);
+                    bench::do_not_optimize(t);
+                });
+                print_rate(name, total_bytes, total_frames, seconds, baseline);
+            }
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
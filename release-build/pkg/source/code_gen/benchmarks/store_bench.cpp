@@ -0,0 +1,235 @@
+// ============================================================================
+// 解码结果存储基准（protocol_store.h）
+// 1. 追加：4 种报文类型交替写入 200 万条 48 字节定长记录（时间戳递增），输出每条耗时与写入带宽
+// 2. 时间范围查询：单一类型上随机 1 ms 窗口（约 125 条记录），稀疏索引（4KB 间隔）vs 无索引
+//    （每段只有首项，从段首顺序扫描），并与写入时保存的参考结果核对条数
+// 3. 另一线程持续追加时的查询（读取方 refresh + 查询最近 1 ms）
+// 数据写入临时目录，运行结束后删除
+// 编译: g++ -std=c++11 -O2 -pthread -I../protocol_parser_framework store_bench.cpp -o store_bench
+// ============================================================================
+#include "protocol_store.h"
+#include "bench_common.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace protocol_parser;
+
+namespace {
+
+const size_t kRecords = 2000000;
+const uint32_t kTypes = 4;
+const uint64_t kStepNs = 2000;          // 相邻记录时间间隔（全部类型合计）
+const uint64_t kWindowNs = 1000000;     // 查询窗口 1 ms
+
+struct BenchRecord {
+    uint64_t timestamp;
+    uint32_t sequence;
+    uint16_t message_id;
+    uint16_t flags;
+    int32_t value[8];
+};
+
+void remove_directory(const std::string& directory) {
+    std::string command = "rm -rf '" + directory + "'";
+    if (std::system(command.c_str()) != 0) {
+        std::printf("warning: cannot remove %s\n", directory.c_str());
+    }
+}
+
+bool write_store(const std::string& directory, const SegmentStoreConfig& config, double& seconds) {
+    SegmentStoreWriter writer;
+    std::string error;
+    if (!writer.open(directory, error, config)) {
+        std::printf("open failed: %s\n", error.c_str());
+        return false;
+    }
+    BenchRecord record;
+    std::memset(&record, 0, sizeof(record));
+    const double start = bench::now_seconds();
+    for (size_t i = 0; i < kRecords; ++i) {
+        record.timestamp = i * kStepNs;
+        record.sequence = static_cast<uint32_t>(i);
+        record.message_id = static_cast<uint16_t>(i % kTypes);
+        record.value[i % 8] = static_cast<int32_t>(i);
+        if (!writer.append_record(record.message_id, record.timestamp, record)) {
+            std::printf("append failed: %s\n", writer.error().c_str());
+            return false;
+        }
+    }
+    seconds = bench::now_seconds() - start;
+    return true;
+}
+
+// 类型 0 在 [begin, end] 内的参考条数（时间戳 = 序号 * kStepNs，序号为 kTypes 的倍数）
+uint64_t expected_count(uint64_t begin, uint64_t end) {
+    const uint64_t period = kStepNs * kTypes;
+    const uint64_t last = (kRecords - 1) / kTypes * period;
+    if (begin > last) {
+        return 0;
+    }
+    if (end > last) {
+        end = last;
+    }
+    const uint64_t first = (begin + period - 1) / period;
+    return end / period >= first ? end / period - first + 1 : 0;
+}
+
+int run_queries(const char* name, const std::string& directory) {
+    SegmentStoreReader reader;
+    std::string error;
+    if (!reader.open(directory, error)) {
+        std::printf("open failed: %s\n", error.c_str());
+        return 1;
+    }
+    const uint64_t span = kRecords * kStepNs;
+    const size_t kQueries = 1000;
+    std::vector<uint64_t> begins(kQueries);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < kQueries; ++i) {
+        state = state * 1664525u + 1013904223u;
+        begins[i] = static_cast<uint64_t>(state) * (span - kWindowNs) / 0xFFFFFFFFull;
+    }
+    uint64_t total = 0;
+    for (size_t i = 0; i < kQueries; ++i) {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        reader.query(0, begins[i], begins[i] + kWindowNs, [&](const StoredRecord& record) {
+            BenchRecord value;
+            if (record.read_as(value)) {
+                sum += value.sequence;
+            }
+            ++count;
+            return true;
+        });
+        if (count != expected_count(begins[i], begins[i] + kWindowNs)) {
+            std::printf("MISMATCH: %s query %zu returned %llu records\n", name, i,
+                        static_cast<unsigned long long>(count));
+            return 1;
+        }
+        total += count + (sum & 1);
+    }
+    const double seconds = bench::measure([&]() {
+        uint64_t records = 0;
+        for (size_t i = 0; i < kQueries; ++i) {
+            records += reader.query(0, begins[i], begins[i] + kWindowNs, [](const StoredRecord&) { return true; });
+        }
+        bench::do_not_optimize(records);
+    }) / kQueries;
+    std::printf("%-28s %12.2f us/query  (%.1f records/query)\n", name, seconds * 1e6,
+                static_cast<double>(total) / kQueries);
+    return 0;
+}
+
+int run_concurrent(const std::string& directory, const SegmentStoreConfig& config) {
+    SegmentStoreWriter writer;
+    std::string error;
+    if (!writer.open(directory, error, config)) {
+        std::printf("open failed: %s\n", error.c_str());
+        return 1;
+    }
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> written(0);
+    std::thread producer([&]() {
+        BenchRecord record;
+        std::memset(&record, 0, sizeof(record));
+        for (size_t i = 0; i < kRecords; ++i) {
+            record.timestamp = i * kStepNs;
+            record.sequence = static_cast<uint32_t>(i);
+            writer.append_record(0, record.timestamp, record);
+            written.store(i + 1, std::memory_order_release);
+        }
+        done.store(true);
+    });
+
+    SegmentStoreReader reader;
+    while (!reader.open(directory, error)) {
+        std::this_thread::yield();
+    }
+    uint64_t queries = 0;
+    uint64_t errors = 0;
+    const double start = bench::now_seconds();
+    while (!done.load()) {
+        // 先读写入计数再 refresh：refresh 之后映射的段必然覆盖计数之前的全部记录
+        // （反过来写入方可能在两次调用之间新开一段，读取方尚未映射却已计入 visible）
+        const uint64_t visible = written.load(std::memory_order_acquire);
+        reader.refresh();
+        if (visible == 0) {
+            continue;
+        }
+        // 写入计数之前的记录必然已发布：最近 1 ms 内至少应查到这些
+        const uint64_t end = (visible - 1) * kStepNs;
+        const uint64_t begin = end > kWindowNs ? end - kWindowNs : 0;
+        uint32_t next = static_cast<uint32_t>(begin / kStepNs + (begin % kStepNs != 0));
+        reader.query(0, begin, end, [&](const StoredRecord& record) {
+            BenchRecord value;
+            if (!record.read_as(value) || value.sequence != next) {
+                ++errors;
+            }
+            ++next;
+            return true;
+        });
+        if (next != static_cast<uint32_t>(end / kStepNs + 1)) {
+            ++errors;
+        }
+        ++queries;
+    }
+    const double elapsed = bench::now_seconds() - start;
+    producer.join();
+    if (errors != 0) {
+        std::printf("MISMATCH: %llu errors in concurrent queries\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    std::printf("%-28s %12.2f us/query  (%llu queries while writing)\n", "query during append",
+                elapsed * 1e6 / (queries > 0 ? queries : 1), static_cast<unsigned long long>(queries));
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    char pattern[] = "/tmp/store_bench_XXXXXX";
+    const char* root = mkdtemp(pattern);
+    if (root == nullptr) {
+        std::printf("cannot create temporary directory\n");
+        return 1;
+    }
+    const std::string indexed = std::string(root) + "/indexed";
+    const std::string unindexed = std::string(root) + "/unindexed";
+    const std::string concurrent = std::string(root) + "/concurrent";
+    int failures = 0;
+
+    SegmentStoreConfig config;
+    config.segment_size = 64u << 20;
+    SegmentStoreConfig no_index = config;
+    no_index.index_stride = static_cast<uint32_t>(config.segment_size);   // 每段只有首项
+
+    bench::print_header("append 48 B records, 4 types");
+    double seconds = 0.0;
+    if (write_store(indexed, config, seconds)) {
+        std::printf("%-28s %12.2f ns/record  %8.1f MB/s\n", "indexed (4KB stride)", seconds * 1e9 / kRecords,
+                    kRecords * store_detail::record_size(sizeof(BenchRecord)) / seconds / 1e6);
+    } else {
+        ++failures;
+    }
+    if (write_store(unindexed, no_index, seconds)) {
+        std::printf("%-28s %12.2f ns/record  %8.1f MB/s\n", "no index", seconds * 1e9 / kRecords,
+                    kRecords * store_detail::record_size(sizeof(BenchRecord)) / seconds / 1e6);
+    } else {
+        ++failures;
+    }
+
+    bench::print_header("time range query, one type, 1 ms window");
+    if (failures == 0) {
+        failures += run_queries("sparse index", indexed);
+        failures += run_queries("scan from segment start", unindexed);
+    }
+
+    bench::print_header("single writer + reader");
+    failures += run_concurrent(concurrent, config);
+
+    remove_directory(root);
+    return failures == 0 ? 0 : 1;
+}
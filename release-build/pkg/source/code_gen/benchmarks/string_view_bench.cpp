@@ -0,0 +1,200 @@
+// ============================================================================
+// 零拷贝视图基准：std::string 字段 vs StringView / BCD 整数 / 定长字符数组
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework string_view_bench.cpp -o string_view_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace protocol_parser;
+
+// ============================================================================
+// 堆分配计数（替换全局 operator new，统计每帧分配次数）
+// ============================================================================
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    void* ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+// ============================================================================
+// 测试报文：定长字符串(24) + 变长字符串 + BCD(6 字节) + BCD(10 字节) + 2 个编码字段
+// 字符串长度均超过常见 SSO 容量(15)，反映真实网关报文
+// ============================================================================
+const size_t kNameLength = 24;
+const size_t kCodeBytes = 6;
+const size_t kImsiBytes = 10;
+
+const char* mode_meaning(uint8_t value) {
+    switch (value) {
+        case 0: return "Standby - waiting for command";
+        case 1: return "Tracking - target locked on";
+        case 2: return "Maintenance - self test running";
+        default: return "Unknown";
+    }
+}
+
+// 默认模式：Business 结构体持有 std::string
+struct OwnedResult {
+    std::string name;
+    std::string route;
+    std::string code;
+    std::string imsi;
+    uint8_t mode_value;
+    std::string mode_meaning;
+    uint8_t state_value;
+    std::string state_meaning;
+};
+
+// 零拷贝视图模式：字符串指向输入缓冲区，BCD 为整数/定长数组，含义为静态字符串
+struct ViewResult {
+    StringView name;
+    StringView route;
+    uint64_t code;
+    BcdChars<kImsiBytes * 2> imsi;
+    uint8_t mode_value;
+    const char* mode_meaning;
+    uint8_t state_value;
+    const char* state_meaning;
+};
+
+std::vector<uint8_t> make_frame() {
+    std::vector<uint8_t> frame;
+    const char* name = "GW-NODE-SHANGHAI-PUDONG-A";
+    frame.insert(frame.end(), name, name + kNameLength);
+    const char* route = "uplink/sat-7/beam-12/channel-03";
+    frame.insert(frame.end(), route, route + std::strlen(route) + 1);
+    const uint8_t code[kCodeBytes] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0x01 };
+    frame.insert(frame.end(), code, code + kCodeBytes);
+    const uint8_t imsi[kImsiBytes] = { 0x46, 0x00, 0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x23, 0x45 };
+    frame.insert(frame.end(), imsi, imsi + kImsiBytes);
+    frame.push_back(1);
+    frame.push_back(2);
+    return frame;
+}
+
+bool parse_owned(const uint8_t* data, size_t length, OwnedResult& out) {
+    DeserializeContext ctx(data, length, BIG_ENDIAN);
+    if (!deserialize_string_generic(ctx, out.name, kNameLength, "ASCII")) return false;
+    if (!deserialize_string_generic(ctx, out.route, 0, "ASCII")) return false;
+    if (!deserialize_bcd_generic(ctx, out.code, kCodeBytes)) return false;
+    if (!deserialize_bcd_generic(ctx, out.imsi, kImsiBytes)) return false;
+    if (!deserialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, out.mode_value)) return false;
+    out.mode_meaning = mode_meaning(out.mode_value);
+    if (!deserialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, out.state_value)) return false;
+    out.state_meaning = mode_meaning(out.state_value);
+    return true;
+}
+
+bool parse_view(const uint8_t* data, size_t length, ViewResult& out) {
+    DeserializeContext ctx(data, length, BIG_ENDIAN);
+    if (!deserialize_string_view(ctx, out.name, kNameLength)) return false;
+    if (!deserialize_string_view(ctx, out.route, 0)) return false;
+    if (!deserialize_bcd_uint(ctx, out.code, kCodeBytes)) return false;
+    if (!deserialize_bcd_chars(ctx, out.imsi)) return false;
+    if (!deserialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, out.mode_value)) return false;
+    out.mode_meaning = mode_meaning(out.mode_value);
+    if (!deserialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, out.state_value)) return false;
+    out.state_meaning = mode_meaning(out.state_value);
+    return true;
+}
+
+// 解析后原样转发（网关场景）
+template<typename Result>
+bool forward(const Result& in, uint8_t* buffer, size_t size);
+
+template<>
+bool forward<OwnedResult>(const OwnedResult& in, uint8_t* buffer, size_t size) {
+    SerializeContext ctx(buffer, size, BIG_ENDIAN);
+    return serialize_string_generic(ctx, in.name, kNameLength, "ASCII") &&
+           serialize_string_generic(ctx, in.route, 0, "ASCII") &&
+           serialize_bcd_generic(ctx, in.code, kCodeBytes) &&
+           serialize_bcd_generic(ctx, in.imsi, kImsiBytes) &&
+           serialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, in.mode_value) &&
+           serialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, in.state_value);
+}
+
+template<>
+bool forward<ViewResult>(const ViewResult& in, uint8_t* buffer, size_t size) {
+    SerializeContext ctx(buffer, size, BIG_ENDIAN);
+    return serialize_string_view(ctx, in.name, kNameLength) &&
+           serialize_string_view(ctx, in.route, 0) &&
+           serialize_bcd_uint(ctx, in.code, kCodeBytes) &&
+           serialize_bcd_chars(ctx, in.imsi) &&
+           serialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, in.mode_value) &&
+           serialize_unsigned_int_fixed<BIG_ENDIAN>(ctx, in.state_value);
+}
+
+template<typename Result, typename Parser>
+int run_case(const char* name, Parser parser, const std::vector<uint8_t>& frame) {
+    std::vector<uint8_t> out(frame.size());
+
+    // 正确性：解析后转发应与输入逐字节一致
+    {
+        Result result;
+        if (!parser(frame.data(), frame.size(), result) ||
+            !forward(result, out.data(), out.size()) ||
+            std::memcmp(out.data(), frame.data(), frame.size()) != 0) {
+            std::printf("MISMATCH: %s\n", name);
+            return 1;
+        }
+    }
+
+    // 每帧分配次数（每帧新建结果对象，与生成代码中 Facade 的用法一致）
+    const size_t before = g_allocations;
+    {
+        Result result;
+        parser(frame.data(), frame.size(), result);
+        forward(result, out.data(), out.size());
+    }
+    const size_t allocations = g_allocations - before;
+
+    const double parse_seconds = bench::measure([&]() {
+        Result result;
+        bool ok = parser(frame.data(), frame.size(), result);
+        bench::do_not_optimize(ok);
+        bench::do_not_optimize(result);
+    });
+    const double round_trip_seconds = bench::measure([&]() {
+        Result result;
+        bool ok = parser(frame.data(), frame.size(), result) &&
+                  forward(result, out.data(), out.size());
+        bench::do_not_optimize(ok);
+        bench::do_not_optimize(out);
+    });
+
+    std::printf("%-24s parse %8.1f ns | parse+forward %8.1f ns | %zu allocs/frame\n",
+                name, parse_seconds * 1e9, round_trip_seconds * 1e9, allocations);
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<uint8_t> frame = make_frame();
+    std::printf("frame: %zu bytes (2 strings, 2 BCD, 2 encoded fields)\n", frame.size());
+
+    bench::print_header("Per-frame decode");
+    int failures = 0;
+    failures += run_case<OwnedResult>("std::string fields", parse_owned, frame);
+    failures += run_case<ViewResult>("zero-copy views", parse_view, frame);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+/**
+ * 基准套件的合成协议
+ *
+ * 每个协议代表一类典型报文形态，配置与正式协议一样交给 nodegen 生成代码：
+ * - fixed_layout：全部为定长整数/浮点，走全静态布局快速路径
+ * - bitfield_heavy：7 个 1~4 字节位域（每个 4~10 个位段）与编码字段
+ * - string_heavy：定长/变长字符串与 BCD 字段
+ * - array_heavy：定长、按计数字段确定长度和延伸到尾部字段之前的标量数组
+ * - dispatcher_200：200 种 MessageID（稀疏取值）的分发器，表驱动查找
+ */
+
+/**
+ * 定长字段（线上 48 字节）
+ */
+function fixedLayout() {
+    const fields = [
+        { type: 'UnsignedInt', fieldName: 'sync', byteLength: 2 },
+        { type: 'UnsignedInt', fieldName: 'length', byteLength: 2 },
+        { type: 'UnsignedInt', fieldName: 'sequence', byteLength: 4 }
+    ];
+    for (let i = 0; i < 6; i++) {
+        fields.push({ type: 'SignedInt', fieldName: `channel${i}`, byteLength: 2 });
+    }
+    for (let i = 0; i < 4; i++) {
+        fields.push({ type: 'Float', fieldName: `value${i}`, precision: 'float' });
+    }
+    fields.push({ type: 'Float', fieldName: 'position', precision: 'double' });
+    fields.push({ type: 'UnsignedInt', fieldName: 'status', byteLength: 4, byteOrder: 'little' });
+    return { name: 'SuiteFixedLayout', defaultByteOrder: 'big', fields };
+}
+
+/**
+ * 位域密集（线上 18 字节）
+ */
+function bitfieldHeavy() {
+    const fields = [
+        { type: 'UnsignedInt', fieldName: 'sync', byteLength: 2 }
+    ];
+    const widths = [1, 2, 1, 4, 2, 1, 4];
+    widths.forEach((byteLength, index) => {
+        const totalBits = byteLength * 8;
+        const subFields = [];
+        let start = 0;
+        let sub = 0;
+        while (start < totalBits) {
+            const width = Math.min(totalBits - start, [1, 3, 2, 5, 7][sub % 5]);
+            subFields.push({ name: `f${sub}`, startBit: start, endBit: start + width - 1 });
+            start += width;
+            sub++;
+        }
+        fields.push({ type: 'Bitfield', fieldName: `flags${index}`, byteLength, subFields });
+    });
+    fields.push({
+        type: 'Encode', fieldName: 'mode', byteLength: 1,
+        maps: [{ value: 0, meaning: 'idle' }, { value: 1, meaning: 'run' }, { value: 2, meaning: 'fault' }]
+    });
+    return { name: 'SuiteBitfieldHeavy', defaultByteOrder: 'big', fields };
+}
+
+/**
+ * 字符串密集（定长 8/16/32 字节、变长 '\0' 结尾、BCD）
+ */
+function stringHeavy() {
+    return {
+        name: 'SuiteStringHeavy',
+        defaultByteOrder: 'big',
+        fields: [
+            { type: 'UnsignedInt', fieldName: 'sync', byteLength: 2 },
+            { type: 'String', fieldName: 'callsign', length: 8 },
+            { type: 'String', fieldName: 'station', length: 16 },
+            { type: 'String', fieldName: 'operatorName', length: 32 },
+            { type: 'Bcd', fieldName: 'serial', byteLength: 6 },
+            { type: 'String', fieldName: 'note', length: 0 },
+            { type: 'Bcd', fieldName: 'date', byteLength: 4 },
+            { type: 'String', fieldName: 'remark', length: 0 },
+            { type: 'UnsignedInt', fieldName: 'trailer', byteLength: 2 }
+        ]
+    };
+}
+
+/**
+ * 数组密集（定长 uint16 / int32 / float 数组、按计数字段确定长度的数组，
+ * 以及延伸到尾部字段之前、元素为小端 uint32 的数组）
+ */
+function arrayHeavy() {
+    return {
+        name: 'SuiteArrayHeavy',
+        defaultByteOrder: 'big',
+        fields: [
+            { type: 'UnsignedInt', fieldName: 'sync', byteLength: 2 },
+            { type: 'UnsignedInt', fieldName: 'sampleCount', byteLength: 2 },
+            { type: 'Array', fieldName: 'samples', countFromField: 'sampleCount', element: { type: 'SignedInt', byteLength: 2 } },
+            { type: 'Array', fieldName: 'gains', count: 16, element: { type: 'UnsignedInt', byteLength: 2 } },
+            { type: 'Array', fieldName: 'offsets', count: 16, element: { type: 'SignedInt', byteLength: 4 } },
+            { type: 'Array', fieldName: 'spectrum', count: 32, element: { type: 'Float', precision: 'float' } },
+            { type: 'Array', fieldName: 'history', bytesInTrailer: 2, element: { type: 'UnsignedInt', byteLength: 4, byteOrder: 'little' } },
+            { type: 'UnsignedInt', fieldName: 'trailer', byteLength: 2 }
+        ]
+    };
+}
+
+/**
+ * 分发器：200 个子协议，MessageID 为稀疏 16 位取值（第 2~3 字节，大端）
+ * 子协议按 4 种形态轮换（纯整数 / 带位域 / 带字符串 / 带浮点），长度 12~40 字节
+ */
+function dispatcher200() {
+    const messages = {};
+    for (let i = 0; i < 200; i++) {
+        const id = (0x0101 + i * 0x0137) & 0xFFFF;
+        const name = `SuiteMsg${String(i).padStart(3, '0')}`;
+        const fields = [
+            { type: 'UnsignedInt', fieldName: 'sync', byteLength: 2 },
+            { type: 'MessageId', fieldName: 'msgId', byteLength: 2, messageIdValue: id },
+            { type: 'UnsignedInt', fieldName: 'sequence', byteLength: 4 }
+        ];
+        switch (i % 4) {
+            case 0:
+                for (let k = 0; k < 4 + i % 5; k++) {
+                    fields.push({ type: 'UnsignedInt', fieldName: `v${k}`, byteLength: 4 });
+                }
+                break;
+            case 1:
+                fields.push({
+                    type: 'Bitfield', fieldName: 'state', byteLength: 2,
+                    subFields: [
+                        { name: 'mode', startBit: 0, endBit: 3 },
+                        { name: 'level', startBit: 4, endBit: 10 },
+                        { name: 'alarm', startBit: 11, endBit: 15 }
+                    ]
+                });
+                fields.push({ type: 'SignedInt', fieldName: 'delta', byteLength: 2 });
+                break;
+            case 2:
+                fields.push({ type: 'String', fieldName: 'tag', length: 12 });
+                fields.push({ type: 'UnsignedInt', fieldName: 'count', byteLength: 2 });
+                break;
+            default:
+                fields.push({ type: 'Float', fieldName: 'x', precision: 'float' });
+                fields.push({ type: 'Float', fieldName: 'y', precision: 'float' });
+                fields.push({ type: 'Float', fieldName: 'z', precision: 'double' });
+                break;
+        }
+        messages[`0x${id.toString(16).toUpperCase().padStart(4, '0')}`] = { name, defaultByteOrder: 'big', fields };
+    }
+    return {
+        protocolName: 'SuiteDispatch',
+        dispatch: { field: 'msgId', type: 'MessageId', byteOrder: 'big', offset: 2, size: 2, lookup: 'table' },
+        messages
+    };
+}
+
+/**
+ * 套件中的全部协议
+ * @returns {Array<{ id: string, kind: 'protocol' | 'dispatcher', config: Object }>}
+ */
+export function buildSuiteProtocols() {
+    return [
+        { id: 'fixed_layout', kind: 'protocol', config: fixedLayout() },
+        { id: 'bitfield_heavy', kind: 'protocol', config: bitfieldHeavy() },
+        { id: 'string_heavy', kind: 'protocol', config: stringHeavy() },
+        { id: 'array_heavy', kind: 'protocol', config: arrayHeavy() },
+        { id: 'dispatcher_200', kind: 'dispatcher', config: dispatcher200() }
+    ];
+}
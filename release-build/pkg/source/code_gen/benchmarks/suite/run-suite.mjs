@@ -0,0 +1,544 @@
+#!/usr/bin/env node
+/**
+ * 生成代码基准套件
+ *
+ * 流程：
+ * 1. protocols.mjs 中的合成协议交给 nodegen 生成 C++ 解析器（输出到 build/<协议>/）
+ * 2. 为每个协议生成驱动程序：构造确定性的业务层报文，序列化为语料并做往返校验，
+ *    再分别计时反序列化、序列化、CRC-32 校验（分发器另测表驱动解码）
+ * 3. 编译、运行，汇总为 JSON（ns/报文、字节/秒、堆分配次数/报文）
+ * 4. 可与保存的基线比较，耗时增加超过阈值或分配次数增加时以退出码 1 结束
+ *
+ * 用法：
+ *   node run-suite.mjs [--only fixed_layout,dispatcher_200] [--cxx g++] [--cxxflags "-O2 -march=native"]
+ *                      [--min-seconds 0.1] [--repeats 5] [--out results.json]
+ *                      [--save-baseline baseline.json] [--baseline baseline.json] [--threshold 0.10]
+ */
+
+import { spawnSync } from 'child_process';
+import { existsSync, mkdirSync, readFileSync, readdirSync, rmSync, writeFileSync } from 'fs';
+import os from 'os';
+import path from 'path';
+import { fileURLToPath, pathToFileURL } from 'url';
+import { parseArgs } from 'util';
+
+import { buildSuiteProtocols } from './protocols.mjs';
+
+const SUITE_DIR = path.dirname(fileURLToPath(import.meta.url));
+const CODE_GEN_DIR = path.resolve(SUITE_DIR, '../..');
+const NODEGEN_DIR = path.join(CODE_GEN_DIR, 'nodegen');
+const FRAMEWORK_DIR = path.join(CODE_GEN_DIR, 'protocol_parser_framework');
+const BUILD_DIR = path.join(SUITE_DIR, 'build');
+
+const nodegenModule = file => pathToFileURL(path.join(NODEGEN_DIR, file)).href;
+
+const RESULT_SCHEMA = 'protocol-parser-bench-suite/1';
+
+// 每个协议语料的报文条数
+const PROTOCOL_MESSAGES = 1024;
+const DISPATCHER_MESSAGES = 4096;
+// 延伸到尾部字段之前的数组（bytesInTrailer）填充的元素个数
+const TRAILER_ARRAY_COUNT = 8;
+
+// ============================================================================
+// 命令行参数
+// ============================================================================
+
+function parseOptions() {
+    const { values } = parseArgs({
+        options: {
+            only: { type: 'string' },
+            cxx: { type: 'string', default: process.env.CXX || 'g++' },
+            cxxflags: { type: 'string', default: process.env.CXXFLAGS || '-O2' },
+            'min-seconds': { type: 'string', default: '0.1' },
+            repeats: { type: 'string', default: '5' },
+            out: { type: 'string', default: path.join(BUILD_DIR, 'results.json') },
+            baseline: { type: 'string' },
+            'save-baseline': { type: 'string' },
+            threshold: { type: 'string', default: '0.10' }
+        }
+    });
+    return {
+        only: values.only ? values.only.split(',').map(s => s.trim()).filter(Boolean) : null,
+        cxx: values.cxx,
+        cxxflags: values.cxxflags.split(/\s+/).filter(Boolean),
+        minSeconds: Number(values['min-seconds']),
+        repeats: Number(values.repeats),
+        out: path.resolve(values.out),
+        baseline: values.baseline ? path.resolve(values.baseline) : null,
+        saveBaseline: values['save-baseline'] ? path.resolve(values['save-baseline']) : null,
+        threshold: Number(values.threshold)
+    };
+}
+
+// ============================================================================
+// 代码生成
+// ============================================================================
+
+/**
+ * 调用 nodegen 生成协议代码（与 main.js 相同的 parseConfigObject → GeneratorFactory 流程）
+ */
+async function generateProtocol(protocol, outputDir) {
+    const { parseConfigObject } = await import(nodegenModule('config-parser.js'));
+    const { GeneratorFactory } = await import(nodegenModule('generator-factory.js'));
+
+    const { kind, config } = parseConfigObject(protocol.config);
+    const generator = GeneratorFactory.create('cpp11', kind, config, {
+        language: 'cpp11',
+        platform: 'linux-x86_64',
+        cppSdk: true
+    });
+    rmSync(outputDir, { recursive: true, force: true });
+    mkdirSync(outputDir, { recursive: true });
+    await generator.generateFiles(outputDir);
+}
+
+/**
+ * 扫描生成代码中尚未实现的字段（Raw 层对 Array/Struct 等输出 TODO 注释）
+ * 这些字段不参与线上编解码，计时结果不包含其开销，需在报告中标出
+ */
+function findIncompleteFields(outputDir) {
+    const incomplete = new Set();
+    for (const file of readdirSync(outputDir)) {
+        if (!file.endsWith('.cpp')) continue;
+        const source = readFileSync(path.join(outputDir, file), 'utf-8');
+        for (const match of source.matchAll(/\/\/ TODO: Raw (?:parse|serialize) for (\w+) type (\w+)/g)) {
+            incomplete.add(`${match[2]} (${match[1]})`);
+        }
+    }
+    return [...incomplete].sort();
+}
+
+// ============================================================================
+// 驱动程序生成
+// ============================================================================
+
+/**
+ * 生成按变体号 v 填充业务层结构体的语句
+ * @param {Array} fields - 字段配置
+ * @param {string} target - 结构体变量名
+ * @returns {string[]} C++ 语句
+ */
+function fillStatements(fields, target) {
+    const countFields = new Set(fields.filter(f => f.type === 'Array' && f.countFromField).map(f => f.countFromField));
+    const lines = [];
+    fields.forEach((field, index) => {
+        const member = `${target}.${field.fieldName}`;
+        const salt = index + 1;
+        const byteLength = field.byteLength || 0;
+        const mask = byteLength > 0 && byteLength < 8 ? `0x${(2n ** BigInt(byteLength * 8) - 1n).toString(16)}ULL` : '~0ULL';
+
+        switch (field.type) {
+            case 'UnsignedInt':
+            case 'SignedInt':
+            case 'Timestamp':
+                if (field.compression) {
+                    lines.push(`${member} = static_cast<decltype(${member})>(suite::mix(v, ${salt}) >> (suite::mix(v, ${salt + 100}) % 64));`);
+                } else if (countFields.has(field.fieldName)) {
+                    lines.push(`${member} = static_cast<decltype(${member})>(8 + v % 24);`);
+                } else {
+                    lines.push(`${member} = static_cast<decltype(${member})>(suite::mix(v, ${salt}) & ${mask});`);
+                }
+                break;
+            case 'Float':
+                // 1/16 的整数倍，float/double 均可精确表示，往返比对不受舍入影响
+                lines.push(`${member} = static_cast<decltype(${member})>(static_cast<int64_t>(suite::mix(v, ${salt}) % 200001) - 100000) / 16;`);
+                break;
+            case 'Bitfield':
+                field.subFields.forEach((sub, k) => {
+                    const width = sub.endBit - sub.startBit + 1;
+                    const subMask = width >= 64 ? '~0ULL' : `0x${(2n ** BigInt(width) - 1n).toString(16)}ULL`;
+                    lines.push(`${member}.${sub.name} = suite::mix(v, ${salt * 64 + k}) & ${subMask};`);
+                });
+                break;
+            case 'Encode': {
+                const values = field.maps.map(m => `${m.value}LL`).join(', ');
+                lines.push(`{ static const long long values[] = { ${values} }; ` +
+                    `${member}_value = static_cast<decltype(${member}_value)>(values[suite::mix(v, ${salt}) % ${field.maps.length}]); }`);
+                break;
+            }
+            case 'String':
+                if (field.length > 1) {
+                    lines.push(`${member} = suite::make_text(v, ${salt}, ${field.length - 1});`);
+                } else if (!field.length) {
+                    lines.push(`${member} = suite::make_text(v, ${salt}, 24);`);
+                }
+                break;
+            case 'Bcd':
+                lines.push(`${member} = suite::make_digits(v, ${salt}, ${(byteLength || 1) * 2});`);
+                break;
+            case 'Array': {
+                const count = field.countFromField ? `${target}.${field.countFromField}`
+                    : (field.count !== undefined ? field.count : (field.bytesInTrailer !== undefined ? TRAILER_ARRAY_COUNT : undefined));
+                if (count === undefined || !field.element || !['UnsignedInt', 'SignedInt', 'Float'].includes(field.element.type)) {
+                    lines.push(`// ${field.fieldName}: 元素类型或长度不受支持，保持默认值`);
+                    break;
+                }
+                const valueType = `decltype(${member})::value_type`;
+                const value = field.element.type === 'Float'
+                    ? `static_cast<${valueType}>(static_cast<int64_t>(suite::mix(v + k, ${salt}) % 2001) - 1000) / 8`
+                    : `static_cast<${valueType}>(suite::mix(v + k, ${salt}))`;
+                lines.push(`${member}.resize(${count});`);
+                lines.push(`for (size_t k = 0; k < ${member}.size(); ++k) { ${member}[k] = ${value}; }`);
+                break;
+            }
+            default:
+                // MessageId 使用配置的默认值；Checksum / Padding 由序列化器计算或填充
+                break;
+        }
+    });
+    return lines;
+}
+
+/**
+ * 解码值比对函数：比较 fill() 填充过的顶层数组字段（元素为定长整数 / 浮点）
+ */
+function sameFunction(name, resultType, fields) {
+    const members = fields
+        .filter(f => f.type === 'Array' && f.element && (f.count !== undefined || f.countFromField || f.bytesInTrailer !== undefined) &&
+            ['UnsignedInt', 'SignedInt', 'Float'].includes(f.element.type))
+        .map(f => `a.${f.fieldName} == b.${f.fieldName}`);
+    const body = members.length > 0 ? `    return ${members.join(' &&\n        ')};` : '    (void)a;\n    (void)b;\n    return true;';
+    return `static bool ${name}(const ${resultType}& a, const ${resultType}& b) {\n${body}\n}\n`;
+}
+
+function fillFunction(name, resultType, fields) {
+    const body = fillStatements(fields, 'r').map(line => `    ${line}`).join('\n');
+    return `static void ${name}(${resultType}& r, uint64_t v) {\n    (void)v;\n${body}\n}\n`;
+}
+
+/**
+ * 计时片段：遍历语料执行 op，输出一行 JSON
+ */
+function timedOp(op, messages, loopBody, sink) {
+    return `    suite::report(kName, "${op}", ${messages}, bytes_per_msg, suite::measure_pass([&]() {
+        for (size_t i = 0; i < corpus.count(); ++i) {
+            ${loopBody}
+        }
+        bench::do_not_optimize(${sink});
+    }, ${messages}, options));
+`;
+}
+
+const CHECKSUM_OP = (messages) => `    Checksum_CRC<uint32_t> crc(0x04C11DB7UL);  // CRC-32 (IEEE 802.3)
+    crc.set_init(0xFFFFFFFFUL);
+    crc.set_xor_out(0xFFFFFFFFUL);
+    crc.set_ref_in(true);
+    crc.set_ref_out(true);
+    uint32_t checksum = 0;
+${timedOp('checksum', messages, 'checksum ^= crc.calculate(corpus.data(i), corpus.lengths[i]);', 'checksum')}`;
+
+function protocolDriver(protocol) {
+    const name = protocol.config.name;
+    const resultType = `${name}Result`;
+    return `// 由 run-suite.mjs 生成：${protocol.id}
+#include "${name.toLowerCase()}_parser.h"
+#include "protocol_checksum.h"
+#include "suite_driver.h"
+
+using namespace protocol_parser;
+
+${fillFunction('fill', resultType, protocol.config.fields)}
+${sameFunction('same_values', resultType, protocol.config.fields)}
+int main(int argc, char** argv) {
+    const suite::Options options = suite::parse_options(argc, argv);
+    const char* kName = "${protocol.id}";
+
+    std::vector<${resultType}> messages(${PROTOCOL_MESSAGES});
+    for (size_t i = 0; i < messages.size(); ++i) {
+        fill(messages[i], i);
+    }
+
+    auto serialize = [](const ${resultType}& m, uint8_t* buffer, size_t size) {
+        return serialize_${name}(m, buffer, size);
+    };
+    auto deserialize = [](const uint8_t* data, size_t length, ${resultType}& r) {
+        return deserialize_${name}(data, length, r);
+    };
+
+    suite::Corpus corpus;
+    std::string error;
+    ${resultType} result;
+    if (!suite::build_corpus(messages, serialize, corpus, error) ||
+        !suite::check_round_trip(corpus, result, deserialize, serialize, error) ||
+        !suite::check_decoded(corpus, messages, result, deserialize, same_values, error)) {
+        suite::report_error(kName, "setup", error);
+        return 1;
+    }
+    const double bytes_per_msg = static_cast<double>(corpus.bytes.size()) / corpus.count();
+    uint8_t buffer[suite::kMaxMessageSize];
+
+${timedOp('deserialize', PROTOCOL_MESSAGES, 'deserialize(corpus.data(i), corpus.lengths[i], result);', 'result')}
+${timedOp('serialize', PROTOCOL_MESSAGES, 'serialize(messages[i], buffer, sizeof(buffer));', 'buffer')}
+${CHECKSUM_OP(PROTOCOL_MESSAGES)}    return 0;
+}
+`;
+}
+
+function dispatcherDriver(protocol) {
+    const dispatcher = protocol.config.protocolName;
+    const resultType = `${dispatcher}DispatcherResult`;
+    const storageType = `${dispatcher}DispatchStorage`;
+    const subProtocols = Object.values(protocol.config.messages);
+    const memberName = name => name.charAt(0).toLowerCase() + name.slice(1);
+
+    const fills = subProtocols.map(sub => fillFunction(`fill_${sub.name}`, `${sub.name}Result`, sub.fields)).join('\n');
+    const cases = subProtocols.map((sub, i) => `    case ${i}: {
+        ${sub.name}Result m;
+        fill_${sub.name}(m, v);
+        d.set_${memberName(sub.name)}(std::move(m));
+        break;
+    }`).join('\n');
+
+    return `// 由 run-suite.mjs 生成：${protocol.id}
+#include "${dispatcher.toLowerCase()}_dispatcher.h"
+#include "protocol_checksum.h"
+#include "suite_driver.h"
+
+#include <memory>
+
+using namespace protocol_parser;
+
+${fills}
+static void fill_any(${resultType}& d, size_t which, uint64_t v) {
+    switch (which) {
+${cases}
+    default:
+        break;
+    }
+}
+
+int main(int argc, char** argv) {
+    const suite::Options options = suite::parse_options(argc, argv);
+    const char* kName = "${protocol.id}";
+
+    // 均匀分布的报文类型序列（固定种子）
+    std::vector<${resultType}> messages(${DISPATCHER_MESSAGES});
+    uint32_t state = 12345;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        state = state * 1664525u + 1013904223u;
+        fill_any(messages[i], (state >> 8) % ${subProtocols.length}, i);
+    }
+
+    auto serialize = [](const ${resultType}& m, uint8_t* buffer, size_t size) {
+        return serialize_${dispatcher}Dispatcher(m, buffer, size);
+    };
+    auto deserialize = [](const uint8_t* data, size_t length, ${resultType}& r) {
+        return deserialize_${dispatcher}Dispatcher(data, length, r);
+    };
+    auto serialize_from = [](const ${storageType}& s, uint8_t* buffer, size_t size) {
+        return serialize_${dispatcher}DispatcherFrom(s, buffer, size);
+    };
+    auto deserialize_into = [](const uint8_t* data, size_t length, ${storageType}& s) {
+        return deserialize_${dispatcher}DispatcherInto(data, length, s);
+    };
+
+    // 分发存储包含全部子协议槽位，放在堆上
+    std::unique_ptr<${storageType}> storage(new ${storageType}());
+    suite::Corpus corpus;
+    std::string error;
+    ${resultType} result;
+    if (!suite::build_corpus(messages, serialize, corpus, error) ||
+        !suite::check_round_trip(corpus, result, deserialize, serialize, error) ||
+        !suite::check_round_trip(corpus, *storage, deserialize_into, serialize_from, error)) {
+        suite::report_error(kName, "setup", error);
+        return 1;
+    }
+    const double bytes_per_msg = static_cast<double>(corpus.bytes.size()) / corpus.count();
+    uint8_t buffer[suite::kMaxMessageSize];
+
+${timedOp('deserialize', DISPATCHER_MESSAGES, 'deserialize(corpus.data(i), corpus.lengths[i], result);', 'result')}
+${timedOp('deserialize_into', DISPATCHER_MESSAGES, 'deserialize_into(corpus.data(i), corpus.lengths[i], *storage);', '*storage')}
+${timedOp('serialize', DISPATCHER_MESSAGES, 'serialize(messages[i], buffer, sizeof(buffer));', 'buffer')}
+${CHECKSUM_OP(DISPATCHER_MESSAGES)}    return 0;
+}
+`;
+}
+
+// ============================================================================
+// 编译与运行
+// ============================================================================
+
+function run(command, args, options = {}) {
+    const result = spawnSync(command, args, { encoding: 'utf-8', maxBuffer: 64 * 1024 * 1024, ...options });
+    if (result.error) {
+        throw new Error(`${command}: ${result.error.message}`);
+    }
+    return result;
+}
+
+function compilerVersion(cxx) {
+    try {
+        const result = run(cxx, ['--version']);
+        return (result.stdout || '').split('\n')[0].trim();
+    } catch (e) {
+        return 'unknown';
+    }
+}
+
+function buildDriver(protocol, outputDir, options) {
+    const driverFile = path.join(outputDir, 'suite_main.cpp');
+    writeFileSync(driverFile, protocol.kind === 'dispatcher' ? dispatcherDriver(protocol) : protocolDriver(protocol));
+
+    const sources = readdirSync(outputDir).filter(f => f.endsWith('.cpp')).map(f => path.join(outputDir, f));
+    const binary = path.join(outputDir, 'suite_bench');
+    const args = ['-std=c++11', ...options.cxxflags, `-I${outputDir}`, `-I${FRAMEWORK_DIR}`, `-I${SUITE_DIR}`,
+        ...sources, '-o', binary];
+    const result = run(options.cxx, args);
+    if (result.status !== 0) {
+        throw new Error(`compile failed:\n${result.stderr}`);
+    }
+    return binary;
+}
+
+function runDriver(binary, options) {
+    const result = run(binary, ['--min-seconds', String(options.minSeconds), '--repeats', String(options.repeats)]);
+    const records = (result.stdout || '').split('\n').filter(line => line.startsWith('{')).map(line => JSON.parse(line));
+    if (result.status !== 0 && !records.some(r => r.error)) {
+        records.push({ op: 'run', error: `exit code ${result.status}: ${result.stderr}` });
+    }
+    return records;
+}
+
+// ============================================================================
+// 基线比较
+// ============================================================================
+
+/**
+ * 与基线逐项比较：ns/报文增加超过 threshold 或 allocs/报文增加视为回退
+ * @returns {boolean} 是否存在回退
+ */
+function compareWithBaseline(results, baseline, threshold) {
+    const key = r => `${r.protocol}/${r.op}`;
+    const base = new Map(baseline.results.filter(r => !r.error).map(r => [key(r), r]));
+    let regressed = false;
+
+    console.log(`\nComparison with baseline (${baseline.created}, ${baseline.compiler.version}), threshold ${(threshold * 100).toFixed(0)}%`);
+    console.log(`${'benchmark'.padEnd(36)} ${'base ns'.padStart(10)} ${'ns'.padStart(10)} ${'delta'.padStart(8)} ${'allocs'.padStart(14)}  status`);
+    for (const r of results.filter(r => !r.error)) {
+        const b = base.get(key(r));
+        if (!b) {
+            console.log(`${key(r).padEnd(36)} ${'-'.padStart(10)} ${r.ns_per_msg.toFixed(1).padStart(10)} ${'-'.padStart(8)} ${'-'.padStart(14)}  new`);
+            continue;
+        }
+        const delta = (r.ns_per_msg - b.ns_per_msg) / b.ns_per_msg;
+        const slower = delta > threshold;
+        const moreAllocs = r.allocs_per_msg > b.allocs_per_msg + 1e-3;
+        const status = slower || moreAllocs
+            ? ['REGRESSION', slower ? 'time' : null, moreAllocs ? 'allocs' : null].filter(Boolean).join(' ')
+            : (delta < -threshold ? 'faster' : 'ok');
+        regressed = regressed || slower || moreAllocs;
+        const allocs = `${b.allocs_per_msg.toFixed(2)}->${r.allocs_per_msg.toFixed(2)}`;
+        console.log(`${key(r).padEnd(36)} ${b.ns_per_msg.toFixed(1).padStart(10)} ${r.ns_per_msg.toFixed(1).padStart(10)} ` +
+            `${((delta >= 0 ? '+' : '') + (delta * 100).toFixed(1) + '%').padStart(8)} ${allocs.padStart(14)}  ${status}`);
+    }
+    const current = new Set(results.map(key));
+    for (const k of base.keys()) {
+        if (!current.has(k)) {
+            console.log(`${k.padEnd(36)} (missing from this run)`);
+        }
+    }
+    return regressed;
+}
+
+// ============================================================================
+// 主流程
+// ============================================================================
+
+async function main() {
+    const options = parseOptions();
+
+    // 生成过程日志只保留警告与错误
+    process.env.LOG_LEVEL = process.env.LOG_LEVEL || 'warn';
+    const { logger } = await import(nodegenModule('logger.js'));
+    logger.configure();
+
+    const protocols = buildSuiteProtocols().filter(p => !options.only || options.only.includes(p.id));
+    if (protocols.length === 0) {
+        console.error(`No protocol matches --only ${options.only.join(',')}`);
+        process.exit(2);
+    }
+
+    const results = [];
+    const incomplete = {};
+    let failed = false;
+    for (const protocol of protocols) {
+        const outputDir = path.join(BUILD_DIR, protocol.id);
+        process.stdout.write(`[${protocol.id}] generate`);
+        try {
+            await generateProtocol(protocol, outputDir);
+            const missing = findIncompleteFields(outputDir);
+            if (missing.length > 0) {
+                incomplete[protocol.id] = missing;
+            }
+            process.stdout.write(', compile');
+            const binary = buildDriver(protocol, outputDir, options);
+            process.stdout.write(', run\n');
+            for (const record of runDriver(binary, options)) {
+                results.push({ protocol: protocol.id, ...record });
+            }
+        } catch (e) {
+            process.stdout.write('\n');
+            results.push({ protocol: protocol.id, op: 'build', error: e.message });
+        }
+    }
+
+    console.log(`\n${'benchmark'.padEnd(36)} ${'B/msg'.padStart(8)} ${'ns/msg'.padStart(10)} ${'MB/s'.padStart(10)} ${'allocs/msg'.padStart(11)}`);
+    for (const r of results) {
+        if (r.error) {
+            failed = true;
+            console.log(`${`${r.protocol}/${r.op}`.padEnd(36)} ERROR ${r.error}`);
+            continue;
+        }
+        console.log(`${`${r.protocol}/${r.op}`.padEnd(36)} ${r.bytes_per_msg.toFixed(1).padStart(8)} ` +
+            `${r.ns_per_msg.toFixed(1).padStart(10)} ${(r.bytes_per_sec / 1e6).toFixed(1).padStart(10)} ${r.allocs_per_msg.toFixed(2).padStart(11)}`);
+    }
+    for (const [id, fields] of Object.entries(incomplete)) {
+        console.warn(`warning: ${id}: generated code does not encode/decode ${fields.join(', ')}; timings exclude these fields`);
+    }
+
+    const report = {
+        schema: RESULT_SCHEMA,
+        created: new Date().toISOString(),
+        host: {
+            platform: `${os.platform()}-${os.arch()}`,
+            cpu: os.cpus().length > 0 ? os.cpus()[0].model : 'unknown',
+            cpus: os.cpus().length,
+            node: process.version
+        },
+        compiler: { cxx: options.cxx, version: compilerVersion(options.cxx), flags: ['-std=c++11', ...options.cxxflags] },
+        settings: { minSeconds: options.minSeconds, repeats: options.repeats },
+        incomplete_fields: incomplete,
+        results
+    };
+    mkdirSync(path.dirname(options.out), { recursive: true });
+    writeFileSync(options.out, JSON.stringify(report, null, 2) + '\n');
+    console.log(`\nResults written to ${options.out}`);
+    if (options.saveBaseline) {
+        mkdirSync(path.dirname(options.saveBaseline), { recursive: true });
+        writeFileSync(options.saveBaseline, JSON.stringify(report, null, 2) + '\n');
+        console.log(`Baseline saved to ${options.saveBaseline}`);
+    }
+
+    if (options.baseline) {
+        if (!existsSync(options.baseline)) {
+            console.error(`Baseline not found: ${options.baseline}`);
+            process.exit(2);
+        }
+        const baseline = JSON.parse(readFileSync(options.baseline, 'utf-8'));
+        if (baseline.schema !== RESULT_SCHEMA) {
+            console.error(`Unsupported baseline schema: ${baseline.schema}`);
+            process.exit(2);
+        }
+        if (compareWithBaseline(results, baseline, options.threshold)) {
+            failed = true;
+        }
+    }
+
+    process.exit(failed ? 1 : 0);
+}
+
+main().catch(e => {
+    console.error(e.stack || e.message);
+    process.exit(1);
+});
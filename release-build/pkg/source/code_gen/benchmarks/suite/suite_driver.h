@@ -0,0 +1,226 @@
+// ============================================================================
+// 基准套件驱动公共部分（由 run-suite.mjs 生成的每个驱动程序包含）
+// - 报文语料：把业务层结构体逐条序列化成线上字节，记录每条报文的偏移与长度
+// - 往返校验：反序列化后再序列化，逐字节比对
+// - 计时：每轮遍历整个语料，取多轮中位数，换算为 ns/报文、字节/秒
+// - 堆分配计数：替换全局 operator new（因此每个程序只能有一个翻译单元包含本文件）
+// - 结果输出：每项一行 JSON，由 run-suite.mjs 收集
+// ============================================================================
+#ifndef SUITE_DRIVER_H
+#define SUITE_DRIVER_H
+
+#include "../bench_common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 堆分配计数
+// ============================================================================
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    void* ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace suite {
+
+// 单条报文的最大线上长度（套件协议均远小于此值）
+static const size_t kMaxMessageSize = 4096;
+
+// ============================================================================
+// 运行参数
+// ============================================================================
+struct Options {
+    double min_seconds;  // 每轮最短计时
+    int repeats;         // 轮数（取中位数）
+
+    Options() : min_seconds(0.1), repeats(5) {}
+};
+
+// 解析 --min-seconds <s> --repeats <n>
+inline Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--min-seconds") == 0) {
+            options.min_seconds = std::atof(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--repeats") == 0) {
+            options.repeats = std::max(1, std::atoi(argv[i + 1]));
+        }
+    }
+    return options;
+}
+
+// ============================================================================
+// 报文语料
+// ============================================================================
+struct Corpus {
+    std::vector<uint8_t> bytes;    // 全部报文首尾相接
+    std::vector<size_t> offsets;   // 每条报文的起始偏移
+    std::vector<size_t> lengths;   // 每条报文的长度
+
+    size_t count() const { return offsets.size(); }
+    const uint8_t* data(size_t i) const { return bytes.data() + offsets[i]; }
+};
+
+// 逐条序列化 messages 构建语料；serialize(msg, buf, size) 返回 SerializeStatus
+template<typename Msg, typename Serialize>
+inline bool build_corpus(const std::vector<Msg>& messages, Serialize serialize, Corpus& corpus, std::string& error) {
+    uint8_t buffer[kMaxMessageSize];
+    for (size_t i = 0; i < messages.size(); ++i) {
+        const auto status = serialize(messages[i], buffer, sizeof(buffer));
+        if (!status.is_success()) {
+            error = "serialize failed for message " + std::to_string(i) + ": " + status.error_message;
+            return false;
+        }
+        corpus.offsets.push_back(corpus.bytes.size());
+        corpus.lengths.push_back(status.bytes_written);
+        corpus.bytes.insert(corpus.bytes.end(), buffer, buffer + status.bytes_written);
+    }
+    return true;
+}
+
+// 往返校验：deserialize(data, len, result) 后 serialize(result, buf, size)，与原字节比对
+template<typename Result, typename Deserialize, typename Serialize>
+inline bool check_round_trip(const Corpus& corpus, Result& result, Deserialize deserialize, Serialize serialize,
+                             std::string& error) {
+    uint8_t buffer[kMaxMessageSize];
+    for (size_t i = 0; i < corpus.count(); ++i) {
+        const auto parsed = deserialize(corpus.data(i), corpus.lengths[i], result);
+        if (!parsed.is_success()) {
+            error = "deserialize failed for message " + std::to_string(i) + ": " + parsed.error_message;
+            return false;
+        }
+        const auto written = serialize(result, buffer, sizeof(buffer));
+        if (!written.is_success()) {
+            error = "re-serialize failed for message " + std::to_string(i) + ": " + written.error_message;
+            return false;
+        }
+        if (written.bytes_written != corpus.lengths[i] ||
+            std::memcmp(buffer, corpus.data(i), corpus.lengths[i]) != 0) {
+            error = "round trip mismatch for message " + std::to_string(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// 解码值校验：逐条解码语料，与构建语料的原始报文比对（same(decoded, original)）
+// 字节往返比对发现不了解析和序列化两侧都漏掉的字段
+template<typename Result, typename Deserialize, typename Same>
+inline bool check_decoded(const Corpus& corpus, const std::vector<Result>& messages, Result& result,
+                          Deserialize deserialize, Same same, std::string& error) {
+    for (size_t i = 0; i < corpus.count(); ++i) {
+        const auto parsed = deserialize(corpus.data(i), corpus.lengths[i], result);
+        if (!parsed.is_success()) {
+            error = "deserialize failed for message " + std::to_string(i) + ": " + parsed.error_message;
+            return false;
+        }
+        if (!same(result, messages[i])) {
+            error = "decoded value mismatch for message " + std::to_string(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// 计时与结果输出
+// ============================================================================
+struct Measurement {
+    double ns_per_msg;
+    double allocs_per_msg;
+};
+
+// pass() 遍历一次全部 messages 条报文；返回多轮中位数耗时与单轮平均分配次数
+template<typename Pass>
+inline Measurement measure_pass(Pass pass, size_t messages, const Options& options) {
+    std::vector<double> samples;
+    for (int r = 0; r < options.repeats; ++r) {
+        samples.push_back(bench::measure(pass, options.min_seconds));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    // 预热后的单轮分配次数（首轮可能包含容量增长，不计入）
+    pass();
+    const size_t before = g_allocations;
+    pass();
+    const size_t allocations = g_allocations - before;
+
+    Measurement m;
+    m.ns_per_msg = samples[samples.size() / 2] * 1e9 / static_cast<double>(messages);
+    m.allocs_per_msg = static_cast<double>(allocations) / static_cast<double>(messages);
+    return m;
+}
+
+inline void report(const char* protocol, const char* op, size_t messages, double bytes_per_msg,
+                   const Measurement& m) {
+    std::printf("{\"protocol\":\"%s\",\"op\":\"%s\",\"messages\":%zu,\"bytes_per_msg\":%.2f,"
+                "\"ns_per_msg\":%.3f,\"bytes_per_sec\":%.0f,\"allocs_per_msg\":%.4f}\n",
+                protocol, op, messages, bytes_per_msg, m.ns_per_msg,
+                m.ns_per_msg > 0.0 ? bytes_per_msg * 1e9 / m.ns_per_msg : 0.0, m.allocs_per_msg);
+}
+
+inline void report_error(const char* protocol, const char* op, const std::string& message) {
+    std::string escaped;
+    for (size_t i = 0; i < message.size(); ++i) {
+        const char c = message[i];
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+    std::printf("{\"protocol\":\"%s\",\"op\":\"%s\",\"error\":\"%s\"}\n", protocol, op, escaped.c_str());
+}
+
+// ============================================================================
+// 确定性取值（按变体号 v 与字段序号生成，保证每次运行语料一致）
+// ============================================================================
+inline uint64_t mix(uint64_t v, uint64_t salt) {
+    uint64_t x = v * 0x9E3779B97F4A7C15ULL + salt * 0xBF58476D1CE4E5B9ULL + 1;
+    x ^= x >> 31;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 29;
+    return x;
+}
+
+// 长度 1..max_length 的可打印字符串
+inline std::string make_text(uint64_t v, uint64_t salt, size_t max_length) {
+    const size_t length = 1 + static_cast<size_t>(mix(v, salt) % max_length);
+    std::string text(length, 'a');
+    for (size_t i = 0; i < length; ++i) {
+        text[i] = static_cast<char>('A' + mix(v + i, salt) % 26);
+    }
+    return text;
+}
+
+// digits 位十进制数字串（BCD 字段）
+inline std::string make_digits(uint64_t v, uint64_t salt, size_t digits) {
+    std::string text(digits, '0');
+    for (size_t i = 0; i < digits; ++i) {
+        text[i] = static_cast<char>('0' + mix(v + i, salt) % 10);
+    }
+    return text;
+}
+
+} // namespace suite
+
+#endif // SUITE_DRIVER_H
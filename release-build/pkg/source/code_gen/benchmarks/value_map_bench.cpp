@@ -0,0 +1,142 @@
+// ============================================================================
+// 值映射查找基准：逐项比较 vs 稠密数组 vs 有序表二分查找（映射项数 4 ~ 1024）
+// 编译: g++ -std=c++11 -O2 -I../protocol_parser_framework value_map_bench.cpp -o value_map_bench
+// ============================================================================
+#include "protocol_common.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <algorithm>
+
+using namespace protocol_parser;
+
+namespace {
+
+const size_t kMapSizes[] = { 4, 16, 64, 256, 1024 };
+const size_t kQueryCount = 4096;
+
+// 映射表：连续取值（适合稠密数组）或稀疏取值（步长不定，适合有序表）
+struct MapCase {
+    std::vector<std::string> meaning_storage;
+    std::vector<ValueMeaning> sorted;
+    std::vector<const char*> dense;
+    int64_t dense_base;
+    std::vector<uint32_t> queries;
+};
+
+MapCase make_case(size_t size, bool contiguous) {
+    MapCase c;
+    c.meaning_storage.reserve(size);
+    uint32_t state = 2024;
+    int64_t value = contiguous ? 0 : 1000;
+    for (size_t i = 0; i < size; ++i) {
+        char text[64];
+        std::snprintf(text, sizeof(text), "operating mode %04zu (nominal)", i);
+        c.meaning_storage.push_back(text);
+        ValueMeaning entry;
+        entry.value = value;
+        entry.meaning = c.meaning_storage.back().c_str();
+        c.sorted.push_back(entry);
+        if (contiguous) {
+            value += 1;
+        } else {
+            state = state * 1664525u + 1013904223u;
+            value += 3 + static_cast<int64_t>((state >> 24) % 97);
+        }
+    }
+
+    c.dense_base = c.sorted.front().value;
+    if (contiguous) {
+        c.dense.assign(size, nullptr);
+        for (size_t i = 0; i < size; ++i) {
+            c.dense[static_cast<size_t>(c.sorted[i].value - c.dense_base)] = c.sorted[i].meaning;
+        }
+    }
+
+    // 查询：约 90% 命中映射项，10% 未命中
+    for (size_t i = 0; i < kQueryCount; ++i) {
+        state = state * 1664525u + 1013904223u;
+        size_t pick = (state >> 8) % size;
+        bool miss = ((state >> 4) % 10) == 0;
+        c.queries.push_back(static_cast<uint32_t>(c.sorted[pick].value + (miss ? 1000000 : 0)));
+    }
+    return c;
+}
+
+// 旧模板：不带 else 的 if 链，每条报文比较全部映射项并赋值 std::string
+struct IfChainString {
+    static const char* name() { return "if-chain + std::string"; }
+    std::string meaning;
+    const char* lookup(const MapCase& c, uint32_t value) {
+        meaning = "Unknown";
+        for (size_t i = 0; i < c.sorted.size(); ++i) {
+            if (static_cast<int64_t>(value) == c.sorted[i].value) {
+                meaning = c.sorted[i].meaning;
+            }
+        }
+        return meaning.c_str();
+    }
+};
+
+struct DenseTable {
+    static const char* name() { return "dense array"; }
+    const char* lookup(const MapCase& c, uint32_t value) {
+        return lookup_dense_meaning(c.dense.data(), c.dense.size(), c.dense_base, value, "Unknown");
+    }
+};
+
+struct SortedTable {
+    static const char* name() { return "sorted table (binary)"; }
+    const char* lookup(const MapCase& c, uint32_t value) {
+        return lookup_sorted_meaning(c.sorted.data(), c.sorted.size(), value, "Unknown");
+    }
+};
+
+template<typename Method>
+int run_method(const MapCase& c, size_t size) {
+    Method method;
+
+    // 正确性：与有序表参考结果逐条比对
+    for (size_t i = 0; i < c.queries.size(); ++i) {
+        const char* expected = lookup_sorted_meaning(c.sorted.data(), c.sorted.size(), c.queries[i], "Unknown");
+        if (std::strcmp(method.lookup(c, c.queries[i]), expected) != 0) {
+            std::printf("MISMATCH: %s / %zu entries / value %u\n", Method::name(), size, c.queries[i]);
+            return 1;
+        }
+    }
+
+    const double seconds = bench::measure([&]() {
+        size_t total = 0;
+        for (size_t i = 0; i < c.queries.size(); ++i) {
+            total += static_cast<size_t>(method.lookup(c, c.queries[i])[0]);
+        }
+        bench::do_not_optimize(total);
+    });
+
+    std::printf("%-26s %6zu entries %10.2f ns/lookup\n",
+                Method::name(), size, seconds * 1e9 / static_cast<double>(c.queries.size()));
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+
+    bench::print_header("Contiguous values (generator emits dense array)");
+    for (size_t s = 0; s < sizeof(kMapSizes) / sizeof(kMapSizes[0]); ++s) {
+        const MapCase c = make_case(kMapSizes[s], true);
+        failures += run_method<IfChainString>(c, kMapSizes[s]);
+        failures += run_method<DenseTable>(c, kMapSizes[s]);
+        failures += run_method<SortedTable>(c, kMapSizes[s]);
+    }
+
+    bench::print_header("Sparse values (generator emits sorted table)");
+    for (size_t s = 0; s < sizeof(kMapSizes) / sizeof(kMapSizes[0]); ++s) {
+        const MapCase c = make_case(kMapSizes[s], false);
+        failures += run_method<IfChainString>(c, kMapSizes[s]);
+        failures += run_method<SortedTable>(c, kMapSizes[s]);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
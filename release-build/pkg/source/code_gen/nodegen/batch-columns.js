@@ -0,0 +1,112 @@
+/**
+ * 批量解码列布局分析（协议配置 batchDecode = true）
+ * 为 deserialize_batch_<Protocol>() 确定列存储（Structure of Arrays）的列：
+ *   - 定长标量（整数/浮点/时间戳/MessageId/Encode/Bitfield 原始值）：每字段一个连续数组，元素类型与 Raw 成员一致
+ *   - String / Bcd（字符串形式）：offsets（rows + 1 个）+ 连续字节数组
+ *   - Padding / Reserved 不生成列
+ * 批量解码建立在 Raw 层之上（逐帧 parse_from_order 后分散写入各列），
+ * Raw 层尚未解析的 Struct / Array / Command / Checksum 字段不生成列，在生成代码的注释中列出。
+ */
+
+import { getFieldInfo } from './config-parser.js';
+import { CppTypeMapper } from './cpp-type-mapper.js';
+
+const UNSIGNED_TYPES = { 1: 'uint8_t', 2: 'uint16_t', 4: 'uint32_t', 8: 'uint64_t' };
+
+const SCALAR_TYPES = new Set(['UnsignedInt', 'SignedInt', 'Float', 'Timestamp', 'MessageId', 'Encode']);
+
+/**
+ * 变长字节列的数据来源表达式（Raw 成员 → [begin, end)）
+ *
+ * @param {string} member - Raw 成员访问表达式（如 raw.name）
+ * @param {string} cppType - Raw 成员类型
+ * @returns {Object} { begin, end }
+ */
+function bytesRange(member, cppType) {
+    if (cppType === 'StringView') {
+        return { begin: `${member}.data`, end: `${member}.data + ${member}.size` };
+    }
+    if (cppType.startsWith('BcdChars<')) {
+        return { begin: `${member}.digits`, end: `${member}.digits + ${member}.size()` };
+    }
+    return { begin: `${member}.begin()`, end: `${member}.end()` };
+}
+
+/**
+ * 分析顶层字段的列布局
+ *
+ * 返回的每列包含：
+ *   - field_name: Raw 成员名（Bitfield 为 <name>_raw），同时作为列名
+ *   - kind: 'scalar'（定长数组）或 'bytes'（offsets + 字节数组）
+ *   - cpp_type: 标量列元素类型
+ *   - description: 字段描述
+ *   - bytes_begin / bytes_end: 字节列的数据来源表达式（基于 raw.<field_name>）
+ *   - bytes_per_row: 字节列每行的定长字节数（reserve 使用，变长为 0）
+ *
+ * @param {Array} fields - 顶层字段配置数组
+ * @param {Object} options
+ * @param {string} options.protocolName - 协议名称
+ * @param {boolean} options.zeroCopyViews - 是否为零拷贝视图模式（影响 Raw 成员类型）
+ * @returns {Object} { columns, skipped }，skipped 为 [{ field_name, type }]
+ */
+export function analyzeBatchColumns(fields, { protocolName = null, zeroCopyViews = false } = {}) {
+    const columns = [];
+    const skipped = [];
+    const typeOptions = { zeroCopyViews };
+
+    for (const field of fields || []) {
+        const fieldInfo = getFieldInfo(field);
+        const fieldType = fieldInfo.type;
+        const fieldName = fieldInfo.fieldName || '';
+        const description = fieldInfo.description || '';
+
+        if (fieldType === 'Padding' || fieldType === 'Reserved') {
+            continue;
+        }
+
+        if (fieldType === 'Bitfield') {
+            columns.push({
+                field_name: `${fieldName}_raw`,
+                kind: 'scalar',
+                cpp_type: UNSIGNED_TYPES[fieldInfo.byteLength || 1] || 'uint32_t',
+                description: `${description} (raw bitfield)`
+            });
+            continue;
+        }
+
+        if (SCALAR_TYPES.has(fieldType)) {
+            columns.push({
+                field_name: fieldName,
+                kind: 'scalar',
+                cpp_type: CppTypeMapper.mapType(fieldInfo, protocolName, typeOptions),
+                description
+            });
+            continue;
+        }
+
+        if (fieldType === 'String' || fieldType === 'Bcd') {
+            const cppType = CppTypeMapper.mapType(fieldInfo, protocolName, typeOptions);
+            if (cppType === 'uint64_t') {
+                // 整数模式 / 零拷贝视图模式下的短 BCD：十进制整数
+                columns.push({ field_name: fieldName, kind: 'scalar', cpp_type: cppType, description });
+                continue;
+            }
+            const range = bytesRange(`raw.${fieldName}`, cppType);
+            columns.push({
+                field_name: fieldName,
+                kind: 'bytes',
+                description,
+                bytes_begin: range.begin,
+                bytes_end: range.end,
+                bytes_per_row: fieldType === 'String'
+                    ? (fieldInfo.length > 0 ? fieldInfo.length : 0)
+                    : (fieldInfo.byteLength || 1) * 2
+            });
+            continue;
+        }
+
+        skipped.push({ field_name: fieldName, type: fieldType });
+    }
+
+    return { columns, skipped };
+}
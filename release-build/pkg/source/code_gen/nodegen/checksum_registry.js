@@ -144,6 +144,34 @@ export const CHECKSUM_ALGORITHMS = {
         }
     },
 
+    // ========================================================================
+    // 标准 CRC32C (Castagnoli, iSCSI)
+    // x86 上由框架自动使用 SSE4.2 crc32 指令 / PCLMUL 折叠加速
+    // ========================================================================
+    "crc32c": {
+        cppClass: "Checksum_CRC<uint32_t>",
+        returnType: "uint32_t",
+        byteLength: 4,
+        description: "CRC32C-Castagnoli (Poly=0x1EDC6F41, Init=0xFFFFFFFF, RefIn=true, RefOut=true, XorOut=0xFFFFFFFF)",
+        required: [
+            { name: "poly", argOrder: 0 }
+        ],
+        optional: {
+            "init": { setter: "set_init", default: 0xFFFFFFFF },
+            "xorOut": { setter: "set_xor_out", default: 0xFFFFFFFF },
+            "refIn": { setter: "set_ref_in", default: true },
+            "refOut": { setter: "set_ref_out", default: true }
+        },
+        // 固定参数（预定义标准）
+        fixedParams: {
+            "poly": 0x1EDC6F41,
+            "init": 0xFFFFFFFF,
+            "xorOut": 0xFFFFFFFF,
+            "refIn": true,
+            "refOut": true
+        }
+    },
+
     // ========================================================================
     // 自定义 CRC 算法
     // ========================================================================
@@ -225,6 +253,59 @@ export function getChecksumAlgorithm(algorithmName) {
     return CHECKSUM_ALGORITHMS[algorithmName] || null;
 }
 
+/**
+ * 解析校验字段的算法参数（构造函数实参 + setter 调用），供生成校验对象的代码使用
+ * 参数优先级：fixedParams > JSON parameters > 默认值；缺少必填参数时抛出错误
+ *
+ * @param {Object} fieldInfo - Checksum 字段信息（algorithm、parameters、byteLength、fieldName）
+ * @returns {Object} { cppClass, returnType, byteLength, constructorArgs, setters: [{ setter, value }] }
+ */
+export function resolveChecksumParams(fieldInfo) {
+    const algorithm = fieldInfo.algorithm || '';
+    const algorithmConfig = getChecksumAlgorithm(algorithm);
+    if (!algorithmConfig) {
+        throw new Error(`Unsupported checksum algorithm: "${algorithm}" in field "${fieldInfo.fieldName}"`);
+    }
+    const fixedParams = algorithmConfig.fixedParams || {};
+    const parameters = fieldInfo.parameters || {};
+
+    const constructorArgs = [];
+    for (const reqParam of algorithmConfig.required || []) {
+        const paramName = reqParam.name;
+        if (fixedParams[paramName] !== undefined) {
+            constructorArgs.push(fixedParams[paramName]);
+        } else if (parameters[paramName] !== undefined) {
+            constructorArgs.push(parameters[paramName]);
+        } else {
+            throw new Error(
+                `Required parameter "${paramName}" not provided for checksum field "${fieldInfo.fieldName}" ` +
+                `(algorithm: "${algorithm}")`
+            );
+        }
+    }
+
+    const setters = [];
+    for (const [paramName, paramConfig] of Object.entries(algorithmConfig.optional || {})) {
+        let value = paramConfig.default;
+        if (fixedParams[paramName] !== undefined) {
+            value = fixedParams[paramName];
+        } else if (parameters[paramName] !== undefined) {
+            value = parameters[paramName];
+        }
+        if (value !== undefined && value !== null) {
+            setters.push({ setter: paramConfig.setter, value });
+        }
+    }
+
+    return {
+        cppClass: algorithmConfig.cppClass,
+        returnType: algorithmConfig.returnType,
+        byteLength: fieldInfo.byteLength || algorithmConfig.byteLength,
+        constructorArgs,
+        setters
+    };
+}
+
 /**
  * 检查算法是否支持
  * @param {string} algorithmName - 算法名称
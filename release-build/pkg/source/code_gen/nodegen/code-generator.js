@@ -144,8 +144,22 @@ export class CodeGenerator {
             // 复制 protocol_common.h
             logger.log(`Copying common header: ${this.frameworkSrc} -> ${commonHeaderDst}`);
             await copyFile(this.frameworkSrc, commonHeaderDst);
+
+            // protocol_common.h 包含的 CPU 特性检测与字符串编码头文件（GBK 映射表单独一个文件）
+            for (const header of ['protocol_cpu.h', 'protocol_encoding.h', 'protocol_gbk_table.h']) {
+                const headerSrc = path.join(path.dirname(this.frameworkSrc), header);
+                const headerDst = path.join(frameworkDir, header);
+                logger.log(`Copying encoding header: ${headerSrc} -> ${headerDst}`);
+                await copyFile(headerSrc, headerDst);
+            }
             logger.log('[OK] Common header copied successfully');
 
+            // 复制 protocol_instrumentation.h（生成代码总是包含，-DPROTOCOL_INSTRUMENTATION=1 时才有内容）
+            const instrumentationHeaderSrc = path.join(path.dirname(this.frameworkSrc), 'protocol_instrumentation.h');
+            const instrumentationHeaderDst = path.join(frameworkDir, 'protocol_instrumentation.h');
+            logger.log(`Copying instrumentation header: ${instrumentationHeaderSrc} -> ${instrumentationHeaderDst}`);
+            await copyFile(instrumentationHeaderSrc, instrumentationHeaderDst);
+
             // 检查是否需要复制 protocol_compression.h
             const needsCompression = this._checkIfCompressionNeeded();
             if (needsCompression) {
@@ -165,7 +179,19 @@ export class CodeGenerator {
 
                 logger.log(`Copying timestamp header: ${timestampHeaderSrc} -> ${timestampHeaderDst}`);
                 await copyFile(timestampHeaderSrc, timestampHeaderDst);
-                logger.log('[OK] Timestamp header copied successfully');
+
+                // 含时间戳字段的报文可按时间范围存取：一并复制解码结果存储 protocol_store.h
+                const storeHeaderSrc = path.join(path.dirname(this.frameworkSrc), 'protocol_store.h');
+                const storeHeaderDst = path.join(frameworkDir, 'protocol_store.h');
+                logger.log(`Copying store header: ${storeHeaderSrc} -> ${storeHeaderDst}`);
+                await copyFile(storeHeaderSrc, storeHeaderDst);
+
+                // 多链路按时间归并 protocol_merge.h（依赖 protocol_timestamp.h）
+                const mergeHeaderSrc = path.join(path.dirname(this.frameworkSrc), 'protocol_merge.h');
+                const mergeHeaderDst = path.join(frameworkDir, 'protocol_merge.h');
+                logger.log(`Copying merge header: ${mergeHeaderSrc} -> ${mergeHeaderDst}`);
+                await copyFile(mergeHeaderSrc, mergeHeaderDst);
+                logger.log('[OK] Timestamp headers copied successfully');
             }
 
             // 检查是否需要复制 protocol_checksum.h
@@ -178,6 +204,19 @@ export class CodeGenerator {
                 await copyFile(checksumHeaderSrc, checksumHeaderDst);
                 logger.log('[OK] Checksum header copied successfully');
             }
+
+            // 配置了流式分帧时复制 protocol_framer.h 和基于分帧器的多核流水线 protocol_pipeline.h、
+            // 录制文件并行批量解码 protocol_batch_decode.h（文件映射用 protocol_capture.h）
+            if (this.config.framing) {
+                for (const header of ['protocol_framer.h', 'protocol_pipeline.h', 'protocol_batch_decode.h', 'protocol_capture.h']) {
+                    const headerSrc = path.join(path.dirname(this.frameworkSrc), header);
+                    const headerDst = path.join(frameworkDir, header);
+
+                    logger.log(`Copying framer header: ${headerSrc} -> ${headerDst}`);
+                    await copyFile(headerSrc, headerDst);
+                }
+                logger.log('[OK] Framer headers copied successfully');
+            }
         } catch (e) {
             logger.error(`Warning: Failed to copy common headers - ${e.message}`);
             logger.error(`Please manually copy ${this.frameworkSrc} to ${path.join(outputDir, 'protocol_parser_framework/protocol_common.h')}`);
@@ -0,0 +1,57 @@
+/**
+ * 压缩算法注册表
+ *
+ * 定义所有支持的压缩算法及其 C++ 实现映射。
+ * 设计原则：
+ * - 关注点分离：C++ 框架（protocol_compression.h）提供算法，注册表提供映射关系，模板负责代码渲染
+ * - 架构一致性：与 timestamp-registry.js 采用相同的注册表模式
+ * - 两个层级：报文级（messageCompression，整帧压缩，需要编解码器对象）和字段级（field.compression，按字段编码，无状态）
+ */
+
+export const COMPRESSION_REGISTRY = {
+    /**
+     * LZ4 块压缩（报文级）
+     * - 线上格式：varint(原始报文长度) + LZ4 块，与标准 LZ4 block format 兼容
+     * - 编解码器持有哈希表和复用的解压缓冲区，每个线程一个实例
+     */
+    'lz4': {
+        className: 'Lz4BlockCodec',
+        level: 'message',
+        description: 'LZ4 块压缩（报文级）'
+    },
+
+    /**
+     * varint（字段级）
+     * - 无符号整数 LEB128 编码，有符号整数 ZigZag 后编码，小数值只占 1~2 字节
+     * - 仅用于 UnsignedInt / SignedInt 字段，无状态，不需要编解码器对象
+     */
+    'varint': {
+        className: null,
+        level: 'field',
+        fieldTypes: ['UnsignedInt', 'SignedInt'],
+        description: 'varint / ZigZag 变长整数（字段级）'
+    }
+};
+
+/**
+ * 获取指定压缩算法的定义
+ * @param {string} type - 压缩算法名称
+ * @returns {Object} 包含 className、level 的对象
+ * @throws {Error} 如果压缩算法不支持
+ */
+export function getCompressionAlgorithm(type) {
+    if (!COMPRESSION_REGISTRY.hasOwnProperty(type)) {
+        throw new Error(`Unknown compression type: ${type}. Supported types: ${Object.keys(COMPRESSION_REGISTRY).join(', ')}`);
+    }
+    return COMPRESSION_REGISTRY[type];
+}
+
+/**
+ * 检查压缩算法是否支持指定层级
+ * @param {string} type - 压缩算法名称
+ * @param {string} level - 'message' 或 'field'
+ * @returns {boolean} 是否支持
+ */
+export function isSupportedCompression(type, level) {
+    return COMPRESSION_REGISTRY.hasOwnProperty(type) && COMPRESSION_REGISTRY[type].level === level;
+}
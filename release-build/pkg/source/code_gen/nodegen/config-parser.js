@@ -6,6 +6,10 @@
 import { readFile } from 'fs/promises';
 import Ajv from 'ajv';
 import addFormats from 'ajv-formats';
+import { getCompressionAlgorithm, isSupportedCompression } from './compression-registry.js';
+
+// String 字段支持的 encoding 名称（大写；与 CppTypeMapper.mapStringEncoding 一致）
+const STRING_ENCODING_NAMES = ['ASCII', 'UTF-8', 'UTF8', 'GBK', 'CP936', 'GB2312'];
 
 /**
  * 协议配置类，用于存储解析后的协议信息
@@ -25,6 +29,28 @@ export class ProtocolConfig {
         if (this.structAlignment !== null) {
             this._validateStructAlignment(this.structAlignment);
         }
+
+        // 零拷贝视图模式：ASCII String 生成为指向输入缓冲区的 StringView（UTF-8 / GBK 仍为 std::string），
+        // Bcd 生成为整数或定长字符数组，值映射含义生成为 const char*
+        this.zeroCopyViews = configDict.zeroCopyViews === true;
+
+        // 批量解码：额外生成 <Protocol>Columns 列存储和 deserialize_batch_<Protocol>()
+        this.batchDecode = configDict.batchDecode === true;
+
+        // 惰性视图：额外生成 <Protocol>View，按需从输入缓冲区读取字段
+        this.lazyView = configDict.lazyView === true;
+
+        // 流式分帧配置（同步字、长度字段），生成 <Protocol>_frame_spec() 供 StreamFramer 使用
+        this.framing = configDict.framing || null;
+
+        // 报文级压缩（{ type: 'lz4', maxMessageSize }），生成 deserialize_<Protocol>_compressed() 等接口
+        this.messageCompression = configDict.messageCompression || null;
+
+        // 验证字段级压缩配置（field.compression）
+        this._validateFieldCompression(this.fields);
+
+        // 验证字符串编码配置（field.encoding）
+        this._validateStringEncoding(this.fields);
     }
 
     /**
@@ -158,6 +184,63 @@ export class ProtocolConfig {
             );
         }
     }
+
+    /**
+     * 验证字段级压缩配置（私有方法）：目前仅支持整数字段的 varint
+     */
+    _validateFieldCompression(fields) {
+        for (const field of fields) {
+            if (field.compression) {
+                if (!isSupportedCompression(field.compression, 'field')) {
+                    throw new Error(
+                        `Invalid compression "${field.compression}" on field "${field.fieldName}". ` +
+                        `Field-level compression supports: varint`
+                    );
+                }
+                const algo = getCompressionAlgorithm(field.compression);
+                if (!algo.fieldTypes.includes(field.type)) {
+                    throw new Error(
+                        `Compression "${field.compression}" on field "${field.fieldName}" ` +
+                        `requires type ${algo.fieldTypes.join(' / ')}, got ${field.type}`
+                    );
+                }
+            }
+            if (Array.isArray(field.fields)) {
+                this._validateFieldCompression(field.fields);
+            }
+        }
+    }
+
+    /**
+     * 验证字符串编码配置（私有方法）：String 字段的 encoding 须为支持的名称（不区分大小写）
+     * 递归检查 Struct 子字段、Array 元素和 Command 分支
+     */
+    _validateStringEncoding(fields) {
+        for (const field of fields) {
+            if (!field || typeof field !== 'object') {
+                continue;
+            }
+            if (field.type === 'String' && field.encoding !== undefined && field.encoding !== '' &&
+                !STRING_ENCODING_NAMES.includes(String(field.encoding).toUpperCase())) {
+                throw new Error(
+                    `Invalid encoding "${field.encoding}" on field "${field.fieldName}". ` +
+                    `String encoding supports: ASCII, UTF-8, GBK (aliases UTF8, CP936, GB2312)`
+                );
+            }
+            if (Array.isArray(field.fields)) {
+                this._validateStringEncoding(field.fields);
+            }
+            if (field.element) {
+                this._validateStringEncoding([field.element]);
+            }
+            if (Array.isArray(field.elements)) {
+                this._validateStringEncoding(field.elements);
+            }
+            if (field.cases && typeof field.cases === 'object') {
+                this._validateStringEncoding(Object.values(field.cases));
+            }
+        }
+    }
 }
 
 /**
@@ -284,6 +367,9 @@ export class DispatcherConfig {
         this.description = configDict.description || '';
         this.dispatch = configDict.dispatch || {};
         this.messages = configDict.messages || {};
+
+        // 流式分帧配置（分发器使用 lengthOffset / lengthSize 指定长度字段）
+        this.framing = configDict.framing || null;
         
         // 内部缓存：存储已解析的子协议配置 (ProtocolConfig 实例)
         // 格式: { [messageId]: ProtocolConfig }
@@ -374,6 +460,15 @@ export class DispatcherConfig {
         return this.dispatch.size || 2;
     }
 
+    /**
+     * 获取分发查找方式
+     * 'switch'：按 MessageID switch 分发（默认）
+     * 'table'：额外生成表驱动分发（稠密跳转表 / 完美哈希），解码到调用方提供的存储
+     */
+    getDispatchLookup() {
+        return this.dispatch.lookup || 'switch';
+    }
+
     /**
      * 获取 C++ 类型（用于读取 MessageID）
      */
@@ -530,7 +625,7 @@ export class FieldInfo {
         this.fields = fieldDict.fields || [];
         this.algorithm = fieldDict.algorithm || '';
         this.messageIdValue = fieldDict.messageIdValue; // 用于 MessageId 类型
-        this.valueType = fieldDict.valueType; // 用于 MessageId 类型，可选值: "UnsignedInt" / "SignedInt"
+        this.valueType = fieldDict.valueType; // 用于 MessageId 类型，可选值: "UnsignedInt" / "SignedInt"；Bcd 为 "UnsignedInt" 时按十进制整数存储
         this.validWhen = fieldDict.validWhen || null; // 有效性条件 { field: "name", value: 1 }
         // 扩展支持：Array 与 Command 的嵌套元素
         this.elements = fieldDict.elements || [];
@@ -558,6 +653,9 @@ export class FieldInfo {
         this.rangeEndRef = fieldDict.rangeEndRef || '';  // 校验范围结束引用
         this.parameters = fieldDict.parameters || {};  // 算法参数
         this.byteOrder = fieldDict.byteOrder || fieldDict.defaultByteOrder; // 字段级字节序覆写
+        // 字段级压缩（'varint'），线上长度随值变化
+        this.compression = fieldDict.compression || null;
+        this.compressionType = this.compression;
     }
 
     /**
@@ -613,6 +711,26 @@ export class FieldInfo {
         }
     }
 
+    /**
+     * 验证 Bcd 的整数模式：valueType 只能为 "UnsignedInt"，且不超过 9 字节（18 位十进制，见 BCD_UINT_MAX_BYTES）
+     * @throws {Error} 如果配置不合法
+     */
+    validateBcdValueType() {
+        if (this.type !== 'Bcd' || this.valueType === undefined) {
+            return;
+        }
+        if (this.valueType !== 'UnsignedInt') {
+            throw new Error(
+                `Bcd field "${this.fieldName}" valueType must be "UnsignedInt", got "${this.valueType}"`
+            );
+        }
+        if ((this.byteLength || 1) > 9) {
+            throw new Error(
+                `Bcd field "${this.fieldName}" with valueType "UnsignedInt" must be at most 9 bytes, got ${this.byteLength}`
+            );
+        }
+    }
+
     /**
      * 验证值范围是否合法
      * @throws {Error} 如果值范围不合法
@@ -634,6 +752,23 @@ export class FieldInfo {
     }
 }
 
+/**
+ * JSON Schema 约束配置（流式分帧，单协议与分发器共用）
+ */
+const framingSchema = {
+    type: 'object',
+    properties: {
+        syncWord: { type: 'string', pattern: '^(0[xX])?([0-9A-Fa-f]{2})*$' },
+        lengthField: { type: 'string', minLength: 1 },
+        lengthOffset: { type: 'integer', minimum: 0 },
+        lengthSize: { enum: [1, 2, 4, 8] },
+        lengthByteOrder: { enum: ['big', 'little'] },
+        lengthAdjust: { type: 'integer' },
+        maxFrameLength: { type: 'integer', minimum: 1 }
+    },
+    additionalProperties: false
+};
+
 /**
  * JSON Schema 约束配置（单协议配置）
  */
@@ -645,6 +780,19 @@ const configSchema = {
         version: { type: 'string' },
         description: { type: 'string' },
         defaultByteOrder: { enum: ['big', 'little'] },
+        zeroCopyViews: { type: 'boolean' },
+        batchDecode: { type: 'boolean' },
+        lazyView: { type: 'boolean' },
+        framing: framingSchema,
+        messageCompression: {
+            type: 'object',
+            required: ['type'],
+            properties: {
+                type: { enum: ['lz4'] },
+                maxMessageSize: { type: 'integer', minimum: 1 }
+            },
+            additionalProperties: false
+        },
         fields: {
             type: 'array',
             items: { type: 'object' }
@@ -663,6 +811,7 @@ const dispatcherSchema = {
     properties: {
         protocolName: { type: 'string', minLength: 1, maxLength: 255 },
         description: { type: 'string' },
+        framing: framingSchema,
         dispatch: {
             type: 'object',
             required: ['field', 'type', 'byteOrder', 'offset', 'size'],
@@ -671,7 +820,8 @@ const dispatcherSchema = {
                 type: { enum: ['UnsignedInt', 'SignedInt', 'MessageId'] },
                 byteOrder: { enum: ['big', 'little'] },
                 offset: { type: 'number', minimum: 0 },
-                size: { enum: [1, 2, 4, 8] }
+                size: { enum: [1, 2, 4, 8] },
+                lookup: { enum: ['switch', 'table'] }
             },
             additionalProperties: false
         },
@@ -722,6 +872,7 @@ const softwareSchema = {
                                 id: { type: 'string', minLength: 1 },
                                 protocolName: { type: 'string', minLength: 1, maxLength: 255 },
                                 description: { type: 'string' },
+                                framing: framingSchema,
                                 dispatch: {
                                     type: 'object',
                                     required: ['field', 'type', 'byteOrder', 'offset', 'size'],
@@ -731,7 +882,8 @@ const softwareSchema = {
                                         type: { enum: ['UnsignedInt', 'SignedInt', 'MessageId'] },
                                         byteOrder: { enum: ['big', 'little'] },
                                         offset: { type: 'number', minimum: 0 },
-                                        size: { enum: [1, 2, 4, 8] }
+                                        size: { enum: [1, 2, 4, 8] },
+                                        lookup: { enum: ['switch', 'table'] }
                                     },
                                     additionalProperties: false
                                 },
@@ -807,6 +959,13 @@ function validateAllFields(fields, context = 'root') {
             throw new Error(`[${context}] ${err.message}`);
         }
 
+        // 验证 Bcd 整数模式
+        try {
+            fieldInfo.validateBcdValueType();
+        } catch (err) {
+            throw new Error(`[${context}] ${err.message}`);
+        }
+
         // 递归验证嵌套字段 (Struct)
         if (fieldInfo.fields && fieldInfo.fields.length > 0) {
             validateAllFields(fieldInfo.fields, `${context}.${fieldInfo.fieldName}`);
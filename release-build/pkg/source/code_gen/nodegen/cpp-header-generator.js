@@ -6,6 +6,9 @@
 import { TemplateManager } from './template-manager.js';
 import { FieldInfo } from './config-parser.js';
 import { CppTypeMapper } from './cpp-type-mapper.js';
+import { analyzeFixedLayout, analyzeFraming, analyzeViewLayout } from './layout-analyzer.js';
+import { analyzeBatchColumns } from './batch-columns.js';
+import { getCompressionAlgorithm } from './compression-registry.js';
 
 /**
  * C++ 头文件生成器
@@ -82,6 +85,9 @@ export class CppHeaderGenerator {
         // 生成压缩器成员变量
         const compressionMembers = this._generateCompressionMembers();
 
+        // 全静态布局：Raw 结构体导出线上固定长度
+        const fixedLayout = analyzeFixedLayout(this.config.fields);
+
         // ================================================================
         // 3. 组装模板上下文
         // ================================================================
@@ -101,16 +107,25 @@ export class CppHeaderGenerator {
             raw_structs: rawStructs,
             raw_fields: rawFields,
             has_valid_when_fields: hasValidWhenFields,
+            fixed_layout: fixedLayout !== null,
+            fixed_layout_size: fixedLayout ? fixedLayout.size : 0,
 
             // 结构体对齐配置
             struct_alignment: this.config.structAlignment,
 
+            // 零拷贝视图模式（值映射含义为 const char*）
+            zero_copy_views: !!this.config.zeroCopyViews,
+
             // 框架头文件相对路径（用于多层级目录结构）
             framework_relative_path: this.templateManager.frameworkRelativePath || './',
 
             // 压缩相关上下文
+            has_compression: !!this.config.messageCompression || this._hasCompressedFields(this.config.fields),
             has_message_compression: !!this.config.messageCompression,
             message_compression_type: this.config.messageCompression?.type || null,
+            message_compression_class: this.config.messageCompression
+                ? getCompressionAlgorithm(this.config.messageCompression.type).className : null,
+            max_message_size: this.config.messageCompression?.maxMessageSize || 65536,
             compression_members: compressionMembers,
             has_compression_members: compressionMembers.length > 0,
 
@@ -118,7 +133,24 @@ export class CppHeaderGenerator {
             has_timestamp_fields: this._hasTimestampFields(),
 
             // 校验和相关上下文
-            has_checksum_fields: this._hasChecksumFields()
+            has_checksum_fields: this._hasChecksumFields(),
+
+            // 批量解码列布局（协议配置 batchDecode，未启用时为 null）
+            batch_columns: this.config.batchDecode
+                ? analyzeBatchColumns(this.config.fields, {
+                    protocolName: this.config.name,
+                    zeroCopyViews: !!this.config.zeroCopyViews
+                })
+                : null,
+
+            // 惰性视图访问布局（协议配置 lazyView，未启用时为 null）
+            lazy_view: this.config.lazyView ? analyzeViewLayout(this.config.fields) : null,
+
+            // 流式分帧参数（协议配置 framing，未配置时为 null）
+            framing: analyzeFraming(this.config.framing, {
+                fields: this.config.fields,
+                defaultByteOrder: this.config.defaultByteOrder
+            })
         };
 
         return this.templateManager.renderTemplate('main_parser/main_parser.h.template', context);
@@ -156,7 +188,8 @@ export class CppHeaderGenerator {
             description: description,
             fields: preparedFields,
             constructor_initializers: initializers.join(', '),
-            has_initializers: initializers.length > 0
+            has_initializers: initializers.length > 0,
+            zero_copy_views: !!this.config.zeroCopyViews
         };
 
         return this.templateManager.renderTemplate('composites/struct.h.template', context);
@@ -170,7 +203,7 @@ export class CppHeaderGenerator {
      * @returns {Object} 字段上下文字典
      */
     _prepareStructFieldContext(protocolName, fieldInfo) {
-        let fieldType = CppTypeMapper.mapType(fieldInfo, protocolName);
+        let fieldType = CppTypeMapper.mapType(fieldInfo, protocolName, this._typeOptions());
 
         // 特殊处理 Struct 类型，生成正确的结构体名称
         if (fieldInfo.type === 'Struct') {
@@ -233,7 +266,7 @@ export class CppHeaderGenerator {
                 for (const caseKey in fieldInfo.cases) {
                     const caseConfig = fieldInfo.cases[caseKey];
                     const caseFieldInfo = new FieldInfo(caseConfig);
-                    const caseCppType = CppTypeMapper.mapType(caseFieldInfo, protocolName);
+                    const caseCppType = CppTypeMapper.mapType(caseFieldInfo, protocolName, this._typeOptions());
                     
                     caseFields.push({
                         field_name: caseConfig.fieldName || `case_${caseKey}`,
@@ -279,7 +312,7 @@ export class CppHeaderGenerator {
             field_name: fieldName,
             description: description,
             unit: unit,
-            field_cpp_type: CppTypeMapper.mapType(fieldInfo, protocolName),
+            field_cpp_type: CppTypeMapper.mapType(fieldInfo, protocolName, this._typeOptions()),
             is_struct: fieldType === 'Struct',
             is_bitfield: fieldType === 'Bitfield',
             is_checksum: fieldType === 'Checksum',
@@ -334,11 +367,9 @@ export class CppHeaderGenerator {
                 // Struct 类型由其自己的构造函数处理
             } else if (fieldInfo.type === 'String' || fieldInfo.type === 'Bcd') {
                 // String/Bcd 类型：只有配置了 defaultValue 时才初始化
-                const defaultVal = fieldInfo.defaultValue;
-                if (defaultVal !== null && defaultVal !== undefined) {
-                    // 字符串默认值需要用引号包裹，并转义内部引号
-                    const escapedVal = defaultVal.replace(/\\/g, '\\\\').replace(/"/g, '\\"');
-                    initializers.push(`${fieldName}("${escapedVal}")`);
+                const initializer = this._stringDefaultInitializer(fieldInfo);
+                if (initializer) {
+                    initializers.push(initializer);
                 }
             } else if (fieldInfo.type === 'Bytes') {
                 // Bytes 类型（std::vector）暂不处理 defaultValue
@@ -392,11 +423,9 @@ export class CppHeaderGenerator {
                 // Struct 类型由其自己的构造函数处理，不添加初始化
             } else if (fieldType === 'String' || fieldType === 'Bcd') {
                 // String/Bcd 类型：只有配置了 defaultValue 时才初始化
-                const defaultVal = fieldInfo.defaultValue;
-                if (defaultVal !== null && defaultVal !== undefined) {
-                    // 字符串默认值需要用引号包裹，并转义内部引号
-                    const escapedVal = defaultVal.replace(/\\/g, '\\\\').replace(/"/g, '\\"');
-                    initializers.push(`${fieldName}("${escapedVal}")`);
+                const initializer = this._stringDefaultInitializer(fieldInfo);
+                if (initializer) {
+                    initializers.push(initializer);
                 }
             } else if (fieldType === 'Bytes') {
                 // Bytes 类型（std::vector）暂不处理 defaultValue
@@ -538,7 +567,7 @@ export class CppHeaderGenerator {
                                 is_struct_raw: true
                             });
                         } else {
-                            const caseCppType = CppTypeMapper.mapType(caseFieldInfo, protocolName);
+                            const caseCppType = CppTypeMapper.mapType(caseFieldInfo, protocolName, this._typeOptions());
                             rawFields.push({
                                 field_name: caseConfig.fieldName || `case_${caseKey}`,
                                 field_cpp_type: caseCppType,
@@ -552,7 +581,7 @@ export class CppHeaderGenerator {
 
             // Array 类型：保持数组，但元素类型可能需要 _Raw 后缀
             if (fieldType === 'Array') {
-                let elementType = CppTypeMapper.mapType(fieldInfo, protocolName);
+                let elementType = CppTypeMapper.mapType(fieldInfo, protocolName, this._typeOptions());
                 
                 // 如果元素是 Struct，使用 _Raw 后缀
                 if (fieldInfo.element && fieldInfo.element.type === 'Struct') {
@@ -570,7 +599,7 @@ export class CppHeaderGenerator {
             }
 
             // 其他类型：直接使用 CppTypeMapper
-            const cppType = CppTypeMapper.mapType(fieldInfo, protocolName);
+            const cppType = CppTypeMapper.mapType(fieldInfo, protocolName, this._typeOptions());
             rawFields.push({
                 field_name: fieldName,
                 field_cpp_type: cppType,
@@ -640,6 +669,39 @@ export class CppHeaderGenerator {
         return this.templateManager.renderTemplate('composites/struct_raw.h.template', context);
     }
 
+    /**
+     * 类型映射选项（传给 CppTypeMapper.mapType）
+     *
+     * @returns {Object} 映射选项
+     */
+    _typeOptions() {
+        return { zeroCopyViews: !!this.config.zeroCopyViews };
+    }
+
+    /**
+     * 生成 String/Bcd 字段默认值的初始化语句
+     * 整数模式（valueType: "UnsignedInt"）或零拷贝视图模式下，不超过 9 字节的 Bcd 以十进制整数存储，默认值生成为整数字面量；
+     * StringView 和 BcdChars 均可由字符串字面量构造
+     *
+     * @param {FieldInfo} fieldInfo - 字段信息
+     * @returns {string|null} 初始化语句，未配置 defaultValue 时返回 null
+     */
+    _stringDefaultInitializer(fieldInfo) {
+        const defaultVal = fieldInfo.defaultValue;
+        if (defaultVal === null || defaultVal === undefined) {
+            return null;
+        }
+
+        const fieldName = fieldInfo.fieldName;
+        if (CppTypeMapper.isBcdInteger(fieldInfo, this._typeOptions())) {
+            return `${fieldName}(${CppTypeMapper.bcdIntegerLiteral(defaultVal)})`;
+        }
+
+        // 字符串默认值需要用引号包裹，并转义内部引号
+        const escapedVal = String(defaultVal).replace(/\\/g, '\\\\').replace(/"/g, '\\"');
+        return `${fieldName}("${escapedVal}")`;
+    }
+
     /**
      * 首字母大写辅助函数
      *
@@ -664,7 +726,7 @@ export class CppHeaderGenerator {
         if (this.config.messageCompression) {
             const type = this.config.messageCompression.type;
             const algo = getCompressionAlgorithm(type);
-            if (algo) {
+            if (algo.className) {
                 members.push({
                     class_name: algo.className,
                     member_name: 'm_messageCompressor',
@@ -679,7 +741,7 @@ export class CppHeaderGenerator {
             const fieldInfo = new FieldInfo(field);
             if (fieldInfo.compression) {
                 const algo = getCompressionAlgorithm(fieldInfo.compressionType);
-                if (algo) {
+                if (algo.className) {
                     members.push({
                         class_name: algo.className,
                         member_name: `m_${fieldInfo.fieldName}Compressor`,
@@ -692,6 +754,17 @@ export class CppHeaderGenerator {
         return members;
     }
 
+    /**
+     * 递归检测字段列表中是否有字段级压缩（field.compression）
+     *
+     * @param {Array} fields - 字段列表
+     * @returns {boolean} 是否包含压缩字段
+     */
+    _hasCompressedFields(fields) {
+        return fields.some(field => !!field.compression ||
+            (Array.isArray(field.fields) && this._hasCompressedFields(field.fields)));
+    }
+
     /**
      * 检测协议中是否有 Timestamp 类型的字段（递归检测所有字段）
      *
@@ -6,7 +6,12 @@
 import { getFieldInfo } from './config-parser.js';
 import { TemplateManager } from './template-manager.js';
 import { getChecksumAlgorithm } from './checksum_registry.js';
+import { getCompressionAlgorithm } from './compression-registry.js';
 import { logger } from './logger.js';
+import { analyzeFixedLayout, rawByteOrderArg } from './layout-analyzer.js';
+import { CppTypeMapper } from './cpp-type-mapper.js';
+import { generateMeaningLookup } from './value-map-lookup.js';
+import { analyzeBatchColumns } from './batch-columns.js';
 
 /**
  * C++ 实现文件生成器
@@ -44,6 +49,9 @@ export class CppImplGenerator {
         // 生成 from_raw() 转换代码
         const fromRawConversions = this._generateFromRawFieldConversions();
 
+        // 全静态布局：一次长度检查 + 常量偏移直接读取
+        const fixedLayout = analyzeFixedLayout(this.config.fields);
+
         // 准备模板上下文
         const context = {
             protocol_name: this.config.name,
@@ -57,7 +65,24 @@ export class CppImplGenerator {
             // 两阶段重构新增
             raw_field_calls: rawFieldCalls,
             from_raw_conversions: fromRawConversions,
-            has_two_phase: true  // 标记使用两阶段
+            has_two_phase: true,  // 标记使用两阶段
+
+            // 全静态布局快速路径
+            fixed_layout: fixedLayout !== null,
+            fixed_layout_loads: fixedLayout ? this._generateFixedLayoutLoads(fixedLayout) : [],
+
+            // 批量解码列布局（协议配置 batchDecode，未启用时为 null）
+            batch_columns: this.config.batchDecode
+                ? analyzeBatchColumns(this.config.fields, {
+                    protocolName: this.config.name,
+                    zeroCopyViews: !!this.config.zeroCopyViews
+                })
+                : null,
+
+            // 报文级压缩（协议配置 messageCompression）
+            has_message_compression: !!this.config.messageCompression,
+            message_compression_class: this.config.messageCompression
+                ? getCompressionAlgorithm(this.config.messageCompression.type).className : null
         };
 
         // 渲染模板
@@ -527,6 +552,8 @@ export class CppImplGenerator {
             const fieldInfo = getFieldInfo(field);
             const fieldType = fieldInfo.type;
             const fieldName = fieldInfo.fieldName || '';
+            // 字段编号（从 1 开始，与 field_name_of() 一致），写入出错结果的 field_id
+            const fieldId = rawFieldCalls.length + 1;
 
             // Padding 类型：生成读取代码
             if (fieldType === 'Padding') {
@@ -567,20 +594,20 @@ export class CppImplGenerator {
                 const byteLength = fieldInfo.byteLength || 1;
                 const intTypeMap = { 1: 'uint8_t', 2: 'uint16_t', 4: 'uint32_t', 8: 'uint64_t' };
                 const cppType = intTypeMap[byteLength] || 'uint32_t';
-                const readFunc = `deserialize_unsigned_int_generic<${cppType}>`;
+                const readFunc = `deserialize_unsigned_int_fixed<${rawByteOrderArg(fieldInfo)}, ${cppType}>`;
                 
                 rawFieldCalls.push({
                     field_name: `${fieldName}_raw`,
                     type: 'Bitfield',
                     description: fieldInfo.description || '',
-                    raw_parse_code: `    {\n        ${cppType} temp = 0;\n        DeserializeResult res = ${readFunc}(ctx, temp);\n        if (!res.is_success()) return false;\n        raw.${fieldName}_raw = temp;\n    }`,
+                    raw_parse_code: `    {\n        ${cppType} temp = 0;\n        DeserializeStatus res = ${readFunc}(ctx, temp);\n        if (!res.is_success()) return res.at_field(${fieldId});\n        raw.${fieldName}_raw = temp;\n    }`,
                     original_field_name: fieldName
                 });
                 continue;
             }
 
             // 其他类型：生成标准解析代码（无 validWhen 判断）
-            const parseCode = this._generateRawParseCodeForField(fieldInfo, 'raw');
+            const parseCode = this._generateRawParseCodeForField(fieldInfo, 'raw', fieldId);
             rawFieldCalls.push({
                 field_name: fieldName,
                 type: fieldType,
@@ -592,16 +619,38 @@ export class CppImplGenerator {
         return rawFieldCalls;
     }
 
+    /**
+     * 生成全静态布局的直接读取代码（parse_from_order() 已做过整体长度检查）
+     *
+     * @param {Object} layout - analyzeFixedLayout() 的分析结果
+     * @returns {Array} 读取代码数组
+     */
+    _generateFixedLayoutLoads(layout) {
+        return layout.fields.map(entry => {
+            let code;
+            if (entry.kind === 'bytes') {
+                code = entry.byte_length === 1
+                    ? `    raw.${entry.field_name} = buffer[${entry.offset}];`
+                    : `    std::memcpy(raw.${entry.field_name}, buffer + ${entry.offset}, ${entry.byte_length});`;
+            } else {
+                code = `    raw.${entry.field_name} = read_fixed_order<${entry.byte_order}, ${entry.cpp_type}>(buffer + ${entry.offset});`;
+            }
+            return { field_name: entry.field_name, offset: entry.offset, load_code: code };
+        });
+    }
+
     /**
      * 为单个字段生成 Raw 解析代码
      *
      * @param {FieldInfo} fieldInfo - 字段信息
      * @param {string} resultPrefix - 结果变量前缀
+     * @param {number} fieldId - 字段编号（出错时写入 DeserializeStatus::field_id）
      * @returns {string} 解析代码
      */
-    _generateRawParseCodeForField(fieldInfo, resultPrefix) {
+    _generateRawParseCodeForField(fieldInfo, resultPrefix, fieldId) {
         const fieldType = fieldInfo.type;
         const fieldName = fieldInfo.fieldName;
+        const byteOrder = rawByteOrderArg(fieldInfo);
 
         // 简单整数类型
         if (fieldType === 'SignedInt' || fieldType === 'UnsignedInt') {
@@ -612,8 +661,13 @@ export class CppImplGenerator {
             };
             const cppType = typeMap[fieldType][byteLength] || 'int32_t';
             const funcPrefix = fieldType === 'SignedInt' ? 'signed' : 'unsigned';
+
+            // 字段级压缩：varint（有符号整数为 ZigZag + varint），线上长度可变
+            if (fieldInfo.compression === 'varint') {
+                return `    {\n        ${cppType} temp = 0;\n        DeserializeStatus res = deserialize_varint_generic<${cppType}>(ctx, temp);\n        if (!res.is_success()) return res.at_field(${fieldId});\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            }
             
-            return `    {\n        ${cppType} temp = 0;\n        DeserializeResult res = deserialize_${funcPrefix}_int_generic<${cppType}>(ctx, temp);\n        if (!res.is_success()) return false;\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            return `    {\n        ${cppType} temp = 0;\n        DeserializeStatus res = deserialize_${funcPrefix}_int_fixed<${byteOrder}, ${cppType}>(ctx, temp);\n        if (!res.is_success()) return res.at_field(${fieldId});\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
         }
 
         // Float 类型
@@ -621,13 +675,16 @@ export class CppImplGenerator {
             const precision = fieldInfo.precision || 'float';
             const cppType = precision === 'double' ? 'double' : 'float';
             
-            return `    {\n        ${cppType} temp = 0;\n        DeserializeResult res = deserialize_float_generic<${cppType}>(ctx, temp);\n        if (!res.is_success()) return false;\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            return `    {\n        ${cppType} temp = 0;\n        DeserializeStatus res = deserialize_float_fixed<${byteOrder}, ${cppType}>(ctx, temp);\n        if (!res.is_success()) return res.at_field(${fieldId});\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
         }
 
-        // String 类型
+        // String 类型：直接写入目标成员（零拷贝视图模式下 ASCII 字段为指向输入缓冲区的 StringView）
         if (fieldType === 'String') {
             const length = fieldInfo.length || 0;
-            return `    {\n        std::string temp;\n        DeserializeResult res = deserialize_string(ctx, temp, ${length});\n        if (!res.is_success()) return false;\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            const call = this.config.zeroCopyViews && CppTypeMapper.mapViewType(fieldInfo) === 'StringView'
+                ? `deserialize_string_view(ctx, ${resultPrefix}.${fieldName}, ${length})`
+                : `deserialize_string_generic(ctx, ${resultPrefix}.${fieldName}, ${length}, ${CppTypeMapper.mapStringEncoding(fieldInfo.encoding)})`;
+            return `    {\n        DeserializeStatus res = ${call};\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
         }
 
         // Timestamp 类型：Raw 层读取原始整数（不转换）
@@ -635,7 +692,7 @@ export class CppImplGenerator {
             const byteLength = fieldInfo.byteLength || 4;
             const cppType = byteLength === 8 ? 'uint64_t' : 'uint32_t';
             
-            return `    {\n        ${cppType} temp = 0;\n        DeserializeResult res = deserialize_unsigned_int_generic<${cppType}>(ctx, temp);\n        if (!res.is_success()) return false;\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            return `    {\n        ${cppType} temp = 0;\n        DeserializeStatus res = deserialize_unsigned_int_fixed<${byteOrder}, ${cppType}>(ctx, temp);\n        if (!res.is_success()) return res.at_field(${fieldId});\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
         }
 
         // MessageId 类型
@@ -648,7 +705,7 @@ export class CppImplGenerator {
             const cppType = typeMap[byteLength] || 'uint16_t';
             const funcPrefix = valueType === 'SignedInt' ? 'signed' : 'unsigned';
             
-            return `    {\n        ${cppType} temp = 0;\n        DeserializeResult res = deserialize_${funcPrefix}_int_generic<${cppType}>(ctx, temp);\n        if (!res.is_success()) return false;\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            return `    {\n        ${cppType} temp = 0;\n        DeserializeStatus res = deserialize_${funcPrefix}_int_fixed<${byteOrder}, ${cppType}>(ctx, temp);\n        if (!res.is_success()) return res.at_field(${fieldId});\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
         }
 
         // Encode 类型：Raw 层只读取整数值
@@ -661,19 +718,77 @@ export class CppImplGenerator {
             const cppType = typeMap[byteLength] || 'uint8_t';
             const funcPrefix = baseType === 'signed' ? 'signed' : 'unsigned';
             
-            return `    {\n        ${cppType} temp = 0;\n        DeserializeResult res = deserialize_${funcPrefix}_int_generic<${cppType}>(ctx, temp);\n        if (!res.is_success()) return false;\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            return `    {\n        ${cppType} temp = 0;\n        DeserializeStatus res = deserialize_${funcPrefix}_int_fixed<${byteOrder}, ${cppType}>(ctx, temp);\n        if (!res.is_success()) return res.at_field(${fieldId});\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
         }
 
-        // Bcd 类型
+        // Bcd 类型：直接写入目标成员（整数模式下为十进制整数，零拷贝视图模式下为整数或定长字符数组）
         if (fieldType === 'Bcd') {
             const byteLength = fieldInfo.byteLength || 1;
-            return `    {\n        std::string temp;\n        DeserializeResult res = deserialize_bcd(ctx, temp, ${byteLength});\n        if (!res.is_success()) return false;\n        ${resultPrefix}.${fieldName} = temp;\n    }`;
+            let call = `deserialize_bcd_generic(ctx, ${resultPrefix}.${fieldName}, ${byteLength})`;
+            if (CppTypeMapper.isBcdInteger(fieldInfo, { zeroCopyViews: !!this.config.zeroCopyViews })) {
+                call = `deserialize_bcd_uint(ctx, ${resultPrefix}.${fieldName}, ${byteLength})`;
+            } else if (this.config.zeroCopyViews) {
+                call = `deserialize_bcd_chars(ctx, ${resultPrefix}.${fieldName})`;
+            }
+            return `    {\n        DeserializeStatus res = ${call};\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
+        }
+
+        // Array 类型：定长整数 / 浮点元素一次长度检查后整块读取
+        if (fieldType === 'Array') {
+            const bulkCode = this._generateRawBulkArrayParseCode(fieldInfo, resultPrefix, fieldId);
+            if (bulkCode) {
+                return bulkCode;
+            }
         }
 
         // Struct、Array、Command 等复杂类型：使用原有递归逻辑
         return `    // TODO: Raw parse for ${fieldType} type ${fieldName}`;
     }
 
+    /**
+     * 为顶层 Array 字段生成批量解析代码（deserialize_array_bulk，直接写入 Raw 结构体的 std::vector）
+     * 元素不可批量读取（非定长标量、有范围校验等）或缺少计数方式时返回 null
+     *
+     * @param {FieldInfo} fieldInfo - 字段信息（Array 类型）
+     * @param {string} resultPrefix - 结果变量前缀
+     * @param {number} fieldId - 字段编号
+     * @returns {string|null} 解析代码
+     */
+    _generateRawBulkArrayParseCode(fieldInfo, resultPrefix, fieldId) {
+        const bulkElement = fieldInfo.element ? CppTypeMapper.mapBulkElement(getFieldInfo(fieldInfo.element)) : null;
+        if (!bulkElement) {
+            return null;
+        }
+        const fieldName = fieldInfo.fieldName;
+        const cppType = bulkElement.cppType;
+        // 元素未覆写字节序时沿用数组字段的编译期字节序
+        const byteOrder = bulkElement.byteOrder === 'ctx.byte_order' ? rawByteOrderArg(fieldInfo) : bulkElement.byteOrder;
+
+        let countCode;
+        if (fieldInfo.count !== undefined && fieldInfo.count !== null) {
+            countCode = `        const size_t array_count = ${fieldInfo.count};\n`;
+        } else if (fieldInfo.countFromField) {
+            countCode = `        const size_t array_count = static_cast<size_t>(${resultPrefix}.${fieldInfo.countFromField});\n`;
+        } else if (fieldInfo.bytesInTrailer !== undefined && fieldInfo.bytesInTrailer !== null) {
+            const trailerBytes = this._calculateFollowingFieldsSize(fieldName);
+            countCode =
+                `        if (ctx.remaining_bytes() < ${trailerBytes}) {\n` +
+                `            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough bytes for trailer", ctx.offset).at_field(${fieldId});\n` +
+                `        }\n` +
+                `        const size_t available_bytes = ctx.remaining_bytes() - ${trailerBytes};\n` +
+                `        if (available_bytes % sizeof(${cppType}) != 0) {\n` +
+                `            return DeserializeStatus::failure(INVALID_VALUE, "Array data length not aligned with element size", ctx.offset).at_field(${fieldId});\n` +
+                `        }\n` +
+                `        const size_t array_count = available_bytes / sizeof(${cppType});\n`;
+        } else {
+            return null;
+        }
+
+        return `    {\n${countCode}` +
+            `        DeserializeStatus res = deserialize_array_bulk<${cppType}>(ctx, array_count, ${resultPrefix}.${fieldName}, ${byteOrder});\n` +
+            `        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
+    }
+
     /**
      * 生成 from_raw() 方法中的字段转换代码
      * 处理 validWhen、valueRange、单位转换、Bitfield 解包
@@ -736,9 +851,13 @@ export class CppImplGenerator {
         if (fieldInfo.valueRange && fieldInfo.valueRange.length > 0) {
             const ranges = fieldInfo.valueRange;
             const rawFieldRef = fieldType === 'Bitfield' ? `raw.${fieldName}_raw` : `raw.${fieldName}`;
+            // Bcd 整数模式：范围为十进制数字串，去掉前导零后作为整数字面量
+            const bound = CppTypeMapper.isBcdInteger(fieldInfo, { zeroCopyViews: !!this.config.zeroCopyViews })
+                ? value => CppTypeMapper.bcdIntegerLiteral(value)
+                : value => value;
             
             const rangeConditions = ranges.map(r => 
-                `(${rawFieldRef} >= ${r.min} && ${rawFieldRef} <= ${r.max})`
+                `(${rawFieldRef} >= ${bound(r.min)} && ${rawFieldRef} <= ${bound(r.max)})`
             ).join(' || ');
             
             lines.push(`${indent}// valueRange 校验`);
@@ -754,18 +873,17 @@ export class CppImplGenerator {
                 lines.push(`${indent}// Bitfield 解包`);
                 if (fieldInfo.subFields) {
                     for (const subField of fieldInfo.subFields) {
-                        const mask = ((1 << (subField.endBit - subField.startBit + 1)) - 1) << subField.startBit;
-                        lines.push(`${indent}result.${fieldName}.${subField.name} = (raw.${fieldName}_raw >> ${subField.startBit}) & 0x${((1 << (subField.endBit - subField.startBit + 1)) - 1).toString(16)};`);
+                        const width = subField.endBit - subField.startBit + 1;
+                        lines.push(`${indent}result.${fieldName}.${subField.name} = extract_bits(raw.${fieldName}_raw, ${subField.startBit}, ${width});`);
                         
-                        // 如果有 maps，生成 meaning 映射
-                        if (subField.maps && subField.maps.length > 0) {
-                            lines.push(`${indent}switch (result.${fieldName}.${subField.name}) {`);
-                            for (const map of subField.maps) {
-                                lines.push(`${indent}    case ${map.value}: result.${fieldName}.${subField.name}_meaning = "${map.meaning}"; break;`);
-                            }
-                            lines.push(`${indent}    default: result.${fieldName}.${subField.name}_meaning = "Unknown"; break;`);
-                            lines.push(`${indent}}`);
-                        }
+                        // 如果有 maps，生成 meaning 查找（稠密数组 / 有序表）
+                        lines.push(...generateMeaningLookup({
+                            maps: subField.maps,
+                            tableName: `${fieldName}_${subField.name}_meanings`,
+                            valueExpr: `result.${fieldName}.${subField.name}`,
+                            targetExpr: `result.${fieldName}.${subField.name}_meaning`,
+                            indent
+                        }));
                     }
                 }
                 break;
@@ -773,14 +891,13 @@ export class CppImplGenerator {
             case 'Encode':
                 // Encode 映射
                 lines.push(`${indent}result.${fieldName}_value = raw.${fieldName};`);
-                if (fieldInfo.maps && fieldInfo.maps.length > 0) {
-                    lines.push(`${indent}switch (raw.${fieldName}) {`);
-                    for (const map of fieldInfo.maps) {
-                        lines.push(`${indent}    case ${map.value}: result.${fieldName}_meaning = "${map.meaning}"; break;`);
-                    }
-                    lines.push(`${indent}    default: result.${fieldName}_meaning = "Unknown"; break;`);
-                    lines.push(`${indent}}`);
-                }
+                lines.push(...generateMeaningLookup({
+                    maps: fieldInfo.maps,
+                    tableName: `${fieldName}_meanings`,
+                    valueExpr: `raw.${fieldName}`,
+                    targetExpr: `result.${fieldName}_meaning`,
+                    indent
+                }));
                 break;
 
             case 'Timestamp':
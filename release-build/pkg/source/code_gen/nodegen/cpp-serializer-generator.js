@@ -8,7 +8,9 @@ import { getFieldInfo } from './config-parser.js';
 import { TemplateManager } from './template-manager.js';
 import { getTimestampFunctions } from './timestamp-registry.js';
 import { getChecksumAlgorithm } from './checksum_registry.js';
+import { getCompressionAlgorithm } from './compression-registry.js';
 import { logger } from './logger.js';
+import { analyzeFixedLayout, rawByteOrderArg } from './layout-analyzer.js';
 import { CppTypeMapper } from './cpp-type-mapper.js';
 
 /**
@@ -47,6 +49,9 @@ export class CppSerializerGenerator {
         // 生成 to_raw() 转换代码
         const toRawConversions = this._generateToRawFieldConversions();
 
+        // 全静态布局：一次空间检查 + 常量偏移直接写入
+        const fixedLayout = analyzeFixedLayout(this.config.fields);
+
         // 准备模板上下文
         const context = {
             protocol_name: this.config.name,
@@ -60,7 +65,16 @@ export class CppSerializerGenerator {
             // 两阶段重构新增
             raw_field_calls: rawFieldCalls,
             to_raw_conversions: toRawConversions,
-            has_two_phase: true  // 标记使用两阶段
+            has_two_phase: true,  // 标记使用两阶段
+
+            // 全静态布局快速路径
+            fixed_layout: fixedLayout !== null,
+            fixed_layout_stores: fixedLayout ? this._generateFixedLayoutStores(fixedLayout) : [],
+
+            // 报文级压缩（协议配置 messageCompression）
+            has_message_compression: !!this.config.messageCompression,
+            message_compression_class: this.config.messageCompression
+                ? getCompressionAlgorithm(this.config.messageCompression.type).className : null
         };
 
         // 渲染模板
@@ -292,6 +306,8 @@ export class CppSerializerGenerator {
         }
         if (fieldInfo.length !== undefined) context.length = fieldInfo.length;
         if (fieldInfo.encoding) context.encoding = fieldInfo.encoding;
+        if (fieldInfo.type === 'String') context.encoding_arg = CppTypeMapper.mapStringEncoding(fieldInfo.encoding);
+        if (fieldInfo.type === 'Bcd') context.bcd_integer = CppTypeMapper.isBcdInteger(fieldInfo);
         if (fieldInfo.subFields) context.sub_fields = fieldInfo.subFields;
         if (fieldInfo.baseType) context.base_type = fieldInfo.baseType;
         if (fieldInfo.valueType) context.value_type = fieldInfo.valueType;  // 用于 MessageId
@@ -350,6 +366,13 @@ export class CppSerializerGenerator {
                 context.count = 0;
             }
             
+            // 定长整数 / 浮点元素走批量路径（整块写出，不逐元素序列化）
+            const bulkElement = fieldInfo.element ? CppTypeMapper.mapBulkElement(getFieldInfo(fieldInfo.element)) : null;
+            if (bulkElement) {
+                context.bulk_element_type = bulkElement.cppType;
+                context.bulk_byte_order = bulkElement.byteOrder;
+            }
+
             context.element_serialize_code = this._generateElementSerializeCode(fieldInfo, referencedFields);
         }
 
@@ -711,6 +734,8 @@ export class CppSerializerGenerator {
             const fieldInfo = getFieldInfo(field);
             const fieldType = fieldInfo.type;
             const fieldName = fieldInfo.fieldName || '';
+            // 字段编号（从 1 开始，与 field_name_of() 一致），写入出错结果的 field_id
+            const fieldId = rawFieldCalls.length + 1;
 
             // Padding 类型：生成写入代码
             if (fieldType === 'Padding') {
@@ -752,20 +777,20 @@ export class CppSerializerGenerator {
                 const byteLength = fieldInfo.byteLength || 1;
                 const intTypeMap = { 1: 'uint8_t', 2: 'uint16_t', 4: 'uint32_t', 8: 'uint64_t' };
                 const cppType = intTypeMap[byteLength] || 'uint32_t';
-                const writeFunc = `serialize_unsigned_int_generic<${cppType}>`;
+                const writeFunc = `serialize_unsigned_int_fixed<${rawByteOrderArg(fieldInfo)}, ${cppType}>`;
                 
                 rawFieldCalls.push({
                     field_name: `${fieldName}_raw`,
                     type: 'Bitfield',
                     description: fieldInfo.description || '',
-                    raw_serialize_code: `    {\n        SerializeResult res = ${writeFunc}(ctx, raw.${fieldName}_raw);\n        if (!res.is_success()) return false;\n    }`,
+                    raw_serialize_code: `    {\n        SerializeStatus res = ${writeFunc}(ctx, raw.${fieldName}_raw);\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`,
                     original_field_name: fieldName
                 });
                 continue;
             }
 
             // 其他类型：生成标准序列化代码
-            const serializeCode = this._generateRawSerializeCodeForField(fieldInfo, 'raw');
+            const serializeCode = this._generateRawSerializeCodeForField(fieldInfo, 'raw', fieldId);
             rawFieldCalls.push({
                 field_name: fieldName,
                 type: fieldType,
@@ -777,16 +802,38 @@ export class CppSerializerGenerator {
         return rawFieldCalls;
     }
 
+    /**
+     * 生成全静态布局的直接写入代码（serialize_to_order() 已做过整体空间检查）
+     *
+     * @param {Object} layout - analyzeFixedLayout() 的分析结果
+     * @returns {Array} 写入代码数组
+     */
+    _generateFixedLayoutStores(layout) {
+        return layout.fields.map(entry => {
+            let code;
+            if (entry.kind === 'bytes') {
+                code = entry.byte_length === 1
+                    ? `    buffer[${entry.offset}] = raw.${entry.field_name};`
+                    : `    std::memcpy(buffer + ${entry.offset}, raw.${entry.field_name}, ${entry.byte_length});`;
+            } else {
+                code = `    write_fixed_order<${entry.byte_order}, ${entry.cpp_type}>(buffer + ${entry.offset}, static_cast<${entry.cpp_type}>(raw.${entry.field_name}));`;
+            }
+            return { field_name: entry.field_name, offset: entry.offset, store_code: code };
+        });
+    }
+
     /**
      * 为单个字段生成 Raw 序列化代码
      *
      * @param {FieldInfo} fieldInfo - 字段信息
      * @param {string} dataPrefix - 数据变量前缀
+     * @param {number} fieldId - 字段编号（出错时写入 SerializeStatus::field_id）
      * @returns {string} 序列化代码
      */
-    _generateRawSerializeCodeForField(fieldInfo, dataPrefix) {
+    _generateRawSerializeCodeForField(fieldInfo, dataPrefix, fieldId) {
         const fieldType = fieldInfo.type;
         const fieldName = fieldInfo.fieldName;
+        const byteOrder = rawByteOrderArg(fieldInfo);
 
         // 简单整数类型
         if (fieldType === 'SignedInt' || fieldType === 'UnsignedInt') {
@@ -797,8 +844,13 @@ export class CppSerializerGenerator {
             };
             const cppType = typeMap[fieldType][byteLength] || 'int32_t';
             const funcPrefix = fieldType === 'SignedInt' ? 'signed' : 'unsigned';
+
+            // 字段级压缩：varint（有符号整数为 ZigZag + varint）
+            if (fieldInfo.compression === 'varint') {
+                return `    {\n        SerializeStatus res = serialize_varint_generic<${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
+            }
             
-            return `    {\n        SerializeResult res = serialize_${funcPrefix}_int_generic<${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return false;\n    }`;
+            return `    {\n        SerializeStatus res = serialize_${funcPrefix}_int_fixed<${byteOrder}, ${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
         }
 
         // Float 类型
@@ -806,13 +858,16 @@ export class CppSerializerGenerator {
             const precision = fieldInfo.precision || 'float';
             const cppType = precision === 'double' ? 'double' : 'float';
             
-            return `    {\n        SerializeResult res = serialize_float_generic<${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return false;\n    }`;
+            return `    {\n        SerializeStatus res = serialize_float_fixed<${byteOrder}, ${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
         }
 
-        // String 类型
+        // String 类型（零拷贝视图模式下 ASCII 字段为 StringView；UTF-8 / GBK 字段仍按编码校验、转码）
         if (fieldType === 'String') {
             const length = fieldInfo.length || 0;
-            return `    {\n        SerializeResult res = serialize_string(ctx, ${dataPrefix}.${fieldName}, ${length});\n        if (!res.is_success()) return false;\n    }`;
+            const call = this.config.zeroCopyViews && CppTypeMapper.mapViewType(fieldInfo) === 'StringView'
+                ? `serialize_string_view(ctx, ${dataPrefix}.${fieldName}, ${length})`
+                : `serialize_string_generic(ctx, ${dataPrefix}.${fieldName}, ${length}, ${CppTypeMapper.mapStringEncoding(fieldInfo.encoding)})`;
+            return `    {\n        SerializeStatus res = ${call};\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
         }
 
         // Timestamp 类型：Raw 层直接写入整数（不转换）
@@ -820,7 +875,7 @@ export class CppSerializerGenerator {
             const byteLength = fieldInfo.byteLength || 4;
             const cppType = byteLength === 8 ? 'uint64_t' : 'uint32_t';
             
-            return `    {\n        SerializeResult res = serialize_unsigned_int_generic<${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return false;\n    }`;
+            return `    {\n        SerializeStatus res = serialize_unsigned_int_fixed<${byteOrder}, ${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
         }
 
         // MessageId 类型
@@ -833,7 +888,7 @@ export class CppSerializerGenerator {
             const cppType = typeMap[byteLength] || 'uint16_t';
             const funcPrefix = valueType === 'SignedInt' ? 'signed' : 'unsigned';
             
-            return `    {\n        SerializeResult res = serialize_${funcPrefix}_int_generic<${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return false;\n    }`;
+            return `    {\n        SerializeStatus res = serialize_${funcPrefix}_int_fixed<${byteOrder}, ${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
         }
 
         // Encode 类型：Raw 层只写入整数值
@@ -846,19 +901,73 @@ export class CppSerializerGenerator {
             const cppType = typeMap[byteLength] || 'uint8_t';
             const funcPrefix = baseType === 'signed' ? 'signed' : 'unsigned';
             
-            return `    {\n        SerializeResult res = serialize_${funcPrefix}_int_generic<${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return false;\n    }`;
+            return `    {\n        SerializeStatus res = serialize_${funcPrefix}_int_fixed<${byteOrder}, ${cppType}>(ctx, ${dataPrefix}.${fieldName});\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
         }
 
         // Bcd 类型
         if (fieldType === 'Bcd') {
             const byteLength = fieldInfo.byteLength || 1;
-            return `    {\n        SerializeResult res = serialize_bcd(ctx, ${dataPrefix}.${fieldName}, ${byteLength});\n        if (!res.is_success()) return false;\n    }`;
+            let call = `serialize_bcd_generic(ctx, ${dataPrefix}.${fieldName}, ${byteLength})`;
+            if (CppTypeMapper.isBcdInteger(fieldInfo, { zeroCopyViews: !!this.config.zeroCopyViews })) {
+                call = `serialize_bcd_uint(ctx, ${dataPrefix}.${fieldName}, ${byteLength})`;
+            } else if (this.config.zeroCopyViews) {
+                call = `serialize_bcd_chars(ctx, ${dataPrefix}.${fieldName})`;
+            }
+            return `    {\n        SerializeStatus res = ${call};\n        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
+        }
+
+        // Array 类型：定长整数 / 浮点元素一次空间检查后整块写出
+        if (fieldType === 'Array') {
+            const bulkCode = this._generateRawBulkArraySerializeCode(fieldInfo, dataPrefix, fieldId);
+            if (bulkCode) {
+                return bulkCode;
+            }
         }
 
         // Struct、Array、Command 等复杂类型
         return `    // TODO: Raw serialize for ${fieldType} type ${fieldName}`;
     }
 
+    /**
+     * 为顶层 Array 字段生成批量序列化代码（serialize_array_bulk，与解析侧对称）
+     * 定长 / 按计数字段确定长度的数组先校验元素个数；元素不可批量写出时返回 null
+     *
+     * @param {FieldInfo} fieldInfo - 字段信息（Array 类型）
+     * @param {string} dataPrefix - 数据变量前缀
+     * @param {number} fieldId - 字段编号
+     * @returns {string|null} 序列化代码
+     */
+    _generateRawBulkArraySerializeCode(fieldInfo, dataPrefix, fieldId) {
+        const bulkElement = fieldInfo.element ? CppTypeMapper.mapBulkElement(getFieldInfo(fieldInfo.element)) : null;
+        if (!bulkElement) {
+            return null;
+        }
+        const fieldName = fieldInfo.fieldName;
+        // 元素未覆写字节序时沿用数组字段的编译期字节序
+        const byteOrder = bulkElement.byteOrder === 'ctx.byte_order' ? rawByteOrderArg(fieldInfo) : bulkElement.byteOrder;
+
+        let expectedCount = null;
+        if (fieldInfo.count !== undefined && fieldInfo.count !== null) {
+            expectedCount = `${fieldInfo.count}`;
+        } else if (fieldInfo.countFromField) {
+            expectedCount = `static_cast<size_t>(${dataPrefix}.${fieldInfo.countFromField})`;
+        } else if (fieldInfo.bytesInTrailer === undefined || fieldInfo.bytesInTrailer === null) {
+            return null;
+        }
+
+        let code = '    {\n';
+        if (expectedCount) {
+            code +=
+                `        if (${dataPrefix}.${fieldName}.size() != ${expectedCount}) {\n` +
+                `            return SerializeStatus::failure(INVALID_VALUE, "Array size mismatch for ${fieldName}", ctx.offset).at_field(${fieldId});\n` +
+                `        }\n`;
+        }
+        code +=
+            `        SerializeStatus res = serialize_array_bulk<${bulkElement.cppType}>(ctx, ${dataPrefix}.${fieldName}, ${byteOrder});\n` +
+            `        if (!res.is_success()) return res.at_field(${fieldId});\n    }`;
+        return code;
+    }
+
     /**
      * 生成 to_raw() 方法中的字段转换代码
      * 执行逆向单位转换、Bitfield 打包、Padding 填充
@@ -949,11 +1058,20 @@ export class CppSerializerGenerator {
             case 'Bitfield':
                 // Bitfield 打包
                 lines.push(`${indent}// Bitfield 打包`);
-                lines.push(`${indent}raw.${fieldName}_raw = 0;`);
-                if (fieldInfo.subFields) {
+                if (fieldInfo.subFields && fieldInfo.subFields.length > 0) {
+                    const intTypeMap = { 1: 'uint8_t', 2: 'uint16_t', 4: 'uint32_t', 8: 'uint64_t' };
+                    const bitfieldRawType = intTypeMap[fieldInfo.byteLength || 1] || 'uint32_t';
+                    // 在 64 位整数中逐个写入位段，最后一次收缩到线上宽度
+                    lines.push(`${indent}{`);
+                    lines.push(`${indent}    uint64_t packed = 0;`);
                     for (const subField of fieldInfo.subFields) {
-                        lines.push(`${indent}raw.${fieldName}_raw |= (data.${fieldName}.${subField.name} & 0x${((1 << (subField.endBit - subField.startBit + 1)) - 1).toString(16)}) << ${subField.startBit};`);
+                        const width = subField.endBit - subField.startBit + 1;
+                        lines.push(`${indent}    packed = deposit_bits(packed, data.${fieldName}.${subField.name}, ${subField.startBit}, ${width});`);
                     }
+                    lines.push(`${indent}    raw.${fieldName}_raw = static_cast<${bitfieldRawType}>(packed);`);
+                    lines.push(`${indent}}`);
+                } else {
+                    lines.push(`${indent}raw.${fieldName}_raw = 0;`);
                 }
                 break;
 
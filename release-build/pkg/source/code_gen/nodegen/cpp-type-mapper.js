@@ -17,6 +17,9 @@ function capitalize(str) {
     return str.charAt(0).toUpperCase() + str.slice(1);
 }
 
+// 压缩 BCD 按整数存储的最大字节数（与 protocol_common.h 中 BCD_UINT_MAX_BYTES 一致）
+export const BCD_UINT_MAX_BYTES = 9;
+
 /**
  * C++ 类型映射器类
  */
@@ -25,9 +28,11 @@ export class CppTypeMapper {
      * 将 FieldInfo 映射为 C++ 类型字符串
      * @param {FieldInfo} fieldInfo - 字段信息对象
      * @param {string} protocolName - 协议名称（用于 Struct 命名）
+     * @param {Object} options - 映射选项
+     * @param {boolean} options.zeroCopyViews - 是否使用零拷贝视图类型（String/Bcd 不分配内存）
      * @returns {string} C++ 类型，如 'uint16_t', 'std::vector<float>'
      */
-    static mapType(fieldInfo, protocolName = null) {
+    static mapType(fieldInfo, protocolName = null, options = {}) {
         // 1) 整数类型：根据 byteLength 精确选择最小可容纳类型
         if (fieldInfo.type === 'UnsignedInt' || fieldInfo.type === 'SignedInt') {
             const unsignedMap = {
@@ -98,7 +103,7 @@ export class CppTypeMapper {
 
             // 递归获取元素类型
             const elementInfo = new FieldInfo(fieldInfo.element);
-            let elementType = CppTypeMapper.mapType(elementInfo, protocolName);
+            let elementType = CppTypeMapper.mapType(elementInfo, protocolName, options);
 
             // 特殊处理：如果元素是 Struct，需要生成正确的结构体名称
             if (elementInfo.type === 'Struct' && protocolName && elementInfo.fieldName) {
@@ -137,7 +142,20 @@ export class CppTypeMapper {
             return unsignedMap[fieldInfo.byteLength] || 'uint64_t';
         }
 
-        // 8) 其他类型：保持原有宽类型设计
+        // 8) Bcd 整数模式（valueType: "UnsignedInt"，不超过 9 字节）：按十进制整数存储，如表号、终端号
+        if (CppTypeMapper.isBcdInteger(fieldInfo)) {
+            return 'uint64_t';
+        }
+
+        // 9) 零拷贝视图模式：ASCII String → StringView，Bcd → uint64_t（不超过 9 字节）或 BcdChars<位数>
+        if (options.zeroCopyViews) {
+            const viewType = CppTypeMapper.mapViewType(fieldInfo);
+            if (viewType) {
+                return viewType;
+            }
+        }
+
+        // 10) 其他类型：保持原有宽类型设计
         const typeMapping = {
             'Bitfield': 'uint64_t',
             'String': 'std::string',
@@ -156,4 +174,101 @@ export class CppTypeMapper {
         // 未知类型：直接抛出错误，让问题在代码生成期暴露
         throw new Error(`Unknown field type: "${fieldInfo.type}" (field name: "${fieldInfo.fieldName}")`);
     }
+
+    /**
+     * 获取可整块批量读写的数组元素（一次长度检查 + memcpy + 向量化字节交换）
+     * 仅定长整数 / 浮点元素、线上字节数与 C++ 类型一致且无范围校验时可用
+     * @param {FieldInfo} elementInfo - 数组元素字段信息
+     * @returns {Object|null} { cppType, byteOrder }，byteOrder 为 C++ 字节序表达式（元素未覆写时为 ctx.byte_order）；不可批量时返回 null
+     */
+    static mapBulkElement(elementInfo) {
+        const wireSizes = {
+            'int8_t': 1, 'uint8_t': 1, 'int16_t': 2, 'uint16_t': 2,
+            'int32_t': 4, 'uint32_t': 4, 'int64_t': 8, 'uint64_t': 8,
+            'float': 4, 'double': 8
+        };
+        if (!['UnsignedInt', 'SignedInt', 'Float'].includes(elementInfo.type)) {
+            return null;
+        }
+        if (elementInfo.hasRangeValidation()) {
+            return null;
+        }
+        const cppType = CppTypeMapper.mapType(elementInfo);
+        // Float 只配置 precision 时按 C++ 类型的宽度读写
+        const wireLength = elementInfo.type === 'Float' && !elementInfo.byteLength
+            ? wireSizes[cppType]
+            : elementInfo.byteLength;
+        if (wireSizes[cppType] !== wireLength) {
+            return null;
+        }
+        const order = (elementInfo.byteOrder || '').toLowerCase();
+        const byteOrder = order === 'big' ? 'BIG_ENDIAN' : (order === 'little' ? 'LITTLE_ENDIAN' : 'ctx.byte_order');
+        return { cppType, byteOrder };
+    }
+
+    /**
+     * 判断 Bcd 字段是否按十进制整数（uint64_t）存储
+     * 字段配置 valueType: "UnsignedInt"，或零拷贝视图模式下，不超过 BCD_UINT_MAX_BYTES 字节的 Bcd 按整数存储
+     * @param {FieldInfo} fieldInfo - 字段信息对象
+     * @param {Object} options - 映射选项（同 mapType）
+     * @returns {boolean} 是否为整数存储
+     */
+    static isBcdInteger(fieldInfo, options = {}) {
+        if (fieldInfo.type !== 'Bcd' || (fieldInfo.byteLength || 1) > BCD_UINT_MAX_BYTES) {
+            return false;
+        }
+        return fieldInfo.valueType === 'UnsignedInt' || !!options.zeroCopyViews;
+    }
+
+    /**
+     * 整数存储的 Bcd 字段的数字串（默认值、范围）对应的 C++ 整数字面量
+     * 去掉前导零，避免被当作八进制
+     * @param {string|number} digits - 十进制数字串，如 "000123"
+     * @returns {string} 字面量，如 '123ULL'
+     */
+    static bcdIntegerLiteral(digits) {
+        return `${String(digits).replace(/^0+(?=\d)/, '')}ULL`;
+    }
+
+    /**
+     * 获取零拷贝视图模式下 String/Bcd 字段的 C++ 类型
+     * 仅 ASCII String 生成 StringView；UTF-8 / GBK 需要校验或转码，仍为 std::string
+     * @param {FieldInfo} fieldInfo - 字段信息对象
+     * @returns {string|null} 视图类型，非 String/Bcd 或非 ASCII String 返回 null
+     */
+    static mapViewType(fieldInfo) {
+        if (fieldInfo.type === 'String') {
+            return CppTypeMapper.mapStringEncoding(fieldInfo.encoding) === 'STRING_ENCODING_ASCII' ? 'StringView' : null;
+        }
+        if (fieldInfo.type === 'Bcd') {
+            const byteLength = fieldInfo.byteLength || 1;
+            return byteLength <= BCD_UINT_MAX_BYTES ? 'uint64_t' : `BcdChars<${byteLength * 2}>`;
+        }
+        return null;
+    }
+
+    /**
+     * 获取 String 字段 encoding 对应的 C++ 编码常量（protocol_encoding.h 中的 StringEncoding）
+     * 未配置时为 ASCII；无法识别的名称在生成期报错（与 config-parser.js 的 STRING_ENCODING_NAMES 一致）
+     * @param {string} encoding - 配置中的 encoding（"ASCII" / "UTF-8" / "GBK"，不区分大小写）
+     * @returns {string} C++ 实参，如 'STRING_ENCODING_GBK'
+     * @throws {Error} encoding 无法识别时
+     */
+    static mapStringEncoding(encoding) {
+        const constants = {
+            'ASCII': 'STRING_ENCODING_ASCII',
+            'UTF-8': 'STRING_ENCODING_UTF8',
+            'UTF8': 'STRING_ENCODING_UTF8',
+            'GBK': 'STRING_ENCODING_GBK',
+            'CP936': 'STRING_ENCODING_GBK',
+            'GB2312': 'STRING_ENCODING_GBK'
+        };
+        const name = (encoding || 'ASCII').toUpperCase();
+        if (!constants[name]) {
+            throw new Error(
+                `Unsupported string encoding "${encoding}". Supported: ASCII, UTF-8, GBK (aliases UTF8, CP936, GB2312)`
+            );
+        }
+        return constants[name];
+    }
 }
@@ -0,0 +1,173 @@
+/**
+ * 分发表生成（表驱动分发器，dispatch.lookup = "table"）
+ * 为 MessageID → 解码函数 选择查找结构：
+ *   - MessageID 紧凑时生成稠密跳转表，直接下标访问
+ *   - MessageID 稀疏时生成两级完美哈希表（每个桶一个种子，键映射到互不冲突的槽位），
+ *     查找为两次哈希 + 一次比较，与报文类型数量无关
+ *   - 完美哈希在尝试上限内构造失败时，退化为按 MessageID 升序的有序表二分查找
+ * 运行时查找由 protocol_common.h 中的 lookup_dense_handler / lookup_hashed_handler /
+ * lookup_sorted_handler 完成，哈希函数须与 dispatch_hash 保持逐位一致。
+ */
+
+import { isDenseSpan } from './value-map-lookup.js';
+
+const MASK64 = (1n << 64n) - 1n;
+
+// 每个桶尝试的种子数上限（种子以 uint32_t 存储）
+const MAX_SEED_ATTEMPTS = 1 << 16;
+
+// 槽位数相对 nextPow2(键数) 的最大放大倍数（以 2 的幂次计）
+const MAX_SLOT_GROWTH_BITS = 2;
+
+/**
+ * 分发哈希函数（与 protocol_common.h 中的 dispatch_hash 一致）
+ *
+ * @param {bigint} key - MessageID（uint64 表示）
+ * @param {bigint} seed - 种子
+ * @returns {bigint} 64 位哈希值
+ */
+export function dispatchHash(key, seed) {
+    let h = ((key ^ seed) * 0x9E3779B97F4A7C15n) & MASK64;
+    h ^= h >> 29n;
+    h = (h * 0xBF58476D1CE4E5B9n) & MASK64;
+    return h ^ (h >> 32n);
+}
+
+/**
+ * 不小于 n 的最小 2 的幂次的指数
+ *
+ * @param {number} n - 正整数
+ * @returns {number} ceil(log2(n))
+ */
+function ceilLog2(n) {
+    let bits = 0;
+    while ((1 << bits) < n) {
+        bits++;
+    }
+    return bits;
+}
+
+/**
+ * 尝试构造两级完美哈希表
+ *
+ * @param {Array} entries - [{ key, handler }]，key 为 uint64 BigInt
+ * @param {number} slotBits - 槽位数的指数
+ * @param {number} bucketBits - 桶数的指数
+ * @returns {Object|null} { seeds, slots }，失败时返回 null
+ */
+function tryBuildPerfectHash(entries, slotBits, bucketBits) {
+    const slotShift = BigInt(64 - slotBits);
+    const bucketShift = BigInt(64 - bucketBits);
+    const bucketCount = 1 << bucketBits;
+
+    const buckets = Array.from({ length: bucketCount }, (_, index) => ({ index, entries: [] }));
+    for (const entry of entries) {
+        const bucket = bucketBits === 0 ? 0 : Number(dispatchHash(entry.key, 0n) >> bucketShift);
+        buckets[bucket].entries.push(entry);
+    }
+
+    // 大桶优先放置：此时空槽位最多，最容易找到无冲突的种子
+    const order = buckets
+        .filter(bucket => bucket.entries.length > 0)
+        .sort((a, b) => b.entries.length - a.entries.length || a.index - b.index);
+
+    const seeds = new Array(bucketCount).fill(0);
+    const slots = new Array(1 << slotBits).fill(null);
+
+    for (const bucket of order) {
+        let placed = false;
+        for (let seed = 0; seed < MAX_SEED_ATTEMPTS && !placed; ++seed) {
+            const positions = [];
+            for (const entry of bucket.entries) {
+                const slot = Number(dispatchHash(entry.key, BigInt(seed)) >> slotShift);
+                if (slots[slot] !== null || positions.includes(slot)) {
+                    break;
+                }
+                positions.push(slot);
+            }
+            if (positions.length === bucket.entries.length) {
+                positions.forEach((slot, i) => { slots[slot] = bucket.entries[i]; });
+                seeds[bucket.index] = seed;
+                placed = true;
+            }
+        }
+        if (!placed) {
+            return null;
+        }
+    }
+
+    return { seeds, slots };
+}
+
+/**
+ * 构造分发表
+ *
+ * @param {Array} messages - [{ id, handler }]，id 为整数（number/bigint/十进制或 "0x" 字符串），handler 为 C++ 函数名
+ * @returns {Object} 模板上下文：
+ *   - kind: 'dense' | 'hash' | 'sorted'
+ *   - dense: base（C++ 字面量）、base_value / last_value（注释用）、handlers（槽位函数名，空位为 'nullptr'）
+ *   - hash: slot_bits、bucket_bits、seeds、slots（[{ id, handler }]，空槽位为 { id: '0ULL', handler: 'nullptr' }）
+ *   - sorted: slots（按 id 升序）
+ *   - size: 表项数
+ */
+export function buildDispatchTable(messages) {
+    if (!messages || messages.length === 0) {
+        throw new Error('Dispatch table requires at least one message');
+    }
+
+    const byKey = new Map();
+    for (const msg of messages) {
+        const key = BigInt.asUintN(64, BigInt(msg.id));
+        if (byKey.has(key)) {
+            throw new Error(`Duplicate MessageID ${msg.id} in dispatch table`);
+        }
+        byKey.set(key, { key, value: BigInt(msg.id), handler: msg.handler });
+    }
+    const entries = [...byKey.values()].sort((a, b) => (a.key < b.key ? -1 : a.key > b.key ? 1 : 0));
+    const literal = key => `${key}ULL`;
+
+    // 1. 紧凑：稠密跳转表（按有符号取值判断跨度，负数 MessageID 同样适用）
+    const byValue = [...entries].sort((a, b) => (a.value < b.value ? -1 : a.value > b.value ? 1 : 0));
+    const base = byValue[0];
+    const span = byValue[byValue.length - 1].value - base.value + 1n;
+    if (isDenseSpan(span, BigInt(entries.length))) {
+        const handlers = new Array(Number(span)).fill('nullptr');
+        for (const entry of entries) {
+            handlers[Number(entry.value - base.value)] = entry.handler;
+        }
+        return {
+            kind: 'dense',
+            base: literal(base.key),
+            base_value: base.value.toString(),
+            last_value: byValue[byValue.length - 1].value.toString(),
+            handlers,
+            size: handlers.length
+        };
+    }
+
+    // 2. 稀疏：两级完美哈希（平均每桶 2 个键），槽位不足时逐步放大
+    const keyBits = Math.max(1, ceilLog2(entries.length));
+    const bucketBits = Math.max(0, keyBits - 1);
+    for (let slotBits = keyBits; slotBits <= keyBits + MAX_SLOT_GROWTH_BITS; ++slotBits) {
+        const table = tryBuildPerfectHash(entries, slotBits, bucketBits);
+        if (table) {
+            return {
+                kind: 'hash',
+                slot_bits: slotBits,
+                bucket_bits: bucketBits,
+                seeds: table.seeds,
+                slots: table.slots.map(entry => entry
+                    ? { id: literal(entry.key), handler: entry.handler }
+                    : { id: '0ULL', handler: 'nullptr' }),
+                size: table.slots.length
+            };
+        }
+    }
+
+    // 3. 兜底：有序表二分查找
+    return {
+        kind: 'sorted',
+        slots: entries.map(entry => ({ id: literal(entry.key), handler: entry.handler })),
+        size: entries.length
+    };
+}
@@ -21,6 +21,11 @@ function calculateFieldByteLength(field) {
         return 0;
     }
 
+    // 字段级压缩（varint）：线上长度随值变化
+    if (field.compression) {
+        return -1;
+    }
+
     switch (field.type) {
         case 'UnsignedInt':
         case 'SignedInt':
@@ -30,6 +30,7 @@ export class DispatcherGenerator {
      * @param {string} options.templateDir - 模板目录路径
      * @param {string} options.frameworkRelativePath - 框架头文件相对路径（默认：'./'，用于多层级目录结构）
      * @param {boolean} options.skipCopyFramework - 是否跳过复制框架文件（默认：false）
+     * @param {boolean} options.replayTool - 是否生成抓包回放工具 <dispatcher>_replay.cpp（默认：false）
      */
     constructor(dispatcherConfig, options = {}) {
         this.dispatcherConfig = dispatcherConfig;
@@ -37,6 +38,7 @@ export class DispatcherGenerator {
             path.normalize(path.join(__dirname, '../protocol_parser_framework/protocol_common.h'));
         this.frameworkRelativePath = options.frameworkRelativePath || './';
         this.skipCopyFramework = options.skipCopyFramework || false;
+        this.replayTool = options.replayTool || false;
         this.templateDir = options.templateDir;
         this.templateManager = options.templateManager ||
             new TemplateManager(options.templateDir);
@@ -223,7 +225,7 @@ export class DispatcherGenerator {
         logger.log('='.repeat(60) + '\n');
 
         // 打印config配置，进行调试
-        console.debug('Dispatcher Config:', JSON.stringify(this.dispatcherConfig, null, 2));
+        logger.debug('Dispatcher Config:', JSON.stringify(this.dispatcherConfig, null, 2));
 
         // 1. 生成所有子协议代码
         logger.log('Step 1: Generating sub-protocol code...');
@@ -240,6 +242,13 @@ export class DispatcherGenerator {
         await this.generateDispatcherImpl(outputDir);
         logger.log('[OK] Dispatcher implementation generation completed\n');
 
+        // 3b. 生成抓包回放工具（--replay-tool）
+        if (this.replayTool) {
+            logger.log('Step 3b: Generating capture replay tool...');
+            await this.generateReplayTool(outputDir);
+            logger.log('[OK] Capture replay tool generation completed\n');
+        }
+
         // 4. 复制公共头文件（如果未跳过）
         if (!this.skipCopyFramework) {
             logger.log('Step 4: Copying common headers...');
@@ -266,7 +275,7 @@ export class DispatcherGenerator {
             // 从 DispatcherConfig 获取已解析的子协议配置
             const config = msg.config;
 
-            console.debug('Sub Protocol Config:', JSON.stringify(config, null, 2));
+            logger.debug('Sub Protocol Config:', JSON.stringify(config, null, 2));
             
             if (!config) {
                 // Warning 已经在构造函数中输出过了，这里跳过
@@ -325,6 +334,24 @@ export class DispatcherGenerator {
         await writeFile(implPath, implContent, 'utf-8');
     }
 
+    /**
+     * 生成抓包回放工具（独立可执行程序的 main 所在文件）
+     *
+     * @param {string} outputDir - 输出目录路径
+     */
+    async generateReplayTool(outputDir) {
+        const replayContent = this.templateManager.renderDispatcherReplay(
+            this.dispatcherConfig,
+            this.subProtocolInfos
+        );
+
+        const replayFilename = `${this.dispatcherConfig.protocolName.toLowerCase()}_replay.cpp`;
+        const replayPath = path.join(outputDir, replayFilename);
+
+        logger.log(`  - Writing file: ${replayPath}`);
+        await writeFile(replayPath, replayContent, 'utf-8');
+    }
+
     /**
      * 复制公共头文件到输出目录
      *
@@ -341,6 +368,56 @@ export class DispatcherGenerator {
             // 复制 protocol_common.h
             logger.log(`  - Copying: ${this.frameworkSrc} -> ${commonHeaderDst}`);
             await copyFile(this.frameworkSrc, commonHeaderDst);
+
+            // 复制 protocol_common.h 包含的 CPU 特性检测与字符串编码头文件（GBK 映射表单独一个文件）
+            for (const header of ['protocol_cpu.h', 'protocol_encoding.h', 'protocol_gbk_table.h']) {
+                const headerSrc = path.join(path.dirname(this.frameworkSrc), header);
+                const headerDst = path.join(frameworkDir, header);
+                logger.log(`  - Copying: ${headerSrc} -> ${headerDst}`);
+                await copyFile(headerSrc, headerDst);
+            }
+
+            // 复制 protocol_instrumentation.h（生成代码总是包含，-DPROTOCOL_INSTRUMENTATION=1 时才有内容）
+            const instrumentationHeaderSrc = path.join(path.dirname(this.frameworkSrc), 'protocol_instrumentation.h');
+            const instrumentationHeaderDst = path.join(frameworkDir, 'protocol_instrumentation.h');
+            logger.log(`  - Copying: ${instrumentationHeaderSrc} -> ${instrumentationHeaderDst}`);
+            await copyFile(instrumentationHeaderSrc, instrumentationHeaderDst);
+
+            // 复制 protocol_store.h（按 MessageID 分段、按时间范围查询的解码结果存储）
+            const storeHeaderSrc = path.join(path.dirname(this.frameworkSrc), 'protocol_store.h');
+            const storeHeaderDst = path.join(frameworkDir, 'protocol_store.h');
+            logger.log(`  - Copying: ${storeHeaderSrc} -> ${storeHeaderDst}`);
+            await copyFile(storeHeaderSrc, storeHeaderDst);
+
+            // 复制多链路按时间归并 protocol_merge.h 及其依赖的 protocol_timestamp.h
+            for (const header of ['protocol_merge.h', 'protocol_timestamp.h']) {
+                const headerSrc = path.join(path.dirname(this.frameworkSrc), header);
+                const headerDst = path.join(frameworkDir, header);
+                logger.log(`  - Copying: ${headerSrc} -> ${headerDst}`);
+                await copyFile(headerSrc, headerDst);
+            }
+
+            // 配置了流式分帧时复制 protocol_framer.h 和基于分帧器的多核流水线 protocol_pipeline.h、
+            // 录制文件并行批量解码 protocol_batch_decode.h（文件映射用 protocol_capture.h）
+            if (this.dispatcherConfig.framing) {
+                for (const header of ['protocol_framer.h', 'protocol_pipeline.h', 'protocol_batch_decode.h', 'protocol_capture.h']) {
+                    const headerSrc = path.join(path.dirname(this.frameworkSrc), header);
+                    const headerDst = path.join(frameworkDir, header);
+                    logger.log(`  - Copying: ${headerSrc} -> ${headerDst}`);
+                    await copyFile(headerSrc, headerDst);
+                }
+            }
+
+            // 生成回放工具时复制抓包读取与回放统计头文件
+            if (this.replayTool) {
+                const headers = this.dispatcherConfig.framing ? ['protocol_replay.h'] : ['protocol_capture.h', 'protocol_replay.h'];
+                for (const header of headers) {
+                    const headerSrc = path.join(path.dirname(this.frameworkSrc), header);
+                    const headerDst = path.join(frameworkDir, header);
+                    logger.log(`  - Copying: ${headerSrc} -> ${headerDst}`);
+                    await copyFile(headerSrc, headerDst);
+                }
+            }
         } catch (e) {
             logger.error(`Warning: Failed to copy common headers - ${e.message}`);
             logger.error(`Please manually copy ${this.frameworkSrc} to ${path.join(outputDir, 'protocol_parser_framework/protocol_common.h')}`);
@@ -0,0 +1,493 @@
+/**
+ * 协议布局分析器
+ * 识别"全静态布局"协议：顶层字段全部为定长基本类型，每个字段的偏移在生成期即可确定。
+ * 这类协议的 Raw 层可以只做一次长度检查，然后按常量偏移直接读写，
+ * 不再逐字段经过 deserialize_*_fixed / serialize_*_fixed 的边界检查和结果对象构造。
+ */
+
+import { getFieldInfo } from './config-parser.js';
+import { resolveChecksumParams } from './checksum_registry.js';
+import { CppTypeMapper } from './cpp-type-mapper.js';
+
+const UNSIGNED_TYPES = { 1: 'uint8_t', 2: 'uint16_t', 4: 'uint32_t', 8: 'uint64_t' };
+const SIGNED_TYPES = { 1: 'int8_t', 2: 'int16_t', 4: 'int32_t', 8: 'int64_t' };
+
+const CPP_TYPE_SIZES = {
+    uint8_t: 1, uint16_t: 2, uint32_t: 4, uint64_t: 8,
+    int8_t: 1, int16_t: 2, int32_t: 4, int64_t: 8,
+    float: 4, double: 8
+};
+
+/**
+ * 获取 Raw 层字段读写使用的编译期字节序模板实参
+ * 无字段级覆写时使用 *_order<Order>() 的模板参数 Order，
+ * 有覆写时直接固定为 BIG_ENDIAN / LITTLE_ENDIAN
+ *
+ * @param {FieldInfo} fieldInfo - 字段信息
+ * @returns {string} 模板实参
+ */
+export function rawByteOrderArg(fieldInfo) {
+    const order = (fieldInfo.byteOrder || '').toLowerCase();
+    if (order === 'big') {
+        return 'BIG_ENDIAN';
+    }
+    if (order === 'little') {
+        return 'LITTLE_ENDIAN';
+    }
+    return 'Order';
+}
+
+/**
+ * 获取定长标量字段在线上的 C++ 类型（与 Raw 层逐字段解析代码选用的类型一致）
+ *
+ * @param {FieldInfo} fieldInfo - 字段信息
+ * @returns {string|null} C++ 类型，非定长标量返回 null（含字段级压缩的 varint 字段）
+ */
+function wireScalarType(fieldInfo) {
+    const byteLength = fieldInfo.byteLength;
+    if (fieldInfo.compression) {
+        return null;
+    }
+
+    switch (fieldInfo.type) {
+        case 'UnsignedInt':
+            return UNSIGNED_TYPES[byteLength || 4] || null;
+        case 'SignedInt':
+            return SIGNED_TYPES[byteLength || 4] || null;
+        case 'Float':
+            return fieldInfo.precision === 'double' ? 'double' : 'float';
+        case 'Timestamp':
+            return (byteLength || 4) === 8 ? 'uint64_t' : 'uint32_t';
+        case 'MessageId': {
+            const map = fieldInfo.valueType === 'SignedInt' ? SIGNED_TYPES : UNSIGNED_TYPES;
+            return map[byteLength || 2] || null;
+        }
+        case 'Encode': {
+            const map = fieldInfo.baseType === 'signed' ? SIGNED_TYPES : UNSIGNED_TYPES;
+            return map[byteLength || 1] || null;
+        }
+        case 'Bitfield':
+            return UNSIGNED_TYPES[byteLength || 1] || null;
+        default:
+            return null;
+    }
+}
+
+/**
+ * 分析顶层字段是否构成全静态布局
+ *
+ * 返回的每个条目包含：
+ *   - field_name: Raw 结构体成员名（Padding/Reserved 使用与 Raw 结构体一致的索引命名）
+ *   - kind: 'scalar'（定长标量）或 'bytes'（Padding/Reserved 原样字节）
+ *   - cpp_type: 线上 C++ 类型（kind 为 scalar 时有效）
+ *   - offset: 报文内字节偏移
+ *   - byte_length: 字节长度
+ *   - byte_order: 编译期字节序模板实参
+ *
+ * @param {Array} fields - 顶层字段配置数组
+ * @returns {Object|null} { size, fields }；存在变长/复合字段时返回 null
+ */
+export function analyzeFixedLayout(fields) {
+    if (!fields || fields.length === 0) {
+        return null;
+    }
+
+    const entries = [];
+    let offset = 0;
+    let paddingIndex = 0;
+    let reservedIndex = 0;
+
+    for (const field of fields) {
+        const fieldInfo = getFieldInfo(field);
+        const fieldType = fieldInfo.type;
+        const fieldName = fieldInfo.fieldName || '';
+
+        if (fieldType === 'Padding' || fieldType === 'Reserved') {
+            const isPadding = fieldType === 'Padding';
+            const byteLength = isPadding
+                ? (fieldInfo.byteLength || 1)
+                : (fieldInfo.byteLength || Math.ceil((fieldInfo.bitLength || 8) / 8));
+            const indexedName = fieldName ||
+                (isPadding ? `padding_${paddingIndex++}` : `reserved_${reservedIndex++}`);
+
+            entries.push({
+                field_name: indexedName,
+                kind: 'bytes',
+                cpp_type: 'uint8_t',
+                offset: offset,
+                byte_length: byteLength,
+                byte_order: 'Order'
+            });
+            offset += byteLength;
+            continue;
+        }
+
+        const cppType = wireScalarType(fieldInfo);
+        if (!cppType) {
+            return null;
+        }
+
+        entries.push({
+            field_name: fieldType === 'Bitfield' ? `${fieldName}_raw` : fieldName,
+            kind: 'scalar',
+            cpp_type: cppType,
+            offset: offset,
+            byte_length: CPP_TYPE_SIZES[cppType],
+            byte_order: rawByteOrderArg(fieldInfo)
+        });
+        offset += CPP_TYPE_SIZES[cppType];
+    }
+
+    return { size: offset, fields: entries };
+}
+
+// 视图自身的成员函数名，字段访问器不能与之同名
+const VIEW_RESERVED_NAMES = new Set(['bind', 'valid', 'buffer', 'buffer_size', 'build_index']);
+
+/**
+ * 视图中的字段位置：anchor 为 -1 时是常量偏移 delta，
+ * 否则为 index_[anchor]（第 anchor 个变长字段之后的起点）+ delta
+ *
+ * @param {Object} pos - { anchor, delta }
+ * @returns {string} C++ 偏移表达式
+ */
+function viewPosExpr(pos) {
+    if (pos.anchor < 0) {
+        return `${pos.delta}`;
+    }
+    return pos.delta > 0 ? `index_[${pos.anchor}] + ${pos.delta}` : `index_[${pos.anchor}]`;
+}
+
+/**
+ * 分析惰性视图（协议配置 lazyView = true）的字段访问布局
+ *
+ * 从报文起点顺序推进：定长字段的偏移在生成期确定（常量，或相对于前一个变长字段终点的常量差），
+ * 变长字符串（length 为 0，'\0' 结尾）各占一个偏移索引槽，由视图首次访问其后字段时扫描一次并缓存。
+ * 定长 Struct 展开为 <struct>_<sub> 访问器；Array / Command / 变长 Struct 等无法在不解码的情况下
+ * 定位其后字段，视图在此停止，剩余字段记入 skipped。非 ASCII 编码的 String 不生成访问器（同样记入 skipped），
+ * 但不影响其后字段的定位。
+ *
+ * 返回的 accessors 条目：
+ *   - kind: 'scalar' | 'bitfield' | 'string'（定长）| 'cstring'（'\0' 结尾）| 'bcd'
+ *   - name / description / cpp_type / byte_order / byte_length / length
+ *   - pos: C++ 偏移表达式；indexed: 是否依赖偏移索引
+ *   - sub_fields: Bitfield 位段 [{ name, start, width }]
+ * checksums 条目：校验值位置、校验范围 [start, end) 及算法参数（仅顶层 Checksum）
+ *
+ * @param {Array} fields - 顶层字段配置数组
+ * @returns {Object} { accessors, index_steps, index_count, end, min_size, checksums, checksums_indexed, skipped }
+ */
+export function analyzeViewLayout(fields) {
+    const accessors = [];
+    const indexSteps = [];
+    const checksums = [];
+    const skipped = [];
+    const starts = {};
+    const ends = {};
+    let pos = { anchor: -1, delta: 0 };
+    let minSize = 0;
+    let stopped = false;
+
+    const advance = (size) => {
+        pos = { anchor: pos.anchor, delta: pos.delta + size };
+        minSize += size;
+    };
+
+    // 遇到无法定位的字段时置 stopped，之后的顶层字段全部记入 skipped
+    const walk = (levelFields, prefix, topLevel) => {
+        for (let i = 0; i < levelFields.length; ++i) {
+            const fieldInfo = getFieldInfo(levelFields[i]);
+            const fieldType = fieldInfo.type;
+            const name = `${prefix}${fieldInfo.fieldName || ''}`;
+            const description = fieldInfo.description || '';
+            const startPos = pos;
+
+            if (stopped) {
+                if (topLevel) {
+                    skipped.push({ field_name: name, type: fieldType });
+                }
+                continue;
+            }
+
+            if (fieldType === 'Padding' || fieldType === 'Reserved') {
+                advance(fixedWireSize(levelFields[i]));
+            } else if (fieldType === 'Bitfield') {
+                const cppType = wireScalarType(fieldInfo);
+                accessors.push({
+                    kind: 'bitfield',
+                    name: `${name}_raw`,
+                    description,
+                    cpp_type: cppType,
+                    byte_order: rawByteOrderArg(fieldInfo),
+                    pos: viewPosExpr(pos),
+                    indexed: pos.anchor >= 0,
+                    sub_fields: (fieldInfo.subFields || []).map(sub => ({
+                        name: `${name}_${sub.name}`,
+                        start: sub.startBit,
+                        width: sub.endBit - sub.startBit + 1
+                    }))
+                });
+                advance(CPP_TYPE_SIZES[cppType]);
+            } else if (fieldType === 'String') {
+                // 零拷贝只适用于 ASCII：UTF-8 / GBK 字段须经校验或转码，不生成 StringView 访问器，
+                // 但仍推进偏移（多字节序列不含 '\0'），其后字段照常可访问
+                const zeroCopy = CppTypeMapper.mapStringEncoding(fieldInfo.encoding) === 'STRING_ENCODING_ASCII';
+                if (!zeroCopy) {
+                    skipped.push({ field_name: name, type: `${fieldType}, ${fieldInfo.encoding}` });
+                }
+                if (fieldInfo.length > 0) {
+                    if (zeroCopy) {
+                        accessors.push({
+                            kind: 'string', name, description, length: fieldInfo.length,
+                            pos: viewPosExpr(pos), indexed: pos.anchor >= 0
+                        });
+                    }
+                    advance(fieldInfo.length);
+                } else {
+                    if (zeroCopy) {
+                        accessors.push({
+                            kind: 'cstring', name, description,
+                            pos: viewPosExpr(pos), indexed: true, slot: indexSteps.length
+                        });
+                    }
+                    indexSteps.push({ field_name: name, pos: viewPosExpr(pos), slot: indexSteps.length });
+                    pos = { anchor: indexSteps.length - 1, delta: 0 };
+                    minSize += 1;
+                }
+            } else if (fieldType === 'Bcd' && fieldInfo.byteLength > 0) {
+                accessors.push({
+                    kind: 'bcd', name, description, byte_length: fieldInfo.byteLength,
+                    pos: viewPosExpr(pos), indexed: pos.anchor >= 0
+                });
+                advance(fieldInfo.byteLength);
+            } else if (fieldType === 'Struct' && fieldInfo.fields && fieldInfo.fields.length > 0) {
+                walk(fieldInfo.fields, `${name}_`, false);
+                if (stopped) {
+                    // 结构体内部遇到无法定位的字段：已展开的前部子字段仍可访问
+                    if (topLevel) {
+                        skipped.push({ field_name: name, type: fieldType });
+                    }
+                    continue;
+                }
+            } else if (fieldType === 'Checksum' && topLevel) {
+                const params = resolveChecksumParams(fieldInfo);
+                const checksum = {
+                    field_name: name,
+                    field_id: i + 1,
+                    cpp_class: params.cppClass,
+                    return_type: params.returnType,
+                    byte_order: rawByteOrderArg(fieldInfo),
+                    constructor_args: params.constructorArgs.join(', '),
+                    setters: params.setters,
+                    pos: viewPosExpr(pos),
+                    range_start_ref: fieldInfo.rangeStartRef || '',
+                    range_end_ref: fieldInfo.rangeEndRef || ''
+                };
+                checksums.push(checksum);
+                accessors.push({
+                    kind: 'scalar', name, description, cpp_type: params.returnType,
+                    byte_order: checksum.byte_order, pos: checksum.pos, indexed: pos.anchor >= 0
+                });
+                advance(params.byteLength);
+            } else {
+                const cppType = wireScalarType(fieldInfo);
+                if (!cppType) {
+                    stopped = true;
+                    if (topLevel) {
+                        skipped.push({ field_name: name, type: fieldType });
+                    }
+                    continue;
+                }
+                accessors.push({
+                    kind: 'scalar', name, description, cpp_type: cppType,
+                    byte_order: rawByteOrderArg(fieldInfo), pos: viewPosExpr(pos), indexed: pos.anchor >= 0
+                });
+                advance(CPP_TYPE_SIZES[cppType]);
+            }
+
+            if (topLevel) {
+                starts[name] = startPos;
+                ends[name] = pos;
+            }
+        }
+    };
+    walk(fields || [], '', true);
+
+    for (const accessor of accessors) {
+        const names = [accessor.name].concat((accessor.sub_fields || []).map(sub => sub.name));
+        for (const name of names) {
+            if (VIEW_RESERVED_NAMES.has(name)) {
+                throw new Error(`lazyView: field "${name}" conflicts with a <Protocol>View member function`);
+            }
+        }
+    }
+
+    // 校验范围：[rangeStartRef 起点, rangeEndRef 终点)，两端字段都必须在视图可定位的范围内
+    for (const checksum of checksums) {
+        const start = starts[checksum.range_start_ref];
+        const end = ends[checksum.range_end_ref];
+        if (!start || !end) {
+            throw new Error(
+                `lazyView: checksum "${checksum.field_name}" range [${checksum.range_start_ref}, ` +
+                `${checksum.range_end_ref}] is not addressable by the view`
+            );
+        }
+        checksum.start = viewPosExpr(start);
+        checksum.end = viewPosExpr(end);
+        checksum.indexed = start.anchor >= 0 || end.anchor >= 0 || checksum.pos.includes('index_');
+    }
+
+    return {
+        accessors,
+        index_steps: indexSteps,
+        index_count: indexSteps.length,
+        end: viewPosExpr(pos),
+        min_size: minSize,
+        checksums,
+        checksums_indexed: checksums.some(checksum => checksum.indexed),
+        skipped
+    };
+}
+
+// 默认帧长上限（framing.maxFrameLength 未配置且协议非定长时使用）
+const DEFAULT_MAX_FRAME_LENGTH = 65536;
+
+/**
+ * 计算字段在线上的定长字节数（用于定位长度字段的偏移）
+ *
+ * @param {Object} field - 字段配置
+ * @returns {number|null} 字节数；变长字段返回 null
+ */
+function fixedWireSize(field) {
+    const fieldInfo = getFieldInfo(field);
+
+    switch (fieldInfo.type) {
+        case 'Padding':
+            return fieldInfo.byteLength || 1;
+        case 'Reserved':
+            return fieldInfo.byteLength || Math.ceil((fieldInfo.bitLength || 8) / 8);
+        case 'String':
+            return fieldInfo.length > 0 ? fieldInfo.length : null;
+        case 'Bcd':
+            return fieldInfo.byteLength > 0 ? fieldInfo.byteLength : null;
+        case 'Struct': {
+            let size = 0;
+            for (const subField of fieldInfo.fields) {
+                const subSize = fixedWireSize(subField);
+                if (subSize === null) {
+                    return null;
+                }
+                size += subSize;
+            }
+            return size;
+        }
+        default: {
+            const cppType = wireScalarType(fieldInfo);
+            return cppType ? CPP_TYPE_SIZES[cppType] : null;
+        }
+    }
+}
+
+/**
+ * 按字段路径（如 "header.packetLength"）定位长度字段，要求其之前的字段均为定长
+ *
+ * @param {Array} fields - 字段配置数组
+ * @param {Array<string>} path - 字段路径分段
+ * @param {number} baseOffset - 本层字段的起始偏移
+ * @returns {Object} { offset, fieldInfo }
+ */
+function locateFixedField(fields, path, baseOffset) {
+    let offset = baseOffset;
+    for (const field of fields) {
+        const fieldInfo = getFieldInfo(field);
+        if (fieldInfo.fieldName === path[0]) {
+            if (path.length === 1) {
+                return { offset, fieldInfo };
+            }
+            if (fieldInfo.type !== 'Struct') {
+                throw new Error(`framing.lengthField: "${fieldInfo.fieldName}" is not a Struct`);
+            }
+            return locateFixedField(fieldInfo.fields, path.slice(1), offset);
+        }
+        const size = fixedWireSize(field);
+        if (size === null) {
+            throw new Error(
+                `framing.lengthField: field "${fieldInfo.fieldName}" before "${path[0]}" is not fixed-length, ` +
+                `use lengthOffset / lengthSize instead`
+            );
+        }
+        offset += size;
+    }
+    throw new Error(`framing.lengthField: field "${path[0]}" not found`);
+}
+
+/**
+ * 解析流式分帧配置（协议 / 分发器的 framing），生成 FrameSpec 的模板上下文
+ *
+ * 长度来源三选一：
+ *   - lengthField：按字段名定位（仅单协议，要求之前字段定长，字节序取字段覆写或协议默认）
+ *   - lengthOffset + lengthSize：直接给出偏移和字节数（分发器使用）
+ *   - 都不配置：协议为全静态布局时按定长帧处理
+ *
+ * @param {Object|null} framing - framing 配置
+ * @param {Object} options
+ * @param {Array} options.fields - 顶层字段（分发器为空数组）
+ * @param {string} options.defaultByteOrder - 默认字节序 'big' | 'little'
+ * @returns {Object|null} 模板上下文，未配置 framing 时返回 null
+ */
+export function analyzeFraming(framing, { fields = [], defaultByteOrder = 'big' } = {}) {
+    if (!framing) {
+        return null;
+    }
+
+    const syncHex = (framing.syncWord || '').replace(/^0x/i, '');
+    if (syncHex.length % 2 !== 0 || !/^[0-9A-Fa-f]*$/.test(syncHex)) {
+        throw new Error(`framing.syncWord must be an even-length hex byte string, got "${framing.syncWord}"`);
+    }
+    const syncBytes = [];
+    for (let i = 0; i < syncHex.length; i += 2) {
+        syncBytes.push(`0x${syncHex.slice(i, i + 2).toUpperCase()}`);
+    }
+
+    let lengthOffset = 0;
+    let lengthSize = 0;
+    let lengthOrder = (defaultByteOrder || 'big').toLowerCase();
+    let fixedLength = 0;
+
+    if (framing.lengthField) {
+        const { offset, fieldInfo } = locateFixedField(fields, framing.lengthField.split('.'), 0);
+        if (fieldInfo.type !== 'UnsignedInt' || ![1, 2, 4, 8].includes(fieldInfo.byteLength || 4)) {
+            throw new Error(`framing.lengthField "${framing.lengthField}" must be a 1/2/4/8-byte UnsignedInt`);
+        }
+        lengthOffset = offset;
+        lengthSize = fieldInfo.byteLength || 4;
+        lengthOrder = (fieldInfo.byteOrder || lengthOrder).toLowerCase();
+    } else if (framing.lengthSize) {
+        lengthOffset = framing.lengthOffset || 0;
+        lengthSize = framing.lengthSize;
+    } else {
+        const layout = analyzeFixedLayout(fields);
+        if (!layout) {
+            throw new Error('framing requires lengthField or lengthOffset/lengthSize for variable-length protocols');
+        }
+        fixedLength = layout.size;
+    }
+    if (framing.lengthByteOrder) {
+        lengthOrder = framing.lengthByteOrder.toLowerCase();
+    }
+
+    const maxLength = framing.maxFrameLength || fixedLength || DEFAULT_MAX_FRAME_LENGTH;
+    if (fixedLength > maxLength) {
+        throw new Error(`framing.maxFrameLength (${maxLength}) is smaller than the fixed frame length (${fixedLength})`);
+    }
+
+    return {
+        sync_bytes: syncBytes,
+        length_offset: lengthOffset,
+        length_size: lengthSize,
+        length_byte_order: lengthOrder === 'little' ? 'LITTLE_ENDIAN' : 'BIG_ENDIAN',
+        length_adjust: framing.lengthAdjust || 0,
+        fixed_length: fixedLength,
+        max_length: maxLength
+    };
+}
@@ -242,6 +242,7 @@ async function executeGeneration(rawConfig, options, outputDir, configFilePath,
     };
     if (options.templateDir) generatorOptions.templateDir = options.templateDir;
     if (options.frameworkSrc) generatorOptions.frameworkSrc = options.frameworkSrc;
+    if (options.replayTool) generatorOptions.replayTool = true;
 
     // ============================================================
     // 第三步：使用工厂模式创建生成器并生成代码
@@ -296,6 +297,7 @@ async function main() {
         .option('--platform <platform>', '目标平台 (目前仅支持 linux-x86_64)', 'linux-x86_64')
         .option('--cpp-sdk', '生成 C++ SDK (默认启用)', true)
         .option('--no-cpp-sdk', '禁用 C++ SDK 生成')
+        .option('--replay-tool', '为分发器额外生成抓包回放工具 <dispatcher>_replay.cpp（pcap/pcapng/长度前缀文件）', false)
         .addHelpText('after', `
 示例用法:
   # 单协议配置：从配置文件生成代码
@@ -312,6 +314,9 @@ async function main() {
   # 分发器配置：生成多协议分发器
   node main.js dispatcher.json -o ./output
 
+  # 分发器配置：同时生成抓包回放工具（回放录制文件，统计吞吐、各报文类型计数与错误分布）
+  node main.js dispatcher.json -o ./output --replay-tool
+
   # 软件配置：生成完整的软件代码（多层级）
   # 输出结构: output/{softwareName}/{commNodeId}/{nodeId}/*.h, *.cpp
   node main.js software.json -o ./output
@@ -29,12 +29,14 @@ export class SoftwareProcessor {
      * @param {Object} options - 可选配置
      * @param {string} options.frameworkSrc - 公共头文件源路径
      * @param {string} options.templateDir - 模板目录路径
+     * @param {boolean} options.replayTool - 是否为每个分发器生成抓包回放工具（默认：false）
      */
     constructor(softwareConfig, options = {}) {
         this.softwareConfig = softwareConfig;
         this.frameworkSrc = options.frameworkSrc ||
             path.normalize(path.join(__dirname, '../protocol_parser_framework/protocol_common.h'));
         this.templateDir = options.templateDir;
+        this.replayTool = options.replayTool || false;
         this.templateManager = new TemplateManager(options.templateDir);
 
         // 存储生成的文件信息（用于生成接口文件）
@@ -200,12 +202,14 @@ export class SoftwareProcessor {
         const dispatcherConfigDict = {
             protocolName: node.protocolName,
             description: node.description || '',
+            framing: node.framing,
             dispatch: {
                 field: node.dispatch.field,
                 type: node.dispatch.type,
                 byteOrder: node.dispatch.byteOrder,
                 offset: node.dispatch.offset,
-                size: node.dispatch.size
+                size: node.dispatch.size,
+                lookup: node.dispatch.lookup
             },
             messages: node.messages
         };
@@ -218,7 +222,8 @@ export class SoftwareProcessor {
             frameworkSrc: this.frameworkSrc,
             templateDir: this.templateDir,
             frameworkRelativePath: frameworkRelativePath,
-            skipCopyFramework: true  // 框架文件已在软件根目录复制
+            skipCopyFramework: true,  // 框架文件已在软件根目录复制
+            replayTool: this.replayTool
         });
 
         // 生成代码
@@ -255,6 +260,12 @@ export class SoftwareProcessor {
         // 检查并复制其他可能需要的头文件
         const frameworkSrcDir = path.dirname(this.frameworkSrc);
 
+        // protocol_cpu.h / protocol_encoding.h / protocol_gbk_table.h（protocol_common.h 包含）
+        for (const header of ['protocol_cpu.h', 'protocol_encoding.h', 'protocol_gbk_table.h']) {
+            logger.log(`  - Copying: ${header}`);
+            await copyFile(path.join(frameworkSrcDir, header), path.join(frameworkDir, header));
+        }
+
         // protocol_timestamp.h
         const timestampSrc = path.join(frameworkSrcDir, 'protocol_timestamp.h');
         if (existsSync(timestampSrc)) {
@@ -270,6 +281,22 @@ export class SoftwareProcessor {
             logger.log(`  - Copying: protocol_checksum.h`);
             await copyFile(checksumSrc, checksumDst);
         }
+
+        // protocol_framer.h / protocol_pipeline.h / protocol_batch_decode.h / protocol_capture.h /
+        // protocol_compression.h / protocol_instrumentation.h / protocol_store.h / protocol_merge.h
+        // （生成回放工具时另加 protocol_replay.h）
+        const headers = ['protocol_framer.h', 'protocol_pipeline.h', 'protocol_batch_decode.h', 'protocol_capture.h',
+            'protocol_compression.h', 'protocol_instrumentation.h', 'protocol_store.h', 'protocol_merge.h'];
+        if (this.replayTool) {
+            headers.push('protocol_replay.h');
+        }
+        for (const header of headers) {
+            const headerSrc = path.join(frameworkSrcDir, header);
+            if (existsSync(headerSrc)) {
+                logger.log(`  - Copying: ${header}`);
+                await copyFile(headerSrc, path.join(frameworkDir, header));
+            }
+        }
     }
 
     /**
@@ -10,6 +10,9 @@ import { dirname } from 'path';
 import { FieldInfo, getFieldInfo } from './config-parser.js';
 import { getTimestampFunctions } from './timestamp-registry.js';
 import { CppTypeMapper } from './cpp-type-mapper.js';
+import { generateMeaningLookup } from './value-map-lookup.js';
+import { buildDispatchTable } from './dispatch-table.js';
+import { analyzeFraming } from './layout-analyzer.js';
 
 // 获取当前文件的目录（ES Module 中需要手动实现 __dirname）
 const __filename = fileURLToPath(import.meta.url);
@@ -84,7 +87,8 @@ export class TemplateManager {
     // 分发器模板映射 (Tagged Union 版本)
     static DISPATCHER_TEMPLATE_MAP = {
         'header': 'dispatcher/dispatcher_tagged_union.h.template',
-        'impl': 'dispatcher/dispatcher_tagged_union.cpp.template'
+        'impl': 'dispatcher/dispatcher_tagged_union.cpp.template',
+        'replay': 'dispatcher/dispatcher_replay.cpp.template'
     };
 
     /**
@@ -236,6 +240,8 @@ export class TemplateManager {
             fill_value: fieldInfo.fillValue,
             length: fieldInfo.length,
             encoding: fieldInfo.encoding,
+            encoding_arg: fieldInfo.type === 'String' ? CppTypeMapper.mapStringEncoding(fieldInfo.encoding) : null,
+            bcd_integer: CppTypeMapper.isBcdInteger(fieldInfo),  // Bcd 按十进制整数存储（valueType: "UnsignedInt"）
             has_range: fieldInfo.hasRangeValidation(),
             is_single_range: ranges && ranges.length === 1,
             ranges: ranges,
@@ -252,6 +258,39 @@ export class TemplateManager {
             maps: fieldInfo.maps  // 用于 Encode 类型的值映射
         };
 
+        // Bcd 整数模式：范围端点生成为整数字面量
+        if (context.bcd_integer) {
+            context.ranges = ranges.map(range => ({
+                min: CppTypeMapper.bcdIntegerLiteral(range.min),
+                max: CppTypeMapper.bcdIntegerLiteral(range.max)
+            }));
+        }
+
+        // Encode 值映射：预生成含义查找代码（稠密数组 / 有序表）
+        if (fieldInfo.type === 'Encode') {
+            context.meaning_lookup = generateMeaningLookup({
+                maps: fieldInfo.maps,
+                tableName: `${fieldInfo.fieldName}_meanings`,
+                valueExpr: `${fieldInfo.fieldName}_raw`,
+                targetExpr: `${resultStructType}.${fieldInfo.fieldName}_meaning`,
+                fallback: 'Unknown'
+            }).join('\n');
+        }
+
+        // Bitfield 值映射：为每个带 maps 的位段预生成含义查找代码
+        if (fieldInfo.type === 'Bitfield' && fieldInfo.subFields) {
+            context.sub_fields = fieldInfo.subFields.map(subField => Object.assign({}, subField, {
+                meaning_lookup: generateMeaningLookup({
+                    maps: subField.maps,
+                    tableName: `${fieldInfo.fieldName}_${subField.name}_meanings`,
+                    valueExpr: `${subField.name}_value`,
+                    targetExpr: `${resultStructType}.${fieldInfo.fieldName}.${subField.name}_meaning`,
+                    fallback: '',
+                    indent: '        '
+                }).join('\n')
+            }));
+        }
+
         // Timestamp 特殊处理：添加单位转换函数名
         if (fieldInfo.type === 'Timestamp' && fieldInfo.unit) {
             try {
@@ -305,7 +344,14 @@ export class TemplateManager {
                 context.element_size = this._calculateElementSize(fieldInfo.element);
             }
 
-            // 3. 生成元素解析代码
+            // 3. 定长整数 / 浮点元素走批量路径（整块拷贝，不逐元素解析）
+            const bulkElement = fieldInfo.element ? CppTypeMapper.mapBulkElement(getFieldInfo(fieldInfo.element)) : null;
+            if (bulkElement) {
+                context.bulk_element_type = bulkElement.cppType;
+                context.bulk_byte_order = bulkElement.byteOrder;
+            }
+
+            // 4. 生成元素解析代码
             context.element_parse_code = this._generateElementParseCode(fieldInfo, resultStructType);
         }
 
@@ -582,7 +628,7 @@ export class TemplateManager {
     /**
      * 获取分发器模板路径
      *
-     * @param {string} templateType - 模板类型（'header' 或 'impl'）
+     * @param {string} templateType - 模板类型（'header'、'impl' 或 'replay'）
      * @returns {string|null} 模板文件路径
      */
     getDispatcherTemplatePath(templateType) {
@@ -604,6 +650,15 @@ export class TemplateManager {
      * @returns {Object} 模板上下文
      */
     prepareDispatcherContext(dispatcherConfig, subProtocolInfos) {
+        // 表驱动分发：MessageID → decode_<子协议> 的跳转表 / 完美哈希表
+        const useTable = dispatcherConfig.getDispatchLookup() === 'table' && subProtocolInfos.length > 0;
+        const dispatchTable = useTable
+            ? buildDispatchTable(subProtocolInfos.map(msg => ({
+                id: msg.id_value,
+                handler: `decode_${msg.protocol_name}`
+            })))
+            : null;
+
         return {
             // 分发器基本信息
             protocol_name: dispatcherConfig.protocolName,
@@ -625,7 +680,15 @@ export class TemplateManager {
 
             // 子协议列表
             messages: subProtocolInfos,
-            has_messages: subProtocolInfos.length > 0
+            has_messages: subProtocolInfos.length > 0,
+
+            // 表驱动分发表（未启用时为 null）
+            dispatch_table: dispatchTable,
+
+            // 流式分帧参数（未配置 framing 时为 null）
+            framing: analyzeFraming(dispatcherConfig.framing, {
+                defaultByteOrder: dispatcherConfig.getDefaultByteOrder()
+            })
         };
     }
 
@@ -662,4 +725,21 @@ export class TemplateManager {
         const context = this.prepareDispatcherContext(dispatcherConfig, subProtocolInfos);
         return this.renderTemplate(templatePath, context);
     }
+
+    /**
+     * 渲染分发器抓包回放工具（<dispatcher>_replay.cpp，含 main）
+     *
+     * @param {DispatcherConfig} dispatcherConfig - 分发器配置
+     * @param {Array} subProtocolInfos - 子协议信息数组
+     * @returns {string} 渲染后的回放工具源文件内容
+     */
+    renderDispatcherReplay(dispatcherConfig, subProtocolInfos) {
+        const templatePath = this.getDispatcherTemplatePath('replay');
+        if (!templatePath) {
+            throw new Error('Dispatcher replay template not found');
+        }
+
+        const context = this.prepareDispatcherContext(dispatcherConfig, subProtocolInfos);
+        return this.renderTemplate(templatePath, context);
+    }
 }
@@ -0,0 +1,161 @@
+/**
+ * 值映射查找代码生成
+ * 为 Encode / Bitfield 的 maps 生成常数时间（或对数时间）的含义查找代码，替代逐项比较：
+ *   - 取值紧凑（跨度不超过映射项数的 2 倍或不超过 16）时生成稠密数组，直接下标访问
+ *   - 取值稀疏时生成按 value 升序排列的 ValueMeaning 表，二分查找
+ * 两种方式均调用 protocol_common.h 中的 lookup_dense_meaning / lookup_sorted_meaning，返回静态字符串。
+ */
+
+// 稠密数组的最大长度，超过后即使紧凑也改用有序表，避免生成过大的数组
+const MAX_DENSE_SPAN = 4096n;
+
+// 跨度不超过此值时始终使用稠密数组
+const SMALL_DENSE_SPAN = 16n;
+
+const INT64_MIN = -(2n ** 63n);
+const INT64_MAX = 2n ** 63n - 1n;
+
+/**
+ * 判断取值跨度是否足够紧凑，适合生成稠密数组（值映射与分发跳转表共用）
+ *
+ * @param {bigint} span - 取值跨度（最大值 - 最小值 + 1）
+ * @param {bigint} count - 取值个数
+ * @returns {boolean} 是否使用稠密数组
+ */
+export function isDenseSpan(span, count) {
+    const compact = span <= SMALL_DENSE_SPAN || span <= count * 2n;
+    return compact && span <= MAX_DENSE_SPAN;
+}
+
+/**
+ * 将映射值解析为 BigInt（支持整数和 "0x" / "-0x" 前缀的十六进制字符串）
+ *
+ * @param {number|string} value - 映射值
+ * @returns {bigint} 解析结果
+ */
+function parseMapValue(value) {
+    if (typeof value === 'bigint') {
+        return value;
+    }
+    if (typeof value === 'number') {
+        if (!Number.isInteger(value)) {
+            throw new Error(`Value map key must be an integer, got ${value}`);
+        }
+        return BigInt(value);
+    }
+    const text = String(value).trim();
+    const negative = text.startsWith('-');
+    const parsed = BigInt(negative ? text.slice(1) : text);
+    return negative ? -parsed : parsed;
+}
+
+/**
+ * 转义为 C++ 字符串字面量内容
+ *
+ * @param {string} text - 原始字符串
+ * @returns {string} 转义后的字符串（不含两侧引号）
+ */
+function escapeCppString(text) {
+    return String(text)
+        .replace(/\\/g, '\\\\')
+        .replace(/"/g, '\\"')
+        .replace(/\n/g, '\\n')
+        .replace(/\r/g, '\\r')
+        .replace(/\t/g, '\\t');
+}
+
+/**
+ * int64 整数字面量（INT64_MIN 无法直接写成字面量，需要拆成表达式）
+ *
+ * @param {bigint} value - 数值
+ * @returns {string} C++ 字面量
+ */
+function int64Literal(value) {
+    if (value === INT64_MIN) {
+        return '(-9223372036854775807LL - 1)';
+    }
+    return `${value}LL`;
+}
+
+/**
+ * 分析值映射表，选择查找方式
+ * 重复的取值以最后一项为准（与逐项比较的覆盖语义一致）
+ *
+ * @param {Array} maps - 值映射数组 [{ value, meaning }]
+ * @returns {Object|null} { kind: 'dense'|'sorted', base, span, entries: [{ value, meaning }] }，maps 为空时返回 null
+ */
+export function analyzeValueMap(maps) {
+    if (!maps || maps.length === 0) {
+        return null;
+    }
+
+    const byValue = new Map();
+    for (const map of maps) {
+        const value = parseMapValue(map.value);
+        if (value < INT64_MIN || value > INT64_MAX) {
+            throw new Error(`Value map key ${map.value} is out of int64 range`);
+        }
+        byValue.set(value, map.meaning === undefined || map.meaning === null ? '' : String(map.meaning));
+    }
+
+    const entries = [...byValue.entries()]
+        .map(([value, meaning]) => ({ value, meaning }))
+        .sort((a, b) => (a.value < b.value ? -1 : a.value > b.value ? 1 : 0));
+
+    const base = entries[0].value;
+    const span = entries[entries.length - 1].value - base + 1n;
+
+    return {
+        kind: isDenseSpan(span, BigInt(entries.length)) ? 'dense' : 'sorted',
+        base,
+        span,
+        entries
+    };
+}
+
+/**
+ * 生成含义查找代码
+ *
+ * @param {Object} options
+ * @param {Array} options.maps - 值映射数组
+ * @param {string} options.tableName - 查找表变量名（同一函数内需唯一）
+ * @param {string} options.valueExpr - 取值表达式
+ * @param {string} options.targetExpr - 含义赋值目标
+ * @param {string} options.fallback - 未命中时的含义
+ * @param {string} options.indent - 缩进
+ * @returns {Array<string>} 代码行；maps 为空时返回空数组
+ */
+export function generateMeaningLookup({ maps, tableName, valueExpr, targetExpr, fallback = 'Unknown', indent = '    ' }) {
+    const table = analyzeValueMap(maps);
+    if (!table) {
+        return [];
+    }
+
+    const lines = [];
+    const fallbackLiteral = `"${escapeCppString(fallback)}"`;
+
+    if (table.kind === 'dense') {
+        const slots = new Array(Number(table.span)).fill('nullptr');
+        for (const entry of table.entries) {
+            slots[Number(entry.value - table.base)] = `"${escapeCppString(entry.meaning)}"`;
+        }
+        lines.push(`${indent}// 值映射：稠密数组直接下标（取值 ${table.base} ~ ${table.base + table.span - 1n}）`);
+        lines.push(`${indent}static const char* const ${tableName}[${slots.length}] = {`);
+        for (let i = 0; i < slots.length; ++i) {
+            lines.push(`${indent}    ${slots[i]}${i + 1 < slots.length ? ',' : ''}`);
+        }
+        lines.push(`${indent}};`);
+        lines.push(`${indent}${targetExpr} = lookup_dense_meaning(${tableName}, ${slots.length}, ${int64Literal(table.base)}, ${valueExpr}, ${fallbackLiteral});`);
+    } else {
+        lines.push(`${indent}// 值映射：有序表二分查找（${table.entries.length} 项）`);
+        lines.push(`${indent}static const ValueMeaning ${tableName}[${table.entries.length}] = {`);
+        table.entries.forEach((entry, i) => {
+            const comma = i + 1 < table.entries.length ? ',' : '';
+            lines.push(`${indent}    { ${int64Literal(entry.value)}, "${escapeCppString(entry.meaning)}" }${comma}`);
+        });
+        lines.push(`${indent}};`);
+        lines.push(`${indent}${targetExpr} = lookup_sorted_meaning(${tableName}, ${table.entries.length}, ${valueExpr}, ${fallbackLiteral});`);
+    }
+
+    return lines;
+}
@@ -0,0 +1,558 @@
+#ifndef PROTOCOL_BATCH_DECODE_H
+#define PROTOCOL_BATCH_DECODE_H
+
+#include "protocol_common.h"
+#include "protocol_framer.h"
+#include "protocol_capture.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 编译需要线程库：g++ -std=c++11 -pthread
+
+namespace protocol_parser {
+
+// ============================================================================
+// 录制文件并行批量解码
+//
+// 把整个录制文件（连续字节流，按 FrameSpec 的同步字 / 长度字段分帧）切成若干块，
+// 多个线程从工作窃取队列领取块，各块从块起始处独立重新同步、分帧并解码，结果写入该块自己的 sink，
+// 全部完成后按块顺序交给 merge 合并。输出与单线程 StreamFramer 顺序处理整个文件完全一致：
+//
+// - 分帧是确定性的「从查找位置 q 出发」过程：取 q 之后第一个同步字，长度非法（或 reject_failed 时
+//   解码失败）则从其后 1 字节继续，否则输出该帧并从帧尾继续。块只输出起始位置落在本块内的帧，
+//   帧可以越过块尾（整个文件已映射）
+// - 接缝处理：前一块真正的结束查找位置 p 在本块起始之后时（前一块最后一帧跨入本块），
+//   若本块推测出的第一帧起始 ≥ p，两条路径从此重合，推测结果直接可用；否则说明推测的前几帧落在
+//   前一帧内部（伪同步字），按 p 串行前进几帧直到与推测路径重合，该块整块重新解码（罕见）
+// - 无同步字的 FrameSpec 无法从任意位置重新同步，整个文件作为一块处理
+//
+// 约束：decode 只能依赖帧字节本身（同一帧多次解码结果相同）；Sink 需可默认构造、可移动赋值
+//
+// 用法：
+//   struct CountSink {                              // 每块一个
+//       uint64_t frames = 0;
+//       void operator()(const BatchDecodeItem<XxxDispatcherResult>& item) { ++frames; }
+//   };
+//   BatchDecoder<XxxDispatcherResult> decoder(Xxx_frame_spec(), config);
+//   BatchDecodeStats stats;
+//   std::string error;
+//   decoder.run_file<CountSink>("link.bin",
+//       [](const uint8_t* data, size_t length, XxxDispatcherResult& result) {
+//           return deserialize_XxxDispatcher(data, length, result);
+//       },
+//       [&](CountSink& chunk) { total += chunk.frames; },    // 按文件顺序调用
+//       stats, error);
+// ============================================================================
+
+struct BatchDecodeConfig {
+    size_t workers;          // 解码线程数（含调用线程），0 表示全部硬件线程
+    size_t chunk_size;       // 块大小（字节），0 表示自动：每线程约 16 块，介于 1 MB 与 256 MB 之间
+    bool reject_failed;      // 解码失败的帧视为伪同步字，从其后 1 字节重新同步（同 StreamFramer::reject）；
+                             // 否则照常输出（status 为失败）并从帧尾继续
+
+    BatchDecodeConfig() : workers(0), chunk_size(0), reject_failed(false) {}
+};
+
+struct BatchDecodeStats {
+    uint64_t bytes;            // 文件字节数
+    uint64_t frames;           // 输出的帧数
+    uint64_t decoded;          // 解码成功
+    uint64_t failed;           // 解码失败（reject_failed 为 false 时）
+    uint64_t rejected;         // 解码失败后重新同步的候选帧（reject_failed 为 true 时；可能含接缝处前一帧内部的伪帧）
+    uint64_t bytes_discarded;  // 未落在任何输出帧内的字节（噪声、伪同步字、末尾不完整的帧）
+    size_t workers;
+    size_t chunks;
+    size_t chunks_redone;      // 接缝处推测失败、整块重新解码的块数
+    size_t steals;             // 从其他线程队列窃取的块数
+    double seconds;            // 分帧 + 解码 + 接缝处理耗时（不含 merge）
+
+    BatchDecodeStats()
+        : bytes(0), frames(0), decoded(0), failed(0), rejected(0), bytes_discarded(0)
+        , workers(0), chunks(0), chunks_redone(0), steals(0), seconds(0.0) {}
+};
+
+// 传给 sink 的单帧结果；frame 指向映射内存，result 为解码线程复用的对象，均只在回调期间有效
+template<typename Result>
+struct BatchDecodeItem {
+    uint64_t offset;             // 帧在文件中的偏移
+    FrameSpan frame;
+    DeserializeStatus status;
+    const Result& result;
+
+    BatchDecodeItem(uint64_t frame_offset, const uint8_t* data, size_t length,
+                    const DeserializeStatus& decode_status, const Result& decode_result)
+        : offset(frame_offset), status(decode_status), result(decode_result)
+    {
+        frame.data = data;
+        frame.length = length;
+    }
+};
+
+namespace batch_detail {
+
+const size_t CACHE_LINE = 64;
+const size_t HEAD_RECORDS = 32;      // 每块记录的推测路径前几帧（用于接缝处判断路径是否重合）
+
+// 每个线程一段连续的任务编号 [begin, end)：本线程从头部取，其他线程从尾部窃取
+// 两端打包在同一个 64 位原子变量中，CAS 保证同一任务只被取走一次
+class TaskRange {
+public:
+    TaskRange() : range_(0) {}
+
+    void assign(uint32_t begin, uint32_t end) {
+        range_.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    bool pop_front(uint32_t& task) {
+        uint64_t current = range_.load(std::memory_order_relaxed);
+        for (;;) {
+            const uint32_t begin = static_cast<uint32_t>(current);
+            const uint32_t end = static_cast<uint32_t>(current >> 32);
+            if (begin >= end) {
+                return false;
+            }
+            if (range_.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel)) {
+                task = begin;
+                return true;
+            }
+        }
+    }
+
+    bool steal_back(uint32_t& task) {
+        uint64_t current = range_.load(std::memory_order_relaxed);
+        for (;;) {
+            const uint32_t begin = static_cast<uint32_t>(current);
+            const uint32_t end = static_cast<uint32_t>(current >> 32);
+            if (begin >= end) {
+                return false;
+            }
+            if (range_.compare_exchange_weak(current, pack(begin, end - 1), std::memory_order_acq_rel)) {
+                task = end - 1;
+                return true;
+            }
+        }
+    }
+
+private:
+    std::atomic<uint64_t> range_;
+    char padding_[CACHE_LINE - sizeof(std::atomic<uint64_t>)];
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(end) << 32) | begin;
+    }
+};
+
+// 在 workers 个线程（调用线程为 0 号）上执行 task_count 个任务：fn(worker, task)
+// 任务按编号连续分段分给各线程（相邻块由同一线程顺序处理），空闲线程从其他线程尾部窃取
+template<typename Fn>
+size_t run_work_stealing(size_t workers, size_t task_count, Fn& fn) {
+    if (task_count == 0) {
+        return 0;
+    }
+    if (workers > task_count) {
+        workers = task_count;
+    }
+    std::vector<TaskRange> ranges(workers);
+    for (size_t w = 0; w < workers; ++w) {
+        ranges[w].assign(static_cast<uint32_t>(task_count * w / workers),
+                         static_cast<uint32_t>(task_count * (w + 1) / workers));
+    }
+    std::atomic<size_t> steals(0);
+
+    struct Loop {
+        static void run(size_t worker, std::vector<TaskRange>& ranges, std::atomic<size_t>& steals, Fn& fn) {
+            const size_t count = ranges.size();
+            uint32_t task;
+            for (;;) {
+                if (ranges[worker].pop_front(task)) {
+                    fn(worker, task);
+                    continue;
+                }
+                bool stolen = false;
+                for (size_t i = 1; i < count && !stolen; ++i) {
+                    stolen = ranges[(worker + i) % count].steal_back(task);
+                }
+                if (!stolen) {
+                    return;   // 任务只减不增：所有队列都为空即全部完成
+                }
+                steals.fetch_add(1, std::memory_order_relaxed);
+                fn(worker, task);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; ++w) {
+        threads.push_back(std::thread(&Loop::run, w, std::ref(ranges), std::ref(steals), std::ref(fn)));
+    }
+    Loop::run(0, ranges, steals, fn);
+    for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    return steals.load();
+}
+
+// 推测路径上的一帧：从查找位置 search 出发找到的帧起始 start（stop 表示在此遇到文件末尾不完整的帧）
+struct WalkRecord {
+    uint64_t search;
+    uint64_t start;
+    bool stop;
+};
+
+struct WalkCounters {
+    uint64_t frames;
+    uint64_t decoded;
+    uint64_t failed;
+    uint64_t rejected;
+    uint64_t framed_bytes;
+
+    WalkCounters() : frames(0), decoded(0), failed(0), rejected(0), framed_bytes(0) {}
+};
+
+const uint64_t NO_STOP = ~static_cast<uint64_t>(0);
+
+} // namespace batch_detail
+
+template<typename Result>
+class BatchDecoder {
+public:
+    typedef BatchDecodeItem<Result> Item;
+
+    explicit BatchDecoder(const FrameSpec& spec, const BatchDecodeConfig& config = BatchDecodeConfig())
+        : spec_(spec), config_(config), header_length_(frame_header_length(spec)) {}
+
+    // 解码 [data, data + length)；sink 每块一个（Sink()），merge(Sink&) 在调用线程按块顺序调用
+    // decode: DeserializeStatus (const uint8_t* data, size_t length, Result& result)，每个线程一份拷贝
+    template<typename Sink, typename Decoder, typename Merge>
+    BatchDecodeStats run(const uint8_t* data, size_t length, Decoder decode, Merge merge) {
+        const std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+        BatchDecodeStats stats;
+        stats.bytes = length;
+
+        size_t workers = config_.workers;
+        if (workers == 0) {
+            workers = std::thread::hardware_concurrency();
+        }
+        if (workers == 0) {
+            workers = 1;
+        }
+        std::vector<Chunk> chunks;
+        split_chunks(length, workers, chunks);
+        if (workers > chunks.size()) {
+            workers = chunks.size() > 0 ? chunks.size() : 1;
+        }
+        stats.workers = workers;
+        stats.chunks = chunks.size();
+
+        std::vector<Sink> sinks(chunks.size());
+        std::vector<Decoder> decoders(workers, decode);
+        std::vector<Result> results(workers);
+
+        // 1. 各块从块起始处推测解码
+        ChunkTask<Sink, Decoder> speculate(*this, data, length, chunks, sinks, decoders, results, nullptr);
+        stats.steals += batch_detail::run_work_stealing(workers, chunks.size(), speculate);
+
+        // 2. 按文件顺序串行处理接缝，确定需要重新解码的块
+        std::vector<uint32_t> redo;
+        reconcile(data, length, chunks, decoders[0], results[0], redo);
+
+        // 3. 重新解码推测失败的块（从真正的查找位置出发）
+        for (size_t i = 0; i < redo.size(); ++i) {
+            sinks[redo[i]] = Sink();
+        }
+        ChunkTask<Sink, Decoder> fixup(*this, data, length, chunks, sinks, decoders, results, &redo);
+        stats.steals += batch_detail::run_work_stealing(workers, redo.size(), fixup);
+        stats.chunks_redone = redo.size();
+
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            stats.frames += chunks[i].counters.frames;
+            stats.decoded += chunks[i].counters.decoded;
+            stats.failed += chunks[i].counters.failed;
+            stats.rejected += chunks[i].counters.rejected;
+            stats.bytes_discarded += chunks[i].counters.framed_bytes;
+        }
+        stats.bytes_discarded = length - stats.bytes_discarded;
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        // 4. 按顺序合并（合并后立即释放该块的 sink）
+        for (size_t i = 0; i < sinks.size(); ++i) {
+            merge(sinks[i]);
+            sinks[i] = Sink();
+        }
+        return stats;
+    }
+
+    // 映射文件后解码；打开失败时返回 false，error 为原因
+    template<typename Sink, typename Decoder, typename Merge>
+    bool run_file(const char* path, Decoder decode, Merge merge, BatchDecodeStats& stats, std::string& error) {
+        MappedFile file;
+        if (!file.open(path, error)) {
+            return false;
+        }
+        stats = run<Sink>(file.data(), file.size(), decode, merge);
+        return true;
+    }
+
+    const FrameSpec& spec() const { return spec_; }
+    const BatchDecodeConfig& config() const { return config_; }
+
+private:
+    struct Chunk {
+        uint64_t begin;          // 本块负责起始位置在 [begin, end) 内的帧
+        uint64_t end;
+        uint64_t entry;          // 本块路径的起始查找位置（推测时为 begin，重新解码时为真正的位置）
+        uint64_t exit;           // 路径结束后的查找位置（≥ end；遇到末尾不完整的帧时为文件长度）
+        std::vector<batch_detail::WalkRecord> head;  // 推测路径的前几帧
+        bool head_complete;      // head 是否覆盖了推测路径的全部帧
+        uint64_t tail_search;    // head_complete 时最后一帧之后的查找位置
+        batch_detail::WalkCounters counters;
+
+        Chunk() : begin(0), end(0), entry(0), exit(0), head_complete(true), tail_search(0) {}
+    };
+
+    // 对一块执行分帧 + 解码；redo 非空时任务编号映射到 redo 列表中的块
+    template<typename Sink, typename Decoder>
+    struct ChunkTask {
+        BatchDecoder& owner;
+        const uint8_t* data;
+        uint64_t length;
+        std::vector<Chunk>& chunks;
+        std::vector<Sink>& sinks;
+        std::vector<Decoder>& decoders;
+        std::vector<Result>& results;
+        const std::vector<uint32_t>* redo;
+
+        ChunkTask(BatchDecoder& decoder_owner, const uint8_t* file_data, uint64_t file_length,
+                  std::vector<Chunk>& all_chunks, std::vector<Sink>& all_sinks,
+                  std::vector<Decoder>& worker_decoders, std::vector<Result>& worker_results,
+                  const std::vector<uint32_t>* redo_list)
+            : owner(decoder_owner), data(file_data), length(file_length), chunks(all_chunks), sinks(all_sinks)
+            , decoders(worker_decoders), results(worker_results), redo(redo_list) {}
+
+        void operator()(size_t worker, uint32_t task) {
+            const size_t index = redo != nullptr ? (*redo)[task] : task;
+            Chunk& chunk = chunks[index];
+            Sink& sink = sinks[index];
+            chunk.counters = batch_detail::WalkCounters();
+            const bool record = (redo == nullptr);
+            if (record) {
+                chunk.entry = chunk.begin;
+                chunk.head.clear();
+                chunk.head_complete = true;
+                chunk.tail_search = chunk.begin;
+            }
+            uint64_t stop_search = batch_detail::NO_STOP;
+            uint64_t stop_at = batch_detail::NO_STOP;
+            chunk.exit = owner.walk(data, length, chunk.entry, chunk.end, decoders[worker], results[worker],
+                chunk.counters, stop_search, stop_at,
+                [&](uint64_t search, uint64_t start, uint64_t frame_length, const DeserializeStatus& status,
+                    const Result& result) {
+                    if (record) {
+                        owner.record_head(chunk, search, start, start + frame_length);
+                    }
+                    sink(Item(start, data + start, static_cast<size_t>(frame_length), status, result));
+                    return true;
+                });
+            if (record && stop_at != batch_detail::NO_STOP) {
+                owner.record_stop(chunk, stop_search, stop_at);
+            }
+        }
+    };
+
+    FrameSpec spec_;
+    BatchDecodeConfig config_;
+    size_t header_length_;
+
+    void split_chunks(uint64_t length, size_t workers, std::vector<Chunk>& chunks) const {
+        uint64_t chunk_size = config_.chunk_size;
+        if (chunk_size == 0) {
+            chunk_size = length / (static_cast<uint64_t>(workers) * 16);
+            const uint64_t minimum = 1u << 20;
+            const uint64_t maximum = 256u << 20;
+            chunk_size = chunk_size < minimum ? minimum : (chunk_size > maximum ? maximum : chunk_size);
+        }
+        // 块数不超过任务编号范围
+        if (length / chunk_size >= 0x7FFFFFFFu) {
+            chunk_size = length / 0x7FFFFFFFu + 1;
+        }
+        if (spec_.sync_length == 0 || length <= chunk_size) {
+            chunk_size = length > 0 ? length : 1;   // 无同步字无法从任意位置重新同步：整个文件一块
+        }
+        for (uint64_t begin = 0; begin < length; begin += chunk_size) {
+            Chunk chunk;
+            chunk.begin = begin;
+            chunk.end = (length - begin > chunk_size) ? begin + chunk_size : length;
+            chunks.push_back(chunk);
+        }
+    }
+
+    void record_head(Chunk& chunk, uint64_t search, uint64_t start, uint64_t next_search) const {
+        if (!chunk.head_complete) {
+            return;
+        }
+        if (chunk.head.size() == batch_detail::HEAD_RECORDS) {
+            chunk.head_complete = false;
+            return;
+        }
+        batch_detail::WalkRecord record;
+        record.search = search;
+        record.start = start;
+        record.stop = false;
+        chunk.head.push_back(record);
+        chunk.tail_search = next_search;
+    }
+
+    void record_stop(Chunk& chunk, uint64_t search, uint64_t start) const {
+        if (!chunk.head_complete) {
+            return;
+        }
+        if (chunk.head.size() == batch_detail::HEAD_RECORDS) {
+            chunk.head_complete = false;
+            return;
+        }
+        batch_detail::WalkRecord record;
+        record.search = search;
+        record.start = start;
+        record.stop = true;
+        chunk.head.push_back(record);
+    }
+
+    // 分帧路径：从 search 出发，只处理起始位置 < limit 的帧；on_frame(...) 返回 false 时提前结束
+    // 返回下一个查找位置（≥ limit 表示本块结束）；遇到文件末尾不完整的帧时记录 stop_search / stop_at 并返回 length
+    template<typename Decoder, typename OnFrame>
+    uint64_t walk(const uint8_t* data, uint64_t length, uint64_t search, uint64_t limit,
+                  Decoder& decode, Result& result, batch_detail::WalkCounters& counters,
+                  uint64_t& stop_search, uint64_t& stop_at, OnFrame on_frame) const {
+        while (search < limit) {
+            uint64_t candidate = search;
+            if (spec_.sync_length > 0) {
+                // 候选起始位置 < limit，同步字本身可以越过块尾
+                uint64_t scan_end = limit + spec_.sync_length - 1;
+                if (scan_end > length) {
+                    scan_end = length;
+                }
+                const uint8_t* found = find_sync_pattern(data + search, static_cast<size_t>(scan_end - search),
+                                                         spec_.sync, spec_.sync_length);
+                if (found == nullptr) {
+                    return limit;
+                }
+                candidate = static_cast<uint64_t>(found - data);
+            }
+            if (length - candidate < header_length_) {
+                stop_search = search;
+                stop_at = candidate;
+                return length;
+            }
+            const uint64_t frame_length = frame_length_at(spec_, data + candidate);
+            if (frame_length == 0) {
+                search = candidate + 1;   // 长度非法：伪同步字
+                continue;
+            }
+            if (length - candidate < frame_length) {
+                stop_search = search;
+                stop_at = candidate;
+                return length;
+            }
+            const DeserializeStatus status = decode(data + candidate, static_cast<size_t>(frame_length), result);
+            if (!status.is_success() && config_.reject_failed) {
+                ++counters.rejected;
+                search = candidate + 1;
+                continue;
+            }
+            ++counters.frames;
+            if (status.is_success()) {
+                ++counters.decoded;
+            } else {
+                ++counters.failed;
+            }
+            counters.framed_bytes += frame_length;
+            const uint64_t next = candidate + frame_length;
+            if (!on_frame(search, candidate, frame_length, status, result)) {
+                return next;
+            }
+            search = next;
+        }
+        return search;
+    }
+
+    // 真正的路径从查找位置 p 进入本块时，是否与推测路径重合；重合时 index 为重合处的 head 下标
+    // （index == head.size() 表示 p 之后推测路径已无帧）
+    static bool converges(const Chunk& chunk, uint64_t p, size_t& index) {
+        for (size_t k = 0; k < chunk.head.size(); ++k) {
+            const batch_detail::WalkRecord& record = chunk.head[k];
+            if (p < record.search) {
+                return false;   // p 落在前一条推测帧内部
+            }
+            if (p <= record.start) {
+                index = k;      // [search, start) 内没有可接受的帧：从 p 出发同样找到 start
+                return true;
+            }
+        }
+        if (chunk.head_complete && p >= chunk.tail_search) {
+            index = chunk.head.size();
+            return true;
+        }
+        return false;
+    }
+
+    // 串行确定各块真正的起始查找位置，推测失败的块加入 redo
+    template<typename Decoder>
+    void reconcile(const uint8_t* data, uint64_t length, std::vector<Chunk>& chunks,
+                   Decoder& decode, Result& result, std::vector<uint32_t>& redo) const {
+        uint64_t p = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            Chunk& chunk = chunks[i];
+            if (p < chunk.begin) {
+                p = chunk.begin;  // 前一块之后到本块起始之间没有可接受的帧
+            }
+            size_t index = 0;
+            if (p >= chunk.end) {
+                // 前一帧越过整块（或已到文件末尾）：本块没有帧
+                if (chunk.counters.frames != 0 || chunk.counters.rejected != 0) {
+                    chunk.entry = p;
+                    chunk.exit = p;
+                    redo.push_back(static_cast<uint32_t>(i));
+                }
+                continue;
+            }
+            if (converges(chunk, p, index)) {
+                if (index > 0) {
+                    // 推测的前 index 帧落在前一帧内部：从 p 重新解码（路径在 head[index] 处重合，exit 不变）
+                    chunk.entry = p;
+                    redo.push_back(static_cast<uint32_t>(i));
+                }
+                p = chunk.exit;
+                continue;
+            }
+
+            // 未直接重合（p 落在某条推测帧内部）：从 p 串行前进，直到与推测路径重合或本块结束
+            batch_detail::WalkCounters scratch;
+            uint64_t stop_search = batch_detail::NO_STOP;
+            uint64_t stop_at = batch_detail::NO_STOP;
+            bool joined = false;
+            const uint64_t next = walk(data, length, p, chunk.end, decode, result, scratch, stop_search, stop_at,
+                [&](uint64_t, uint64_t start, uint64_t frame_length, const DeserializeStatus&, const Result&) {
+                    const uint64_t after = start + frame_length;
+                    joined = after < chunk.end && converges(chunk, after, index);
+                    return !joined;
+                });
+            chunk.entry = p;
+            if (!joined) {
+                chunk.exit = next;
+            }
+            redo.push_back(static_cast<uint32_t>(i));
+            p = chunk.exit;
+        }
+    }
+};
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_BATCH_DECODE_H
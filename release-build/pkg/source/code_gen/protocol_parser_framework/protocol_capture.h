@@ -0,0 +1,738 @@
+#ifndef PROTOCOL_CAPTURE_H
+#define PROTOCOL_CAPTURE_H
+
+// ============================================================================
+// 抓包文件读取
+// - MappedFile：只读内存映射整个文件（非 POSIX 平台退回一次性读入内存）
+// - CaptureReader：逐条遍历 pcap（微秒/纳秒、大小端）、pcapng（SHB/IDB/EPB/SPB，多 Section）
+//   和自定义的长度前缀录制文件（[长度][载荷]...），记录指向映射内存，不拷贝
+// - extract_payload()：从链路层帧中剥离以太网（含 VLAN）/ Linux SLL / SLL2 / BSD loopback /
+//   原始 IP、IPv4/IPv6（含扩展头）和 UDP/TCP 头，得到应用层载荷
+// TCP 载荷按段处理（每段视为一条报文），跨段报文需先经 protocol_framer.h 重组
+// ============================================================================
+
+#include "protocol_common.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PROTOCOL_CAPTURE_HAS_MMAP 1
+#else
+#define PROTOCOL_CAPTURE_HAS_MMAP 0
+#endif
+
+namespace protocol_parser {
+
+// ============================================================================
+// 只读文件映射
+// ============================================================================
+class MappedFile {
+public:
+    MappedFile() : data_(nullptr), size_(0), mapped_(false) {}
+    ~MappedFile() { close(); }
+
+    // 打开并映射文件；失败时返回 false，error 为原因
+    bool open(const char* path, std::string& error) {
+        close();
+#if PROTOCOL_CAPTURE_HAS_MMAP
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            error = std::string("cannot open ") + path;
+            return false;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            error = std::string("cannot stat ") + path;
+            return false;
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return true;
+        }
+        void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            size_ = 0;
+            error = std::string("cannot mmap ") + path;
+            return false;
+        }
+#if defined(MADV_SEQUENTIAL)
+        ::madvise(address, size_, MADV_SEQUENTIAL);
+#endif
+        data_ = static_cast<const uint8_t*>(address);
+        mapped_ = true;
+        return true;
+#else
+        std::FILE* file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            error = std::string("cannot open ") + path;
+            return false;
+        }
+        uint8_t chunk[64 * 1024];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            buffer_.insert(buffer_.end(), chunk, chunk + n);
+        }
+        std::fclose(file);
+        data_ = buffer_.empty() ? nullptr : buffer_.data();
+        size_ = buffer_.size();
+        return true;
+#endif
+    }
+
+    void close() {
+#if PROTOCOL_CAPTURE_HAS_MMAP
+        if (mapped_) {
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+        }
+#endif
+        buffer_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    bool mapped_;
+    std::vector<uint8_t> buffer_;
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+// ============================================================================
+// 抓包格式与记录
+// ============================================================================
+enum CaptureFormat {
+    CAPTURE_AUTO = 0,            // 按文件头魔数识别（无法识别时按长度前缀处理）
+    CAPTURE_PCAP,
+    CAPTURE_PCAPNG,
+    CAPTURE_LENGTH_PREFIXED      // [长度][载荷] 重复，长度字段宽度/字节序由 LengthPrefixSpec 指定
+};
+
+// 链路层类型（LINKTYPE_*，pcap/pcapng 共用）
+enum CaptureLinkType {
+    LINKTYPE_NULL = 0,           // BSD loopback（4 字节主机序协议族）
+    LINKTYPE_ETHERNET = 1,
+    LINKTYPE_RAW = 101,          // 原始 IPv4/IPv6
+    LINKTYPE_LINUX_SLL = 113,
+    LINKTYPE_IPV4 = 228,
+    LINKTYPE_IPV6 = 229,
+    LINKTYPE_LINUX_SLL2 = 276,
+    LINKTYPE_PAYLOAD = 0xFFFFFFFFu  // 长度前缀文件：记录本身就是应用层报文
+};
+
+struct LengthPrefixSpec {
+    size_t prefix_bytes;         // 1 / 2 / 4
+    ByteOrder byte_order;        // BIG_ENDIAN / LITTLE_ENDIAN
+    bool includes_prefix;        // 长度值是否包含长度字段本身
+
+    LengthPrefixSpec() : prefix_bytes(4), byte_order(BIG_ENDIAN), includes_prefix(false) {}
+};
+
+struct CaptureRecord {
+    const uint8_t* data;         // 捕获到的字节（指向映射内存）
+    size_t length;               // 捕获长度（可能小于原始长度，见 original_length）
+    size_t original_length;
+    uint64_t timestamp_ns;       // 长度前缀文件为 0
+    uint32_t link_type;
+
+    CaptureRecord() : data(nullptr), length(0), original_length(0), timestamp_ns(0), link_type(LINKTYPE_PAYLOAD) {}
+};
+
+inline const char* capture_format_name(CaptureFormat format) {
+    switch (format) {
+        case CAPTURE_PCAP: return "pcap";
+        case CAPTURE_PCAPNG: return "pcapng";
+        case CAPTURE_LENGTH_PREFIXED: return "length-prefixed";
+        case CAPTURE_AUTO:
+        default: return "auto";
+    }
+}
+
+namespace capture_detail {
+
+const uint32_t PCAP_MAGIC_US = 0xA1B2C3D4u;
+const uint32_t PCAP_MAGIC_NS = 0xA1B23C4Du;
+const uint32_t PCAPNG_SHB = 0x0A0D0D0Au;
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4Du;
+const uint32_t PCAPNG_IDB = 0x00000001u;
+const uint32_t PCAPNG_OPB = 0x00000002u;     // 已废弃的 Packet Block
+const uint32_t PCAPNG_SPB = 0x00000003u;
+const uint32_t PCAPNG_EPB = 0x00000006u;
+const size_t PCAP_GLOBAL_HEADER = 24;
+const size_t PCAP_RECORD_HEADER = 16;
+
+inline uint16_t load16(const uint8_t* p, bool big) {
+    return big ? static_cast<uint16_t>((p[0] << 8) | p[1])
+               : static_cast<uint16_t>((p[1] << 8) | p[0]);
+}
+
+inline uint32_t load32(const uint8_t* p, bool big) {
+    return big ? (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+                 (static_cast<uint32_t>(p[2]) << 8) | p[3]
+               : (static_cast<uint32_t>(p[3]) << 24) | (static_cast<uint32_t>(p[2]) << 16) |
+                 (static_cast<uint32_t>(p[1]) << 8) | p[0];
+}
+
+// pcapng if_tsresol：最高位 0 表示 10^-n 秒，1 表示 2^-n 秒；换算为纳秒的乘除因子
+struct TimestampScale {
+    uint64_t multiply;
+    uint64_t divide;
+
+    TimestampScale() : multiply(1000), divide(1) {}   // 默认微秒
+};
+
+inline TimestampScale tsresol_scale(uint8_t tsresol) {
+    TimestampScale scale;
+    const unsigned exponent = tsresol & 0x7F;
+    if ((tsresol & 0x80) != 0) {
+        scale.multiply = 1000000000ULL;
+        scale.divide = exponent < 63 ? (1ULL << exponent) : (1ULL << 63);
+    } else {
+        uint64_t per_second = 1;
+        for (unsigned i = 0; i < exponent && per_second <= 1000000000000000000ULL; ++i) {
+            per_second *= 10;
+        }
+        if (per_second <= 1000000000ULL) {
+            scale.multiply = 1000000000ULL / per_second;
+            scale.divide = 1;
+        } else {
+            scale.multiply = 1;
+            scale.divide = per_second / 1000000000ULL;
+        }
+    }
+    return scale;
+}
+
+inline uint64_t scale_timestamp(uint64_t ticks, const TimestampScale& scale) {
+    if (scale.divide == 1) {
+        return ticks * scale.multiply;
+    }
+    // 余数部分按浮点换算，避免 (ticks % divide) * multiply 溢出
+    return ticks / scale.divide * scale.multiply + static_cast<uint64_t>(
+        static_cast<double>(ticks % scale.divide) * static_cast<double>(scale.multiply) /
+        static_cast<double>(scale.divide));
+}
+
+struct PcapngInterface {
+    uint32_t link_type;
+    TimestampScale scale;
+};
+
+} // namespace capture_detail
+
+// 按文件头识别格式
+inline CaptureFormat detect_capture_format(const uint8_t* data, size_t length) {
+    if (length >= 4) {
+        const uint32_t magic = capture_detail::load32(data, true);
+        const uint32_t swapped = capture_detail::load32(data, false);
+        if (magic == capture_detail::PCAP_MAGIC_US || magic == capture_detail::PCAP_MAGIC_NS ||
+            swapped == capture_detail::PCAP_MAGIC_US || swapped == capture_detail::PCAP_MAGIC_NS) {
+            return CAPTURE_PCAP;
+        }
+        if (magic == capture_detail::PCAPNG_SHB) {
+            return CAPTURE_PCAPNG;
+        }
+    }
+    return CAPTURE_LENGTH_PREFIXED;
+}
+
+// ============================================================================
+// 抓包记录遍历
+// 用法：
+//   CaptureReader reader(file.data(), file.size(), CAPTURE_AUTO);
+//   CaptureRecord record;
+//   while (reader.next(record)) { ... }
+//   if (!reader.ok()) { reader.error() }
+// 文件末尾的半条记录（录制中途截断）计入 truncated()，不视为错误
+// ============================================================================
+class CaptureReader {
+public:
+    CaptureReader(const uint8_t* data, size_t length, CaptureFormat format = CAPTURE_AUTO,
+                  const LengthPrefixSpec& prefix = LengthPrefixSpec())
+        : data_(data)
+        , length_(length)
+        , position_(0)
+        , format_(format == CAPTURE_AUTO ? detect_capture_format(data, length) : format)
+        , prefix_(prefix)
+        , big_(true)
+        , nanosecond_(false)
+        , pcap_link_type_(LINKTYPE_ETHERNET)
+        , truncated_(0)
+        , skipped_blocks_(0)
+    {
+        if (format_ == CAPTURE_PCAP) {
+            open_pcap();
+        }
+    }
+
+    CaptureFormat format() const { return format_; }
+    bool ok() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+    size_t truncated() const { return truncated_; }          // 末尾不完整的记录数（0 或 1）
+    size_t skipped_blocks() const { return skipped_blocks_; } // pcapng 中跳过的非报文块数
+
+    bool next(CaptureRecord& record) {
+        if (!error_.empty()) {
+            return false;
+        }
+        switch (format_) {
+            case CAPTURE_PCAP: return next_pcap(record);
+            case CAPTURE_PCAPNG: return next_pcapng(record);
+            default: return next_length_prefixed(record);
+        }
+    }
+
+private:
+    const uint8_t* data_;
+    size_t length_;
+    size_t position_;
+    CaptureFormat format_;
+    LengthPrefixSpec prefix_;
+    bool big_;
+    bool nanosecond_;
+    uint32_t pcap_link_type_;
+    std::vector<capture_detail::PcapngInterface> interfaces_;
+    std::string error_;
+    size_t truncated_;
+    size_t skipped_blocks_;
+
+    bool fail(const std::string& message) {
+        char where[32];
+        std::snprintf(where, sizeof(where), " at offset %zu", position_);
+        error_ = message + where;
+        return false;
+    }
+
+    bool end_truncated() {
+        if (position_ < length_) {
+            ++truncated_;
+            position_ = length_;
+        }
+        return false;
+    }
+
+    void open_pcap() {
+        if (length_ < capture_detail::PCAP_GLOBAL_HEADER) {
+            fail("pcap global header truncated");
+            return;
+        }
+        const uint32_t magic = capture_detail::load32(data_, true);
+        big_ = (magic == capture_detail::PCAP_MAGIC_US || magic == capture_detail::PCAP_MAGIC_NS);
+        const uint32_t native = capture_detail::load32(data_, big_);
+        if (native != capture_detail::PCAP_MAGIC_US && native != capture_detail::PCAP_MAGIC_NS) {
+            fail("not a pcap file");
+            return;
+        }
+        nanosecond_ = (native == capture_detail::PCAP_MAGIC_NS);
+        // 低 28 位为链路类型，高位为 FCS 信息
+        pcap_link_type_ = capture_detail::load32(data_ + 20, big_) & 0x0FFFFFFFu;
+        position_ = capture_detail::PCAP_GLOBAL_HEADER;
+    }
+
+    bool next_pcap(CaptureRecord& record) {
+        if (position_ >= length_) {
+            return false;
+        }
+        if (length_ - position_ < capture_detail::PCAP_RECORD_HEADER) {
+            return end_truncated();
+        }
+        const uint8_t* header = data_ + position_;
+        const uint32_t seconds = capture_detail::load32(header, big_);
+        const uint32_t fraction = capture_detail::load32(header + 4, big_);
+        const uint32_t captured = capture_detail::load32(header + 8, big_);
+        const uint32_t original = capture_detail::load32(header + 12, big_);
+        if (captured > 256u * 1024 * 1024) {
+            return fail("pcap record length out of range");
+        }
+        if (length_ - position_ - capture_detail::PCAP_RECORD_HEADER < captured) {
+            return end_truncated();
+        }
+        record.data = header + capture_detail::PCAP_RECORD_HEADER;
+        record.length = captured;
+        record.original_length = original;
+        record.timestamp_ns = static_cast<uint64_t>(seconds) * 1000000000ULL +
+            (nanosecond_ ? fraction : static_cast<uint64_t>(fraction) * 1000);
+        record.link_type = pcap_link_type_;
+        position_ += capture_detail::PCAP_RECORD_HEADER + captured;
+        return true;
+    }
+
+    bool next_pcapng(CaptureRecord& record) {
+        for (;;) {
+            if (position_ >= length_) {
+                return false;
+            }
+            if (length_ - position_ < 12) {
+                return end_truncated();
+            }
+            const uint8_t* block = data_ + position_;
+            uint32_t type = capture_detail::load32(block, big_);
+            if (capture_detail::load32(block, true) == capture_detail::PCAPNG_SHB) {
+                // 新 Section：字节序由 Byte-Order Magic 决定，接口列表重新开始
+                if (length_ - position_ < 28) {
+                    return end_truncated();
+                }
+                const uint32_t order = capture_detail::load32(block + 8, true);
+                if (order == capture_detail::PCAPNG_BYTE_ORDER_MAGIC) {
+                    big_ = true;
+                } else if (capture_detail::load32(block + 8, false) == capture_detail::PCAPNG_BYTE_ORDER_MAGIC) {
+                    big_ = false;
+                } else {
+                    return fail("pcapng section header has bad byte-order magic");
+                }
+                interfaces_.clear();
+                type = capture_detail::PCAPNG_SHB;
+            }
+            const uint32_t total = capture_detail::load32(block + 4, big_);
+            if (total < 12 || (total & 3) != 0) {
+                return fail("pcapng block length invalid");
+            }
+            if (length_ - position_ < total) {
+                return end_truncated();
+            }
+            position_ += total;
+            const uint8_t* body = block + 8;
+            const size_t body_length = total - 12;
+
+            if (type == capture_detail::PCAPNG_IDB) {
+                if (body_length < 8) {
+                    return fail("pcapng interface block truncated");
+                }
+                capture_detail::PcapngInterface interface;
+                interface.link_type = capture_detail::load16(body, big_);
+                parse_idb_options(body + 8, body_length - 8, interface);
+                interfaces_.push_back(interface);
+                continue;
+            }
+            if (type == capture_detail::PCAPNG_EPB || type == capture_detail::PCAPNG_OPB) {
+                if (body_length < 20) {
+                    return fail("pcapng packet block truncated");
+                }
+                const uint32_t interface_id = (type == capture_detail::PCAPNG_EPB)
+                    ? capture_detail::load32(body, big_)
+                    : capture_detail::load16(body, big_);
+                const uint64_t timestamp = (static_cast<uint64_t>(capture_detail::load32(body + 4, big_)) << 32) |
+                                           capture_detail::load32(body + 8, big_);
+                const uint32_t captured = capture_detail::load32(body + 12, big_);
+                if (captured > body_length - 20) {
+                    return fail("pcapng packet length exceeds block");
+                }
+                if (interface_id >= interfaces_.size()) {
+                    return fail("pcapng packet references undefined interface");
+                }
+                record.data = body + 20;
+                record.length = captured;
+                record.original_length = capture_detail::load32(body + 16, big_);
+                record.timestamp_ns = capture_detail::scale_timestamp(timestamp, interfaces_[interface_id].scale);
+                record.link_type = interfaces_[interface_id].link_type;
+                return true;
+            }
+            if (type == capture_detail::PCAPNG_SPB) {
+                if (body_length < 4 || interfaces_.empty()) {
+                    return fail("pcapng simple packet block without interface");
+                }
+                const uint32_t original = capture_detail::load32(body, big_);
+                record.data = body + 4;
+                record.length = original < body_length - 4 ? original : body_length - 4;
+                record.original_length = original;
+                record.timestamp_ns = 0;
+                record.link_type = interfaces_[0].link_type;
+                return true;
+            }
+            if (type != capture_detail::PCAPNG_SHB) {
+                ++skipped_blocks_;
+            }
+        }
+    }
+
+    void parse_idb_options(const uint8_t* options, size_t length, capture_detail::PcapngInterface& interface) {
+        size_t offset = 0;
+        while (length - offset >= 4) {
+            const uint16_t code = capture_detail::load16(options + offset, big_);
+            const uint16_t size = capture_detail::load16(options + offset + 2, big_);
+            offset += 4;
+            if (code == 0 || size > length - offset) {
+                break;
+            }
+            if (code == 9 && size >= 1) {   // if_tsresol
+                interface.scale = capture_detail::tsresol_scale(options[offset]);
+            }
+            offset += (static_cast<size_t>(size) + 3) & ~static_cast<size_t>(3);
+            if (offset > length) {
+                break;
+            }
+        }
+    }
+
+    bool next_length_prefixed(CaptureRecord& record) {
+        if (position_ >= length_) {
+            return false;
+        }
+        const size_t width = prefix_.prefix_bytes;
+        if (width != 1 && width != 2 && width != 4) {
+            return fail("length prefix must be 1, 2 or 4 bytes");
+        }
+        if (length_ - position_ < width) {
+            return end_truncated();
+        }
+        const uint8_t* header = data_ + position_;
+        const bool big = (prefix_.byte_order != LITTLE_ENDIAN);
+        size_t value = width == 1 ? header[0]
+                     : width == 2 ? capture_detail::load16(header, big)
+                     : capture_detail::load32(header, big);
+        if (prefix_.includes_prefix) {
+            if (value < width) {
+                return fail("length prefix smaller than prefix itself");
+            }
+            value -= width;
+        }
+        if (length_ - position_ - width < value) {
+            return end_truncated();
+        }
+        record.data = header + width;
+        record.length = value;
+        record.original_length = value;
+        record.timestamp_ns = 0;
+        record.link_type = LINKTYPE_PAYLOAD;
+        position_ += width + value;
+        return true;
+    }
+};
+
+// ============================================================================
+// 应用层载荷提取
+// ============================================================================
+enum PayloadStatus {
+    PAYLOAD_OK = 0,
+    PAYLOAD_NOT_IP,              // ARP 等非 IP 帧，或不支持的链路类型
+    PAYLOAD_NOT_TRANSPORT,       // 非 UDP/TCP（ICMP 等）
+    PAYLOAD_FRAGMENT,            // IP 分片（不重组）
+    PAYLOAD_FILTERED,            // 端口不匹配
+    PAYLOAD_EMPTY,               // 无载荷（TCP 握手/ACK 等）
+    PAYLOAD_TRUNCATED,           // 头部被截断（snaplen 过小或数据损坏）
+    PAYLOAD_STATUS_COUNT
+};
+
+inline const char* payload_status_name(PayloadStatus status) {
+    switch (status) {
+        case PAYLOAD_OK: return "ok";
+        case PAYLOAD_NOT_IP: return "not_ip";
+        case PAYLOAD_NOT_TRANSPORT: return "not_udp_tcp";
+        case PAYLOAD_FRAGMENT: return "ip_fragment";
+        case PAYLOAD_FILTERED: return "port_filtered";
+        case PAYLOAD_EMPTY: return "empty";
+        case PAYLOAD_TRUNCATED: return "truncated";
+        default: return "unknown";
+    }
+}
+
+enum PayloadMode {
+    PAYLOAD_MODE_AUTO = 0,       // 剥离链路层/IP/UDP/TCP 头（长度前缀记录原样使用）
+    PAYLOAD_MODE_RAW             // 捕获的字节原样作为报文
+};
+
+struct PayloadOptions {
+    PayloadMode mode;
+    int port;                    // 源或目的端口匹配时才保留（-1 不过滤）
+    size_t skip;                 // 载荷前再跳过的字节数（应用层封装头）
+
+    PayloadOptions() : mode(PAYLOAD_MODE_AUTO), port(-1), skip(0) {}
+};
+
+namespace capture_detail {
+
+const uint16_t ETHERTYPE_IPV4 = 0x0800;
+const uint16_t ETHERTYPE_IPV6 = 0x86DD;
+const uint16_t ETHERTYPE_VLAN = 0x8100;
+const uint16_t ETHERTYPE_QINQ = 0x88A8;
+const uint8_t IP_PROTO_TCP = 6;
+const uint8_t IP_PROTO_UDP = 17;
+
+inline PayloadStatus finish_payload(const uint8_t* data, size_t length, const PayloadOptions& options,
+                                    const uint8_t*& out, size_t& out_length) {
+    if (length <= options.skip) {
+        return length == 0 ? PAYLOAD_EMPTY : PAYLOAD_TRUNCATED;
+    }
+    out = data + options.skip;
+    out_length = length - options.skip;
+    return PAYLOAD_OK;
+}
+
+inline PayloadStatus transport_payload(uint8_t protocol, const uint8_t* data, size_t length,
+                                       const PayloadOptions& options, const uint8_t*& out, size_t& out_length) {
+    size_t header;
+    if (protocol == IP_PROTO_UDP) {
+        if (length < 8) {
+            return PAYLOAD_TRUNCATED;
+        }
+        header = 8;
+        const size_t udp_length = load16(data + 4, true);
+        if (udp_length >= 8 && udp_length < length) {
+            length = udp_length;   // 以太网最小帧填充
+        }
+    } else if (protocol == IP_PROTO_TCP) {
+        if (length < 20) {
+            return PAYLOAD_TRUNCATED;
+        }
+        header = static_cast<size_t>(data[12] >> 4) * 4;
+        if (header < 20 || header > length) {
+            return PAYLOAD_TRUNCATED;
+        }
+    } else {
+        return PAYLOAD_NOT_TRANSPORT;
+    }
+    if (options.port >= 0) {
+        const int source = load16(data, true);
+        const int destination = load16(data + 2, true);
+        if (source != options.port && destination != options.port) {
+            return PAYLOAD_FILTERED;
+        }
+    }
+    if (length == header) {
+        return PAYLOAD_EMPTY;
+    }
+    return finish_payload(data + header, length - header, options, out, out_length);
+}
+
+inline PayloadStatus ip_payload(const uint8_t* data, size_t length, const PayloadOptions& options,
+                                const uint8_t*& out, size_t& out_length) {
+    if (length < 1) {
+        return PAYLOAD_TRUNCATED;
+    }
+    const unsigned version = data[0] >> 4;
+    if (version == 4) {
+        if (length < 20) {
+            return PAYLOAD_TRUNCATED;
+        }
+        const size_t header = static_cast<size_t>(data[0] & 0x0F) * 4;
+        const size_t total = load16(data + 2, true);
+        if (header < 20 || total < header || header > length) {
+            return PAYLOAD_TRUNCATED;
+        }
+        if (total < length) {
+            length = total;        // 去掉链路层尾部填充
+        }
+        const uint16_t fragment = load16(data + 6, true);
+        if ((fragment & 0x3FFF) != 0) {   // MF 置位或片偏移非 0
+            return PAYLOAD_FRAGMENT;
+        }
+        return transport_payload(data[9], data + header, length - header, options, out, out_length);
+    }
+    if (version == 6) {
+        if (length < 40) {
+            return PAYLOAD_TRUNCATED;
+        }
+        const size_t total = 40 + static_cast<size_t>(load16(data + 4, true));
+        if (total < length) {
+            length = total;
+        }
+        uint8_t next = data[6];
+        size_t offset = 40;
+        // 逐个跳过扩展头：Hop-by-Hop(0)、Routing(43)、Destination Options(60)；Fragment(44) 不重组
+        for (;;) {
+            if (next == 0 || next == 43 || next == 60) {
+                if (length - offset < 8) {
+                    return PAYLOAD_TRUNCATED;
+                }
+                const size_t extension = (static_cast<size_t>(data[offset + 1]) + 1) * 8;
+                if (extension > length - offset) {
+                    return PAYLOAD_TRUNCATED;
+                }
+                next = data[offset];
+                offset += extension;
+            } else if (next == 44) {
+                return PAYLOAD_FRAGMENT;
+            } else {
+                break;
+            }
+        }
+        return transport_payload(next, data + offset, length - offset, options, out, out_length);
+    }
+    return PAYLOAD_NOT_IP;
+}
+
+inline PayloadStatus ethertype_payload(uint16_t ethertype, const uint8_t* data, size_t length,
+                                       const PayloadOptions& options, const uint8_t*& out, size_t& out_length) {
+    if (ethertype != ETHERTYPE_IPV4 && ethertype != ETHERTYPE_IPV6) {
+        return PAYLOAD_NOT_IP;
+    }
+    return ip_payload(data, length, options, out, out_length);
+}
+
+} // namespace capture_detail
+
+// 取出一条记录的应用层报文；成功时 out/out_length 指向记录内部
+inline PayloadStatus extract_payload(const CaptureRecord& record, const PayloadOptions& options,
+                                     const uint8_t*& out, size_t& out_length) {
+    const uint8_t* data = record.data;
+    const size_t length = record.length;
+    if (options.mode == PAYLOAD_MODE_RAW || record.link_type == LINKTYPE_PAYLOAD) {
+        return capture_detail::finish_payload(data, length, options, out, out_length);
+    }
+    switch (record.link_type) {
+        case LINKTYPE_ETHERNET: {
+            size_t offset = 12;
+            if (length < 14) {
+                return PAYLOAD_TRUNCATED;
+            }
+            uint16_t ethertype = capture_detail::load16(data + offset, true);
+            while (ethertype == capture_detail::ETHERTYPE_VLAN || ethertype == capture_detail::ETHERTYPE_QINQ) {
+                offset += 4;
+                if (length < offset + 2) {
+                    return PAYLOAD_TRUNCATED;
+                }
+                ethertype = capture_detail::load16(data + offset, true);
+            }
+            offset += 2;
+            return capture_detail::ethertype_payload(ethertype, data + offset, length - offset, options, out, out_length);
+        }
+        case LINKTYPE_LINUX_SLL:
+            if (length < 16) {
+                return PAYLOAD_TRUNCATED;
+            }
+            return capture_detail::ethertype_payload(capture_detail::load16(data + 14, true),
+                                                     data + 16, length - 16, options, out, out_length);
+        case LINKTYPE_LINUX_SLL2:
+            if (length < 20) {
+                return PAYLOAD_TRUNCATED;
+            }
+            return capture_detail::ethertype_payload(capture_detail::load16(data, true),
+                                                     data + 20, length - 20, options, out, out_length);
+        case LINKTYPE_NULL:
+            if (length < 4) {
+                return PAYLOAD_TRUNCATED;
+            }
+            // 协议族为写入方主机序；按版本号字段判断 IPv4/IPv6 即可
+            return capture_detail::ip_payload(data + 4, length - 4, options, out, out_length);
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+        case LINKTYPE_IPV6:
+        case 12:   // 部分平台上的 DLT_RAW
+        case 14:
+            return capture_detail::ip_payload(data, length, options, out, out_length);
+        default:
+            return PAYLOAD_NOT_IP;
+    }
+}
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_CAPTURE_H
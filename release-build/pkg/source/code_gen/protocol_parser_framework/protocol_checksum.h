@@ -3,30 +3,258 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+
+#include "protocol_cpu.h"
+
+// ============================================================================
+// 硬件加速（x86 SSE4.2 crc32 / PCLMULQDQ），运行期按 CPU 特性选择
+// 定义 PROTOCOL_CHECKSUM_NO_HW_ACCEL 可完全关闭
+// ============================================================================
+#if !defined(PROTOCOL_CHECKSUM_NO_HW_ACCEL)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PROTOCOL_CHECKSUM_X86 1
+#define PROTOCOL_CHECKSUM_TARGET(features) __attribute__((target(features)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define PROTOCOL_CHECKSUM_X86 1
+#define PROTOCOL_CHECKSUM_TARGET(features)
+#include <intrin.h>
+#endif
+#endif
 
 namespace protocol_parser {
 
+// ============================================================================
+// SIMD 字节归约（Sum / XOR 共用，CPU 特性检测见 protocol_cpu.h）
+// ============================================================================
+
+// SIMD 引擎选择
+enum SimdEngine {
+    SIMD_ENGINE_SCALAR = 0,     // 标量（参考实现）
+    SIMD_ENGINE_SSE2 = 1,       // SSE2（不可用时退回标量）
+    SIMD_ENGINE_AVX2 = 2,       // AVX2（不可用时退回标量）
+    SIMD_ENGINE_AUTO = 255      // 按 CPU 特性与数据长度自动选择（默认）
+};
+
+namespace checksum_detail {
+
+using cpu_detail::CpuFeatures;
+using cpu_detail::cpu_features;
+
+// 自动选择的最小数据长度（更短的数据标量更快）
+static const size_t SIMD_SSE2_MIN_LENGTH = 16;
+static const size_t SIMD_AVX2_MIN_LENGTH = 64;
+
+// ---- 标量实现 ----
+
+inline uint32_t sum_bytes_scalar(uint32_t sum, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+inline uint8_t xor_bytes_scalar(uint8_t xor_val, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        xor_val ^= data[i];
+    }
+    return xor_val;
+}
+
+#if defined(PROTOCOL_CHECKSUM_X86)
+// ---- SSE2 实现 ----
+// 累加和：psadbw 与 0 求绝对差之和，即每 8 字节之和落入 64 位通道，最后截断为 uint32（与标量回绕一致）
+
+PROTOCOL_CHECKSUM_TARGET("sse2")
+inline uint32_t sum_bytes_sse2(uint32_t sum, const uint8_t* data, size_t length) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0 = zero;
+    __m128i acc1 = zero;
+    while (length >= 32) {
+        acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), zero));
+        acc1 = _mm_add_epi64(acc1, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), zero));
+        data += 32;
+        length -= 32;
+    }
+    if (length >= 16) {
+        acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), zero));
+        data += 16;
+        length -= 16;
+    }
+    acc0 = _mm_add_epi64(acc0, acc1);
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc0);
+    sum += static_cast<uint32_t>(lanes[0] + lanes[1]);
+    return sum_bytes_scalar(sum, data, length);
+}
+
+PROTOCOL_CHECKSUM_TARGET("sse2")
+inline uint8_t xor_bytes_sse2(uint8_t xor_val, const uint8_t* data, size_t length) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    while (length >= 32) {
+        acc0 = _mm_xor_si128(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+        acc1 = _mm_xor_si128(acc1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)));
+        data += 32;
+        length -= 32;
+    }
+    if (length >= 16) {
+        acc0 = _mm_xor_si128(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+        data += 16;
+        length -= 16;
+    }
+    // 16 字节折半归约到 1 字节
+    acc0 = _mm_xor_si128(acc0, acc1);
+    acc0 = _mm_xor_si128(acc0, _mm_srli_si128(acc0, 8));
+    acc0 = _mm_xor_si128(acc0, _mm_srli_si128(acc0, 4));
+    acc0 = _mm_xor_si128(acc0, _mm_srli_si128(acc0, 2));
+    acc0 = _mm_xor_si128(acc0, _mm_srli_si128(acc0, 1));
+    xor_val ^= static_cast<uint8_t>(_mm_cvtsi128_si32(acc0));
+    return xor_bytes_scalar(xor_val, data, length);
+}
+
+// ---- AVX2 实现 ----
+
+PROTOCOL_CHECKSUM_TARGET("avx2")
+inline uint32_t sum_bytes_avx2(uint32_t sum, const uint8_t* data, size_t length) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero;
+    __m256i acc1 = zero;
+    __m256i acc2 = zero;
+    __m256i acc3 = zero;
+    while (length >= 128) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32)), zero));
+        acc2 = _mm256_add_epi64(acc2, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 64)), zero));
+        acc3 = _mm256_add_epi64(acc3, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 96)), zero));
+        data += 128;
+        length -= 128;
+    }
+    while (length >= 32) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), zero));
+        data += 32;
+        length -= 32;
+    }
+    acc0 = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1), _mm256_add_epi64(acc2, acc3));
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc0);
+    sum += static_cast<uint32_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return sum_bytes_scalar(sum, data, length);
+}
+
+PROTOCOL_CHECKSUM_TARGET("avx2")
+inline uint8_t xor_bytes_avx2(uint8_t xor_val, const uint8_t* data, size_t length) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+    while (length >= 128) {
+        acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)));
+        acc1 = _mm256_xor_si256(acc1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32)));
+        acc2 = _mm256_xor_si256(acc2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 64)));
+        acc3 = _mm256_xor_si256(acc3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 96)));
+        data += 128;
+        length -= 128;
+    }
+    while (length >= 32) {
+        acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)));
+        data += 32;
+        length -= 32;
+    }
+    acc0 = _mm256_xor_si256(_mm256_xor_si256(acc0, acc1), _mm256_xor_si256(acc2, acc3));
+    __m128i x = _mm_xor_si128(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 8));
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 4));
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 2));
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 1));
+    xor_val ^= static_cast<uint8_t>(_mm_cvtsi128_si32(x));
+    return xor_bytes_scalar(xor_val, data, length);
+}
+#endif // PROTOCOL_CHECKSUM_X86
+
+// ---- 分派 ----
+
+inline uint32_t sum_bytes(uint32_t sum, const uint8_t* data, size_t length, SimdEngine engine) {
+#if defined(PROTOCOL_CHECKSUM_X86)
+    const CpuFeatures& features = cpu_features();
+    if (engine == SIMD_ENGINE_AUTO) {
+        if (length >= SIMD_AVX2_MIN_LENGTH && features.avx2) {
+            return sum_bytes_avx2(sum, data, length);
+        }
+        if (length >= SIMD_SSE2_MIN_LENGTH && features.sse2) {
+            return sum_bytes_sse2(sum, data, length);
+        }
+    } else if (engine == SIMD_ENGINE_AVX2 && features.avx2) {
+        return sum_bytes_avx2(sum, data, length);
+    } else if (engine == SIMD_ENGINE_SSE2 && features.sse2) {
+        return sum_bytes_sse2(sum, data, length);
+    }
+#else
+    (void)engine;
+#endif
+    return sum_bytes_scalar(sum, data, length);
+}
+
+inline uint8_t xor_bytes(uint8_t xor_val, const uint8_t* data, size_t length, SimdEngine engine) {
+#if defined(PROTOCOL_CHECKSUM_X86)
+    const CpuFeatures& features = cpu_features();
+    if (engine == SIMD_ENGINE_AUTO) {
+        if (length >= SIMD_AVX2_MIN_LENGTH && features.avx2) {
+            return xor_bytes_avx2(xor_val, data, length);
+        }
+        if (length >= SIMD_SSE2_MIN_LENGTH && features.sse2) {
+            return xor_bytes_sse2(xor_val, data, length);
+        }
+    } else if (engine == SIMD_ENGINE_AVX2 && features.avx2) {
+        return xor_bytes_avx2(xor_val, data, length);
+    } else if (engine == SIMD_ENGINE_SSE2 && features.sse2) {
+        return xor_bytes_sse2(xor_val, data, length);
+    }
+#else
+    (void)engine;
+#endif
+    return xor_bytes_scalar(xor_val, data, length);
+}
+
+} // namespace checksum_detail
+
 // ============================================================================
 // 简单累加和校验 (Sum)
 // ============================================================================
 class Checksum_Sum {
 public:
-    Checksum_Sum() : initial_(0) {}
+    Checksum_Sum() : initial_(0), state_(0), engine_(SIMD_ENGINE_AUTO) {}
     
     // 可选参数配置
-    void set_initial(uint32_t val) { initial_ = val; }
+    void set_initial(uint32_t val) { initial_ = val; reset(); }
+
+    // SIMD 引擎选择（各引擎结果一致，含 uint32 回绕）
+    void set_engine(SimdEngine engine) { engine_ = engine; }
     
     // 统一计算接口
     uint32_t calculate(const uint8_t* data, size_t length) const {
-        uint32_t sum = initial_;
-        for (size_t i = 0; i < length; ++i) {
-            sum += data[i];
-        }
-        return sum;
+        return checksum_detail::sum_bytes(initial_, data, length, engine_);
+    }
+
+    // 流式接口：reset / update / finalize（分段数据逐段累加，结果与 calculate 一致）
+    void reset() { state_ = initial_; }
+    void update(const uint8_t* data, size_t length) {
+        state_ = checksum_detail::sum_bytes(state_, data, length, engine_);
+    }
+    uint32_t finalize() const { return state_; }
+
+    // 合并两段独立计算的结果：返回 A||B 的校验值
+    uint32_t combine(uint32_t sum_a, uint32_t sum_b, size_t /*length_b*/) const {
+        return sum_a + sum_b - initial_;
     }
 
 private:
     uint32_t initial_;
+    uint32_t state_;
+    SimdEngine engine_;
 };
 
 // ============================================================================
@@ -34,22 +262,506 @@ private:
 // ============================================================================
 class Checksum_XOR {
 public:
-    Checksum_XOR() : initial_(0) {}
+    Checksum_XOR() : initial_(0), state_(0), engine_(SIMD_ENGINE_AUTO) {}
     
     // 可选参数配置
-    void set_initial(uint8_t val) { initial_ = val; }
+    void set_initial(uint8_t val) { initial_ = val; reset(); }
+
+    // SIMD 引擎选择（各引擎结果一致）
+    void set_engine(SimdEngine engine) { engine_ = engine; }
     
     // 统一计算接口
     uint8_t calculate(const uint8_t* data, size_t length) const {
-        uint8_t xor_val = initial_;
-        for (size_t i = 0; i < length; ++i) {
-            xor_val ^= data[i];
-        }
-        return xor_val;
+        return checksum_detail::xor_bytes(initial_, data, length, engine_);
+    }
+
+    // 流式接口：reset / update / finalize
+    void reset() { state_ = initial_; }
+    void update(const uint8_t* data, size_t length) {
+        state_ = checksum_detail::xor_bytes(state_, data, length, engine_);
+    }
+    uint8_t finalize() const { return state_; }
+
+    // 合并两段独立计算的结果：返回 A||B 的校验值
+    uint8_t combine(uint8_t xor_a, uint8_t xor_b, size_t /*length_b*/) const {
+        return static_cast<uint8_t>(xor_a ^ xor_b ^ initial_);
     }
 
 private:
     uint8_t initial_;
+    uint8_t state_;
+    SimdEngine engine_;
+};
+
+// ============================================================================
+// CRC 查表引擎
+// ============================================================================
+// 说明：
+// - 单字节表项由 constexpr 函数生成，注册表内置的标准预设（CRC8 / CRC16-Modbus /
+//   CRC32）在编译期直接展开为常量表，其他多项式首次使用时在运行期生成并缓存
+// - 每组表包含 8 张 256 项子表：第 k 张表示"字节 i 后再跟 k 个 0 字节"的余式，
+//   用于 slice-by-4/8；第 0 张即经典的单字节查表
+// - ref_in 为 true 时使用反射表（反转多项式 + 低位优先移位），
+//   从而省去每个输入字节的位反转
+namespace crc_detail {
+
+static const size_t CRC_TABLE_SIZE = 256;
+static const size_t CRC_SLICE_COUNT = 8;
+
+// 最高位掩码
+template<typename T>
+constexpr T crc_top_bit() {
+    return static_cast<T>(static_cast<T>(1) << (sizeof(T) * 8 - 1));
+}
+
+// 按位反转（constexpr 递归实现，用于生成反射多项式）
+template<typename T>
+constexpr T crc_reflect(T value, size_t bits = sizeof(T) * 8, T result = 0) {
+    return bits == 0 ? result
+        : crc_reflect<T>(static_cast<T>(value >> 1), bits - 1,
+                         static_cast<T>((result << 1) | (value & 1)));
+}
+
+// 高位优先移位 bits 次
+template<typename T>
+constexpr T crc_shift_msb(T crc, T poly, int bits) {
+    return bits == 0 ? crc
+        : crc_shift_msb<T>((crc & crc_top_bit<T>()) ? static_cast<T>((crc << 1) ^ poly)
+                                                     : static_cast<T>(crc << 1),
+                           poly, bits - 1);
+}
+
+// 低位优先移位 bits 次（rpoly 为反转后的多项式）
+template<typename T>
+constexpr T crc_shift_lsb(T crc, T rpoly, int bits) {
+    return bits == 0 ? crc
+        : crc_shift_lsb<T>((crc & 1) ? static_cast<T>((crc >> 1) ^ rpoly)
+                                     : static_cast<T>(crc >> 1),
+                           rpoly, bits - 1);
+}
+
+// 单字节表项（reflected 时 table_poly 为反转后的多项式）
+template<typename T>
+constexpr T crc_table_entry(T table_poly, bool reflected, uint8_t index) {
+    return reflected
+        ? crc_shift_lsb<T>(static_cast<T>(index), table_poly, 8)
+        : crc_shift_msb<T>(static_cast<T>(static_cast<T>(index) << (sizeof(T) * 8 - 8)), table_poly, 8);
+}
+
+// 在已有余式后追加一个 0 字节
+template<typename T>
+constexpr T crc_slice_step(T prev, T table_poly, bool reflected) {
+    return reflected
+        ? static_cast<T>((prev >> 8) ^ crc_table_entry<T>(table_poly, true, static_cast<uint8_t>(prev & 0xFF)))
+        : static_cast<T>((prev << 8) ^ crc_table_entry<T>(table_poly, false, static_cast<uint8_t>(prev >> (sizeof(T) * 8 - 8))));
+}
+
+// 第 slice 张子表的表项
+template<typename T>
+constexpr T crc_slice_entry(T table_poly, bool reflected, size_t slice, uint8_t index) {
+    return slice == 0 ? crc_table_entry<T>(table_poly, reflected, index)
+        : crc_slice_step<T>(crc_slice_entry<T>(table_poly, reflected, slice - 1, index), table_poly, reflected);
+}
+
+// 对数深度的编译期索引序列（C++11 无 std::index_sequence）
+template<size_t... Is> struct IndexSeq {};
+
+template<typename A, typename B> struct IndexSeqConcat;
+
+template<size_t... A, size_t... B>
+struct IndexSeqConcat<IndexSeq<A...>, IndexSeq<B...> > {
+    typedef IndexSeq<A..., (sizeof...(A) + B)...> type;
+};
+
+template<size_t N>
+struct MakeIndexSeq {
+    typedef typename IndexSeqConcat<typename MakeIndexSeq<N / 2>::type,
+                                    typename MakeIndexSeq<N - N / 2>::type>::type type;
+};
+
+template<> struct MakeIndexSeq<0> { typedef IndexSeq<> type; };
+template<> struct MakeIndexSeq<1> { typedef IndexSeq<0> type; };
+
+// 编译期常量表（扁平存储：value[slice * 256 + index]）
+template<typename T, T Poly, bool Reflected,
+         typename Seq = typename MakeIndexSeq<CRC_SLICE_COUNT * CRC_TABLE_SIZE>::type>
+struct CrcConstTables;
+
+template<typename T, T Poly, bool Reflected, size_t... Is>
+struct CrcConstTables<T, Poly, Reflected, IndexSeq<Is...> > {
+    static constexpr T value[sizeof...(Is)] = {
+        crc_slice_entry<T>(Reflected ? crc_reflect<T>(Poly) : Poly, Reflected,
+                           Is / CRC_TABLE_SIZE, static_cast<uint8_t>(Is % CRC_TABLE_SIZE))...
+    };
+};
+
+template<typename T, T Poly, bool Reflected, size_t... Is>
+constexpr T CrcConstTables<T, Poly, Reflected, IndexSeq<Is...> >::value[sizeof...(Is)];
+
+// 标准预设（与 checksum_registry.js 中的 fixedParams 对应）
+template<typename T>
+struct CrcPresetTables {
+    static const T* find(T, bool) { return nullptr; }
+};
+
+template<>
+struct CrcPresetTables<uint8_t> {
+    static const uint8_t* find(uint8_t poly, bool reflected) {
+        // crc8: Poly=0x07, RefIn=false
+        if (poly == 0x07 && !reflected) return CrcConstTables<uint8_t, 0x07, false>::value;
+        return nullptr;
+    }
+};
+
+template<>
+struct CrcPresetTables<uint16_t> {
+    static const uint16_t* find(uint16_t poly, bool reflected) {
+        // crc16-modbus: Poly=0x8005, RefIn=true
+        if (poly == 0x8005 && reflected) return CrcConstTables<uint16_t, 0x8005, true>::value;
+        return nullptr;
+    }
+};
+
+template<>
+struct CrcPresetTables<uint32_t> {
+    static const uint32_t* find(uint32_t poly, bool reflected) {
+        // crc32: Poly=0x04C11DB7, RefIn=true
+        if (poly == 0x04C11DB7UL && reflected) return CrcConstTables<uint32_t, 0x04C11DB7UL, true>::value;
+        // crc32c: Poly=0x1EDC6F41, RefIn=true
+        if (poly == 0x1EDC6F41UL && reflected) return CrcConstTables<uint32_t, 0x1EDC6F41UL, true>::value;
+        return nullptr;
+    }
+};
+
+// CRC-32C（Castagnoli）反射多项式，SSE4.2 crc32 指令固定使用该多项式
+static const uint32_t CRC32C_POLY = 0x1EDC6F41UL;
+
+// PCLMUL 折叠的最小数据长度（更短的数据查表更快）
+static const size_t CRC_CLMUL_MIN_LENGTH = 128;
+
+// x^n mod P（高位优先表示，width 为 CRC 位宽）
+inline uint64_t crc_xpow_mod(unsigned n, uint64_t poly, unsigned width) {
+    const uint64_t top = static_cast<uint64_t>(1) << (width - 1);
+    const uint64_t mask = (width == 64) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << width) - 1);
+    uint64_t r = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        const bool carry = (r & top) != 0;
+        r = (r << 1) & mask;
+        if (carry) {
+            r ^= poly;
+        }
+    }
+    return r;
+}
+
+// a * b mod P（高位优先表示）
+inline uint64_t crc_mulmod(uint64_t a, uint64_t b, uint64_t poly, unsigned width) {
+    const uint64_t top = static_cast<uint64_t>(1) << (width - 1);
+    const uint64_t mask = (width == 64) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << width) - 1);
+    uint64_t r = 0;
+    for (unsigned i = width; i-- > 0;) {
+        const bool carry = (r & top) != 0;
+        r = (r << 1) & mask;
+        if (carry) {
+            r ^= poly;
+        }
+        if ((b >> i) & 1) {
+            r ^= a;
+        }
+    }
+    return r;
+}
+
+// x^(8n) mod P：平方-乘法，O(log n)
+inline uint64_t crc_xpow8n_mod(uint64_t n, uint64_t poly, unsigned width) {
+    uint64_t result = 1;
+    uint64_t base = crc_xpow_mod(8, poly, width);
+    while (n != 0) {
+        if (n & 1) {
+            result = crc_mulmod(result, base, poly, width);
+        }
+        base = crc_mulmod(base, base, poly, width);
+        n >>= 1;
+    }
+    return result;
+}
+
+// 单个 (多项式, 是否反射) 组合的引擎数据：查表 + 折叠常数 + 硬件路径标志
+template<typename T>
+struct CrcEngineData {
+    T poly;
+    bool reflected;
+    const T* table;             // 8 x 256 查表（扁平存储）
+    bool use_crc32c_hw;         // 可用 SSE4.2 crc32 指令
+    bool use_clmul;             // 可用 PCLMUL 折叠
+    uint64_t fold[8];           // 折叠常数：{512, 384, 256, 128} 位距离各一对
+    CrcEngineData* next;
+};
+
+// 运行期引擎缓存：按 (多项式, 是否反射) 生成一次，进程生命周期内常驻
+// 读路径无锁（原子链表头），仅首次生成时加锁
+template<typename T>
+class CrcTableRegistry {
+public:
+    static const CrcEngineData<T>* get(T poly, bool reflected) {
+        for (CrcEngineData<T>* n = head().load(std::memory_order_acquire); n; n = n->next) {
+            if (n->poly == poly && n->reflected == reflected) {
+                return n;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex());
+        CrcEngineData<T>* first = head().load(std::memory_order_acquire);
+        for (CrcEngineData<T>* n = first; n; n = n->next) {
+            if (n->poly == poly && n->reflected == reflected) {
+                return n;
+            }
+        }
+
+        CrcEngineData<T>* node = new CrcEngineData<T>();
+        node->poly = poly;
+        node->reflected = reflected;
+        node->table = CrcPresetTables<T>::find(poly, reflected);
+        if (!node->table) {
+            node->table = build_table(poly, reflected);
+        }
+
+        const cpu_detail::CpuFeatures& features = cpu_detail::cpu_features();
+        node->use_crc32c_hw = features.sse42 && reflected
+            && sizeof(T) == 4 && static_cast<uint32_t>(poly) == CRC32C_POLY;
+        node->use_clmul = features.pclmul;
+        build_fold_constants(node);
+
+        node->next = first;
+        head().store(node, std::memory_order_release);
+        return node;
+    }
+
+    static const T* get_table(T poly, bool reflected) {
+        return get(poly, reflected)->table;
+    }
+
+private:
+    static const T* build_table(T poly, bool reflected) {
+        T* table = new T[CRC_SLICE_COUNT * CRC_TABLE_SIZE];
+        const T table_poly = reflected ? crc_reflect<T>(poly) : poly;
+        for (size_t i = 0; i < CRC_TABLE_SIZE; ++i) {
+            table[i] = crc_table_entry<T>(table_poly, reflected, static_cast<uint8_t>(i));
+        }
+        for (size_t k = 1; k < CRC_SLICE_COUNT; ++k) {
+            for (size_t i = 0; i < CRC_TABLE_SIZE; ++i) {
+                table[k * CRC_TABLE_SIZE + i] =
+                    crc_slice_step<T>(table[(k - 1) * CRC_TABLE_SIZE + i], table_poly, reflected);
+            }
+        }
+        return table;
+    }
+
+    // 高位优先：{lo, hi} = {x^d, x^(d+64)} mod P
+    // 反射：    {lo, hi} = {rev64(x^(d+63)), rev64(x^(d-1))} mod P（反射乘积少一位，指数各减 1）
+    static void build_fold_constants(CrcEngineData<T>* node) {
+        static const unsigned distances[4] = { 512, 384, 256, 128 };
+        const unsigned width = static_cast<unsigned>(sizeof(T) * 8);
+        const uint64_t poly = static_cast<uint64_t>(node->poly);
+        for (size_t i = 0; i < 4; ++i) {
+            const unsigned d = distances[i];
+            if (node->reflected) {
+                node->fold[i * 2] = crc_reflect<uint64_t>(crc_xpow_mod(d + 63, poly, width));
+                node->fold[i * 2 + 1] = crc_reflect<uint64_t>(crc_xpow_mod(d - 1, poly, width));
+            } else {
+                node->fold[i * 2] = crc_xpow_mod(d, poly, width);
+                node->fold[i * 2 + 1] = crc_xpow_mod(d + 64, poly, width);
+            }
+        }
+    }
+
+    static std::atomic<CrcEngineData<T>*>& head() {
+        static std::atomic<CrcEngineData<T>*> head_node(nullptr);
+        return head_node;
+    }
+
+    static std::mutex& mutex() {
+        static std::mutex table_mutex;
+        return table_mutex;
+    }
+};
+
+// 取寄存器中参与第 j 个输入字节运算的那一字节
+template<typename T, bool Reflected>
+inline uint8_t crc_register_byte(T crc, size_t j) {
+    if (j >= sizeof(T)) {
+        return 0;
+    }
+    return Reflected ? static_cast<uint8_t>(crc >> (8 * j))
+                     : static_cast<uint8_t>(crc >> (8 * (sizeof(T) - 1 - j)));
+}
+
+// slice-by-N 的各字节查表项异或（编译期展开，避免依赖编译器的循环展开）
+template<typename T, size_t N, bool Reflected, size_t J = 0>
+struct CrcSliceTerms {
+    static T sum(const T* tables, T crc, const uint8_t* p) {
+        const uint8_t idx = static_cast<uint8_t>(p[J] ^ crc_register_byte<T, Reflected>(crc, J));
+        return static_cast<T>(tables[(N - 1 - J) * CRC_TABLE_SIZE + idx]
+                              ^ CrcSliceTerms<T, N, Reflected, J + 1>::sum(tables, crc, p));
+    }
+};
+
+template<typename T, size_t N, bool Reflected>
+struct CrcSliceTerms<T, N, Reflected, N> {
+    static T sum(const T*, T, const uint8_t*) { return 0; }
+};
+
+// 一次处理 N 个字节（slice-by-N）
+template<typename T, size_t N, bool Reflected>
+inline T crc_slice_block(const T* tables, T crc, const uint8_t* p) {
+    // 位宽大于 N 字节时，寄存器中未被本块"消耗"的部分直接移位保留
+    const unsigned keep_shift = static_cast<unsigned>((8 * N) % (8 * sizeof(T)));
+    T acc = 0;
+    if (sizeof(T) > N) {
+        acc = Reflected ? static_cast<T>(crc >> keep_shift) : static_cast<T>(crc << keep_shift);
+    }
+    return static_cast<T>(acc ^ CrcSliceTerms<T, N, Reflected>::sum(tables, crc, p));
+}
+
+// 单字节查表
+template<typename T, bool Reflected>
+inline T crc_table_byte(const T* tables, T crc, uint8_t byte) {
+    return Reflected
+        ? static_cast<T>((crc >> 8) ^ tables[static_cast<uint8_t>(crc ^ byte)])
+        : static_cast<T>((crc << 8) ^ tables[static_cast<uint8_t>((crc >> (sizeof(T) * 8 - 8)) ^ byte)]);
+}
+
+// 查表更新：Slice 为每轮处理的字节数（1 / 4 / 8）
+template<typename T, size_t Slice, bool Reflected>
+inline T crc_table_update(const T* tables, T crc, const uint8_t* data, size_t length) {
+    if (Slice >= 8) {
+        while (length >= 8) {
+            crc = crc_slice_block<T, 8, Reflected>(tables, crc, data);
+            data += 8;
+            length -= 8;
+        }
+    }
+    if (Slice >= 4) {
+        while (length >= 4) {
+            crc = crc_slice_block<T, 4, Reflected>(tables, crc, data);
+            data += 4;
+            length -= 4;
+        }
+    }
+    while (length > 0) {
+        crc = crc_table_byte<T, Reflected>(tables, crc, *data++);
+        --length;
+    }
+    return crc;
+}
+
+#if defined(PROTOCOL_CHECKSUM_X86)
+// SSE4.2 crc32 指令：直接维护 CRC-32C 反射寄存器（不含 init / xor_out）
+PROTOCOL_CHECKSUM_TARGET("sse4.2")
+inline uint32_t crc32c_hw_update(uint32_t crc, const uint8_t* data, size_t length) {
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    while (length >= 4) {
+        uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        length -= 4;
+    }
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, *data++);
+        --length;
+    }
+    return crc;
+}
+
+// 128 位折叠：x.lo * k.lo ^ x.hi * k.hi
+PROTOCOL_CHECKSUM_TARGET("pclmul,ssse3")
+inline __m128i crc_clmul_fold(__m128i x, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+// 读取 16 字节并转换为多项式表示（高位优先需要整体字节反转）
+template<bool Reflected>
+PROTOCOL_CHECKSUM_TARGET("pclmul,ssse3")
+inline __m128i crc_clmul_load(const uint8_t* p, __m128i bswap_mask) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return Reflected ? v : _mm_shuffle_epi8(v, bswap_mask);
+}
+
+// PCLMUL 折叠：4 路并行折叠到 128 位，再用查表处理折叠结果与尾部（要求 length >= 64）
+// 适用于任意 8~64 位多项式
+template<typename T, bool Reflected>
+PROTOCOL_CHECKSUM_TARGET("pclmul,ssse3")
+inline T crc_clmul_update(const CrcEngineData<T>* engine, T crc, const uint8_t* data, size_t length) {
+    const __m128i bswap_mask = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i k512 = _mm_set_epi64x(static_cast<long long>(engine->fold[1]), static_cast<long long>(engine->fold[0]));
+    const __m128i k384 = _mm_set_epi64x(static_cast<long long>(engine->fold[3]), static_cast<long long>(engine->fold[2]));
+    const __m128i k256 = _mm_set_epi64x(static_cast<long long>(engine->fold[5]), static_cast<long long>(engine->fold[4]));
+    const __m128i k128 = _mm_set_epi64x(static_cast<long long>(engine->fold[7]), static_cast<long long>(engine->fold[6]));
+
+    __m128i x0 = crc_clmul_load<Reflected>(data, bswap_mask);
+    __m128i x1 = crc_clmul_load<Reflected>(data + 16, bswap_mask);
+    __m128i x2 = crc_clmul_load<Reflected>(data + 32, bswap_mask);
+    __m128i x3 = crc_clmul_load<Reflected>(data + 48, bswap_mask);
+    data += 64;
+    length -= 64;
+
+    // 初始寄存器等价于异或到报文开头的 W 位
+    if (Reflected) {
+        x0 = _mm_xor_si128(x0, _mm_set_epi64x(0, static_cast<long long>(static_cast<uint64_t>(crc))));
+    } else {
+        const uint64_t top = static_cast<uint64_t>(crc) << (64 - sizeof(T) * 8);
+        x0 = _mm_xor_si128(x0, _mm_set_epi64x(static_cast<long long>(top), 0));
+    }
+
+    while (length >= 64) {
+        x0 = _mm_xor_si128(crc_clmul_fold(x0, k512), crc_clmul_load<Reflected>(data, bswap_mask));
+        x1 = _mm_xor_si128(crc_clmul_fold(x1, k512), crc_clmul_load<Reflected>(data + 16, bswap_mask));
+        x2 = _mm_xor_si128(crc_clmul_fold(x2, k512), crc_clmul_load<Reflected>(data + 32, bswap_mask));
+        x3 = _mm_xor_si128(crc_clmul_fold(x3, k512), crc_clmul_load<Reflected>(data + 48, bswap_mask));
+        data += 64;
+        length -= 64;
+    }
+
+    // 4 路合并为 1 路
+    __m128i x = _mm_xor_si128(_mm_xor_si128(crc_clmul_fold(x0, k384), crc_clmul_fold(x1, k256)),
+                              _mm_xor_si128(crc_clmul_fold(x2, k128), x3));
+
+    while (length >= 16) {
+        x = _mm_xor_si128(crc_clmul_fold(x, k128), crc_clmul_load<Reflected>(data, bswap_mask));
+        data += 16;
+        length -= 16;
+    }
+
+    // 折叠结果与原报文同余：以 0 为初值对这 16 字节查表即得寄存器值
+    uint8_t folded[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(folded), Reflected ? x : _mm_shuffle_epi8(x, bswap_mask));
+    crc = crc_table_update<T, 8, Reflected>(engine->table, 0, folded, sizeof(folded));
+    return crc_table_update<T, 8, Reflected>(engine->table, crc, data, length);
+}
+#endif // PROTOCOL_CHECKSUM_X86
+
+} // namespace crc_detail
+
+// CRC 计算引擎选择
+enum CrcEngine {
+    CRC_ENGINE_BITWISE = 0,     // 逐位计算（参考实现）
+    CRC_ENGINE_TABLE = 1,       // 单字节查表
+    CRC_ENGINE_SLICE_4 = 4,     // slice-by-4
+    CRC_ENGINE_SLICE_8 = 8,     // slice-by-8
+    CRC_ENGINE_CLMUL = 16,      // PCLMUL 折叠（不可用时退回 slice-by-8）
+    CRC_ENGINE_SSE42 = 32,      // SSE4.2 crc32 指令，仅 CRC-32C（不可用时退回 slice-by-8）
+    CRC_ENGINE_AUTO = 255       // 按 CPU 特性与数据长度自动选择（默认）
 };
 
 // ============================================================================
@@ -65,16 +777,59 @@ public:
         , xor_out_(0)
         , ref_in_(false)
         , ref_out_(false) 
+        , engine_(CRC_ENGINE_AUTO)
+        , register_(0)
+        , engine_data_(nullptr)
     {}
     
     // 可选参数配置（带默认值）
-    void set_init(T val) { init_ = val; }
+    void set_init(T val) { init_ = val; reset(); }
     void set_xor_out(T val) { xor_out_ = val; }
-    void set_ref_in(bool val) { ref_in_ = val; }
+    void set_ref_in(bool val) { ref_in_ = val; engine_data_ = nullptr; reset(); }
     void set_ref_out(bool val) { ref_out_ = val; }
 
+    // 计算引擎选择（各引擎结果逐位一致）
+    void set_engine(CrcEngine engine) { engine_ = engine; }
+
     // 统一计算接口
     T calculate(const uint8_t* data, size_t length) const {
+        if (engine_ == CRC_ENGINE_BITWISE) {
+            return calculate_bitwise(data, length);
+        }
+
+        const crc_detail::CrcEngineData<T>* engine = crc_detail::CrcTableRegistry<T>::get(poly_, ref_in_);
+        return finalize_register(advance_register(engine, initial_register(), data, length));
+    }
+
+    // 流式接口：reset / update / finalize
+    // 分段到达的数据逐段 update，无需先拼接成连续缓冲区；结果与 calculate 逐位一致
+    void reset() { register_ = initial_register(); }
+
+    void update(const uint8_t* data, size_t length) {
+        if (!engine_data_) {
+            engine_data_ = crc_detail::CrcTableRegistry<T>::get(poly_, ref_in_);
+        }
+        register_ = advance_register(engine_data_, register_, data, length);
+    }
+
+    T finalize() const { return finalize_register(register_); }
+
+    // CRC 合并：crc_a = CRC(A)、crc_b = CRC(B)（同一组参数分别计算），返回 CRC(A || B)
+    // 用于多段并行计算后拼接，耗时 O(log length_b)
+    T combine(T crc_a, T crc_b, size_t length_b) const {
+        const unsigned width = static_cast<unsigned>(sizeof(T) * 8);
+        const uint64_t poly = static_cast<uint64_t>(poly_);
+        const uint64_t reg_a = static_cast<uint64_t>(to_msb_register(crc_a));
+        const uint64_t reg_b = static_cast<uint64_t>(to_msb_register(crc_b));
+
+        // reg(A||B) = reg(B) ^ (reg(A) ^ init) * x^(8 * length_b) mod P
+        const uint64_t shift = crc_detail::crc_xpow8n_mod(static_cast<uint64_t>(length_b), poly, width);
+        const uint64_t reg = reg_b ^ crc_detail::crc_mulmod(reg_a ^ static_cast<uint64_t>(init_), shift, poly, width);
+        return from_msb_register(static_cast<T>(reg));
+    }
+
+    // 逐位计算（参考实现，用于校验查表引擎）
+    T calculate_bitwise(const uint8_t* data, size_t length) const {
         T crc = init_;
         
         for (size_t i = 0; i < length; ++i) {
@@ -106,6 +861,72 @@ private:
     T xor_out_;
     bool ref_in_;
     bool ref_out_;
+    CrcEngine engine_;
+    T register_;                                        // 流式计算的寄存器（ref_in 时为反射形式）
+    const crc_detail::CrcEngineData<T>* engine_data_;   // 流式计算缓存的引擎数据
+
+    // 反射表直接维护反射后的寄存器，因此初值需要先反转
+    T initial_register() const {
+        return ref_in_ ? reverse_bits(init_) : init_;
+    }
+
+    // 反射寄存器本身即 ref_out 形式，仅当 ref_in 与 ref_out 不一致时需要反转，最后异或
+    T finalize_register(T crc) const {
+        if (ref_in_ != ref_out_) {
+            crc = reverse_bits(crc);
+        }
+        return static_cast<T>(crc ^ xor_out_);
+    }
+
+    // 输出值 <-> 高位优先寄存器（与 calculate_bitwise 的寄存器一致）
+    T to_msb_register(T value) const {
+        value = static_cast<T>(value ^ xor_out_);
+        return ref_out_ ? reverse_bits(value) : value;
+    }
+
+    T from_msb_register(T reg) const {
+        if (ref_out_) {
+            reg = reverse_bits(reg);
+        }
+        return static_cast<T>(reg ^ xor_out_);
+    }
+
+    T advance_register(const crc_detail::CrcEngineData<T>* engine, T crc, const uint8_t* data, size_t length) const {
+        if (engine_ == CRC_ENGINE_BITWISE) {
+            // 参考实现按高位优先寄存器计算
+            T msb = ref_in_ ? reverse_bits(crc) : crc;
+            for (size_t i = 0; i < length; ++i) {
+                msb = crc_update(msb, ref_in_ ? reverse_bits_8(data[i]) : data[i]);
+            }
+            return ref_in_ ? reverse_bits(msb) : msb;
+        }
+        return ref_in_ ? update_register<true>(engine, crc, data, length)
+                       : update_register<false>(engine, crc, data, length);
+    }
+
+    template<bool Reflected>
+    T update_register(const crc_detail::CrcEngineData<T>* engine, T crc, const uint8_t* data, size_t length) const {
+#if defined(PROTOCOL_CHECKSUM_X86)
+        // 长数据优先 4 路 PCLMUL 折叠（吞吐高于单路 crc32 指令），短数据 CRC-32C 走 crc32 指令
+        const bool allow_clmul = (engine_ == CRC_ENGINE_AUTO || engine_ == CRC_ENGINE_CLMUL);
+        if (allow_clmul && engine->use_clmul && length >= crc_detail::CRC_CLMUL_MIN_LENGTH) {
+            return crc_detail::crc_clmul_update<T, Reflected>(engine, crc, data, length);
+        }
+        const bool allow_sse42 = (engine_ == CRC_ENGINE_AUTO || engine_ == CRC_ENGINE_SSE42);
+        if (allow_sse42 && Reflected && engine->use_crc32c_hw) {
+            return static_cast<T>(crc_detail::crc32c_hw_update(static_cast<uint32_t>(crc), data, length));
+        }
+#endif
+        const T* tables = engine->table;
+        switch (engine_) {
+        case CRC_ENGINE_TABLE:
+            return crc_detail::crc_table_update<T, 1, Reflected>(tables, crc, data, length);
+        case CRC_ENGINE_SLICE_4:
+            return crc_detail::crc_table_update<T, 4, Reflected>(tables, crc, data, length);
+        default:
+            return crc_detail::crc_table_update<T, 8, Reflected>(tables, crc, data, length);
+        }
+    }
     
     // 反转字节的位顺序
     static uint8_t reverse_bits_8(uint8_t byte) {
@@ -191,6 +1012,35 @@ public:
     }
 };
 
+// ============================================================================
+// 分段数据（scatter-gather）校验
+// ============================================================================
+struct ChecksumSegment {
+    const uint8_t* data;
+    size_t length;
+};
+
+// 将逻辑偏移 [begin, end) 覆盖的各分段依次送入 checker.update()，不拷贝数据
+// 范围超出分段总长度时返回 false
+template<typename Checker>
+inline bool checksum_update_range(Checker& checker, const ChecksumSegment* segments, size_t count,
+                                  size_t begin, size_t end) {
+    if (end < begin) {
+        return false;
+    }
+    size_t segment_start = 0;
+    for (size_t i = 0; i < count && begin < end; ++i) {
+        const size_t segment_end = segment_start + segments[i].length;
+        if (begin < segment_end) {
+            const size_t stop = end < segment_end ? end : segment_end;
+            checker.update(segments[i].data + (begin - segment_start), stop - begin);
+            begin = stop;
+        }
+        segment_start = segment_end;
+    }
+    return begin == end;
+}
+
 } // namespace protocol_parser
 
 #endif // PROTOCOL_CHECKSUM_H
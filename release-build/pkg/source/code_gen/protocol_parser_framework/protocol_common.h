@@ -5,6 +5,47 @@
 #include <string>
 #include <vector>
 #include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "protocol_cpu.h"
+#include "protocol_encoding.h"
+#if defined(_MSC_VER)
+#include <cstdlib>
+#endif
+
+// ============================================================================
+// 位级读写的 BMI2 路径（BZHI / PEXT / PDEP），编译时启用 BMI2（-mbmi2 / -march=native）才生效
+// 定义 PROTOCOL_NO_BMI2 可关闭，回退到移位 + 掩码
+// ============================================================================
+#if !defined(PROTOCOL_NO_BMI2)
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+#define PROTOCOL_BITS_BMI2 1
+#include <immintrin.h>
+#endif
+#endif
+
+// ============================================================================
+// 数组批量读写的字节交换 SIMD 路径（SSE2 为 x86-64 基线指令集，无需运行期检测）
+// 定义 PROTOCOL_ARRAY_NO_SIMD 可关闭，回退到逐元素 bswap
+// ============================================================================
+#if !defined(PROTOCOL_ARRAY_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PROTOCOL_ARRAY_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif
+
+// ============================================================================
+// 压缩 BCD 与数字串互转的 SIMD 路径（SSE2，每次 16 字节 BCD / 32 个数字）
+// 定义 PROTOCOL_BCD_NO_SIMD 可关闭，回退到每次 8 字节的 SWAR 实现
+// ============================================================================
+#if !defined(PROTOCOL_BCD_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PROTOCOL_BCD_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif
 
 namespace protocol_parser {
 
@@ -27,6 +68,16 @@ enum ParseError {
 // ============================================================================
 // 字节序枚举
 // ============================================================================
+
+// glibc 的 <endian.h>（经 <string> 等标准头间接包含）把 BIG_ENDIAN / LITTLE_ENDIAN
+// 定义为数值宏，会与下面的枚举值冲突，这里取消这两个宏定义
+#ifdef BIG_ENDIAN
+#undef BIG_ENDIAN
+#endif
+#ifdef LITTLE_ENDIAN
+#undef LITTLE_ENDIAN
+#endif
+
 enum ByteOrder {
     BIG_ENDIAN,                 // 大端字节序
     LITTLE_ENDIAN,            // 小端字节序
@@ -34,8 +85,142 @@ enum ByteOrder {
     REVERSE_ENDIAN             // 反转字节序
 };
 
+// ============================================================================
+// 错误码名称（静态字符串，不分配内存）
+// ============================================================================
+inline const char* error_code_name(ParseError error) {
+    switch (error) {
+        case SUCCESS: return "Success";
+        case INSUFFICIENT_DATA: return "Insufficient data";
+        case INVALID_FORMAT: return "Invalid format";
+        case INVALID_VALUE: return "Invalid value";
+        case INVALID_CHECKSUM: return "Invalid checksum";
+        case BUFFER_OVERFLOW: return "Buffer overflow";
+        case DECOMPRESSION_FAILED: return "Decompression failed";
+        case COMPRESSION_FAILED: return "Compression failed";
+        case UNSUPPORTED_ENCODING: return "Unsupported encoding";
+        case UNKNOWN_ERROR: return "Unknown error";
+        default: return "Unknown error";
+    }
+}
+
+// 错误码个数（ParseError 为从 0 开始的连续取值）
+const size_t PARSE_ERROR_COUNT = static_cast<size_t>(UNKNOWN_ERROR) + 1;
+
+// 错误码标识符（用于导出，与枚举名一致）
+inline const char* error_code_id(ParseError error) {
+    switch (error) {
+        case SUCCESS: return "SUCCESS";
+        case INSUFFICIENT_DATA: return "INSUFFICIENT_DATA";
+        case INVALID_FORMAT: return "INVALID_FORMAT";
+        case INVALID_VALUE: return "INVALID_VALUE";
+        case INVALID_CHECKSUM: return "INVALID_CHECKSUM";
+        case BUFFER_OVERFLOW: return "BUFFER_OVERFLOW";
+        case DECOMPRESSION_FAILED: return "DECOMPRESSION_FAILED";
+        case COMPRESSION_FAILED: return "COMPRESSION_FAILED";
+        case UNSUPPORTED_ENCODING: return "UNSUPPORTED_ENCODING";
+        case UNKNOWN_ERROR: return "UNKNOWN_ERROR";
+        default: return "UNKNOWN_ERROR";
+    }
+}
+
+// ============================================================================
+// 反序列化状态（可平凡复制，不分配内存）
+// 框架通用函数、生成的解析器和分发器均返回此类型；
+// error_message 只指向字符串字面量等静态存储，出错位置由 offset / field_id 表达
+// ============================================================================
+struct DeserializeStatus {
+    ParseError error_code;      // 错误码
+    const char* error_message;  // 错误消息（静态字符串，永不为 nullptr）
+    size_t bytes_consumed;      // 已解析的字节数
+    size_t offset;              // 出错位置（报文内字节偏移）
+    uint32_t field_id;          // 出错字段编号（顶层字段序号，从 1 开始；0 表示未指定）
+
+    DeserializeStatus()
+        : error_code(SUCCESS), error_message(""), bytes_consumed(0), offset(0), field_id(0) {}
+
+    DeserializeStatus(ParseError err, const char* msg = "", size_t bytes = 0,
+                      size_t off = 0, uint32_t field = 0)
+        : error_code(err), error_message(msg ? msg : ""), bytes_consumed(bytes),
+          offset(off), field_id(field) {}
+
+    bool is_success() const {
+        return error_code == SUCCESS;
+    }
+
+    explicit operator bool() const {
+        return is_success();
+    }
+
+    // 返回标注了出错字段的副本（字段已标注时保留最内层的编号）
+    DeserializeStatus at_field(uint32_t field) const {
+        DeserializeStatus status = *this;
+        if (status.field_id == 0) {
+            status.field_id = field;
+        }
+        return status;
+    }
+
+    static DeserializeStatus success(size_t bytes = 0) {
+        return DeserializeStatus(SUCCESS, "", bytes);
+    }
+
+    static DeserializeStatus failure(ParseError err, const char* msg, size_t off, uint32_t field = 0) {
+        return DeserializeStatus(err, msg, 0, off, field);
+    }
+};
+
+// ============================================================================
+// 序列化状态（可平凡复制，不分配内存，与 DeserializeStatus 对称）
+// ============================================================================
+struct SerializeStatus {
+    ParseError error_code;      // 错误码（复用 ParseError）
+    const char* error_message;  // 错误消息（静态字符串，永不为 nullptr）
+    size_t bytes_written;       // 已写入的字节数
+    size_t offset;              // 出错位置（缓冲区内字节偏移）
+    uint32_t field_id;          // 出错字段编号（顶层字段序号，从 1 开始；0 表示未指定）
+
+    SerializeStatus()
+        : error_code(SUCCESS), error_message(""), bytes_written(0), offset(0), field_id(0) {}
+
+    SerializeStatus(ParseError err, const char* msg = "", size_t bytes = 0,
+                    size_t off = 0, uint32_t field = 0)
+        : error_code(err), error_message(msg ? msg : ""), bytes_written(bytes),
+          offset(off), field_id(field) {}
+
+    bool is_success() const {
+        return error_code == SUCCESS;
+    }
+
+    explicit operator bool() const {
+        return is_success();
+    }
+
+    SerializeStatus at_field(uint32_t field) const {
+        SerializeStatus status = *this;
+        if (status.field_id == 0) {
+            status.field_id = field;
+        }
+        return status;
+    }
+
+    static SerializeStatus success(size_t bytes = 0) {
+        return SerializeStatus(SUCCESS, "", bytes);
+    }
+
+    static SerializeStatus failure(ParseError err, const char* msg, size_t off, uint32_t field = 0) {
+        return SerializeStatus(err, msg, 0, off, field);
+    }
+};
+
+static_assert(std::is_trivially_copyable<DeserializeStatus>::value,
+              "DeserializeStatus must stay trivially copyable");
+static_assert(std::is_trivially_copyable<SerializeStatus>::value,
+              "SerializeStatus must stay trivially copyable");
+
 // ============================================================================
 // 反序列化结果结构体（二进制 → 结构体）
+// 兼容旧接口：持有 std::string 消息，可由 DeserializeStatus 隐式构造
 // ============================================================================
 struct DeserializeResult {
     ParseError error_code;      // 错误码
@@ -48,6 +233,10 @@ struct DeserializeResult {
     DeserializeResult(ParseError err, const std::string& msg = "", size_t bytes = 0)
         : error_code(err), error_message(msg), bytes_consumed(bytes) {}
 
+    DeserializeResult(const DeserializeStatus& status)
+        : error_code(status.error_code), error_message(status.error_message),
+          bytes_consumed(status.bytes_consumed) {}
+
     bool is_success() const {
         return error_code == SUCCESS;
     }
@@ -105,10 +294,26 @@ struct DeserializeContext {
     size_t get_total_bytes() const {
         return (bit_offset > 0) ? (offset + 1) : offset;
     }
+
+    // 精确按位检查剩余数据（非字节对齐读取使用）
+    bool has_bits(size_t count) const {
+        return count == 0 || (offset < total_length && count <= (total_length - offset) * 8 - bit_offset);
+    }
+
+    // 位流位置（MSB 优先编号）与定位
+    size_t bit_position() const {
+        return offset * 8 + bit_offset;
+    }
+
+    void seek_bits(size_t position) {
+        offset = position >> 3;
+        bit_offset = static_cast<uint8_t>(position & 7);
+    }
 };
 
 // ============================================================================
 // 序列化结果结构体
+// 兼容旧接口：持有 std::string 消息，可由 SerializeStatus 隐式构造
 // ============================================================================
 struct SerializeResult {
     ParseError error_code;      // 错误码（复用 ParseError）
@@ -121,6 +326,10 @@ struct SerializeResult {
     SerializeResult(ParseError err, const std::string& msg = "", size_t bytes = 0)
         : error_code(err), error_message(msg), bytes_written(bytes) {}
 
+    SerializeResult(const SerializeStatus& status)
+        : error_code(status.error_code), error_message(status.error_message),
+          bytes_written(status.bytes_written) {}
+
     bool is_success() const {
         return error_code == SUCCESS;
     }
@@ -166,85 +375,896 @@ struct SerializeContext {
         bit_offset = total_bits % 8;
     }
 
-    // 获取实际使用的总字节数（包括部分填充的最后一个字节）
-    size_t get_total_bytes() const {
-        return (bit_offset > 0) ? (offset + 1) : offset;
+    // 获取实际使用的总字节数（包括部分填充的最后一个字节）
+    size_t get_total_bytes() const {
+        return (bit_offset > 0) ? (offset + 1) : offset;
+    }
+
+    // 精确按位检查剩余空间（非字节对齐写入使用）
+    bool has_space_bits(size_t count) const {
+        return count == 0 || (offset < max_length && count <= (max_length - offset) * 8 - bit_offset);
+    }
+
+    // 位流位置（MSB 优先编号）与定位
+    size_t bit_position() const {
+        return offset * 8 + bit_offset;
+    }
+
+    void seek_bits(size_t position) {
+        offset = position >> 3;
+        bit_offset = static_cast<uint8_t>(position & 7);
+    }
+};
+
+// ============================================================================
+// 字节序转换通用工具函数
+// ============================================================================
+
+// 编译期主机字节序检测：能确定时定义 PROTOCOL_HOST_LITTLE_ENDIAN 为 1/0，
+// 否则不定义，回退到运行期检测（结果同样会被编译器常量折叠）
+#if !defined(PROTOCOL_HOST_LITTLE_ENDIAN)
+#  if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && defined(__ORDER_BIG_ENDIAN__)
+#    if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#      define PROTOCOL_HOST_LITTLE_ENDIAN 1
+#    elif __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#      define PROTOCOL_HOST_LITTLE_ENDIAN 0
+#    endif
+#  elif defined(_WIN32) || defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM) || defined(_M_ARM64)
+#    define PROTOCOL_HOST_LITTLE_ENDIAN 1
+#  endif
+#endif
+
+// 判断当前系统字节序
+#if defined(PROTOCOL_HOST_LITTLE_ENDIAN)
+inline bool is_system_little_endian() {
+    return PROTOCOL_HOST_LITTLE_ENDIAN != 0;
+}
+#else
+inline bool is_system_little_endian() {
+    uint16_t test = 0x0001;
+    uint8_t first = 0;
+    std::memcpy(&first, &test, 1);
+    return first == 0x01;
+}
+#endif
+
+// 整数字节交换（GCC/Clang/MSVC 下编译为单条 bswap/rev 指令）
+inline uint8_t byte_swap(uint8_t value) {
+    return value;
+}
+
+inline uint16_t byte_swap(uint16_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap16(value);
+#elif defined(_MSC_VER)
+    return _byteswap_ushort(value);
+#else
+    return static_cast<uint16_t>((value >> 8) | (value << 8));
+#endif
+}
+
+inline uint32_t byte_swap(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(value);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(value);
+#else
+    return ((value & 0x000000FFu) << 24) | ((value & 0x0000FF00u) << 8) |
+           ((value & 0x00FF0000u) >> 8)  | ((value & 0xFF000000u) >> 24);
+#endif
+}
+
+inline uint64_t byte_swap(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#else
+    return (static_cast<uint64_t>(byte_swap(static_cast<uint32_t>(value))) << 32) |
+           byte_swap(static_cast<uint32_t>(value >> 32));
+#endif
+}
+
+namespace byte_order_detail {
+
+// 按字节宽度选择同宽无符号整数，用于整数/浮点的统一交换
+template<size_t N> struct UIntOfSize;
+template<> struct UIntOfSize<1> { typedef uint8_t type; };
+template<> struct UIntOfSize<2> { typedef uint16_t type; };
+template<> struct UIntOfSize<4> { typedef uint32_t type; };
+template<> struct UIntOfSize<8> { typedef uint64_t type; };
+
+} // namespace byte_order_detail
+
+// 字节反转函数模板（支持 1/2/4/8 字节的整数和浮点类型）
+template<typename T>
+inline T reverse_bytes(T value) {
+    typedef typename byte_order_detail::UIntOfSize<sizeof(T)>::type UInt;
+    UInt bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    bits = byte_swap(bits);
+    T result;
+    std::memcpy(&result, &bits, sizeof(T));
+    return result;
+}
+
+// 编译期字节序：给定线上字节序是否需要交换（SYSTEM_ENDIAN 不交换，REVERSE_ENDIAN 总交换）
+template<ByteOrder Order>
+inline bool need_byte_swap() {
+    return Order == REVERSE_ENDIAN ||
+           (Order == BIG_ENDIAN && is_system_little_endian()) ||
+           (Order == LITTLE_ENDIAN && !is_system_little_endian());
+}
+
+// 运行期字节序：与 need_byte_swap<Order>() 语义一致
+inline bool need_byte_swap(ByteOrder order) {
+    return order == REVERSE_ENDIAN ||
+           (order == BIG_ENDIAN && is_system_little_endian()) ||
+           (order == LITTLE_ENDIAN && !is_system_little_endian());
+}
+
+// 将 SYSTEM_ENDIAN / REVERSE_ENDIAN 归一为 BIG_ENDIAN / LITTLE_ENDIAN，
+// 供生成代码在入口处一次性选择编译期字节序实例
+inline ByteOrder resolve_byte_order(ByteOrder order) {
+    if (order == BIG_ENDIAN || order == LITTLE_ENDIAN) {
+        return order;
+    }
+    bool little = is_system_little_endian();
+    if (order == REVERSE_ENDIAN) {
+        little = !little;
+    }
+    return little ? LITTLE_ENDIAN : BIG_ENDIAN;
+}
+
+// 编译期字节序读取：无分支，编译为 load (+ bswap)
+template<ByteOrder Order, typename T>
+inline T read_fixed_order(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    if (need_byte_swap<Order>()) {
+        value = reverse_bytes(value);
+    }
+    return value;
+}
+
+// 编译期字节序写入：无分支，编译为 (bswap +) store
+template<ByteOrder Order, typename T>
+inline void write_fixed_order(uint8_t* buffer, T value) {
+    if (need_byte_swap<Order>()) {
+        value = reverse_bytes(value);
+    }
+    std::memcpy(buffer, &value, sizeof(T));
+}
+
+// 根据字节序读取数据
+template<typename T>
+inline T read_with_byte_order(const uint8_t* data, ByteOrder order) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+
+    if (need_byte_swap(order)) {
+        value = reverse_bytes(value);
+    }
+
+    return value;
+}
+
+// 根据字节序写入数据
+template<typename T>
+inline void write_with_byte_order(uint8_t* buffer, T value, ByteOrder order) {
+    if (need_byte_swap(order)) {
+        value = reverse_bytes(value);
+    }
+
+    std::memcpy(buffer, &value, sizeof(T));
+}
+
+// ============================================================================
+// 错误消息辅助函数（通用错误消息，与具体数据类型无关）
+// ============================================================================
+
+inline std::string get_error_message(ParseError error) {
+    return error_code_name(error);
+}
+
+// ============================================================================
+// 零拷贝视图类型（协议配置 zeroCopyViews 为 true 时生成代码使用）
+// StringView 直接指向输入缓冲区，调用方需保证缓冲区在使用期间有效；
+// BcdChars<N> 为定长内联字符数组，不分配内存
+// ============================================================================
+
+// 字符串视图：(指针, 长度) 切片，C++11 下替代 std::string_view
+struct StringView {
+    const char* data;
+    size_t size;
+
+    StringView() : data(""), size(0) {}
+    StringView(const char* str) : data(str ? str : ""), size(str ? std::strlen(str) : 0) {}
+    StringView(const char* str, size_t len) : data(str), size(len) {}
+    StringView(const std::string& str) : data(str.data()), size(str.size()) {}
+
+    bool empty() const { return size == 0; }
+    std::string to_string() const { return std::string(data, size); }
+
+    bool operator==(const StringView& other) const {
+        return size == other.size && (size == 0 || std::memcmp(data, other.data, size) == 0);
+    }
+    bool operator!=(const StringView& other) const { return !(*this == other); }
+};
+
+// 完整帧的零拷贝视图（StreamFramer 输出、批量解码 deserialize_batch_<Protocol>() 输入）
+struct FrameSpan {
+    const uint8_t* data;
+    size_t length;
+};
+
+// BCD 定长字符数组：N 为数字位数（字节长度 * 2），末尾保留 '\0'
+template<size_t N>
+struct BcdChars {
+    char digits[N + 1];
+
+    BcdChars() { std::memset(digits, '0', N); digits[N] = '\0'; }
+    // 从数字串构造：不足 N 位时补前导零，超长时截取低位
+    BcdChars(const char* str) {
+        size_t len = str ? std::strlen(str) : 0;
+        size_t skip = len > N ? len - N : 0;
+        size_t pad = N - (len - skip);
+        std::memset(digits, '0', pad);
+        std::memcpy(digits + pad, str + skip, len - skip);
+        digits[N] = '\0';
+    }
+
+    static size_t size() { return N; }
+    const char* c_str() const { return digits; }
+    std::string to_string() const { return std::string(digits, N); }
+
+    bool operator==(const BcdChars& other) const { return std::memcmp(digits, other.digits, N) == 0; }
+    bool operator!=(const BcdChars& other) const { return !(*this == other); }
+    bool operator<(const BcdChars& other) const { return std::memcmp(digits, other.digits, N) < 0; }
+};
+
+// 压缩 BCD 按整数存储的最大字节数（9 字节 = 18 位十进制，不超过 uint64_t）
+static const size_t BCD_UINT_MAX_BYTES = 9;
+
+namespace bcd_detail {
+
+// ----------------------------------------------------------------------------
+// SWAR 基础：8 字节按 uint64_t 一次处理
+// 每字节只放一个半字节（0..15）时，b > 9 等价于 b + 0x76 的最高位为 1，且不会进位到相邻字节
+// ----------------------------------------------------------------------------
+
+// 按小端读写（字节 0 在最低位），与主机字节序无关
+inline uint64_t load_le64(const uint8_t* ptr) {
+    uint64_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return is_system_little_endian() ? value : byte_swap(value);
+}
+
+inline void store_le64(uint8_t* ptr, uint64_t value) {
+    if (!is_system_little_endian()) {
+        value = byte_swap(value);
+    }
+    std::memcpy(ptr, &value, sizeof(value));
+}
+
+inline void store_le32(uint8_t* ptr, uint32_t value) {
+    if (!is_system_little_endian()) {
+        value = byte_swap(value);
+    }
+    std::memcpy(ptr, &value, sizeof(value));
+}
+
+// 按大端读写：压缩 BCD 的首字节是最高位数字，大端读入后整数的位序即数字顺序
+inline uint64_t load_be64(const uint8_t* ptr) {
+    uint64_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return is_system_little_endian() ? byte_swap(value) : value;
+}
+
+inline void store_be64(uint8_t* ptr, uint64_t value) {
+    if (is_system_little_endian()) {
+        value = byte_swap(value);
+    }
+    std::memcpy(ptr, &value, sizeof(value));
+}
+
+// 8 字节压缩 BCD 中是否有大于 9 的半字节
+inline bool has_invalid_nibble(uint64_t packed) {
+    const uint64_t low = packed & 0x0F0F0F0F0F0F0F0FULL;
+    const uint64_t high = (packed >> 4) & 0x0F0F0F0F0F0F0F0FULL;
+    return (((low + 0x7676767676767676ULL) | (high + 0x7676767676767676ULL)) & 0x8080808080808080ULL) != 0;
+}
+
+// 4 字节压缩 BCD（小端读入）→ 8 个 ASCII 数字（小端写出）：
+// 先把字节 i 展开到 16 位通道 i，再把高半字节放到通道低字节、低半字节放到通道高字节
+inline uint64_t unpack4_swar(uint32_t packed) {
+    uint64_t spread = packed;
+    spread = (spread | (spread << 16)) & 0x0000FFFF0000FFFFULL;
+    spread = (spread | (spread << 8)) & 0x00FF00FF00FF00FFULL;
+    const uint64_t digits = ((spread >> 4) & 0x000F000F000F000FULL) | ((spread & 0x000F000F000F000FULL) << 8);
+    return digits + 0x3030303030303030ULL;
+}
+
+// 8 个 ASCII 数字（小端读入）是否都在 '0'..'9'
+inline bool all_digits(uint64_t chars) {
+    const uint64_t low = chars & 0x0F0F0F0F0F0F0F0FULL;
+    return (chars & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL &&
+           ((low + 0x7676767676767676ULL) & 0x8080808080808080ULL) == 0;
+}
+
+// 8 个 ASCII 数字（小端读入，已验证）→ 4 字节压缩 BCD（小端）：
+// 16 位通道内合并 (首位 << 4) | 次位，再把 4 个通道的低字节收拢到低 32 位
+inline uint32_t pack8_swar(uint64_t chars) {
+    const uint64_t digits = chars & 0x0F0F0F0F0F0F0F0FULL;
+    uint64_t packed = ((digits & 0x00FF00FF00FF00FFULL) << 4) | ((digits >> 8) & 0x00FF00FF00FF00FFULL);
+    packed = (packed | (packed >> 8)) & 0x0000FFFF0000FFFFULL;
+    packed = (packed | (packed >> 16)) & 0x00000000FFFFFFFFULL;
+    return static_cast<uint32_t>(packed);
+}
+
+// 8 字节压缩 BCD（大端读入，已验证）→ 十进制值（16 位数字）
+// 每步把相邻两组 k 位数字合并为一组 2k 位：hi * 2^w + lo 减去 hi * (2^w - 10^k)
+inline uint64_t packed8_to_uint(uint64_t packed) {
+    packed -= ((packed >> 4) & 0x0F0F0F0F0F0F0F0FULL) * 6;           // 每字节：hi * 10 + lo
+    packed -= ((packed >> 8) & 0x00FF00FF00FF00FFULL) * 156;         // 每 16 位：hi * 100 + lo
+    packed -= ((packed >> 16) & 0x0000FFFF0000FFFFULL) * 55536;      // 每 32 位：hi * 10^4 + lo
+    packed -= (packed >> 32) * 4194967296ULL;                        // hi * 10^8 + lo
+    return packed;
+}
+
+// 小于 10^8 的十进制值 → 4 字节压缩 BCD（按整数，最高位数字在最高字节）
+// 与 packed8_to_uint 相反：在 32 位 / 16 位通道内并行做除以 100 / 10（乘法 + 移位）
+inline uint32_t uint_to_packed4(uint32_t value) {
+    // 32 位通道：高通道 value / 10^4，低通道 value % 10^4
+    uint64_t lanes = (static_cast<uint64_t>(value / 10000) << 32) | (value % 10000);
+    // 每个 32 位通道 y < 10^4 拆为 (y / 100) << 16 | y % 100；y * 5243 >> 19 在 y < 43699 时等于 y / 100
+    uint64_t quotient = ((lanes * 5243) >> 19) & 0x0000007F0000007FULL;
+    lanes += quotient * (65536 - 100);
+    // 每个 16 位通道 z < 100 变为 (z / 10) << 4 | z % 10；z * 103 >> 10 在 z < 179 时等于 z / 10
+    quotient = ((lanes * 103) >> 10) & 0x000F000F000F000FULL;
+    lanes += quotient * (16 - 10);
+    // 收拢 4 个 16 位通道的低字节
+    lanes = (lanes | (lanes >> 8)) & 0x0000FFFF0000FFFFULL;
+    lanes = (lanes | (lanes >> 16)) & 0x00000000FFFFFFFFULL;
+    return static_cast<uint32_t>(lanes);
+}
+
+// 10 的幂（10^0 .. 10^19）
+inline uint64_t power_of_10(size_t exponent) {
+    static const uint64_t table[20] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+        100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+        10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+    };
+    return table[exponent];
+}
+
+// ----------------------------------------------------------------------------
+// 压缩 BCD ↔ 数字串 / 十进制整数
+// ----------------------------------------------------------------------------
+
+// 解码 byte_length 字节 BCD 为 byte_length * 2 个 ASCII 数字，遇到非法半字节返回 false（out 内容未定义）
+inline bool decode_digits(const uint8_t* ptr, size_t byte_length, char* out) {
+    size_t i = 0;
+#if defined(PROTOCOL_BCD_SSE2)
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero_char = _mm_set1_epi8('0');
+    for (; i + 16 <= byte_length; i += 16) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+        const __m128i low = _mm_and_si128(packed, low_mask);
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(packed, 4), low_mask);
+        const __m128i invalid = _mm_or_si128(_mm_cmpgt_epi8(low, nine), _mm_cmpgt_epi8(high, nine));
+        if (_mm_movemask_epi8(invalid) != 0) {
+            return false;
+        }
+        // 交错高 / 低半字节：每字节展开为 (高位数字, 低位数字)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2),
+                         _mm_add_epi8(_mm_unpacklo_epi8(high, low), zero_char));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2 + 16),
+                         _mm_add_epi8(_mm_unpackhi_epi8(high, low), zero_char));
+    }
+#endif
+    for (; i + 8 <= byte_length; i += 8) {
+        const uint64_t packed = load_le64(ptr + i);
+        if (has_invalid_nibble(packed)) {
+            return false;
+        }
+        store_le64(reinterpret_cast<uint8_t*>(out + i * 2), unpack4_swar(static_cast<uint32_t>(packed)));
+        store_le64(reinterpret_cast<uint8_t*>(out + i * 2 + 8), unpack4_swar(static_cast<uint32_t>(packed >> 32)));
+    }
+    for (; i < byte_length; ++i) {
+        uint8_t high = static_cast<uint8_t>(ptr[i] >> 4);
+        uint8_t low = static_cast<uint8_t>(ptr[i] & 0x0F);
+        if (high > 9 || low > 9) {
+            return false;
+        }
+        out[i * 2] = static_cast<char>('0' + high);
+        out[i * 2 + 1] = static_cast<char>('0' + low);
+    }
+    return true;
+}
+
+// 将 digit_count (= byte_length * 2) 个 ASCII 数字编码为 BCD，遇到非数字返回 false（out 内容未定义）
+inline bool encode_digits(const char* digits, size_t byte_length, uint8_t* out) {
+    size_t i = 0;
+    const uint8_t* chars = reinterpret_cast<const uint8_t*>(digits);
+#if defined(PROTOCOL_BCD_SSE2)
+    const __m128i zero_char = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i low_byte = _mm_set1_epi16(0x00FF);
+    for (; i + 16 <= byte_length; i += 16) {
+        // 减去 '0' 后按无符号比较：小于 '0' 的字符回绕为大值，同样被 > 9 拦下
+        const __m128i first = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i * 2)), zero_char);
+        const __m128i second = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i * 2 + 16)), zero_char);
+        const __m128i over = _mm_or_si128(_mm_subs_epu8(first, nine), _mm_subs_epu8(second, nine));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(over, _mm_setzero_si128())) != 0xFFFF) {
+            return false;
+        }
+        // 16 位通道内 (首位 << 4) | 次位，再饱和收窄为字节
+        const __m128i packed_first = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(first, low_byte), 4),
+                                                  _mm_srli_epi16(first, 8));
+        const __m128i packed_second = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(second, low_byte), 4),
+                                                   _mm_srli_epi16(second, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(packed_first, packed_second));
+    }
+#endif
+    for (; i + 4 <= byte_length; i += 4) {
+        const uint64_t block = load_le64(chars + i * 2);
+        if (!all_digits(block)) {
+            return false;
+        }
+        store_le32(out + i, pack8_swar(block));
+    }
+    for (; i < byte_length; ++i) {
+        char high = digits[i * 2];
+        char low = digits[i * 2 + 1];
+        if (high < '0' || high > '9' || low < '0' || low > '9') {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>(((high - '0') << 4) | (low - '0'));
+    }
+    return true;
+}
+
+// 将 digit_count 个 ASCII 数字右对齐编码为 byte_length 字节 BCD，不足的高位补零
+// （digit_count 不超过 byte_length * 2，奇数位时首个数字放在低半字节）
+inline bool encode_digits_padded(const char* digits, size_t digit_count, size_t byte_length, uint8_t* out) {
+    const size_t pad = byte_length * 2 - digit_count;
+    std::memset(out, 0, pad / 2);
+    out += pad / 2;
+    if (pad % 2 != 0) {
+        if (digits[0] < '0' || digits[0] > '9') {
+            return false;
+        }
+        *out++ = static_cast<uint8_t>(digits[0] - '0');
+        ++digits;
+    }
+    return encode_digits(digits, byte_length - (pad + 1) / 2, out);
+}
+
+// 解码 byte_length（不超过 BCD_UINT_MAX_BYTES）字节 BCD 为十进制整数，遇到非法半字节返回 false
+inline bool decode_uint(const uint8_t* ptr, size_t byte_length, uint64_t& out) {
+    uint64_t head = 0;
+    if (byte_length > 8) {
+        // 第 9 字节（最高两位）单独处理，其余 8 字节一次完成
+        const uint8_t high = static_cast<uint8_t>(ptr[0] >> 4);
+        const uint8_t low = static_cast<uint8_t>(ptr[0] & 0x0F);
+        if (high > 9 || low > 9) {
+            return false;
+        }
+        head = high * 10u + low;
+        ++ptr;
+        --byte_length;
+    }
+    uint64_t packed = 0;
+    if (byte_length == 8) {
+        packed = load_be64(ptr);
+    } else {
+        // 不足 8 字节：高位为零，数值不变
+        for (size_t i = 0; i < byte_length; ++i) {
+            packed = (packed << 8) | ptr[i];
+        }
+    }
+    if (has_invalid_nibble(packed)) {
+        return false;
+    }
+    out = head * 10000000000000000ULL + packed8_to_uint(packed);
+    return true;
+}
+
+// 十进制整数编码为 byte_length（不超过 BCD_UINT_MAX_BYTES）字节 BCD，高位补零；位数超出返回 false
+inline bool encode_uint(uint64_t value, size_t byte_length, uint8_t* out) {
+    if (value >= power_of_10(byte_length * 2)) {
+        return false;
+    }
+    if (byte_length > 8) {
+        const uint64_t head = value / 10000000000000000ULL;
+        value %= 10000000000000000ULL;
+        *out++ = static_cast<uint8_t>(((head / 10) << 4) | (head % 10));
+        --byte_length;
+    }
+    // 不超过 4 字节时 value < 10^8，只需一半
+    const uint64_t packed = byte_length <= 4
+        ? uint_to_packed4(static_cast<uint32_t>(value))
+        : (static_cast<uint64_t>(uint_to_packed4(static_cast<uint32_t>(value / 100000000))) << 32) |
+              uint_to_packed4(static_cast<uint32_t>(value % 100000000));
+    if (byte_length == 8) {
+        store_be64(out, packed);
+    } else {
+        uint64_t remaining = packed;
+        for (size_t i = byte_length; i > 0; --i) {
+            out[i - 1] = static_cast<uint8_t>(remaining);
+            remaining >>= 8;
+        }
+    }
+    return true;
+}
+
+} // namespace bcd_detail
+
+// ============================================================================
+// 位级读写（非字节对齐字段、位域子字段、位填充）
+// 位流按 MSB 优先编号：第 0 位是首字节的最高位（与线上报文的书写顺序一致）；
+// 位域整数内部的子字段按 LSB 编号（startBit 0 为最低位），与 JSON 配置一致
+// ============================================================================
+namespace bits_detail {
+
+inline uint64_t low_mask(unsigned width) {
+    return width >= 64 ? ~0ULL : ((1ULL << width) - 1);
+}
+
+// 以大端方式装载 ptr 起最多 8 字节到 64 位窗口（首字节在最高位），不足 8 字节时低位补 0
+inline uint64_t load_window(const uint8_t* ptr, size_t available) {
+    if (available >= 8) {
+        return read_fixed_order<BIG_ENDIAN, uint64_t>(ptr);
+    }
+    uint64_t window = 0;
+    for (size_t i = 0; i < available; ++i) {
+        window |= static_cast<uint64_t>(ptr[i]) << (56 - 8 * i);
+    }
+    return window;
+}
+
+} // namespace bits_detail
+
+// 取 word 的第 [start, start + width) 位（start 0..63，width 1..64）
+inline uint64_t extract_bits(uint64_t word, unsigned start, unsigned width) {
+#if defined(PROTOCOL_BITS_BMI2)
+    return _bzhi_u64(word >> start, width);
+#else
+    return (word >> start) & bits_detail::low_mask(width);
+#endif
+}
+
+// 把 value 的低 width 位写入 word 的第 [start, start + width) 位，其余位保持不变
+inline uint64_t deposit_bits(uint64_t word, uint64_t value, unsigned start, unsigned width) {
+    const uint64_t mask = bits_detail::low_mask(width) << start;
+    return (word & ~mask) | ((value << start) & mask);
+}
+
+// 按掩码收集不连续的位到低位（PEXT），如分散在多个字节中的同类标志位
+inline uint64_t gather_bits(uint64_t word, uint64_t mask) {
+#if defined(PROTOCOL_BITS_BMI2)
+    return _pext_u64(word, mask);
+#else
+    uint64_t result = 0;
+    for (uint64_t bit = 1; mask != 0; bit <<= 1) {
+        if (word & mask & (~mask + 1)) {
+            result |= bit;
+        }
+        mask &= mask - 1;
+    }
+    return result;
+#endif
+}
+
+// gather_bits 的逆操作：把低位依次散布到掩码的各个置位上（PDEP）
+inline uint64_t scatter_bits(uint64_t value, uint64_t mask) {
+#if defined(PROTOCOL_BITS_BMI2)
+    return _pdep_u64(value, mask);
+#else
+    uint64_t result = 0;
+    for (uint64_t bit = 1; mask != 0; bit <<= 1) {
+        if (value & bit) {
+            result |= mask & (~mask + 1);
+        }
+        mask &= mask - 1;
+    }
+    return result;
+#endif
+}
+
+// 位流读取器：每次读取整体装载一个 64 位窗口再移位截取，不逐位循环
+// 调用方负责边界检查（DeserializeContext::has_bits）
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t length, size_t bit_position = 0)
+        : data_(data), length_(length), position_(bit_position) {}
+
+    size_t bit_position() const { return position_; }
+
+    // 读取 count（1..64）位，按 MSB 优先组成无符号整数
+    uint64_t read(unsigned count) {
+        if (count > 57) {
+            // 起始位偏移最多 7，一个窗口最多容纳 57 位
+            const uint64_t high = read(count - 32);
+            return (high << 32) | read(32);
+        }
+        const size_t byte = position_ >> 3;
+        const uint64_t window = bits_detail::load_window(data_ + byte, length_ - byte) << (position_ & 7);
+        position_ += count;
+        return window >> (64 - count);
+    }
+
+    void skip(size_t count) { position_ += count; }
+
+private:
+    const uint8_t* data_;
+    size_t length_;
+    size_t position_;
+};
+
+// 位流写入器：待写的位先累积在 64 位寄存器中，凑满整字节后一次写出（不回读缓冲区）；
+// 大段位填充只对首尾不足一字节的部分做位运算，中间整字节 memset。
+// 起始位置之前的位保持不变；为了整字写出，当前位置之后最多 7 字节（尚未写入的区域）可能被改写。
+// 写完须调用 flush()（析构时也会调用）把最后不足一字节的位合并进缓冲区
+// 调用方负责边界检查（SerializeContext::has_space_bits）
+class BitWriter {
+public:
+    BitWriter(uint8_t* buffer, size_t capacity, size_t bit_position = 0)
+        : buffer_(buffer), capacity_(capacity), byte_(bit_position >> 3),
+          pending_(0), pending_bits_(static_cast<unsigned>(bit_position & 7)) {
+        if (pending_bits_ > 0) {
+            // 当前字节中已写入的前导位
+            pending_ = (static_cast<uint64_t>(buffer_[byte_]) << 56) & ~(~0ULL >> pending_bits_);
+        }
+    }
+
+    ~BitWriter() { flush(); }
+
+    size_t bit_position() const { return byte_ * 8 + pending_bits_; }
+
+    // 写入 value 的低 count（1..64）位，MSB 优先
+    void write(uint64_t value, unsigned count) {
+        if (count > 57) {
+            // 累积器中最多残留 7 位，一次最多再放 57 位
+            write(value >> 32, count - 32);
+            write(value, 32);
+            return;
+        }
+        pending_ |= (value << (64 - count)) >> pending_bits_;
+        pending_bits_ += count;
+        emit_full_bytes();
+    }
+
+    // 写入 count 个相同的位（one 为 true 时全 1）
+    void fill(size_t count, bool one) {
+        const uint64_t pattern = one ? ~0ULL : 0;
+        const size_t head = (8 - pending_bits_) & 7;
+        if (head > 0 && count > 0) {
+            const size_t n = count < head ? count : head;
+            write(pattern, static_cast<unsigned>(n));
+            count -= n;
+        }
+        const size_t bytes = count >> 3;
+        if (bytes > 0) {
+            // 此时 pending_bits_ 为 0（已对齐）
+            std::memset(buffer_ + byte_, one ? 0xFF : 0x00, bytes);
+            byte_ += bytes;
+        }
+        if ((count & 7) > 0) {
+            write(pattern, static_cast<unsigned>(count & 7));
+        }
+    }
+
+    // 把不足一字节的剩余位与缓冲区中该字节的其余位合并写出；可重复调用，之后仍可继续写入
+    void flush() {
+        if (pending_bits_ > 0) {
+            const uint8_t keep = static_cast<uint8_t>(0xFFu >> pending_bits_);
+            buffer_[byte_] = static_cast<uint8_t>((pending_ >> 56) | (buffer_[byte_] & keep));
+        }
+    }
+
+private:
+    void emit_full_bytes() {
+        const unsigned full = pending_bits_ >> 3;
+        if (full == 0) {
+            return;
+        }
+        if (capacity_ - byte_ >= 8) {
+            write_fixed_order<BIG_ENDIAN, uint64_t>(buffer_ + byte_, pending_);
+        } else {
+            for (unsigned i = 0; i < full; ++i) {
+                buffer_[byte_ + i] = static_cast<uint8_t>(pending_ >> (56 - 8 * i));
+            }
+        }
+        byte_ += full;
+        pending_ = full == 8 ? 0 : pending_ << (8 * full);
+        pending_bits_ &= 7;
+    }
+
+    uint8_t* buffer_;
+    size_t capacity_;
+    size_t byte_;            // 累积器首位所在字节
+    uint64_t pending_;       // 尚未写出的位（左对齐）
+    unsigned pending_bits_;  // 累积器中的位数
+};
+
+// ============================================================================
+// 数组批量字节交换（定长标量数组整块 memcpy 后原地交换字节序）
+// SSE2 下每次处理 16 字节：先交换每个 16 位字内的两个字节，再按元素宽度重排 16 位字
+// ============================================================================
+
+namespace array_detail {
+
+#if defined(PROTOCOL_ARRAY_SSE2)
+inline __m128i swap_bytes_in_words(__m128i v) {
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+template<size_t N> inline __m128i swap_lanes(__m128i v);
+template<> inline __m128i swap_lanes<2>(__m128i v) {
+    return swap_bytes_in_words(v);
+}
+template<> inline __m128i swap_lanes<4>(__m128i v) {
+    v = swap_bytes_in_words(v);
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+}
+template<> inline __m128i swap_lanes<8>(__m128i v) {
+    v = swap_bytes_in_words(v);
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+}
+#endif
+
+// 原地反转 count 个 N 字节元素的字节序（data 不要求对齐）
+template<size_t N>
+inline void swap_elements(uint8_t* data, size_t count) {
+    typedef typename byte_order_detail::UIntOfSize<N>::type UInt;
+    size_t i = 0;
+#if defined(PROTOCOL_ARRAY_SSE2)
+    const size_t per_vector = 16 / N;
+    for (; i + per_vector <= count; i += per_vector) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * N));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * N), swap_lanes<N>(v));
+    }
+#endif
+    for (; i < count; ++i) {
+        UInt value;
+        std::memcpy(&value, data + i * N, N);
+        value = byte_swap(value);
+        std::memcpy(data + i * N, &value, N);
+    }
+}
+
+template<>
+inline void swap_elements<1>(uint8_t*, size_t) {
+}
+
+} // namespace array_detail
+
+// 从线上字节读取 count 个定长标量元素到 out（整数 / 浮点，1/2/4/8 字节）
+template<typename T>
+inline void load_array_elements(T* out, const uint8_t* data, size_t count, ByteOrder order) {
+    static_assert(std::is_arithmetic<T>::value, "T must be arithmetic type");
+    if (count == 0) {
+        return;
+    }
+    std::memcpy(out, data, count * sizeof(T));
+    if (sizeof(T) > 1 && need_byte_swap(order)) {
+        array_detail::swap_elements<sizeof(T)>(reinterpret_cast<uint8_t*>(out), count);
+    }
+}
+
+// 把 count 个定长标量元素按 order 写为线上字节
+template<typename T>
+inline void store_array_elements(uint8_t* buffer, const T* in, size_t count, ByteOrder order) {
+    static_assert(std::is_arithmetic<T>::value, "T must be arithmetic type");
+    if (count == 0) {
+        return;
     }
-};
+    std::memcpy(buffer, in, count * sizeof(T));
+    if (sizeof(T) > 1 && need_byte_swap(order)) {
+        array_detail::swap_elements<sizeof(T)>(buffer, count);
+    }
+}
 
 // ============================================================================
-// 字节序转换通用工具函数
+// 值映射查找（Encode / Bitfield 的 maps → 含义字符串）
+// 生成代码按取值分布选择：取值连续/紧凑时用稠密数组直接下标，稀疏时用有序表二分查找；
+// 返回的含义均为静态字符串，查找过程不分配内存
 // ============================================================================
 
-// 判断当前系统字节序
-inline bool is_system_little_endian() {
-    uint16_t test = 0x0001;
-    return *reinterpret_cast<uint8_t*>(&test) == 0x01;
-}
+// 有序映射表项（生成代码保证按 value 升序排列且无重复）
+struct ValueMeaning {
+    int64_t value;
+    const char* meaning;
+};
 
-// 字节反转函数模板（支持整数和浮点类型）
+// 稠密映射：table[i] 对应取值 base + i，空位为 nullptr；越界或空位返回 fallback
 template<typename T>
-inline T reverse_bytes(T value) {
-    uint8_t bytes[sizeof(T)];
-    std::memcpy(bytes, &value, sizeof(T));
-    
-    // 反转字节顺序
-    for (size_t i = 0; i < sizeof(T) / 2; ++i) {
-        std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+inline const char* lookup_dense_meaning(const char* const* table, size_t size, int64_t base,
+                                        T value, const char* fallback) {
+    // 无符号减法：越界（含小于 base）时下标回绕为大数，一次比较即可
+    uint64_t index = static_cast<uint64_t>(static_cast<int64_t>(value)) - static_cast<uint64_t>(base);
+    if (index < size && table[index] != nullptr) {
+        return table[index];
     }
-    
-    T result;
-    std::memcpy(&result, bytes, sizeof(T));
-    return result;
+    return fallback;
 }
 
-// 根据字节序读取数据
+// 稀疏映射：有序表二分查找（循环体无分支，编译为 cmov），未命中返回 fallback
 template<typename T>
-inline T read_with_byte_order(const uint8_t* data, ByteOrder order) {
-    T value;
-    std::memcpy(&value, data, sizeof(T));
-
-    bool need_swap = (order == BIG_ENDIAN && is_system_little_endian()) ||
-                     (order == LITTLE_ENDIAN && !is_system_little_endian());
-
-    if (need_swap) {
-        value = reverse_bytes(value);
+inline const char* lookup_sorted_meaning(const ValueMeaning* table, size_t size,
+                                         T value, const char* fallback) {
+    if (size == 0) {
+        return fallback;
     }
-
-    return value;
+    const int64_t key = static_cast<int64_t>(value);
+    const ValueMeaning* first = table;
+    size_t count = size;
+    while (count > 1) {
+        size_t half = count / 2;
+        first = (first[half].value <= key) ? first + half : first;
+        count -= half;
+    }
+    return first->value == key ? first->meaning : fallback;
 }
 
-// 根据字节序写入数据
-template<typename T>
-inline void write_with_byte_order(uint8_t* buffer, T value, ByteOrder order) {
-    bool need_swap = (order == BIG_ENDIAN && is_system_little_endian()) ||
-                     (order == LITTLE_ENDIAN && !is_system_little_endian());
+// ============================================================================
+// 报文分发表（MessageID → 解码函数，表驱动分发器使用）
+// 生成器按 MessageID 分布选择：取值紧凑时用稠密跳转表，稀疏时用生成的完美哈希表
+// （两级：桶种子 + 槽位，查找为两次哈希、一次比较），完美哈希构造失败时退化为有序表二分查找。
+// MessageID 统一按 uint64_t 比较（有符号取值按补码转换），未命中返回空处理函数
+// ============================================================================
 
-    if (need_swap) {
-        value = reverse_bytes(value);
-    }
+// 哈希槽位 / 有序表项；空槽位的 handler 为空
+template<typename Handler>
+struct DispatchSlot {
+    uint64_t id;
+    Handler handler;
+};
 
-    std::memcpy(buffer, &value, sizeof(T));
+// 分发哈希函数（与 nodegen/dispatch-table.js 中的 dispatchHash 逐位一致）
+inline uint64_t dispatch_hash(uint64_t key, uint64_t seed) {
+    uint64_t h = (key ^ seed) * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 32);
 }
 
-// ============================================================================
-// 错误消息辅助函数（通用错误消息，与具体数据类型无关）
-// ============================================================================
+// 稠密跳转表：table[i] 对应 MessageID base + i，空位为空处理函数
+template<typename Handler>
+inline Handler lookup_dense_handler(const Handler* table, size_t size, uint64_t base, uint64_t id) {
+    uint64_t index = id - base;
+    return index < size ? table[index] : Handler();
+}
 
-inline std::string get_error_message(ParseError error) {
-    switch (error) {
-        case SUCCESS: return "Success";
-        case INSUFFICIENT_DATA: return "Insufficient data";
-        case INVALID_FORMAT: return "Invalid format";
-        case INVALID_VALUE: return "Invalid value";
-        case INVALID_CHECKSUM: return "Invalid checksum";
-        case BUFFER_OVERFLOW: return "Buffer overflow";
-        case DECOMPRESSION_FAILED: return "Decompression failed";
-        case COMPRESSION_FAILED: return "Compression failed";
-        case UNSUPPORTED_ENCODING: return "Unsupported encoding";
-        case UNKNOWN_ERROR: return "Unknown error";
-        default: return "Unknown error";
+// 完美哈希表：桶号取 dispatch_hash(id, 0) 的高 bucket_bits 位，
+// 槽位取 dispatch_hash(id, seeds[桶号]) 的高 slot_bits 位（slot_bits >= 1）
+template<typename Handler>
+inline Handler lookup_hashed_handler(const DispatchSlot<Handler>* slots, unsigned slot_bits,
+                                     const uint32_t* seeds, unsigned bucket_bits, uint64_t id) {
+    size_t bucket = bucket_bits == 0 ? 0 : static_cast<size_t>(dispatch_hash(id, 0) >> (64 - bucket_bits));
+    const DispatchSlot<Handler>& slot = slots[dispatch_hash(id, seeds[bucket]) >> (64 - slot_bits)];
+    return slot.id == id ? slot.handler : Handler();
+}
+
+// 有序表二分查找（按 id 升序，无重复）
+template<typename Handler>
+inline Handler lookup_sorted_handler(const DispatchSlot<Handler>* table, size_t size, uint64_t id) {
+    if (size == 0) {
+        return Handler();
+    }
+    const DispatchSlot<Handler>* first = table;
+    size_t count = size;
+    while (count > 1) {
+        size_t half = count / 2;
+        first = (first[half].id <= id) ? first + half : first;
+        count -= half;
     }
+    return first->id == id ? first->handler : Handler();
 }
 
 // ============================================================================
@@ -253,17 +1273,17 @@ inline std::string get_error_message(ParseError error) {
 
 // 通用无符号整数反序列化模板
 template<typename T>
-inline DeserializeResult deserialize_unsigned_int_generic(DeserializeContext& ctx, T& out_value) {
+inline DeserializeStatus deserialize_unsigned_int_generic(DeserializeContext& ctx, T& out_value) {
     static_assert(std::is_unsigned<T>::value, "T must be unsigned integer type");
     
     const size_t byte_length = sizeof(T);
     
     if (!ctx.has_bytes(byte_length)) {
-        return DeserializeResult(INSUFFICIENT_DATA, "Not enough data for unsigned integer", 0);
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for unsigned integer", ctx.offset);
     }
     
     if (byte_length > 8) {
-        return DeserializeResult(INVALID_FORMAT, "Unsigned integer byte length too large", 0);
+        return DeserializeStatus::failure(INVALID_FORMAT, "Unsigned integer byte length too large", ctx.offset);
     }
     
     const uint8_t* ptr = ctx.data + ctx.offset;
@@ -286,22 +1306,22 @@ inline DeserializeResult deserialize_unsigned_int_generic(DeserializeContext& ct
     
     out_value = value;
     ctx.advance(byte_length);
-    return DeserializeResult(SUCCESS, "", byte_length);
+    return DeserializeStatus::success(byte_length);
 }
 
 // 通用有符号整数反序列化模板
 template<typename T>
-inline DeserializeResult deserialize_signed_int_generic(DeserializeContext& ctx, T& out_value) {
+inline DeserializeStatus deserialize_signed_int_generic(DeserializeContext& ctx, T& out_value) {
     static_assert(std::is_signed<T>::value, "T must be signed integer type");
     
     const size_t byte_length = sizeof(T);
     
     if (!ctx.has_bytes(byte_length)) {
-        return DeserializeResult(INSUFFICIENT_DATA, "Not enough data for signed integer", 0);
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for signed integer", ctx.offset);
     }
     
     if (byte_length > 8) {
-        return DeserializeResult(INVALID_FORMAT, "Signed integer byte length too large", 0);
+        return DeserializeStatus::failure(INVALID_FORMAT, "Signed integer byte length too large", ctx.offset);
     }
     
     const uint8_t* ptr = ctx.data + ctx.offset;
@@ -327,129 +1347,285 @@ inline DeserializeResult deserialize_signed_int_generic(DeserializeContext& ctx,
     
     out_value = value;
     ctx.advance(byte_length);
-    return DeserializeResult(SUCCESS, "", byte_length);
+    return DeserializeStatus::success(byte_length);
 }
 
 // 通用浮点数反序列化模板
 template<typename T>
-inline DeserializeResult deserialize_float_generic(DeserializeContext& ctx, T& out_value) {
+inline DeserializeStatus deserialize_float_generic(DeserializeContext& ctx, T& out_value) {
     static_assert(std::is_floating_point<T>::value, "T must be floating point type");
     
     const size_t byte_length = sizeof(T);
     
     if (!ctx.has_bytes(byte_length)) {
-        return DeserializeResult(INSUFFICIENT_DATA, "Not enough data for float", 0);
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for float", ctx.offset);
     }
     
     const uint8_t* ptr = ctx.data + ctx.offset;
     out_value = read_with_byte_order<T>(ptr, ctx.byte_order);
     
     ctx.advance(byte_length);
-    return DeserializeResult(SUCCESS, "", byte_length);
+    return DeserializeStatus::success(byte_length);
+}
+
+// 编译期字节序版本：字节序作为模板参数，忽略 ctx.byte_order，
+// 读取展开为一次长度检查 + load (+ bswap)，无按字段的字节序分支
+template<ByteOrder Order, typename T>
+inline DeserializeStatus deserialize_scalar_fixed(DeserializeContext& ctx, T& out_value) {
+    static_assert(std::is_arithmetic<T>::value, "T must be arithmetic type");
+
+    const size_t byte_length = sizeof(T);
+
+    if (!ctx.has_bytes(byte_length)) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for scalar", ctx.offset);
+    }
+
+    out_value = read_fixed_order<Order, T>(ctx.data + ctx.offset);
+    ctx.advance(byte_length);
+    return DeserializeStatus::success(byte_length);
+}
+
+template<ByteOrder Order, typename T>
+inline DeserializeStatus deserialize_unsigned_int_fixed(DeserializeContext& ctx, T& out_value) {
+    static_assert(std::is_unsigned<T>::value, "T must be unsigned integer type");
+    return deserialize_scalar_fixed<Order, T>(ctx, out_value);
+}
+
+template<ByteOrder Order, typename T>
+inline DeserializeStatus deserialize_signed_int_fixed(DeserializeContext& ctx, T& out_value) {
+    static_assert(std::is_signed<T>::value && std::is_integral<T>::value, "T must be signed integer type");
+    return deserialize_scalar_fixed<Order, T>(ctx, out_value);
+}
+
+template<ByteOrder Order, typename T>
+inline DeserializeStatus deserialize_float_fixed(DeserializeContext& ctx, T& out_value) {
+    static_assert(std::is_floating_point<T>::value, "T must be floating point type");
+    return deserialize_scalar_fixed<Order, T>(ctx, out_value);
 }
 
 // 通用BCD反序列化函数
-inline DeserializeResult deserialize_bcd_generic(DeserializeContext& ctx, std::string& out_value,
+inline DeserializeStatus deserialize_bcd_generic(DeserializeContext& ctx, std::string& out_value,
                                                  size_t byte_length) {
     if (!ctx.has_bytes(byte_length)) {
-        return DeserializeResult(INSUFFICIENT_DATA, "Not enough data for BCD", 0);
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for BCD", ctx.offset);
     }
     
-    const uint8_t* ptr = ctx.data + ctx.offset;
-    std::string bcd_str;
-    bcd_str.reserve(byte_length * 2);
-    
-    for (size_t i = 0; i < byte_length; ++i) {
-        uint8_t byte = ptr[i];
-        uint8_t high = (byte >> 4) & 0x0F;
-        uint8_t low = byte & 0x0F;
-        
-        if (high > 9 || low > 9) {
-            return DeserializeResult(INVALID_VALUE, "Invalid BCD value", 0);
-        }
-        
-        bcd_str += ('0' + high);
-        bcd_str += ('0' + low);
+    // 直接解码到输出字符串（复用其已有容量），不经过临时字符串
+    out_value.resize(byte_length * 2);
+    if (byte_length > 0 && !bcd_detail::decode_digits(ctx.data + ctx.offset, byte_length, &out_value[0])) {
+        return DeserializeStatus::failure(INVALID_VALUE, "Invalid BCD value", ctx.offset);
     }
-    
-    out_value = bcd_str;
+
     ctx.advance(byte_length);
-    return DeserializeResult(SUCCESS, "", byte_length);
+    return DeserializeStatus::success(byte_length);
 }
 
 // 通用字符串反序列化函数
-inline DeserializeResult deserialize_string_generic(DeserializeContext& ctx, std::string& out_value,
-                                                    size_t length, const std::string& encoding) {
+// length 为 0 时读到 '\0' 为止并消费终止符；定长时截断到第一个 '\0'，消费 length 字节
+// encoding：ASCII 拒绝 0x80 及以上的字节；UTF-8 验证合法性；GBK 转换为 UTF-8（纯 ASCII 内容直接拷贝）
+inline DeserializeStatus deserialize_string_generic(DeserializeContext& ctx, std::string& out_value,
+                                                    size_t length, StringEncoding encoding) {
+    if (encoding == STRING_ENCODING_UNKNOWN) {
+        return DeserializeStatus::failure(UNSUPPORTED_ENCODING, "Unsupported string encoding", ctx.offset);
+    }
     const uint8_t* ptr = ctx.data + ctx.offset;
+    size_t content_length = 0;
     size_t bytes_consumed = 0;
     
     if (length == 0) {
-        // 变长字符串：读取到 '\0' 截止
+        // 变长字符串：读取到 '\0' 截止（GBK 双字节的尾字节不为 0，可直接查找）
         size_t remaining = ctx.remaining_bytes();
-        size_t str_len = 0;
-        
-        // 查找 '\0' 终止符
-        while (str_len < remaining && ptr[str_len] != '\0') {
-            str_len++;
+        const void* terminator = remaining > 0 ? std::memchr(ptr, '\0', remaining) : nullptr;
+        if (terminator == nullptr) {
+            return DeserializeStatus::failure(INVALID_FORMAT, "Variable-length string missing null terminator", ctx.offset);
         }
-        
-        // 检查是否找到终止符
-        if (str_len == remaining) {
-            return DeserializeResult(INVALID_FORMAT, "Variable-length string missing null terminator", 0);
-        }
-        
-        // 读取字符串内容（不包含 '\0'）
-        out_value.assign(reinterpret_cast<const char*>(ptr), str_len);
+        content_length = static_cast<size_t>(static_cast<const uint8_t*>(terminator) - ptr);
         // 消费字符串内容 + '\0' 终止符
-        bytes_consumed = str_len + 1;
+        bytes_consumed = content_length + 1;
     } else {
         // 定长字符串：读取固定字节数
         if (!ctx.has_bytes(length)) {
-            return DeserializeResult(INSUFFICIENT_DATA, "Not enough data for fixed-length string", 0);
+            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for fixed-length string", ctx.offset);
         }
         
-        // 查找实际内容长度（到第一个 '\0' 或到 length）
-        size_t actual_length = 0;
-        for (size_t i = 0; i < length; ++i) {
-            if (ptr[i] == '\0') {
-                break;
-            }
-            actual_length++;
-        }
-        
-        out_value.assign(reinterpret_cast<const char*>(ptr), actual_length);
+        // 实际内容到第一个 '\0' 或到 length
+        const void* terminator = std::memchr(ptr, '\0', length);
+        content_length = terminator != nullptr
+            ? static_cast<size_t>(static_cast<const uint8_t*>(terminator) - ptr) : length;
         bytes_consumed = length;
     }
     
-    // TODO: 根据 encoding 进行字符集转换
-    // ASCII: 直接使用
-    // UTF-8: 验证编码合法性
-    // GBK: 转换为内部编码（UTF-8 或宽字符）
+    if (encoding == STRING_ENCODING_ASCII) {
+        const size_t ascii_length = ascii_prefix_length(ptr, content_length);
+        if (ascii_length != content_length) {
+            return DeserializeStatus::failure(INVALID_VALUE, "Non-ASCII byte in ASCII string", ctx.offset + ascii_length);
+        }
+    } else if (encoding == STRING_ENCODING_UTF8) {
+        const size_t error_offset = utf8_error_offset(ptr, content_length);
+        if (error_offset != content_length) {
+            return DeserializeStatus::failure(INVALID_VALUE, "Invalid UTF-8 string", ctx.offset + error_offset);
+        }
+    } else if (encoding == STRING_ENCODING_GBK && !is_ascii(ptr, content_length)) {
+        // 直接转换到输出字符串（复用其已有容量），再收缩到实际长度
+        out_value.resize(gbk_to_utf8_max_length(content_length));
+        const TranscodeStatus status = gbk_to_utf8(ptr, content_length,
+                                                   reinterpret_cast<uint8_t*>(&out_value[0]), out_value.size());
+        if (!status.ok()) {
+            return DeserializeStatus::failure(INVALID_VALUE, "Invalid GBK string", ctx.offset + status.consumed);
+        }
+        out_value.resize(status.produced);
+        ctx.advance(bytes_consumed);
+        return DeserializeStatus::success(bytes_consumed);
+    }
     
+    out_value.assign(reinterpret_cast<const char*>(ptr), content_length);
+    ctx.advance(bytes_consumed);
+    return DeserializeStatus::success(bytes_consumed);
+}
+
+// 编码按名称指定（"ASCII" / "UTF-8" / "GBK"，不区分大小写），未知名称返回 UNSUPPORTED_ENCODING
+inline DeserializeStatus deserialize_string_generic(DeserializeContext& ctx, std::string& out_value,
+                                                    size_t length, const std::string& encoding) {
+    return deserialize_string_generic(ctx, out_value, length, string_encoding_from_name(encoding.c_str()));
+}
+
+// 零拷贝字符串反序列化：结果指向输入缓冲区，语义与 ASCII 编码的 deserialize_string_generic 一致
+// （length 为 0 时读到 '\0' 为止并消费终止符；定长时截断到第一个 '\0'，消费 length 字节；拒绝非 ASCII 字节）
+inline DeserializeStatus deserialize_string_view(DeserializeContext& ctx, StringView& out_value,
+                                                 size_t length) {
+    const uint8_t* ptr = ctx.data + ctx.offset;
+    size_t bytes_consumed = 0;
+
+    if (length == 0) {
+        size_t remaining = ctx.remaining_bytes();
+        const void* terminator = remaining > 0 ? std::memchr(ptr, '\0', remaining) : nullptr;
+        if (terminator == nullptr) {
+            return DeserializeStatus::failure(INVALID_FORMAT, "Variable-length string missing null terminator", ctx.offset);
+        }
+        size_t str_len = static_cast<size_t>(static_cast<const uint8_t*>(terminator) - ptr);
+        out_value = StringView(reinterpret_cast<const char*>(ptr), str_len);
+        bytes_consumed = str_len + 1;
+    } else {
+        if (!ctx.has_bytes(length)) {
+            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for fixed-length string", ctx.offset);
+        }
+        const void* terminator = std::memchr(ptr, '\0', length);
+        size_t actual_length = terminator
+            ? static_cast<size_t>(static_cast<const uint8_t*>(terminator) - ptr)
+            : length;
+        out_value = StringView(reinterpret_cast<const char*>(ptr), actual_length);
+        bytes_consumed = length;
+    }
+
+    const size_t ascii_length = ascii_prefix_length(ptr, out_value.size);
+    if (ascii_length != out_value.size) {
+        return DeserializeStatus::failure(INVALID_VALUE, "Non-ASCII byte in ASCII string", ctx.offset + ascii_length);
+    }
+
     ctx.advance(bytes_consumed);
-    return DeserializeResult(SUCCESS, "", bytes_consumed);
+    return DeserializeStatus::success(bytes_consumed);
+}
+
+// BCD 反序列化为十进制整数（byte_length 不超过 BCD_UINT_MAX_BYTES），如 0x12 0x34 → 1234
+inline DeserializeStatus deserialize_bcd_uint(DeserializeContext& ctx, uint64_t& out_value,
+                                              size_t byte_length) {
+    if (byte_length > BCD_UINT_MAX_BYTES) {
+        return DeserializeStatus::failure(INVALID_FORMAT, "BCD too long for integer storage", ctx.offset);
+    }
+    if (!ctx.has_bytes(byte_length)) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for BCD", ctx.offset);
+    }
+
+    if (!bcd_detail::decode_uint(ctx.data + ctx.offset, byte_length, out_value)) {
+        return DeserializeStatus::failure(INVALID_VALUE, "Invalid BCD value", ctx.offset);
+    }
+
+    ctx.advance(byte_length);
+    return DeserializeStatus::success(byte_length);
+}
+
+// BCD 反序列化为定长内联字符数组（N 必须等于 byte_length * 2）
+template<size_t N>
+inline DeserializeStatus deserialize_bcd_chars(DeserializeContext& ctx, BcdChars<N>& out_value) {
+    static_assert(N % 2 == 0, "BcdChars digit count must be even");
+    const size_t byte_length = N / 2;
+    if (!ctx.has_bytes(byte_length)) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for BCD", ctx.offset);
+    }
+    if (!bcd_detail::decode_digits(ctx.data + ctx.offset, byte_length, out_value.digits)) {
+        return DeserializeStatus::failure(INVALID_VALUE, "Invalid BCD value", ctx.offset);
+    }
+
+    ctx.advance(byte_length);
+    return DeserializeStatus::success(byte_length);
 }
 
 // 通用填充跳过函数
-inline DeserializeResult skip_padding_generic(DeserializeContext& ctx, size_t byte_length) {
+inline DeserializeStatus skip_padding_generic(DeserializeContext& ctx, size_t byte_length) {
     if (!ctx.has_bytes(byte_length)) {
-        return DeserializeResult(INSUFFICIENT_DATA, "Not enough data for padding", 0);
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for padding", ctx.offset);
     }
     
     ctx.advance(byte_length);
-    return DeserializeResult(SUCCESS, "", byte_length);
+    return DeserializeStatus::success(byte_length);
 }
 
 // 通用位填充跳过函数
-inline DeserializeResult skip_bits_generic(DeserializeContext& ctx, size_t bit_count) {
-    // 简单检查：将剩余字节转换为位
-    size_t bits_remaining = (ctx.total_length - ctx.offset) * 8 - ctx.bit_offset;
-    if (bit_count > bits_remaining) {
-        return DeserializeResult(INSUFFICIENT_DATA, "Not enough data for bit padding", 0);
+inline DeserializeStatus skip_bits_generic(DeserializeContext& ctx, size_t bit_count) {
+    if (!ctx.has_bits(bit_count)) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for bit padding", ctx.offset);
     }
     
     ctx.advance_bits(bit_count);
-    return DeserializeResult(SUCCESS, "", 0); // bytes_consumed 难以精确表示，暂传 0
+    return DeserializeStatus::success(0); // bytes_consumed 难以精确表示，暂传 0
+}
+
+// 任意位置读取 bit_count（1..64）位（MSB 优先），不要求字节对齐
+inline DeserializeStatus read_bits_generic(DeserializeContext& ctx, unsigned bit_count, uint64_t& out_value) {
+    if (!ctx.has_bits(bit_count)) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for bits", ctx.offset);
+    }
+    BitReader reader(ctx.data, ctx.total_length, ctx.bit_position());
+    out_value = reader.read(bit_count);
+    ctx.seek_bits(reader.bit_position());
+    return DeserializeStatus::success(0);
+}
+
+// 位域整数反序列化：字节对齐时与 deserialize_unsigned_int_generic 相同；
+// 前面有位填充导致不对齐时，从当前位开始读取 sizeof(T) * 8 位，再按字节序解释，位偏移保留给后续位级字段
+template<typename T>
+inline DeserializeStatus deserialize_bitfield_generic(DeserializeContext& ctx, T& out_value) {
+    static_assert(std::is_unsigned<T>::value, "T must be unsigned integer type");
+    if (ctx.bit_offset == 0) {
+        return deserialize_unsigned_int_generic<T>(ctx, out_value);
+    }
+    uint64_t bits = 0;
+    DeserializeStatus res = read_bits_generic(ctx, sizeof(T) * 8, bits);
+    if (!res.is_success()) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for bitfield", ctx.offset);
+    }
+    // 位流按大端组成整数，小端协议再反转字节
+    T value = static_cast<T>(bits);
+    if (resolve_byte_order(ctx.byte_order) == LITTLE_ENDIAN) {
+        value = reverse_bytes(value);
+    }
+    out_value = value;
+    return DeserializeStatus::success(sizeof(T));
+}
+
+// 定长标量数组批量反序列化：一次长度检查，resize 后整块拷贝（需要时向量化交换字节序），
+// 直接写入结果向量；order 为元素字节序（字段未覆写时传 ctx.byte_order）
+template<typename T>
+inline DeserializeStatus deserialize_array_bulk(DeserializeContext& ctx, size_t count, std::vector<T>& out,
+                                                ByteOrder order) {
+    if (count > ctx.remaining_bytes() / sizeof(T)) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for array", ctx.offset);
+    }
+    const size_t byte_length = count * sizeof(T);
+    out.resize(count);
+    load_array_elements(out.data(), ctx.data + ctx.offset, count, order);
+    ctx.advance(byte_length);
+    return DeserializeStatus::success(byte_length);
 }
 
 // 通用范围验证模板（单范围）
@@ -475,17 +1651,17 @@ inline bool validate_multi_range(T value, const std::vector<std::pair<T, T>>& ra
 
 // 通用无符号整数序列化模板
 template<typename T>
-inline SerializeResult serialize_unsigned_int_generic(SerializeContext& ctx, T value) {
+inline SerializeStatus serialize_unsigned_int_generic(SerializeContext& ctx, T value) {
     static_assert(std::is_unsigned<T>::value, "T must be unsigned integer type");
 
     const size_t byte_length = sizeof(T);
 
     if (!ctx.has_space(byte_length)) {
-        return SerializeResult(BUFFER_OVERFLOW, "Not enough space for unsigned integer", 0);
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for unsigned integer", ctx.offset);
     }
 
     if (byte_length > 8) {
-        return SerializeResult(INVALID_FORMAT, "Unsigned integer byte length too large", 0);
+        return SerializeStatus::failure(INVALID_FORMAT, "Unsigned integer byte length too large", ctx.offset);
     }
 
     uint8_t* ptr = ctx.buffer + ctx.offset;
@@ -506,22 +1682,22 @@ inline SerializeResult serialize_unsigned_int_generic(SerializeContext& ctx, T v
     }
 
     ctx.advance(byte_length);
-    return SerializeResult(SUCCESS, "", byte_length);
+    return SerializeStatus::success(byte_length);
 }
 
 // 通用有符号整数序列化模板
 template<typename T>
-inline SerializeResult serialize_signed_int_generic(SerializeContext& ctx, T value) {
+inline SerializeStatus serialize_signed_int_generic(SerializeContext& ctx, T value) {
     static_assert(std::is_signed<T>::value, "T must be signed integer type");
 
     const size_t byte_length = sizeof(T);
 
     if (!ctx.has_space(byte_length)) {
-        return SerializeResult(BUFFER_OVERFLOW, "Not enough space for signed integer", 0);
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for signed integer", ctx.offset);
     }
 
     if (byte_length > 8) {
-        return SerializeResult(INVALID_FORMAT, "Signed integer byte length too large", 0);
+        return SerializeStatus::failure(INVALID_FORMAT, "Signed integer byte length too large", ctx.offset);
     }
 
     uint8_t* ptr = ctx.buffer + ctx.offset;
@@ -544,82 +1720,139 @@ inline SerializeResult serialize_signed_int_generic(SerializeContext& ctx, T val
     }
 
     ctx.advance(byte_length);
-    return SerializeResult(SUCCESS, "", byte_length);
+    return SerializeStatus::success(byte_length);
 }
 
 // 通用浮点数序列化模板
 template<typename T>
-inline SerializeResult serialize_float_generic(SerializeContext& ctx, T value) {
+inline SerializeStatus serialize_float_generic(SerializeContext& ctx, T value) {
     static_assert(std::is_floating_point<T>::value, "T must be floating point type");
 
     const size_t byte_length = sizeof(T);
 
     if (!ctx.has_space(byte_length)) {
-        return SerializeResult(BUFFER_OVERFLOW, "Not enough space for float", 0);
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for float", ctx.offset);
     }
 
     uint8_t* ptr = ctx.buffer + ctx.offset;
     write_with_byte_order(ptr, value, ctx.byte_order);
 
     ctx.advance(byte_length);
-    return SerializeResult(SUCCESS, "", byte_length);
+    return SerializeStatus::success(byte_length);
 }
 
-// 通用BCD序列化函数
-inline SerializeResult serialize_bcd_generic(SerializeContext& ctx, const std::string& value,
-                                             size_t byte_length) {
-    if (!ctx.has_space(byte_length)) {
-        return SerializeResult(BUFFER_OVERFLOW, "Not enough space for BCD", 0);
-    }
+// 编译期字节序版本（与 deserialize_*_fixed 对称）
+template<ByteOrder Order, typename T>
+inline SerializeStatus serialize_scalar_fixed(SerializeContext& ctx, T value) {
+    static_assert(std::is_arithmetic<T>::value, "T must be arithmetic type");
 
-    // BCD 需要偶数位数字
-    size_t required_digits = byte_length * 2;
-    if (value.length() > required_digits) {
-        return SerializeResult(INVALID_VALUE, "BCD string too long", 0);
-    }
+    const size_t byte_length = sizeof(T);
 
-    // 填充前导零
-    std::string padded_value = value;
-    while (padded_value.length() < required_digits) {
-        padded_value = "0" + padded_value;
+    if (!ctx.has_space(byte_length)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for scalar", ctx.offset);
     }
 
-    uint8_t* ptr = ctx.buffer + ctx.offset;
+    write_fixed_order<Order, T>(ctx.buffer + ctx.offset, value);
+    ctx.advance(byte_length);
+    return SerializeStatus::success(byte_length);
+}
+
+template<ByteOrder Order, typename T>
+inline SerializeStatus serialize_unsigned_int_fixed(SerializeContext& ctx, T value) {
+    static_assert(std::is_unsigned<T>::value, "T must be unsigned integer type");
+    return serialize_scalar_fixed<Order, T>(ctx, value);
+}
 
-    for (size_t i = 0; i < byte_length; ++i) {
-        char high_char = padded_value[i * 2];
-        char low_char = padded_value[i * 2 + 1];
+template<ByteOrder Order, typename T>
+inline SerializeStatus serialize_signed_int_fixed(SerializeContext& ctx, T value) {
+    static_assert(std::is_signed<T>::value && std::is_integral<T>::value, "T must be signed integer type");
+    return serialize_scalar_fixed<Order, T>(ctx, value);
+}
 
-        if (high_char < '0' || high_char > '9' || low_char < '0' || low_char > '9') {
-            return SerializeResult(INVALID_VALUE, "Invalid BCD character", 0);
-        }
+template<ByteOrder Order, typename T>
+inline SerializeStatus serialize_float_fixed(SerializeContext& ctx, T value) {
+    static_assert(std::is_floating_point<T>::value, "T must be floating point type");
+    return serialize_scalar_fixed<Order, T>(ctx, value);
+}
 
-        uint8_t high = high_char - '0';
-        uint8_t low = low_char - '0';
-        ptr[i] = (high << 4) | low;
+// 数字串（不必以 '\0' 结尾）序列化为 byte_length 字节 BCD，不足的高位补零；
+// 定长字符数组、字符串字面量直接调用，不构造临时字符串
+inline SerializeStatus serialize_bcd_digits(SerializeContext& ctx, const char* digits, size_t length,
+                                            size_t byte_length) {
+    if (!ctx.has_space(byte_length)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for BCD", ctx.offset);
+    }
+    if (length > byte_length * 2) {
+        return SerializeStatus::failure(INVALID_VALUE, "BCD string too long", ctx.offset);
+    }
+    if (!bcd_detail::encode_digits_padded(digits, length, byte_length, ctx.buffer + ctx.offset)) {
+        return SerializeStatus::failure(INVALID_VALUE, "Invalid BCD character", ctx.offset);
     }
 
     ctx.advance(byte_length);
-    return SerializeResult(SUCCESS, "", byte_length);
+    return SerializeStatus::success(byte_length);
+}
+
+// 通用BCD序列化函数
+inline SerializeStatus serialize_bcd_generic(SerializeContext& ctx, const std::string& value,
+                                             size_t byte_length) {
+    return serialize_bcd_digits(ctx, value.data(), value.size(), byte_length);
 }
 
 // 通用字符串序列化函数
-inline SerializeResult serialize_string_generic(SerializeContext& ctx, const std::string& value,
-                                                size_t fixed_length, const std::string& encoding) {
-    // TODO: 根据 encoding 进行字符集转换
-    // ASCII: 直接使用
-    // UTF-8: 直接使用（假设输入已是UTF-8）
-    // GBK: 从内部编码转换为 GBK
-    
+// 变长写入内容 + '\0'；定长不足补 0、超长截断（UTF-8 / GBK 在字符边界截断）
+// encoding：ASCII 原样写入，含 0x80 及以上的字节时报错；UTF-8 验证后原样写入；
+// GBK 由 UTF-8 转换，GBK 中没有的字符报错
+inline SerializeStatus serialize_string_generic(SerializeContext& ctx, const std::string& value,
+                                                size_t fixed_length, StringEncoding encoding) {
+    if (encoding == STRING_ENCODING_UNKNOWN) {
+        return SerializeStatus::failure(UNSUPPORTED_ENCODING, "Unsupported string encoding", ctx.offset);
+    }
     uint8_t* ptr = ctx.buffer + ctx.offset;
+    const uint8_t* text = reinterpret_cast<const uint8_t*>(value.data());
     size_t bytes_written = 0;
+
+    // 与解析侧对称：写入前检查内容（GBK 在转换时检查）
+    if (encoding == STRING_ENCODING_ASCII && !is_ascii(text, value.length())) {
+        return SerializeStatus::failure(INVALID_VALUE, "Non-ASCII character in ASCII string", ctx.offset);
+    }
+    if (encoding == STRING_ENCODING_UTF8 && !is_valid_utf8(text, value.length())) {
+        return SerializeStatus::failure(INVALID_VALUE, "Invalid UTF-8 string", ctx.offset);
+    }
     
-    if (fixed_length == 0) {
+    if (encoding == STRING_ENCODING_GBK) {
+        // 直接转换到输出缓冲区；变长时为终止符预留 1 字节
+        const size_t capacity = fixed_length == 0
+            ? (ctx.remaining_space() > 0 ? ctx.remaining_space() - 1 : 0) : fixed_length;
+        if (fixed_length != 0 && !ctx.has_space(fixed_length)) {
+            return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for fixed-length string", ctx.offset);
+        }
+        const TranscodeStatus status = utf8_to_gbk(text, value.length(), ptr, capacity);
+        if (status.error == TRANSCODE_INVALID_INPUT) {
+            return SerializeStatus::failure(INVALID_VALUE, "Invalid UTF-8 string", ctx.offset);
+        }
+        if (status.error == TRANSCODE_UNMAPPABLE) {
+            return SerializeStatus::failure(INVALID_VALUE, "Character not representable in GBK", ctx.offset);
+        }
+        if (fixed_length == 0) {
+            if (!status.ok() || !ctx.has_space(status.produced + 1)) {
+                return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for variable-length string", ctx.offset);
+            }
+            ptr[status.produced] = '\0';
+            bytes_written = status.produced + 1;
+        } else {
+            // 超长时已在字符边界截断（TRANSCODE_OUTPUT_FULL），剩余部分补 0
+            if (status.produced < fixed_length) {
+                std::memset(ptr + status.produced, 0, fixed_length - status.produced);
+            }
+            bytes_written = fixed_length;
+        }
+    } else if (fixed_length == 0) {
         // 变长字符串：写入内容 + '\0' 终止符
         size_t write_length = value.length() + 1;
         
         if (!ctx.has_space(write_length)) {
-            return SerializeResult(BUFFER_OVERFLOW, "Not enough space for variable-length string", 0);
+            return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for variable-length string", ctx.offset);
         }
         
         std::memcpy(ptr, value.data(), value.length());
@@ -628,11 +1861,14 @@ inline SerializeResult serialize_string_generic(SerializeContext& ctx, const std
     } else {
         // 定长字符串：写入固定字节数
         if (!ctx.has_space(fixed_length)) {
-            return SerializeResult(BUFFER_OVERFLOW, "Not enough space for fixed-length string", 0);
+            return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for fixed-length string", ctx.offset);
         }
         
-        // 不足补0，超长截断
+        // 不足补0，超长截断（UTF-8 不截断在多字节字符中间）
         size_t copy_len = (value.length() < fixed_length) ? value.length() : fixed_length;
+        if (encoding == STRING_ENCODING_UTF8) {
+            copy_len = utf8_truncate_length(text, value.length(), fixed_length);
+        }
         std::memcpy(ptr, value.data(), copy_len);
         
         // 填充剩余部分为 0
@@ -644,63 +1880,154 @@ inline SerializeResult serialize_string_generic(SerializeContext& ctx, const std
     }
 
     ctx.advance(bytes_written);
-    return SerializeResult(SUCCESS, "", bytes_written);
+    return SerializeStatus::success(bytes_written);
+}
+
+// 编码按名称指定（"ASCII" / "UTF-8" / "GBK"，不区分大小写），未知名称返回 UNSUPPORTED_ENCODING
+inline SerializeStatus serialize_string_generic(SerializeContext& ctx, const std::string& value,
+                                                size_t fixed_length, const std::string& encoding) {
+    return serialize_string_generic(ctx, value, fixed_length, string_encoding_from_name(encoding.c_str()));
+}
+
+// 零拷贝字符串序列化（与 ASCII 编码的 serialize_string_generic 语义一致：变长写入 '\0'，定长不足补 0、超长截断）
+inline SerializeStatus serialize_string_view(SerializeContext& ctx, const StringView& value,
+                                             size_t fixed_length) {
+    uint8_t* ptr = ctx.buffer + ctx.offset;
+    size_t bytes_written = 0;
+
+    if (!is_ascii(reinterpret_cast<const uint8_t*>(value.data), value.size)) {
+        return SerializeStatus::failure(INVALID_VALUE, "Non-ASCII character in ASCII string", ctx.offset);
+    }
+
+    if (fixed_length == 0) {
+        size_t write_length = value.size + 1;
+        if (!ctx.has_space(write_length)) {
+            return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for variable-length string", ctx.offset);
+        }
+        if (value.size > 0) {
+            std::memcpy(ptr, value.data, value.size);
+        }
+        ptr[value.size] = '\0';
+        bytes_written = write_length;
+    } else {
+        if (!ctx.has_space(fixed_length)) {
+            return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for fixed-length string", ctx.offset);
+        }
+        size_t copy_len = value.size < fixed_length ? value.size : fixed_length;
+        if (copy_len > 0) {
+            std::memcpy(ptr, value.data, copy_len);
+        }
+        if (copy_len < fixed_length) {
+            std::memset(ptr + copy_len, 0, fixed_length - copy_len);
+        }
+        bytes_written = fixed_length;
+    }
+
+    ctx.advance(bytes_written);
+    return SerializeStatus::success(bytes_written);
+}
+
+// 十进制整数序列化为 BCD（byte_length 不超过 BCD_UINT_MAX_BYTES，高位补零）
+inline SerializeStatus serialize_bcd_uint(SerializeContext& ctx, uint64_t value, size_t byte_length) {
+    if (byte_length > BCD_UINT_MAX_BYTES) {
+        return SerializeStatus::failure(INVALID_FORMAT, "BCD too long for integer storage", ctx.offset);
+    }
+    if (!ctx.has_space(byte_length)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for BCD", ctx.offset);
+    }
+
+    if (!bcd_detail::encode_uint(value, byte_length, ctx.buffer + ctx.offset)) {
+        return SerializeStatus::failure(INVALID_VALUE, "BCD value too large", ctx.offset);
+    }
+
+    ctx.advance(byte_length);
+    return SerializeStatus::success(byte_length);
+}
+
+// 定长内联字符数组序列化为 BCD
+template<size_t N>
+inline SerializeStatus serialize_bcd_chars(SerializeContext& ctx, const BcdChars<N>& value) {
+    static_assert(N % 2 == 0, "BcdChars digit count must be even");
+    const size_t byte_length = N / 2;
+    if (!ctx.has_space(byte_length)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for BCD", ctx.offset);
+    }
+    if (!bcd_detail::encode_digits(value.digits, byte_length, ctx.buffer + ctx.offset)) {
+        return SerializeStatus::failure(INVALID_VALUE, "Invalid BCD character", ctx.offset);
+    }
+
+    ctx.advance(byte_length);
+    return SerializeStatus::success(byte_length);
 }
 
 // 通用填充写入函数
-inline SerializeResult write_padding_generic(SerializeContext& ctx, size_t byte_length,
+inline SerializeStatus write_padding_generic(SerializeContext& ctx, size_t byte_length,
                                              uint8_t fill_value = 0x00) {
     if (!ctx.has_space(byte_length)) {
-        return SerializeResult(BUFFER_OVERFLOW, "Not enough space for padding", 0);
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for padding", ctx.offset);
     }
 
     uint8_t* ptr = ctx.buffer + ctx.offset;
     std::memset(ptr, fill_value, byte_length);
 
     ctx.advance(byte_length);
-    return SerializeResult(SUCCESS, "", byte_length);
+    return SerializeStatus::success(byte_length);
 }
 
 // 通用位填充写入函数
-// 支持跨字节边界写入指定的位数（填充 0 或 1）
-inline SerializeResult write_padding_bits_generic(SerializeContext& ctx, size_t bit_count,
+// 支持跨字节边界写入指定的位数（填充 0 或 1）：首尾不足一字节的部分按位写，中间整字节 memset
+inline SerializeStatus write_padding_bits_generic(SerializeContext& ctx, size_t bit_count,
                                                   uint8_t fill_bit = 0) {
-    // 计算剩余空间（位）
-    size_t bits_remaining = (ctx.max_length - ctx.offset) * 8 - ctx.bit_offset;
-    if (bit_count > bits_remaining) {
-        return SerializeResult(BUFFER_OVERFLOW, "Not enough space for bit padding", 0);
+    if (!ctx.has_space_bits(bit_count)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for bit padding", ctx.offset);
     }
 
-    // 逐位写入
-    // 为了性能，这可以优化，但对于 padding 来说，简单循环足够了
-    size_t bits_to_write = bit_count;
-    uint8_t fill = fill_bit ? 1 : 0;
-    
-    // 如果 bit_count 很大，这可能会慢。但通常 Padding 不会太大。
-    // 更好的实现是先处理非对齐部分，然后 memset 中间字节，最后处理剩余非对齐部分。
-    // 这里采用简单的逐位写入以确保正确性。
-    
-    size_t current_offset = ctx.offset;
-    uint8_t current_bit = ctx.bit_offset;
-    
-    while (bits_to_write > 0) {
-        uint8_t* ptr = ctx.buffer + current_offset;
-        if (fill) {
-            *ptr |= (1 << (7 - current_bit));
-        } else {
-            *ptr &= ~(1 << (7 - current_bit));
-        }
-        
-        current_bit++;
-        if (current_bit == 8) {
-            current_bit = 0;
-            current_offset++;
-        }
-        bits_to_write--;
+    BitWriter writer(ctx.buffer, ctx.max_length, ctx.bit_position());
+    writer.fill(bit_count, fill_bit != 0);
+    writer.flush();
+    ctx.seek_bits(writer.bit_position());
+    return SerializeStatus::success(0); // bytes_written 难以精确表示
+}
+
+// 任意位置写入 value 的低 bit_count（1..64）位（MSB 优先），不要求字节对齐
+inline SerializeStatus write_bits_generic(SerializeContext& ctx, uint64_t value, unsigned bit_count) {
+    if (!ctx.has_space_bits(bit_count)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for bits", ctx.offset);
     }
+    BitWriter writer(ctx.buffer, ctx.max_length, ctx.bit_position());
+    writer.write(value, bit_count);
+    writer.flush();
+    ctx.seek_bits(writer.bit_position());
+    return SerializeStatus::success(0);
+}
 
-    ctx.advance_bits(bit_count);
-    return SerializeResult(SUCCESS, "", 0); // bytes_written 难以精确表示
+// 位域整数序列化：与 deserialize_bitfield_generic 对称
+template<typename T>
+inline SerializeStatus serialize_bitfield_generic(SerializeContext& ctx, T value) {
+    static_assert(std::is_unsigned<T>::value, "T must be unsigned integer type");
+    if (ctx.bit_offset == 0) {
+        return serialize_unsigned_int_generic<T>(ctx, value);
+    }
+    if (resolve_byte_order(ctx.byte_order) == LITTLE_ENDIAN) {
+        value = reverse_bytes(value);
+    }
+    SerializeStatus res = write_bits_generic(ctx, value, sizeof(T) * 8);
+    if (!res.is_success()) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for bitfield", ctx.offset);
+    }
+    return SerializeStatus::success(sizeof(T));
+}
+
+// 定长标量数组批量序列化：与 deserialize_array_bulk 对称
+template<typename T>
+inline SerializeStatus serialize_array_bulk(SerializeContext& ctx, const std::vector<T>& in, ByteOrder order) {
+    if (in.size() > ctx.remaining_space() / sizeof(T)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for array", ctx.offset);
+    }
+    const size_t byte_length = in.size() * sizeof(T);
+    store_array_elements(ctx.buffer + ctx.offset, in.data(), in.size(), order);
+    ctx.advance(byte_length);
+    return SerializeStatus::success(byte_length);
 }
 
 } // namespace protocol_parser
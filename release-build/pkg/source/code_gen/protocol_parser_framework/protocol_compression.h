@@ -0,0 +1,725 @@
+#ifndef PROTOCOL_COMPRESSION_H
+#define PROTOCOL_COMPRESSION_H
+
+#include "protocol_common.h"
+#include "protocol_cpu.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// ============================================================================
+// Stream-VByte 解码的 SSSE3 路径（pshufb），运行期按 CPU 特性选择
+// 定义 PROTOCOL_COMPRESSION_NO_SIMD 可关闭，回退到标量解码
+// ============================================================================
+#if !defined(PROTOCOL_COMPRESSION_NO_SIMD)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PROTOCOL_COMPRESSION_X86 1
+#define PROTOCOL_COMPRESSION_TARGET(features) __attribute__((target(features)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define PROTOCOL_COMPRESSION_X86 1
+#define PROTOCOL_COMPRESSION_TARGET(features)
+#include <intrin.h>
+#endif
+#endif
+
+namespace protocol_parser {
+
+// ============================================================================
+// 整数变长编码与块压缩（无外部依赖）
+// - ZigZag：有符号整数映射为无符号（0, -1, 1, -2 ... → 0, 1, 2, 3 ...），小绝对值编码短
+// - varint：LEB128，每字节 7 位、最高位为续位；解码在剩余数据 >= 8 字节时一次装载 8 字节，
+//   用续位掩码定位结束字节，再用三步移位合并各 7 位组，无逐字节分支
+// - Stream-VByte：uint32 数组，每 4 个元素一个控制字节（每元素 2 位长度码）+ 1~4 字节小端数据，
+//   x86 SSSE3 下按控制字节查表 pshufb，一次解出 4 个元素
+// - LZ4 块格式：与标准 LZ4 block format 兼容（可互相解压），贪心哈希匹配
+// ============================================================================
+
+namespace compression_detail {
+
+using cpu_detail::count_trailing_zeros;
+using cpu_detail::load_u32;
+
+} // namespace compression_detail
+
+// ============================================================================
+// ZigZag
+// ============================================================================
+
+template<typename S>
+inline typename std::make_unsigned<S>::type zigzag_encode(S value) {
+    static_assert(std::is_signed<S>::value && std::is_integral<S>::value, "S must be signed integer type");
+    typedef typename std::make_unsigned<S>::type U;
+    const U bits = static_cast<U>(value);
+    // 符号位扩展为全 0 / 全 1（不依赖有符号右移的实现定义行为）
+    const U sign = static_cast<U>(U(0) - (bits >> (sizeof(U) * 8 - 1)));
+    return static_cast<U>((bits << 1) ^ sign);
+}
+
+template<typename U>
+inline typename std::make_signed<U>::type zigzag_decode(U value) {
+    static_assert(std::is_unsigned<U>::value, "U must be unsigned integer type");
+    typedef typename std::make_signed<U>::type S;
+    return static_cast<S>(static_cast<U>((value >> 1) ^ static_cast<U>(U(0) - (value & 1u))));
+}
+
+// ============================================================================
+// varint（LEB128）
+// ============================================================================
+
+// uint64 编码后最多 10 字节
+static const size_t VARINT_MAX_BYTES = 10;
+
+// value 编码后的字节数（1..10）
+inline size_t varint_size(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+// 编码 value，返回写入的字节数；out 至少需要 varint_size(value) 字节
+inline size_t encode_varint(uint64_t value, uint8_t* out) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+// 解码一个 varint，返回消费的字节数；数据截断或超过 64 位时返回 0
+inline size_t decode_varint(const uint8_t* data, size_t length, uint64_t& out_value) {
+    // 1~2 字节（最常见的小数值）逐字节判断；更长的编码走 8 字节装载路径
+    if (length != 0 && data[0] < 0x80) {
+        out_value = data[0];
+        return 1;
+    }
+    if (length >= 2 && data[1] < 0x80) {
+        out_value = static_cast<uint64_t>(data[0] & 0x7F) | (static_cast<uint64_t>(data[1]) << 7);
+        return 2;
+    }
+    if (length >= 8) {
+        const uint64_t word = read_fixed_order<LITTLE_ENDIAN, uint64_t>(data);
+        const uint64_t stops = ~word & 0x8080808080808080ULL;
+        if (stops != 0) {
+            // 续位为 0 的第一个字节即结束字节；前 8 字节内结束时无逐字节分支
+            const unsigned bytes = (compression_detail::count_trailing_zeros(stops) >> 3) + 1;
+            uint64_t x = word & 0x7F7F7F7F7F7F7F7FULL;
+            if (bytes < 8) {
+                x &= (1ULL << (bytes * 8)) - 1;
+            }
+#if defined(PROTOCOL_BITS_BMI2)
+            out_value = _pext_u64(x, 0x7F7F7F7F7F7F7F7FULL);
+#else
+            x = (x & 0x007F007F007F007FULL) | ((x & 0x7F007F007F007F00ULL) >> 1);
+            x = (x & 0x00003FFF00003FFFULL) | ((x & 0x3FFF00003FFF0000ULL) >> 2);
+            x = (x & 0x000000000FFFFFFFULL) | ((x & 0x0FFFFFFF00000000ULL) >> 4);
+            out_value = x;
+#endif
+            return bytes;
+        }
+    }
+    uint64_t value = 0;
+    const size_t limit = length < VARINT_MAX_BYTES ? length : VARINT_MAX_BYTES;
+    for (size_t i = 0; i < limit; ++i) {
+        const uint8_t byte = data[i];
+        if (i == VARINT_MAX_BYTES - 1 && byte > 1) {
+            return 0;  // 第 10 字节只能携带第 64 位
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            out_value = value;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+// 从上下文读取 varint 整数：无符号直接解码，有符号按 ZigZag 解码；超出 T 的取值范围时报 INVALID_VALUE
+template<typename T>
+inline DeserializeStatus deserialize_varint_generic(DeserializeContext& ctx, T& out_value) {
+    static_assert(std::is_integral<T>::value, "T must be integer type");
+    const size_t remaining = ctx.remaining_bytes();
+    uint64_t raw = 0;
+    const size_t consumed = decode_varint(ctx.data + ctx.offset, remaining, raw);
+    if (consumed == 0) {
+        if (remaining < VARINT_MAX_BYTES) {
+            return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for varint", ctx.offset);
+        }
+        return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Malformed varint", ctx.offset);
+    }
+    if (std::is_signed<T>::value) {
+        const int64_t value = zigzag_decode(raw);
+        if (value < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+            value > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+            return DeserializeStatus::failure(INVALID_VALUE, "Varint out of range", ctx.offset);
+        }
+        out_value = static_cast<T>(value);
+    } else {
+        if (raw > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+            return DeserializeStatus::failure(INVALID_VALUE, "Varint out of range", ctx.offset);
+        }
+        out_value = static_cast<T>(raw);
+    }
+    ctx.advance(consumed);
+    return DeserializeStatus::success(consumed);
+}
+
+namespace compression_detail {
+
+template<typename T>
+inline uint64_t varint_wire_value(T value, std::true_type /*is_signed*/) {
+    return zigzag_encode(static_cast<int64_t>(value));
+}
+
+template<typename T>
+inline uint64_t varint_wire_value(T value, std::false_type /*is_signed*/) {
+    return static_cast<uint64_t>(value);
+}
+
+} // namespace compression_detail
+
+// 写入 varint 整数（与 deserialize_varint_generic 对称）
+template<typename T>
+inline SerializeStatus serialize_varint_generic(SerializeContext& ctx, T value) {
+    static_assert(std::is_integral<T>::value, "T must be integer type");
+    const uint64_t wire = compression_detail::varint_wire_value(value, typename std::is_signed<T>::type());
+    const size_t size = varint_size(wire);
+    if (!ctx.has_space(size)) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for varint", ctx.offset);
+    }
+    encode_varint(wire, ctx.buffer + ctx.offset);
+    ctx.advance(size);
+    return SerializeStatus::success(size);
+}
+
+// ============================================================================
+// Stream-VByte（uint32 / int32 数组）
+// 布局：ceil(count / 4) 个控制字节，随后为各元素的 1~4 字节小端数据；
+// 第 i 个元素的长度码位于控制字节 i / 4 的第 (i % 4) * 2 位起的 2 位（长度 = 码 + 1）
+// ============================================================================
+
+namespace compression_detail {
+
+struct StreamVByteTables {
+    uint8_t length[256];       // 控制字节对应的 4 个元素数据总字节数
+    uint8_t shuffle[256][16];  // pshufb 重排表：数据字节 → 4 个 uint32（0x80 置零）
+
+    StreamVByteTables() {
+        for (unsigned control = 0; control < 256; ++control) {
+            unsigned offset = 0;
+            for (unsigned k = 0; k < 4; ++k) {
+                const unsigned size = ((control >> (2 * k)) & 3u) + 1;
+                for (unsigned b = 0; b < 4; ++b) {
+                    shuffle[control][k * 4 + b] = static_cast<uint8_t>(b < size ? offset + b : 0x80);
+                }
+                offset += size;
+            }
+            length[control] = static_cast<uint8_t>(offset);
+        }
+    }
+};
+
+inline const StreamVByteTables& streamvbyte_tables() {
+    static const StreamVByteTables tables;
+    return tables;
+}
+
+inline unsigned streamvbyte_code(uint32_t value) {
+    return static_cast<unsigned>(value > 0xFFu) + static_cast<unsigned>(value > 0xFFFFu) +
+           static_cast<unsigned>(value > 0xFFFFFFu);
+}
+
+// 编码元素值变换：uint32 原样，int32 先 ZigZag
+inline uint32_t streamvbyte_wire(uint32_t value) { return value; }
+inline uint32_t streamvbyte_wire(int32_t value) { return zigzag_encode(value); }
+
+template<typename T>
+inline size_t streamvbyte_encoded_size(const T* values, size_t count) {
+    size_t size = (count + 3) / 4;
+    for (size_t i = 0; i < count; ++i) {
+        size += streamvbyte_code(streamvbyte_wire(values[i])) + 1;
+    }
+    return size;
+}
+
+template<typename T>
+inline size_t streamvbyte_encode_impl(const T* values, size_t count, uint8_t* out, size_t capacity) {
+    const size_t control_bytes = (count + 3) / 4;
+    // 容量足够时每个元素整 4 字节写出（多写的字节被下一个元素覆盖），否则先算出精确长度再逐字节写尾部
+    const bool roomy = capacity >= control_bytes + count * 4;
+    if (!roomy && capacity < streamvbyte_encoded_size(values, count)) {
+        return 0;
+    }
+    uint8_t* data = out + control_bytes;
+    uint8_t* const end = out + capacity;
+    for (size_t group = 0; group < control_bytes; ++group) {
+        // 每组 4 个元素的长度码先在寄存器中拼成控制字节，再一次写出
+        const size_t first = group * 4;
+        const size_t last = first + 4 < count ? first + 4 : count;
+        unsigned control = 0;
+        for (size_t i = first; i < last; ++i) {
+            const uint32_t value = streamvbyte_wire(values[i]);
+            const unsigned code = streamvbyte_code(value);
+            control |= code << ((i - first) * 2);
+            if (roomy || end - data >= 4) {
+                write_fixed_order<LITTLE_ENDIAN, uint32_t>(data, value);
+            } else {
+                for (unsigned b = 0; b <= code; ++b) {
+                    data[b] = static_cast<uint8_t>(value >> (8 * b));
+                }
+            }
+            data += code + 1;
+        }
+        out[group] = static_cast<uint8_t>(control);
+    }
+    return static_cast<size_t>(data - out);
+}
+
+#if defined(PROTOCOL_COMPRESSION_X86)
+// 每个完整控制字节解出 4 个元素；需要从 data 起可读 16 字节，返回已解出的组数
+PROTOCOL_COMPRESSION_TARGET("ssse3")
+inline size_t streamvbyte_decode_ssse3(const uint8_t* control, size_t groups, const uint8_t*& data,
+                                       const uint8_t* input_end, uint32_t* out) {
+    const StreamVByteTables& tables = streamvbyte_tables();
+    size_t g = 0;
+    for (; g < groups && input_end - data >= 16; ++g) {
+        const uint8_t c = control[g];
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[c]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + g * 4), _mm_shuffle_epi8(bytes, mask));
+        data += tables.length[c];
+    }
+    return g;
+}
+#endif
+
+} // namespace compression_detail
+
+// count 个元素编码后的最大字节数
+inline size_t streamvbyte_max_size(size_t count) {
+    return (count + 3) / 4 + count * 4;
+}
+
+// 编码 count 个元素到 out（容量 capacity），返回写入的字节数；容量不足时返回 0。
+// capacity >= streamvbyte_max_size(count) 时走整字写出的快速路径
+inline size_t streamvbyte_encode(const uint32_t* values, size_t count, uint8_t* out, size_t capacity) {
+    return compression_detail::streamvbyte_encode_impl(values, count, out, capacity);
+}
+
+// int32 数组：逐元素 ZigZag 后编码（小绝对值的负数也只占 1 字节）
+inline size_t streamvbyte_encode(const int32_t* values, size_t count, uint8_t* out, size_t capacity) {
+    return compression_detail::streamvbyte_encode_impl(values, count, out, capacity);
+}
+
+// 解码 count 个元素，返回消费的字节数；数据不足时返回 0（先按控制字节核对数据区长度，再解码）
+inline size_t streamvbyte_decode(const uint8_t* data, size_t length, uint32_t* out, size_t count) {
+    const compression_detail::StreamVByteTables& tables = compression_detail::streamvbyte_tables();
+    const size_t control_bytes = (count + 3) / 4;
+    if (length < control_bytes) {
+        return 0;
+    }
+    const size_t groups = count / 4;
+    size_t data_bytes = 0;
+    for (size_t g = 0; g < groups; ++g) {
+        data_bytes += tables.length[data[g]];
+    }
+    for (size_t i = groups * 4; i < count; ++i) {
+        data_bytes += ((data[i >> 2] >> ((i & 3) * 2)) & 3u) + 1;
+    }
+    if (length - control_bytes < data_bytes) {
+        return 0;
+    }
+
+    const uint8_t* p = data + control_bytes;
+    size_t i = 0;
+#if defined(PROTOCOL_COMPRESSION_X86)
+    if (cpu_detail::cpu_features().ssse3) {
+        i = compression_detail::streamvbyte_decode_ssse3(data, groups, p, data + length, out) * 4;
+    }
+#endif
+    for (; i < count; ++i) {
+        const unsigned size = ((data[i >> 2] >> ((i & 3) * 2)) & 3u) + 1;
+        uint32_t value = 0;
+        for (unsigned b = 0; b < size; ++b) {
+            value |= static_cast<uint32_t>(p[b]) << (8 * b);
+        }
+        out[i] = value;
+        p += size;
+    }
+    return control_bytes + data_bytes;
+}
+
+inline size_t streamvbyte_decode(const uint8_t* data, size_t length, int32_t* out, size_t count) {
+    // int32 与 uint32 可互相别名访问：先按无符号解码，再原地 ZigZag 还原
+    uint32_t* raw = reinterpret_cast<uint32_t*>(out);
+    const size_t consumed = streamvbyte_decode(data, length, raw, count);
+    if (consumed != 0) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = zigzag_decode(raw[i]);
+        }
+    }
+    return consumed;
+}
+
+// 从上下文读取 count 个 Stream-VByte 编码的元素到 out（T 为 uint32_t 或 int32_t）
+template<typename T>
+inline DeserializeStatus deserialize_streamvbyte_array(DeserializeContext& ctx, size_t count, std::vector<T>& out) {
+    const size_t remaining = ctx.remaining_bytes();
+    if ((count + 3) / 4 > remaining) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for Stream-VByte array", ctx.offset);
+    }
+    out.resize(count);
+    const size_t consumed = count == 0 ? 0 : streamvbyte_decode(ctx.data + ctx.offset, remaining, out.data(), count);
+    if (count != 0 && consumed == 0) {
+        return DeserializeStatus::failure(INSUFFICIENT_DATA, "Not enough data for Stream-VByte array", ctx.offset);
+    }
+    ctx.advance(consumed);
+    return DeserializeStatus::success(consumed);
+}
+
+// 写入 Stream-VByte 编码的数组（与 deserialize_streamvbyte_array 对称，元素个数由调用方另行记录）
+template<typename T>
+inline SerializeStatus serialize_streamvbyte_array(SerializeContext& ctx, const std::vector<T>& values) {
+    if (values.empty()) {
+        return SerializeStatus::success(0);
+    }
+    const size_t written = streamvbyte_encode(values.data(), values.size(), ctx.buffer + ctx.offset,
+                                              ctx.remaining_space());
+    if (written == 0) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for Stream-VByte array", ctx.offset);
+    }
+    ctx.advance(written);
+    return SerializeStatus::success(written);
+}
+
+// ============================================================================
+// LZ4 块格式
+// 序列：token（高 4 位字面量长度、低 4 位匹配长度 - 4）[长度扩展字节] 字面量 偏移(2B 小端) [长度扩展字节]；
+// 最后一个序列只有字面量。遵循格式约束：最后 5 字节为字面量，最后一次匹配起点距末尾至少 12 字节
+// ============================================================================
+
+static const unsigned LZ4_HASH_LOG = 12;
+static const size_t LZ4_HASH_TABLE_SIZE = static_cast<size_t>(1) << LZ4_HASH_LOG;
+
+namespace compression_detail {
+
+static const size_t LZ4_MIN_MATCH = 4;
+static const size_t LZ4_LAST_LITERALS = 5;
+static const size_t LZ4_MFLIMIT = 12;
+static const size_t LZ4_MAX_OFFSET = 65535;
+static const unsigned LZ4_SKIP_STRENGTH = 6;  // 连续未命中时逐步加大步长（与 LZ4 默认加速一致）
+
+inline uint32_t lz4_hash(uint32_t sequence) {
+    return (sequence * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+// 长度扩展字节数（长度 >= 15 时）
+inline size_t lz4_length_bytes(size_t length) {
+    return length >= 15 ? (length - 15) / 255 + 1 : 0;
+}
+
+inline uint8_t* lz4_write_length(uint8_t* op, size_t length) {
+    if (length >= 15) {
+        length -= 15;
+        while (length >= 255) {
+            *op++ = 255;
+            length -= 255;
+        }
+        *op++ = static_cast<uint8_t>(length);
+    }
+    return op;
+}
+
+// 读取长度扩展字节；越界返回 false
+inline bool lz4_read_length(const uint8_t*& ip, const uint8_t* iend, size_t& length) {
+    uint8_t byte = 0;
+    do {
+        if (ip >= iend) {
+            return false;
+        }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace compression_detail
+
+// 压缩 length 字节后的最大长度
+inline size_t lz4_compress_bound(size_t length) {
+    return length + length / 255 + 16;
+}
+
+// 压缩 src 为一个 LZ4 块写入 dst（容量 capacity），out_length 为压缩后长度。
+// table 为 LZ4_HASH_TABLE_SIZE 个 uint32_t 的哈希表，由调用方分配并跨调用复用（只需在首次使用前清零）：
+// 表项只作为匹配候选，使用前逐字节核对，残留上次压缩的位置不影响正确性
+inline SerializeStatus lz4_compress_block(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity,
+                                          uint32_t* table, size_t& out_length) {
+    using namespace compression_detail;
+    const uint8_t* ip = src;
+    const uint8_t* anchor = src;
+    const uint8_t* const iend = src + length;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + capacity;
+
+    if (length > 0xFFFFFFFFu) {
+        return SerializeStatus::failure(COMPRESSION_FAILED, "LZ4 input too large", 0);
+    }
+
+    if (length >= LZ4_MFLIMIT + 1) {
+        const uint8_t* const mflimit = iend - LZ4_MFLIMIT;
+        const uint8_t* const matchlimit = iend - LZ4_LAST_LITERALS;
+        table[lz4_hash(load_u32(ip))] = 0;
+        ++ip;
+
+        for (;;) {
+            // 查找匹配：当前位置的 4 字节与哈希表候选一致且距离不超过 64KB
+            const uint8_t* match = nullptr;
+            unsigned attempts = 1u << LZ4_SKIP_STRENGTH;
+            for (;;) {
+                if (ip > mflimit) {
+                    goto last_literals;
+                }
+                const uint32_t sequence = load_u32(ip);
+                const uint32_t h = lz4_hash(sequence);
+                const size_t candidate = table[h];
+                const size_t position = static_cast<size_t>(ip - src);
+                table[h] = static_cast<uint32_t>(position);
+                if (candidate < position && position - candidate <= LZ4_MAX_OFFSET &&
+                    load_u32(src + candidate) == sequence) {
+                    match = src + candidate;
+                    break;
+                }
+                ip += attempts++ >> LZ4_SKIP_STRENGTH;
+            }
+
+            // 向前扩展匹配
+            while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                --ip;
+                --match;
+            }
+
+            // 向后扩展匹配（匹配终点不超过 matchlimit）
+            const uint8_t* scan = ip + LZ4_MIN_MATCH;
+            const uint8_t* ref = match + LZ4_MIN_MATCH;
+            while (scan + 8 <= matchlimit) {
+                const uint64_t diff = read_fixed_order<LITTLE_ENDIAN, uint64_t>(scan) ^
+                                      read_fixed_order<LITTLE_ENDIAN, uint64_t>(ref);
+                if (diff != 0) {
+                    scan += count_trailing_zeros(diff) >> 3;
+                    goto match_end;
+                }
+                scan += 8;
+                ref += 8;
+            }
+            while (scan < matchlimit && *scan == *ref) {
+                ++scan;
+                ++ref;
+            }
+        match_end:
+            const size_t literal_length = static_cast<size_t>(ip - anchor);
+            const size_t match_length = static_cast<size_t>(scan - ip);
+            const size_t needed = 1 + lz4_length_bytes(literal_length) + literal_length + 2 +
+                                  lz4_length_bytes(match_length - LZ4_MIN_MATCH);
+            if (static_cast<size_t>(oend - op) < needed) {
+                return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for LZ4 block", 0);
+            }
+
+            uint8_t* token = op++;
+            const size_t literal_code = literal_length < 15 ? literal_length : 15;
+            const size_t match_code = match_length - LZ4_MIN_MATCH < 15 ? match_length - LZ4_MIN_MATCH : 15;
+            *token = static_cast<uint8_t>((literal_code << 4) | match_code);
+            op = lz4_write_length(op, literal_length);
+            std::memcpy(op, anchor, literal_length);
+            op += literal_length;
+            const size_t offset = static_cast<size_t>(ip - match);
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            op = lz4_write_length(op, match_length - LZ4_MIN_MATCH);
+
+            ip = scan;
+            anchor = ip;
+            if (ip > mflimit) {
+                break;
+            }
+            // 记录匹配末尾附近的位置，提高后续命中率
+            table[lz4_hash(load_u32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+        }
+    }
+
+last_literals:
+    const size_t literal_length = static_cast<size_t>(iend - anchor);
+    if (static_cast<size_t>(oend - op) < 1 + compression_detail::lz4_length_bytes(literal_length) + literal_length) {
+        return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for LZ4 block", 0);
+    }
+    *op++ = static_cast<uint8_t>((literal_length < 15 ? literal_length : 15) << 4);
+    op = compression_detail::lz4_write_length(op, literal_length);
+    if (literal_length > 0) {
+        std::memcpy(op, anchor, literal_length);
+    }
+    op += literal_length;
+    out_length = static_cast<size_t>(op - dst);
+    return SerializeStatus::success(out_length);
+}
+
+// 解压一个 LZ4 块到 dst（容量 capacity），out_length 为解压后长度；
+// 所有长度和偏移均做边界检查，输入损坏时返回 DECOMPRESSION_FAILED（不越界读写）
+inline DeserializeStatus lz4_decompress_block(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity,
+                                              size_t& out_length) {
+    using namespace compression_detail;
+    const uint8_t* ip = src;
+    const uint8_t* const iend = src + length;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + capacity;
+
+    for (;;) {
+        if (ip >= iend) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Truncated LZ4 block", static_cast<size_t>(ip - src));
+        }
+        const uint8_t token = *ip++;
+
+        // 字面量
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !lz4_read_length(ip, iend, literal_length)) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Truncated LZ4 block", static_cast<size_t>(ip - src));
+        }
+        if (literal_length > static_cast<size_t>(iend - ip) || literal_length > static_cast<size_t>(oend - op)) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "LZ4 literal out of bounds", static_cast<size_t>(ip - src));
+        }
+        if (literal_length <= 16 && iend - ip >= 16 && oend - op >= 16) {
+            std::memcpy(op, ip, 16);  // 短字面量：定长复制，多写的字节随后被覆盖
+        } else if (literal_length != 0) {
+            std::memcpy(op, ip, literal_length);
+        }
+        op += literal_length;
+        ip += literal_length;
+        if (ip == iend) {
+            break;  // 最后一个序列只有字面量
+        }
+
+        // 匹配
+        if (iend - ip < 2) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Truncated LZ4 block", static_cast<size_t>(ip - src));
+        }
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Invalid LZ4 match offset", static_cast<size_t>(ip - src - 2));
+        }
+        size_t match_length = token & 15u;
+        if (match_length == 15 && !lz4_read_length(ip, iend, match_length)) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Truncated LZ4 block", static_cast<size_t>(ip - src));
+        }
+        match_length += LZ4_MIN_MATCH;
+        const size_t room = static_cast<size_t>(oend - op);
+        if (match_length > room) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "LZ4 match out of bounds", static_cast<size_t>(ip - src));
+        }
+        const uint8_t* match = op - offset;
+        if (offset >= 8 && room - match_length >= 8) {
+            // 每次复制 8 字节（源与目的至少相距 8 字节，块内不重叠），末尾可能多写不超过 7 字节
+            for (size_t i = 0; i < match_length; i += 8) {
+                std::memcpy(op + i, match + i, 8);
+            }
+        } else if (offset >= match_length) {
+            std::memcpy(op, match, match_length);
+        } else {
+            // 短距离重叠（如 offset 1 的游程），逐字节复制
+            for (size_t i = 0; i < match_length; ++i) {
+                op[i] = match[i];
+            }
+        }
+        op += match_length;
+    }
+
+    out_length = static_cast<size_t>(op - dst);
+    return DeserializeStatus::success(length);
+}
+
+// ============================================================================
+// 报文级压缩编解码器（协议配置 messageCompression: { "type": "lz4" }）
+// 线上格式：varint(原始报文长度) + LZ4 块。
+// 持有哈希表和复用缓冲区：解压结果、待压缩的原始报文都放在同一个内部缓冲区中，只增不减，
+// 跨报文复用时稳定后不再分配内存。非线程安全，每个线程使用自己的实例
+// ============================================================================
+class Lz4BlockCodec {
+public:
+    explicit Lz4BlockCodec(size_t max_message_size = 65536)
+        : max_message_size_(max_message_size), table_(LZ4_HASH_TABLE_SIZE, 0) {}
+
+    // 原始报文长度上限（解压时拒绝声明长度更大的输入，防止恶意输入导致大块分配）
+    size_t max_message_size() const { return max_message_size_; }
+
+    // 内部缓冲区，至少 size 字节（序列化时先把原始报文写到这里，再 compress()）
+    uint8_t* scratch(size_t size) {
+        if (scratch_.size() < size) {
+            scratch_.resize(size);
+        }
+        return scratch_.data();
+    }
+
+    // 解压报文：成功时 out 指向内部缓冲区（下次调用本对象的 decompress()/scratch() 前有效）
+    DeserializeStatus decompress(const uint8_t* data, size_t length, const uint8_t*& out, size_t& out_length) {
+        if (data == nullptr || length == 0) {
+            return DeserializeStatus::failure(INVALID_FORMAT, "Invalid input data", 0);
+        }
+        uint64_t raw_length = 0;
+        const size_t header = decode_varint(data, length, raw_length);
+        if (header == 0) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Invalid compressed length prefix", 0);
+        }
+        if (raw_length > max_message_size_) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Decompressed size exceeds limit", 0);
+        }
+        const size_t expected = static_cast<size_t>(raw_length);
+        uint8_t* buffer = scratch(expected);
+        size_t produced = 0;
+        DeserializeStatus status = lz4_decompress_block(data + header, length - header, buffer, expected, produced);
+        if (!status.is_success()) {
+            status.offset += header;
+            return status;
+        }
+        if (produced != expected) {
+            return DeserializeStatus::failure(DECOMPRESSION_FAILED, "Decompressed size mismatch", length);
+        }
+        out = buffer;
+        out_length = produced;
+        return DeserializeStatus::success(length);
+    }
+
+    // 压缩 src 写入 buffer（src 可以是 scratch() 返回的内部缓冲区）；bytes_written 为压缩后总长度
+    SerializeStatus compress(const uint8_t* src, size_t length, uint8_t* buffer, size_t buffer_size) {
+        if (buffer == nullptr || buffer_size == 0) {
+            return SerializeStatus::failure(INVALID_FORMAT, "Invalid output buffer", 0);
+        }
+        const size_t header = varint_size(length);
+        if (buffer_size < header) {
+            return SerializeStatus::failure(BUFFER_OVERFLOW, "Not enough space for compressed length prefix", 0);
+        }
+        encode_varint(length, buffer);
+        size_t block_length = 0;
+        SerializeStatus status = lz4_compress_block(src, length, buffer + header, buffer_size - header,
+                                                    table_.data(), block_length);
+        if (!status.is_success()) {
+            return status;
+        }
+        return SerializeStatus::success(header + block_length);
+    }
+
+private:
+    size_t max_message_size_;
+    std::vector<uint32_t> table_;
+    std::vector<uint8_t> scratch_;
+};
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_COMPRESSION_H
@@ -0,0 +1,135 @@
+#ifndef PROTOCOL_CPU_H
+#define PROTOCOL_CPU_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// ============================================================================
+// CPU 特性检测与位操作辅助（校验和、压缩、字符串编码共用）
+// 各模块的 SIMD 路径仍由自身的开关宏控制（PROTOCOL_CHECKSUM_NO_HW_ACCEL、
+// PROTOCOL_COMPRESSION_NO_SIMD、PROTOCOL_ENCODING_NO_SIMD），这里只负责检测
+// ============================================================================
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PROTOCOL_CPU_X86 1
+#include <cpuid.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define PROTOCOL_CPU_X86 1
+#include <intrin.h>
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace protocol_parser {
+namespace cpu_detail {
+
+// CPU 特性（进程内只检测一次）
+struct CpuFeatures {
+    bool sse2;
+    bool ssse3;     // pshufb（Stream-VByte 解码、UTF-8 验证）
+    bool sse42;     // crc32 指令（CRC-32C）
+    bool pclmul;    // 无进位乘法（任意多项式折叠），同时要求 SSSE3
+    bool avx2;      // 同时要求操作系统保存 YMM 状态
+};
+
+inline CpuFeatures detect_cpu_features() {
+    CpuFeatures features = { false, false, false, false, false };
+#if defined(PROTOCOL_CPU_X86)
+    unsigned int ecx = 0, edx = 0, ebx7 = 0;
+    bool has_leaf7 = false;
+#if defined(_MSC_VER)
+    int info[4] = { 0, 0, 0, 0 };
+    __cpuid(info, 0);
+    has_leaf7 = info[0] >= 7;
+    __cpuid(info, 1);
+    ecx = static_cast<unsigned int>(info[2]);
+    edx = static_cast<unsigned int>(info[3]);
+    if (has_leaf7) {
+        __cpuidex(info, 7, 0);
+        ebx7 = static_cast<unsigned int>(info[1]);
+    }
+#else
+    unsigned int eax = 0, ebx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return features;
+    }
+    has_leaf7 = __get_cpuid_max(0, nullptr) >= 7;
+    if (has_leaf7) {
+        unsigned int eax7 = 0, ecx7 = 0, edx7 = 0;
+        __cpuid_count(7, 0, eax7, ebx7, ecx7, edx7);
+    }
+#endif
+    features.sse2 = (edx & (1u << 26)) != 0;
+    features.ssse3 = (ecx & (1u << 9)) != 0;
+    features.sse42 = (ecx & (1u << 20)) != 0;
+    features.pclmul = (ecx & (1u << 1)) != 0 && features.ssse3;
+
+    // AVX2：CPU 支持 + OSXSAVE 且 XCR0 中 XMM/YMM 状态均已启用
+    const bool osxsave = (ecx & (1u << 27)) != 0 && (ecx & (1u << 28)) != 0;
+    if (osxsave && (ebx7 & (1u << 5)) != 0) {
+#if defined(_MSC_VER)
+        const unsigned long long xcr0 = _xgetbv(0);
+#else
+        unsigned int xcr0_lo = 0, xcr0_hi = 0;
+        __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        const unsigned long long xcr0 = (static_cast<unsigned long long>(xcr0_hi) << 32) | xcr0_lo;
+#endif
+        features.avx2 = (xcr0 & 0x6) == 0x6;
+    }
+#endif
+    return features;
+}
+
+inline const CpuFeatures& cpu_features() {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
+
+// ---- 位操作与非对齐装载（value 不能为 0）----
+
+inline unsigned count_trailing_zeros(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(value));
+#elif defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    unsigned count = 0;
+    while ((value & 1u) == 0) {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline unsigned count_trailing_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    const uint32_t low = static_cast<uint32_t>(value);
+    return low != 0 ? count_trailing_zeros(low) : 32 + count_trailing_zeros(static_cast<uint32_t>(value >> 32));
+#endif
+}
+
+inline uint32_t load_u32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64_t load_u64(const uint8_t* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+} // namespace cpu_detail
+} // namespace protocol_parser
+
+#endif // PROTOCOL_CPU_H
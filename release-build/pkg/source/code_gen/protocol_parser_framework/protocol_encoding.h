@@ -0,0 +1,563 @@
+#ifndef PROTOCOL_ENCODING_H
+#define PROTOCOL_ENCODING_H
+
+#include "protocol_cpu.h"
+#include "protocol_gbk_table.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// ============================================================================
+// 字符串编码的 SIMD 路径
+// - ASCII 检查：SSE2（x86-64 基线指令集，无需运行期检测）每次 64 字节
+// - UTF-8 验证：SSSE3（pshufb 查表），运行期按 CPU 特性选择
+// 定义 PROTOCOL_ENCODING_NO_SIMD 可关闭，回退到每次 8 字节的标量实现
+// ============================================================================
+#if !defined(PROTOCOL_ENCODING_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PROTOCOL_ENCODING_SSE2 1
+#include <emmintrin.h>
+#endif
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PROTOCOL_ENCODING_X86 1
+#define PROTOCOL_ENCODING_TARGET(features) __attribute__((target(features)))
+#include <tmmintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define PROTOCOL_ENCODING_X86 1
+#define PROTOCOL_ENCODING_TARGET(features)
+#include <intrin.h>
+#endif
+#endif
+
+namespace protocol_parser {
+
+// ============================================================================
+// 字符串编码（String 字段的 encoding 属性）
+// - ASCII：按原样读写，不检查
+// - UTF-8：解析时验证编码合法性（拒绝过长编码、代理项、超出 U+10FFFF 和截断的序列）；
+//   定长字段超长时在字符边界截断
+// - GBK：线上为 GBK，程序内为 UTF-8；解析时 GBK → UTF-8，序列化时 UTF-8 → GBK（查表，无映射的字符报错）
+// 三者的快速路径都是向量化的 ASCII 检查：纯 ASCII 内容直接拷贝，不逐字节处理
+// ============================================================================
+
+enum StringEncoding {
+    STRING_ENCODING_ASCII,
+    STRING_ENCODING_UTF8,
+    STRING_ENCODING_GBK,
+    STRING_ENCODING_UNKNOWN
+};
+
+// 编码名称（不区分大小写）："ASCII"、"UTF-8"/"UTF8"、"GBK"/"CP936"/"GB2312"；空字符串按 ASCII
+inline StringEncoding string_encoding_from_name(const char* name) {
+    if (name == nullptr || name[0] == '\0') {
+        return STRING_ENCODING_ASCII;
+    }
+    char upper[8];
+    size_t n = 0;
+    for (; name[n] != '\0'; ++n) {
+        if (n == sizeof(upper) - 1) {
+            return STRING_ENCODING_UNKNOWN;
+        }
+        const char c = name[n];
+        upper[n] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    upper[n] = '\0';
+    if (std::strcmp(upper, "ASCII") == 0) {
+        return STRING_ENCODING_ASCII;
+    }
+    if (std::strcmp(upper, "UTF-8") == 0 || std::strcmp(upper, "UTF8") == 0) {
+        return STRING_ENCODING_UTF8;
+    }
+    if (std::strcmp(upper, "GBK") == 0 || std::strcmp(upper, "CP936") == 0 || std::strcmp(upper, "GB2312") == 0) {
+        return STRING_ENCODING_GBK;
+    }
+    return STRING_ENCODING_UNKNOWN;
+}
+
+// 转码结果：consumed 为已消费的输入字节数（出错时即出错位置，总在字符边界），produced 为已写入的输出字节数
+enum TranscodeError {
+    TRANSCODE_OK,
+    TRANSCODE_INVALID_INPUT,   // 输入不是合法的源编码（含末尾截断的字符）
+    TRANSCODE_UNMAPPABLE,      // 字符在目标编码中不存在
+    TRANSCODE_OUTPUT_FULL      // 输出缓冲区不足（已转换的部分有效）
+};
+
+struct TranscodeStatus {
+    TranscodeError error;
+    size_t consumed;
+    size_t produced;
+
+    TranscodeStatus(TranscodeError code, size_t read, size_t written)
+        : error(code), consumed(read), produced(written) {}
+
+    bool ok() const { return error == TRANSCODE_OK; }
+};
+
+namespace encoding_detail {
+
+using cpu_detail::count_trailing_zeros;
+using cpu_detail::load_u64;
+
+// 标量：每次检查 8 字节的最高位
+inline size_t ascii_prefix_scalar(const uint8_t* data, size_t length, size_t i) {
+    for (; i + 8 <= length; i += 8) {
+        if ((load_u64(data + i) & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+    while (i < length && data[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+// 从 data[i] 开始验证一个 UTF-8 字符，合法时返回其字节数，否则返回 0（Unicode 表 3-7）
+inline size_t utf8_sequence_length(const uint8_t* data, size_t length, size_t i) {
+    const uint8_t lead = data[i];
+    if (lead < 0x80) {
+        return 1;
+    }
+    const size_t remaining = length - i;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        return (remaining >= 2 && (data[i + 1] & 0xC0) == 0x80) ? 2 : 0;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF) {
+        if (remaining < 3 || (data[i + 2] & 0xC0) != 0x80) {
+            return 0;
+        }
+        const uint8_t second = data[i + 1];
+        const uint8_t low = lead == 0xE0 ? 0xA0 : 0x80;    // 过长编码
+        const uint8_t high = lead == 0xED ? 0x9F : 0xBF;   // 代理项 U+D800~U+DFFF
+        return (second >= low && second <= high) ? 3 : 0;
+    }
+    if (lead >= 0xF0 && lead <= 0xF4) {
+        if (remaining < 4 || (data[i + 2] & 0xC0) != 0x80 || (data[i + 3] & 0xC0) != 0x80) {
+            return 0;
+        }
+        const uint8_t second = data[i + 1];
+        const uint8_t low = lead == 0xF0 ? 0x90 : 0x80;    // 过长编码
+        const uint8_t high = lead == 0xF4 ? 0x8F : 0xBF;   // 超出 U+10FFFF
+        return (second >= low && second <= high) ? 4 : 0;
+    }
+    return 0;
+}
+
+// 标量验证，从字符边界 i 开始；返回第一个非法字符的位置，全部合法时返回 length
+inline size_t utf8_error_scalar(const uint8_t* data, size_t length, size_t i) {
+    while (i < length) {
+        i = ascii_prefix_scalar(data, length, i);
+        if (i == length) {
+            break;
+        }
+        const size_t n = utf8_sequence_length(data, length, i);
+        if (n == 0) {
+            return i;
+        }
+        i += n;
+    }
+    return length;
+}
+
+#if defined(PROTOCOL_ENCODING_SSE2)
+// 每次 64 字节（4 个 16 字节向量按位或后取最高位），再逐 16 字节定位
+inline size_t ascii_prefix_sse2(const uint8_t* data, size_t length) {
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 32));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 48));
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0) {
+            break;
+        }
+    }
+    for (; i + 16 <= length; i += 16) {
+        const int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        if (mask != 0) {
+            return i + count_trailing_zeros(static_cast<uint32_t>(mask));
+        }
+    }
+    return ascii_prefix_scalar(data, length, i);
+}
+#endif
+
+#if defined(PROTOCOL_ENCODING_X86)
+// ----------------------------------------------------------------------------
+// 查表法 UTF-8 验证（Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"）
+// 每个字节与其前 1 个字节的高/低半字节各查一张 16 项表（pshufb），三者按位与得到 2 字节范围内的错误；
+// 3/4 字节序列所需的第 2、3 个续字节由前 2/3 个字节是否为 3/4 字节首字节判定
+// ----------------------------------------------------------------------------
+const uint8_t UTF8_TOO_SHORT = 1 << 0;      // 首字节后缺少续字节
+const uint8_t UTF8_TOO_LONG = 1 << 1;       // ASCII 后出现续字节
+const uint8_t UTF8_OVERLONG_3 = 1 << 2;     // E0 80~9F
+const uint8_t UTF8_TOO_LARGE = 1 << 3;      // F4 90~BF、F5~FF
+const uint8_t UTF8_SURROGATE = 1 << 4;      // ED A0~BF
+const uint8_t UTF8_OVERLONG_2 = 1 << 5;     // C0、C1
+const uint8_t UTF8_TOO_LARGE_1000 = 1 << 6; // F5~FF 80~8F
+const uint8_t UTF8_OVERLONG_4 = 1 << 6;     // F0 80~8F
+const uint8_t UTF8_TWO_CONTS = 1 << 7;      // 连续两个续字节（是否合法由 3/4 字节首字节决定）
+const uint8_t UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+struct Utf8Ssse3State {
+    __m128i error;
+    __m128i previous;
+    __m128i previous_incomplete;
+};
+
+PROTOCOL_ENCODING_TARGET("ssse3")
+inline __m128i utf8_high_nibbles(__m128i value) {
+    return _mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi8(0x0F));
+}
+
+PROTOCOL_ENCODING_TARGET("ssse3")
+inline void utf8_check_block(Utf8Ssse3State& state, __m128i input) {
+    const __m128i byte_1_high_table = _mm_setr_epi8(
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        static_cast<char>(UTF8_TWO_CONTS), static_cast<char>(UTF8_TWO_CONTS),
+        static_cast<char>(UTF8_TWO_CONTS), static_cast<char>(UTF8_TWO_CONTS),
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+    const char carry = static_cast<char>(UTF8_CARRY);
+    const char large = static_cast<char>(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000);
+    const __m128i byte_1_low_table = _mm_setr_epi8(
+        static_cast<char>(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4),
+        static_cast<char>(UTF8_CARRY | UTF8_OVERLONG_2),
+        carry, carry,
+        static_cast<char>(UTF8_CARRY | UTF8_TOO_LARGE),
+        large, large, large, large, large, large, large, large,
+        static_cast<char>(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),
+        large, large);
+    const char continuation_80 = static_cast<char>(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+                                                   UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+    const char continuation_90 = static_cast<char>(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+                                                   UTF8_OVERLONG_3 | UTF8_TOO_LARGE);
+    const char continuation_a0 = static_cast<char>(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+                                                   UTF8_SURROGATE | UTF8_TOO_LARGE);
+    const __m128i byte_2_high_table = _mm_setr_epi8(
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        continuation_80, continuation_90, continuation_a0, continuation_a0,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+
+    const __m128i prev1 = _mm_alignr_epi8(input, state.previous, 15);
+    const __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, utf8_high_nibbles(prev1));
+    const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, _mm_set1_epi8(0x0F)));
+    const __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, utf8_high_nibbles(input));
+    const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    // 前 2 个字节 >= 0xE0 或前 3 个字节 >= 0xF0 时，本字节必须是续字节（对应 TWO_CONTS 位）
+    const __m128i prev2 = _mm_alignr_epi8(input, state.previous, 14);
+    const __m128i prev3 = _mm_alignr_epi8(input, state.previous, 13);
+    const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m128i must_continue = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+    state.error = _mm_or_si128(state.error, _mm_xor_si128(must_continue, special));
+
+    // 块末尾未完成的多字节序列（由下一块或结尾检查）
+    const __m128i max_value = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1),
+                                            static_cast<char>(0xC0 - 1));
+    state.previous_incomplete = _mm_subs_epu8(input, max_value);
+    state.previous = input;
+}
+
+PROTOCOL_ENCODING_TARGET("ssse3")
+inline bool utf8_has_error(const Utf8Ssse3State& state) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(state.error, _mm_setzero_si128())) != 0xFFFF;
+}
+
+// 返回第一个非法字符的位置，全部合法时返回 length
+PROTOCOL_ENCODING_TARGET("ssse3")
+inline size_t utf8_error_ssse3(const uint8_t* data, size_t length) {
+    Utf8Ssse3State state;
+    state.error = _mm_setzero_si128();
+    state.previous = _mm_setzero_si128();
+    state.previous_incomplete = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(input) == 0) {
+            // 纯 ASCII 块：只需确认上一块没有未完成的序列
+            state.error = _mm_or_si128(state.error, state.previous_incomplete);
+            state.previous = input;
+            state.previous_incomplete = _mm_setzero_si128();
+        } else {
+            utf8_check_block(state, input);
+        }
+        if (utf8_has_error(state)) {
+            break;
+        }
+    }
+    if (i + 16 > length && !utf8_has_error(state)) {
+        // 末尾不足 16 字节：补 0 后检查，补的 0 同时暴露末尾截断的序列
+        uint8_t tail[16] = { 0 };
+        std::memcpy(tail, data + i, length - i);
+        utf8_check_block(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail)));
+        state.error = _mm_or_si128(state.error, state.previous_incomplete);
+        if (!utf8_has_error(state)) {
+            return length;
+        }
+    }
+    // 出错块之前的内容合法（至多以未完成的序列结尾）：从该序列首字节起用标量定位出错位置
+    size_t start = i;
+    for (size_t back = 1; back <= 3 && back <= i; ++back) {
+        if (data[i - back] >= 0xC0) {
+            start = i - back;
+            break;
+        }
+        if (data[i - back] < 0x80) {
+            break;
+        }
+    }
+    return utf8_error_scalar(data, length, start);
+}
+#endif
+
+// Unicode 码位（BMP）→ GBK 双字节，0 表示无映射；首次使用时由解码表反向生成（128KB）
+struct GbkEncodeTable {
+    uint16_t codes[65536];
+
+    GbkEncodeTable() {
+        std::memset(codes, 0, sizeof(codes));
+        const uint16_t* decode = gbk_decode_table();
+        for (size_t lead = 0; lead < GBK_LEAD_COUNT; ++lead) {
+            for (size_t trail = 0; trail < GBK_TRAIL_COUNT; ++trail) {
+                const uint16_t code_point = decode[lead * GBK_TRAIL_COUNT + trail];
+                if (code_point != 0) {
+                    const size_t trail_byte = 0x40 + trail + (trail >= 0x3F ? 1 : 0);
+                    codes[code_point] = static_cast<uint16_t>(((0x81 + lead) << 8) | trail_byte);
+                }
+            }
+        }
+    }
+};
+
+inline const uint16_t* gbk_encode_table() {
+    static const GbkEncodeTable table;
+    return table.codes;
+}
+
+// GBK 双字节 → Unicode 码位，无映射返回 0
+inline uint16_t gbk_decode_pair(uint8_t lead, uint8_t trail) {
+    if (lead < 0x81 || lead > 0xFE || trail < 0x40 || trail > 0xFE || trail == 0x7F) {
+        return 0;
+    }
+    const size_t column = static_cast<size_t>(trail - 0x40) - (trail > 0x7F ? 1 : 0);
+    return gbk_decode_table()[(lead - 0x81) * GBK_TRAIL_COUNT + column];
+}
+
+} // namespace encoding_detail
+
+// ============================================================================
+// ASCII 检查
+// ============================================================================
+
+// 开头连续 ASCII（< 0x80）字节的个数；等于 length 表示全部为 ASCII
+inline size_t ascii_prefix_length(const uint8_t* data, size_t length) {
+#if defined(PROTOCOL_ENCODING_SSE2)
+    return encoding_detail::ascii_prefix_sse2(data, length);
+#else
+    return encoding_detail::ascii_prefix_scalar(data, length, 0);
+#endif
+}
+
+inline bool is_ascii(const uint8_t* data, size_t length) {
+    return ascii_prefix_length(data, length) == length;
+}
+
+// ============================================================================
+// UTF-8 验证
+// ============================================================================
+
+// 返回第一个非法（或末尾截断的）字符的起始位置，全部合法时返回 length
+inline size_t utf8_error_offset(const uint8_t* data, size_t length) {
+    const size_t ascii = ascii_prefix_length(data, length);
+    if (ascii == length) {
+        return length;
+    }
+#if defined(PROTOCOL_ENCODING_X86)
+    if (cpu_detail::cpu_features().ssse3) {
+        // ASCII 前缀之后即字符边界，不再重复检查
+        return ascii + encoding_detail::utf8_error_ssse3(data + ascii, length - ascii);
+    }
+#endif
+    return encoding_detail::utf8_error_scalar(data, length, ascii);
+}
+
+inline bool is_valid_utf8(const uint8_t* data, size_t length) {
+    return utf8_error_offset(data, length) == length;
+}
+
+// ============================================================================
+// GBK ↔ UTF-8（写入调用方提供的缓冲区）
+// ============================================================================
+
+// GBK → UTF-8 输出的最大字节数（ASCII 1 → 1，双字节 2 → 3）
+inline size_t gbk_to_utf8_max_length(size_t gbk_length) {
+    return gbk_length + gbk_length / 2;
+}
+
+// UTF-8 → GBK 输出的最大字节数（GBK 不会比 UTF-8 长）
+inline size_t utf8_to_gbk_max_length(size_t utf8_length) {
+    return utf8_length;
+}
+
+namespace encoding_detail {
+
+// 接下来 16 字节是否全为 ASCII（调用方保证可读）
+inline bool ascii_block16(const uint8_t* data) {
+    return ((load_u64(data) | load_u64(data + 8)) & 0x8080808080808080ULL) == 0;
+}
+
+// 逐字符转换，ASCII 字节就地复制，遇到 16 字节以上的 ASCII 段时整块拷贝；
+// Checked 为 false 时调用方已保证输出缓冲区足够（按最大长度分配），循环内不检查容量
+template<bool Checked>
+inline TranscodeStatus gbk_to_utf8_loop(const uint8_t* in, size_t in_length, uint8_t* out, size_t out_capacity) {
+    size_t i = 0;
+    size_t o = 0;
+    while (i < in_length) {
+        const uint8_t lead = in[i];
+        if (lead < 0x80) {
+            if (i + 16 <= in_length && ascii_block16(in + i)) {
+                size_t ascii = ascii_prefix_length(in + i, in_length - i);
+                if (Checked && ascii > out_capacity - o) {
+                    ascii = out_capacity - o;
+                    if (ascii != 0) {   // 容量为 0 时 out 可能为空指针
+                        std::memcpy(out + o, in + i, ascii);
+                    }
+                    return TranscodeStatus(TRANSCODE_OUTPUT_FULL, i + ascii, o + ascii);
+                }
+                std::memcpy(out + o, in + i, ascii);
+                i += ascii;
+                o += ascii;
+                continue;
+            }
+            if (Checked && o == out_capacity) {
+                return TranscodeStatus(TRANSCODE_OUTPUT_FULL, i, o);
+            }
+            out[o++] = lead;
+            ++i;
+            continue;
+        }
+        if (i + 1 >= in_length) {
+            return TranscodeStatus(TRANSCODE_INVALID_INPUT, i, o);
+        }
+        const uint16_t code_point = gbk_decode_pair(lead, in[i + 1]);
+        if (code_point == 0) {
+            return TranscodeStatus(TRANSCODE_INVALID_INPUT, i, o);
+        }
+        if (code_point >= 0x800) {
+            if (Checked && out_capacity - o < 3) {
+                return TranscodeStatus(TRANSCODE_OUTPUT_FULL, i, o);
+            }
+            out[o] = static_cast<uint8_t>(0xE0 | (code_point >> 12));
+            out[o + 1] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F));
+            out[o + 2] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+            o += 3;
+        } else {
+            if (Checked && out_capacity - o < 2) {
+                return TranscodeStatus(TRANSCODE_OUTPUT_FULL, i, o);
+            }
+            out[o] = static_cast<uint8_t>(0xC0 | (code_point >> 6));
+            out[o + 1] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+            o += 2;
+        }
+        i += 2;
+    }
+    return TranscodeStatus(TRANSCODE_OK, i, o);
+}
+
+template<bool Checked>
+inline TranscodeStatus utf8_to_gbk_loop(const uint8_t* in, size_t in_length, uint8_t* out, size_t out_capacity) {
+    const uint16_t* table = nullptr;
+    size_t i = 0;
+    size_t o = 0;
+    while (i < in_length) {
+        const uint8_t lead = in[i];
+        if (lead < 0x80) {
+            if (i + 16 <= in_length && ascii_block16(in + i)) {
+                size_t ascii = ascii_prefix_length(in + i, in_length - i);
+                if (Checked && ascii > out_capacity - o) {
+                    ascii = out_capacity - o;
+                    if (ascii != 0) {   // 容量为 0 时 out 可能为空指针
+                        std::memcpy(out + o, in + i, ascii);
+                    }
+                    return TranscodeStatus(TRANSCODE_OUTPUT_FULL, i + ascii, o + ascii);
+                }
+                std::memcpy(out + o, in + i, ascii);
+                i += ascii;
+                o += ascii;
+                continue;
+            }
+            if (Checked && o == out_capacity) {
+                return TranscodeStatus(TRANSCODE_OUTPUT_FULL, i, o);
+            }
+            out[o++] = lead;
+            ++i;
+            continue;
+        }
+        if (table == nullptr) {
+            table = gbk_encode_table();
+        }
+        const size_t n = utf8_sequence_length(in, in_length, i);
+        if (n == 0) {
+            return TranscodeStatus(TRANSCODE_INVALID_INPUT, i, o);
+        }
+        if (n == 4) {
+            return TranscodeStatus(TRANSCODE_UNMAPPABLE, i, o);   // BMP 之外，GBK 无对应字符
+        }
+        const uint32_t code_point = n == 3
+            ? ((lead & 0x0Fu) << 12) | ((in[i + 1] & 0x3Fu) << 6) | (in[i + 2] & 0x3Fu)
+            : ((lead & 0x1Fu) << 6) | (in[i + 1] & 0x3Fu);
+        const uint16_t code = table[code_point];
+        if (code == 0) {
+            return TranscodeStatus(TRANSCODE_UNMAPPABLE, i, o);
+        }
+        if (Checked && out_capacity - o < 2) {
+            return TranscodeStatus(TRANSCODE_OUTPUT_FULL, i, o);
+        }
+        out[o] = static_cast<uint8_t>(code >> 8);
+        out[o + 1] = static_cast<uint8_t>(code & 0xFF);
+        o += 2;
+        i += n;
+    }
+    return TranscodeStatus(TRANSCODE_OK, i, o);
+}
+
+} // namespace encoding_detail
+
+// out_capacity 不小于 gbk_to_utf8_max_length(in_length) 时循环内不检查容量
+inline TranscodeStatus gbk_to_utf8(const uint8_t* in, size_t in_length, uint8_t* out, size_t out_capacity) {
+    if (out_capacity >= gbk_to_utf8_max_length(in_length)) {
+        return encoding_detail::gbk_to_utf8_loop<false>(in, in_length, out, out_capacity);
+    }
+    return encoding_detail::gbk_to_utf8_loop<true>(in, in_length, out, out_capacity);
+}
+
+// out_capacity 不小于 in_length 时循环内不检查容量
+inline TranscodeStatus utf8_to_gbk(const uint8_t* in, size_t in_length, uint8_t* out, size_t out_capacity) {
+    if (out_capacity >= utf8_to_gbk_max_length(in_length)) {
+        return encoding_detail::utf8_to_gbk_loop<false>(in, in_length, out, out_capacity);
+    }
+    return encoding_detail::utf8_to_gbk_loop<true>(in, in_length, out, out_capacity);
+}
+
+// UTF-8 文本截断到不超过 max_length 字节的字符边界（假设输入合法）
+inline size_t utf8_truncate_length(const uint8_t* data, size_t length, size_t max_length) {
+    if (length <= max_length) {
+        return length;
+    }
+    size_t end = max_length;
+    while (end > 0 && (data[end] & 0xC0) == 0x80) {
+        --end;
+    }
+    return end;
+}
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_ENCODING_H
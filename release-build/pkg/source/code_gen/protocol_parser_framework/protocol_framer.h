@@ -0,0 +1,360 @@
+#ifndef PROTOCOL_FRAMER_H
+#define PROTOCOL_FRAMER_H
+
+#include "protocol_common.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// 同步字查找的 SIMD 路径（SSE2 为 x86-64 基线指令集，无需运行期检测）
+// 定义 PROTOCOL_FRAMER_NO_SIMD 可关闭，回退到 memchr + memcmp
+// ============================================================================
+#if !defined(PROTOCOL_FRAMER_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PROTOCOL_FRAMER_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace protocol_parser {
+
+// ============================================================================
+// 分帧参数（由协议配置 framing 生成，见生成代码中的 <Protocol>_frame_spec()）
+// ============================================================================
+struct FrameSpec {
+    const uint8_t* sync;      // 同步字（线上字节顺序），nullptr 表示无同步字
+    size_t sync_length;       // 同步字字节数
+    size_t length_offset;     // 长度字段相对帧起始的偏移
+    size_t length_size;       // 长度字段字节数（1/2/4/8），0 表示定长帧
+    ByteOrder length_order;   // 长度字段字节序
+    int64_t length_adjust;    // 帧总长 = 长度字段值 + length_adjust
+    size_t fixed_length;      // 定长帧的帧长（length_size 为 0 时使用）
+    size_t max_length;        // 帧长上限，超出视为数据损坏并重新同步
+};
+
+// 分帧统计
+struct FramerStats {
+    uint64_t frames;            // 输出的完整帧数（含被拒绝的帧）
+    uint64_t bytes_in;          // 写入的字节数
+    uint64_t bytes_discarded;   // 重新同步时丢弃的字节数
+    uint64_t resyncs;           // 重新同步次数（每段连续的损坏数据计一次）
+    uint64_t rejected;          // 调用方拒绝（reject）的帧数
+};
+
+namespace framer_detail {
+
+// 按字节序读取 1/2/4/8 字节的无符号长度字段
+inline uint64_t read_length_field(const uint8_t* data, size_t size, ByteOrder order) {
+    switch (size) {
+        case 1: return data[0];
+        case 2: return read_with_byte_order<uint16_t>(data, order);
+        case 4: return read_with_byte_order<uint32_t>(data, order);
+        case 8: return read_with_byte_order<uint64_t>(data, order);
+        default: return 0;
+    }
+}
+
+} // namespace framer_detail
+
+// ============================================================================
+// 同步字查找：返回 [data, data + length) 中第一次完整出现 sync 的位置，未找到返回 nullptr
+// 单字节同步字直接使用 memchr；多字节同步字用 SSE2 同时比较前两个字节（每次 16 个候选位置），
+// 候选位置再以 memcmp 确认，噪声中同步字首字节频繁出现时也能保持吞吐
+// ============================================================================
+inline const uint8_t* find_sync_pattern(const uint8_t* data, size_t length,
+                                        const uint8_t* sync, size_t sync_length) {
+    if (sync_length == 0) {
+        return length > 0 ? data : nullptr;
+    }
+    if (length < sync_length) {
+        return nullptr;
+    }
+    if (sync_length == 1) {
+        return static_cast<const uint8_t*>(std::memchr(data, sync[0], length));
+    }
+
+    // 候选起始位置范围 [0, last]
+    const size_t last = length - sync_length;
+    size_t pos = 0;
+
+#if defined(PROTOCOL_FRAMER_SSE2)
+    const __m128i first = _mm_set1_epi8(static_cast<char>(sync[0]));
+    const __m128i second = _mm_set1_epi8(static_cast<char>(sync[1]));
+    // 每次检查 16 个候选位置，需要读取 [pos, pos + 17)
+    while (pos + 16 <= last + 1 && pos + 17 <= length) {
+        const __m128i block0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const __m128i block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block0, first), _mm_cmpeq_epi8(block1, second))));
+        while (mask != 0) {
+            unsigned bit = 0;
+            while (((mask >> bit) & 1u) == 0) {
+                ++bit;
+            }
+            const uint8_t* candidate = data + pos + bit;
+            if (sync_length == 2 || std::memcmp(candidate + 2, sync + 2, sync_length - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        pos += 16;
+    }
+#endif
+
+    while (pos <= last) {
+        const uint8_t* candidate = static_cast<const uint8_t*>(
+            std::memchr(data + pos, sync[0], last - pos + 1));
+        if (candidate == nullptr) {
+            return nullptr;
+        }
+        if (std::memcmp(candidate + 1, sync + 1, sync_length - 1) == 0) {
+            return candidate;
+        }
+        pos = static_cast<size_t>(candidate - data) + 1;
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// 帧头解析（StreamFramer 与 protocol_batch_decode.h 共用）
+// ============================================================================
+
+// 读取帧长所需的最少字节数
+inline size_t frame_header_length(const FrameSpec& spec) {
+    size_t length = spec.sync_length;
+    if (spec.length_size > 0 && spec.length_offset + spec.length_size > length) {
+        length = spec.length_offset + spec.length_size;
+    }
+    return length;
+}
+
+// 计算 frame 处的帧长（至少需 frame_header_length() 字节）；非法（小于帧头或超过上限）时返回 0
+inline uint64_t frame_length_at(const FrameSpec& spec, const uint8_t* frame) {
+    int64_t length;
+    if (spec.length_size == 0) {
+        length = static_cast<int64_t>(spec.fixed_length);
+    } else {
+        const uint64_t value = framer_detail::read_length_field(
+            frame + spec.length_offset, spec.length_size, spec.length_order);
+        if (value > static_cast<uint64_t>(INT64_MAX / 2)) {
+            return 0;
+        }
+        length = static_cast<int64_t>(value) + spec.length_adjust;
+    }
+    if (length <= 0 ||
+        static_cast<uint64_t>(length) < frame_header_length(spec) ||
+        static_cast<uint64_t>(length) > spec.max_length) {
+        return 0;
+    }
+    return static_cast<uint64_t>(length);
+}
+
+// ============================================================================
+// 流式分帧器
+// 从连续字节流（TCP / 串口）中切分完整帧：按同步字定位帧起始，按长度字段（或定长）确定帧长，
+// 长度非法或同步字缺失时丢弃损坏字节并重新同步。输出的 FrameSpan 直接指向内部缓冲区，
+// 可原样交给生成的 deserialize_<Protocol>() / 分发器函数，不做额外拷贝。
+//
+// 缓冲区为单块连续内存（滑动窗口）：读写位置前移，写入空间不足时把尚未消费的尾部数据
+// （至多一个不完整帧加少量噪声）搬到缓冲区开头，保证每个帧在内存中连续。
+//
+// 有效期：next() 返回的帧在下一次 push() / write_area() 之前有效
+// ============================================================================
+class StreamFramer {
+public:
+    // capacity 为 0 时取 max(64 KB, 2 * max_length)；容量至少为 max_length，保证缓冲区满时必有完整帧或可丢弃数据
+    explicit StreamFramer(const FrameSpec& spec, size_t capacity = 0)
+        : spec_(spec)
+        , buffer_(buffer_capacity(spec, capacity))
+        , head_(0)
+        , tail_(0)
+        , last_frame_(0)
+        , pending_length_(0)
+        , in_garbage_(false)
+    {
+        std::memset(&stats_, 0, sizeof(stats_));
+    }
+
+    // 复制写入：空间不足时只写入一部分，返回实际写入的字节数（此时应先调用 next() 消费帧）
+    size_t push(const uint8_t* data, size_t length) {
+        size_t available = 0;
+        uint8_t* area = write_area(available);
+        const size_t accepted = length < available ? length : available;
+        if (accepted > 0) {
+            std::memcpy(area, data, accepted);
+            commit(accepted);
+        }
+        return accepted;
+    }
+
+    // 零拷贝写入：返回可写区域（可直接 recv()/read() 到此处），写入后调用 commit()
+    uint8_t* write_area(size_t& available) {
+        if (head_ == tail_) {
+            head_ = tail_ = last_frame_ = 0;
+        } else if (head_ > 0 && buffer_.size() - tail_ < buffer_.size() / 2) {
+            // 剩余写入空间不足一半时搬移：未消费数据通常不足一帧，搬移量很小
+            compact();
+        }
+        available = buffer_.size() - tail_;
+        return buffer_.data() + tail_;
+    }
+
+    void commit(size_t length) {
+        tail_ += length;
+        stats_.bytes_in += length;
+    }
+
+    // 取下一个完整帧；数据不足时返回 false
+    bool next(FrameSpan& frame) {
+        if (pending_length_ != 0 && tail_ - head_ < pending_length_) {
+            return false;  // 帧头已解析，帧体仍不完整（小块写入时避免重复解析帧头）
+        }
+        for (;;) {
+            const size_t start = seek_frame_start();
+            if (start == NPOS) {
+                return false;
+            }
+
+            const size_t available = tail_ - start;
+            if (available < header_length()) {
+                return false;
+            }
+
+            const uint64_t frame_length = frame_length_at(buffer_.data() + start);
+            if (frame_length == 0) {
+                // 长度非法：视为伪同步字，跳过 1 字节继续查找
+                discard_to(start + 1);
+                continue;
+            }
+            if (available < frame_length) {
+                pending_length_ = static_cast<size_t>(frame_length);
+                return false;
+            }
+
+            frame.data = buffer_.data() + start;
+            frame.length = static_cast<size_t>(frame_length);
+            last_frame_ = start;
+            head_ = start + static_cast<size_t>(frame_length);
+            pending_length_ = 0;
+            in_garbage_ = false;
+            ++stats_.frames;
+            return true;
+        }
+    }
+
+    // 上一帧解码失败（如校验错误）：回到该帧起始位置之后 1 字节重新同步
+    // 仅可在 next() 之后、下一次 push() / write_area() 之前调用
+    void reject() {
+        head_ = last_frame_;
+        discard_to(last_frame_ + 1);
+        ++stats_.rejected;
+    }
+
+    // 逐帧回调 fn(const FrameSpan&)，返回 false 表示该帧解码失败（触发 reject 重新同步）
+    // 返回本次接受的帧数
+    template<typename Fn>
+    size_t drain(Fn fn) {
+        size_t accepted = 0;
+        FrameSpan frame;
+        while (next(frame)) {
+            if (fn(frame)) {
+                ++accepted;
+            } else {
+                reject();
+            }
+        }
+        return accepted;
+    }
+
+    void reset() {
+        head_ = tail_ = last_frame_ = pending_length_ = 0;
+        in_garbage_ = false;
+    }
+
+    size_t buffered() const { return tail_ - head_; }
+    size_t capacity() const { return buffer_.size(); }
+    const FrameSpec& spec() const { return spec_; }
+    const FramerStats& stats() const { return stats_; }
+
+private:
+    static const size_t NPOS = static_cast<size_t>(-1);
+
+    FrameSpec spec_;
+    std::vector<uint8_t> buffer_;
+    size_t head_;        // 未消费数据起始
+    size_t tail_;        // 已写入数据末尾
+    size_t last_frame_;  // 最近一次输出帧的起始位置（供 reject 使用）
+    size_t pending_length_;  // head_ 处不完整帧的长度（0 表示未知）
+    bool in_garbage_;    // 当前是否处于一段损坏数据中（用于统计重新同步次数）
+    FramerStats stats_;
+
+    static size_t buffer_capacity(const FrameSpec& spec, size_t capacity) {
+        const size_t minimum = spec.max_length > 0 ? spec.max_length : 1;
+        if (capacity == 0) {
+            capacity = 2 * minimum > 64 * 1024 ? 2 * minimum : 64 * 1024;
+        }
+        return capacity < minimum ? minimum : capacity;
+    }
+
+    size_t header_length() const {
+        return frame_header_length(spec_);
+    }
+
+    uint64_t frame_length_at(const uint8_t* frame) const {
+        return protocol_parser::frame_length_at(spec_, frame);
+    }
+
+    // 定位下一个帧起始（同步字位置），丢弃之前的损坏字节；未找到时返回 NPOS
+    size_t seek_frame_start() {
+        if (spec_.sync_length == 0) {
+            return head_ < tail_ ? head_ : NPOS;
+        }
+
+        const uint8_t* base = buffer_.data();
+        const uint8_t* found = find_sync_pattern(base + head_, tail_ - head_, spec_.sync, spec_.sync_length);
+        if (found == nullptr) {
+            // 保留末尾不足一个同步字的字节：同步字可能跨越两次写入
+            const size_t keep = spec_.sync_length - 1;
+            if (tail_ - head_ > keep) {
+                discard_to(tail_ - keep);
+            }
+            return NPOS;
+        }
+
+        const size_t start = static_cast<size_t>(found - base);
+        if (start > head_) {
+            discard_to(start);
+        }
+        return start;
+    }
+
+    void discard_to(size_t position) {
+        if (position <= head_) {
+            return;
+        }
+        pending_length_ = 0;
+        if (!in_garbage_) {
+            in_garbage_ = true;
+            ++stats_.resyncs;
+        }
+        stats_.bytes_discarded += position - head_;
+        head_ = position;
+    }
+
+    void compact() {
+        const size_t remaining = tail_ - head_;
+        if (remaining > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + head_, remaining);
+        }
+        head_ = 0;
+        tail_ = remaining;
+        last_frame_ = 0;
+    }
+};
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_FRAMER_H
@@ -0,0 +1,529 @@
+#ifndef PROTOCOL_INSTRUMENTATION_H
+#define PROTOCOL_INSTRUMENTATION_H
+
+// ============================================================================
+// 热路径统计（可选）
+// 生成的协议门面与分发器在 -DPROTOCOL_INSTRUMENTATION=1 编译时记录：
+// - 每种报文 × 解码/编码 × 错误码的计数
+// - 每种报文 × 解码/编码的耗时直方图（HDR 风格对数分桶，相对误差 ≤ 1/16）
+// 计数按线程分片：每个线程只写自己的分片（普通读 + 写，无原子读改写、无锁），
+// 快照时汇总全部分片。未定义或定义为 0 时本文件不产生任何代码，生成代码中的统计调用也不编译。
+// 同一程序的全部翻译单元须使用相同的 PROTOCOL_INSTRUMENTATION 取值。
+//
+// 计时：x86 上默认读 TSC（rdtsc，要求 invariant TSC，现代 x86 处理器均满足），
+// 快照时按 steady_clock 换算为纳秒；定义 PROTOCOL_INSTRUMENTATION_STEADY_CLOCK 或在其他平台上
+// 直接使用 steady_clock。
+//
+// 用法：
+//   InstrumentationSnapshot last = Foo_instrumentation().snapshot();
+//   ...（周期性）
+//   InstrumentationSnapshot now = Foo_instrumentation().snapshot();
+//   export(now.since(last).to_json());   // 本周期增量
+//   last = now;
+// ============================================================================
+
+#ifndef PROTOCOL_INSTRUMENTATION
+#define PROTOCOL_INSTRUMENTATION 0
+#endif
+
+#if PROTOCOL_INSTRUMENTATION
+
+#include "protocol_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if !defined(PROTOCOL_INSTRUMENTATION_STEADY_CLOCK) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define PROTOCOL_INSTRUMENTATION_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace protocol_parser {
+
+// 统计的操作类型
+enum InstrumentOp {
+    INSTRUMENT_DECODE = 0,
+    INSTRUMENT_ENCODE = 1,
+    INSTRUMENT_OP_COUNT = 2
+};
+
+// ============================================================================
+// 计时
+// ============================================================================
+
+// 当前时刻（TSC 周期数或 steady_clock 纳秒）
+inline uint64_t instrumentation_ticks() {
+#if defined(PROTOCOL_INSTRUMENTATION_TSC)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+namespace instrumentation_detail {
+
+inline uint64_t steady_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 单线程只写的计数器加一：普通读 + 写（不使用 lock 前缀的读改写），其他线程可无撕裂地读取
+inline void bump(std::atomic<uint64_t>& counter, uint64_t delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+// TSC 周期 → 纳秒换算：以首次使用时刻为起点，按此后经过的 steady_clock 时间计算比值
+// 起点之后不足 10ms 时先等待，避免比值误差过大
+class TickClock {
+public:
+    static TickClock& instance() {
+        static TickClock clock;
+        return clock;
+    }
+
+    double ns_per_tick() const {
+#if defined(PROTOCOL_INSTRUMENTATION_TSC)
+        uint64_t ns = steady_ns();
+        while (ns - start_ns_ < 10000000ULL) {
+            ns = steady_ns();
+        }
+        const uint64_t ticks = instrumentation_ticks();
+        return ticks > start_ticks_
+            ? static_cast<double>(ns - start_ns_) / static_cast<double>(ticks - start_ticks_)
+            : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+
+private:
+    TickClock() : start_ticks_(instrumentation_ticks()), start_ns_(steady_ns()) {}
+
+    uint64_t start_ticks_;
+    uint64_t start_ns_;
+};
+
+} // namespace instrumentation_detail
+
+// ============================================================================
+// 耗时直方图（HDR 风格对数分桶）
+// 小于 16 的值各占一桶；更大的值按最高位所在的 2 的幂区间分为 16 个子桶，
+// 相对误差不超过 1/16。超过 2^40 个周期（约数分钟）的值计入最后一桶。
+// ============================================================================
+class LatencyHistogram {
+public:
+    static const unsigned SUB_BUCKET_BITS = 4;
+    static const unsigned MAX_VALUE_BITS = 40;
+    static const size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+    LatencyHistogram() : count_(0), sum_(0), max_(0) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            buckets_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < (1ULL << SUB_BUCKET_BITS)) {
+            return static_cast<size_t>(value);
+        }
+        if (value >= (1ULL << MAX_VALUE_BITS)) {
+            return BUCKET_COUNT - 1;
+        }
+        const unsigned msb = 63 - count_leading_zeros(value);
+        const unsigned shift = msb - SUB_BUCKET_BITS;
+        return (static_cast<size_t>(shift + 1) << SUB_BUCKET_BITS) +
+               static_cast<size_t>((value >> shift) & ((1ULL << SUB_BUCKET_BITS) - 1));
+    }
+
+    // 桶的取值下界
+    static uint64_t bucket_lower_bound(size_t index) {
+        const size_t group = index >> SUB_BUCKET_BITS;
+        const uint64_t sub = index & ((1u << SUB_BUCKET_BITS) - 1);
+        if (group == 0) {
+            return sub;
+        }
+        return ((1ULL << SUB_BUCKET_BITS) + sub) << (group - 1);
+    }
+
+    // 仅由所属线程调用
+    void record(uint64_t value) {
+        instrumentation_detail::bump(buckets_[bucket_index(value)]);
+        instrumentation_detail::bump(count_);
+        instrumentation_detail::bump(sum_, value);
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t bucket(size_t index) const { return buckets_[index].load(std::memory_order_relaxed); }
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+private:
+    static unsigned count_leading_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned n = 0;
+        while ((value & (1ULL << 63)) == 0) {
+            value <<= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    std::atomic<uint64_t> buckets_[BUCKET_COUNT];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+// ============================================================================
+// 快照
+// ============================================================================
+
+// 直方图快照（汇总各线程，可相减得到区间增量）
+struct LatencySnapshot {
+    std::vector<uint64_t> buckets;  // 为空表示无记录
+    uint64_t count;
+    uint64_t sum_ticks;
+    uint64_t max_ticks;             // 累计最大值（区间增量中保留较新快照的值）
+
+    LatencySnapshot() : count(0), sum_ticks(0), max_ticks(0) {}
+
+    void add(const LatencyHistogram& histogram) {
+        if (buckets.empty()) {
+            buckets.assign(LatencyHistogram::BUCKET_COUNT, 0);
+        }
+        for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+            buckets[i] += histogram.bucket(i);
+        }
+        count += histogram.count();
+        sum_ticks += histogram.sum();
+        if (histogram.max() > max_ticks) {
+            max_ticks = histogram.max();
+        }
+    }
+
+    // 第 p 百分位（0~100）所在桶的下界，单位：周期
+    uint64_t percentile_ticks(double p) const {
+        if (count == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(count) + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return LatencyHistogram::bucket_lower_bound(i);
+            }
+        }
+        return max_ticks;
+    }
+
+    double mean_ticks() const {
+        return count ? static_cast<double>(sum_ticks) / static_cast<double>(count) : 0.0;
+    }
+};
+
+// 单种报文的统计
+struct InstrumentationSlotStats {
+    const char* name;
+    uint64_t counts[INSTRUMENT_OP_COUNT][PARSE_ERROR_COUNT];
+    LatencySnapshot latency[INSTRUMENT_OP_COUNT];
+
+    explicit InstrumentationSlotStats(const char* slot_name) : name(slot_name) {
+        for (size_t op = 0; op < INSTRUMENT_OP_COUNT; ++op) {
+            for (size_t e = 0; e < PARSE_ERROR_COUNT; ++e) {
+                counts[op][e] = 0;
+            }
+        }
+    }
+
+    uint64_t total(InstrumentOp op) const {
+        uint64_t sum = 0;
+        for (size_t e = 0; e < PARSE_ERROR_COUNT; ++e) {
+            sum += counts[op][e];
+        }
+        return sum;
+    }
+
+    uint64_t errors(InstrumentOp op) const { return total(op) - counts[op][SUCCESS]; }
+};
+
+struct InstrumentationSnapshot {
+    const char* name;                             // 协议 / 分发器名称
+    uint64_t timestamp_ns;                        // 快照时刻（steady_clock）
+    uint64_t interval_ns;                         // 统计区间长度（since() 的结果；累计快照为 0）
+    double ns_per_tick;                           // 周期 → 纳秒换算系数
+    std::vector<InstrumentationSlotStats> slots;  // 每种报文一项（分发器最后一项为未知 MessageID）
+
+    InstrumentationSnapshot() : name(""), timestamp_ns(0), interval_ns(0), ns_per_tick(1.0) {}
+
+    // 相对较早快照的增量（周期性导出时使用）
+    InstrumentationSnapshot since(const InstrumentationSnapshot& earlier) const {
+        InstrumentationSnapshot delta = *this;
+        delta.interval_ns = timestamp_ns > earlier.timestamp_ns ? timestamp_ns - earlier.timestamp_ns : 0;
+        for (size_t s = 0; s < delta.slots.size() && s < earlier.slots.size(); ++s) {
+            InstrumentationSlotStats& out = delta.slots[s];
+            const InstrumentationSlotStats& old = earlier.slots[s];
+            for (size_t op = 0; op < INSTRUMENT_OP_COUNT; ++op) {
+                for (size_t e = 0; e < PARSE_ERROR_COUNT; ++e) {
+                    out.counts[op][e] -= old.counts[op][e];
+                }
+                LatencySnapshot& latency = out.latency[op];
+                const LatencySnapshot& previous = old.latency[op];
+                if (!latency.buckets.empty() && !previous.buckets.empty()) {
+                    for (size_t i = 0; i < latency.buckets.size(); ++i) {
+                        latency.buckets[i] -= previous.buckets[i];
+                    }
+                }
+                latency.count -= previous.count;
+                latency.sum_ticks -= previous.sum_ticks;
+            }
+        }
+        return delta;
+    }
+
+    // JSON 导出（省略无记录的报文；耗时单位为纳秒，取桶下界）
+    std::string to_json() const {
+        std::string out;
+        char buf[256];
+        std::snprintf(buf, sizeof(buf), "{\"name\":\"%s\",\"timestamp_ns\":%llu,\"interval_ns\":%llu,\"messages\":[",
+                      name, static_cast<unsigned long long>(timestamp_ns),
+                      static_cast<unsigned long long>(interval_ns));
+        out += buf;
+        bool first_slot = true;
+        for (size_t s = 0; s < slots.size(); ++s) {
+            const InstrumentationSlotStats& slot = slots[s];
+            if (slot.total(INSTRUMENT_DECODE) == 0 && slot.total(INSTRUMENT_ENCODE) == 0) {
+                continue;
+            }
+            out += first_slot ? "{\"type\":\"" : ",{\"type\":\"";
+            out += slot.name;
+            out += "\"";
+            first_slot = false;
+            static const char* const kOpNames[INSTRUMENT_OP_COUNT] = { "decode", "encode" };
+            for (size_t op = 0; op < INSTRUMENT_OP_COUNT; ++op) {
+                const InstrumentOp which = static_cast<InstrumentOp>(op);
+                const LatencySnapshot& latency = slot.latency[op];
+                std::snprintf(buf, sizeof(buf), ",\"%s\":{\"total\":%llu,\"errors\":{", kOpNames[op],
+                              static_cast<unsigned long long>(slot.total(which)));
+                out += buf;
+                bool first_error = true;
+                for (size_t e = 1; e < PARSE_ERROR_COUNT; ++e) {
+                    if (slot.counts[op][e] == 0) {
+                        continue;
+                    }
+                    std::snprintf(buf, sizeof(buf), "%s\"%s\":%llu", first_error ? "" : ",",
+                                  error_code_id(static_cast<ParseError>(e)),
+                                  static_cast<unsigned long long>(slot.counts[op][e]));
+                    out += buf;
+                    first_error = false;
+                }
+                std::snprintf(buf, sizeof(buf),
+                              "},\"latency_ns\":{\"count\":%llu,\"mean\":%.1f,\"p50\":%.0f,\"p90\":%.0f,"
+                              "\"p99\":%.0f,\"p999\":%.0f,\"max\":%.0f}}",
+                              static_cast<unsigned long long>(latency.count),
+                              latency.mean_ticks() * ns_per_tick,
+                              latency.percentile_ticks(50) * ns_per_tick,
+                              latency.percentile_ticks(90) * ns_per_tick,
+                              latency.percentile_ticks(99) * ns_per_tick,
+                              latency.percentile_ticks(99.9) * ns_per_tick,
+                              latency.max_ticks * ns_per_tick);
+                out += buf;
+            }
+            out += "}";
+        }
+        out += "]}";
+        return out;
+    }
+};
+
+// ============================================================================
+// 线程分片与注册表
+// ============================================================================
+
+// 单个线程的统计分片：计数器一次分配，直方图在首次记录对应报文时分配
+class InstrumentationShard {
+public:
+    explicit InstrumentationShard(size_t slot_count)
+        : slot_count_(slot_count),
+          counters_(new std::atomic<uint64_t>[slot_count * INSTRUMENT_OP_COUNT * PARSE_ERROR_COUNT]),
+          histograms_(new std::atomic<LatencyHistogram*>[slot_count * INSTRUMENT_OP_COUNT]),
+          in_use_(true),
+          next_(nullptr) {
+        for (size_t i = 0; i < slot_count * INSTRUMENT_OP_COUNT * PARSE_ERROR_COUNT; ++i) {
+            counters_[i].store(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < slot_count * INSTRUMENT_OP_COUNT; ++i) {
+            histograms_[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~InstrumentationShard() {
+        for (size_t i = 0; i < slot_count_ * INSTRUMENT_OP_COUNT; ++i) {
+            delete histograms_[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // 记录一次操作：start_ticks 为 instrumentation_ticks() 的起始读数；仅由持有本分片的线程调用
+    void record(size_t slot, InstrumentOp op, ParseError error, uint64_t start_ticks) {
+        const uint64_t elapsed = instrumentation_ticks() - start_ticks;
+        size_t code = static_cast<size_t>(error);
+        if (code >= PARSE_ERROR_COUNT) {
+            code = UNKNOWN_ERROR;
+        }
+        const size_t index = slot * INSTRUMENT_OP_COUNT + op;
+        instrumentation_detail::bump(counters_[index * PARSE_ERROR_COUNT + code]);
+
+        LatencyHistogram* histogram = histograms_[index].load(std::memory_order_relaxed);
+        if (histogram == nullptr) {
+            histogram = new LatencyHistogram();
+            histograms_[index].store(histogram, std::memory_order_release);
+        }
+        histogram->record(elapsed);
+    }
+
+    void accumulate(std::vector<InstrumentationSlotStats>& slots) const {
+        for (size_t slot = 0; slot < slot_count_; ++slot) {
+            for (size_t op = 0; op < INSTRUMENT_OP_COUNT; ++op) {
+                const size_t index = slot * INSTRUMENT_OP_COUNT + op;
+                for (size_t e = 0; e < PARSE_ERROR_COUNT; ++e) {
+                    slots[slot].counts[op][e] += counters_[index * PARSE_ERROR_COUNT + e].load(std::memory_order_relaxed);
+                }
+                const LatencyHistogram* histogram = histograms_[index].load(std::memory_order_acquire);
+                if (histogram != nullptr) {
+                    slots[slot].latency[op].add(*histogram);
+                }
+            }
+        }
+    }
+
+private:
+    friend class InstrumentationRegistry;
+
+    size_t slot_count_;
+    std::unique_ptr<std::atomic<uint64_t>[]> counters_;
+    std::unique_ptr<std::atomic<LatencyHistogram*>[]> histograms_;
+    std::atomic<bool> in_use_;                 // 线程退出后置 false，供新线程复用（计数累计保留）
+    InstrumentationShard* next_;               // 注册表链表（只在头部插入，发布后不再修改）
+};
+
+// 一个协议门面或分发器的统计注册表：持有全部线程分片，提供快照
+// 通常为生成代码中的函数内静态对象（<名称>_instrumentation()）
+class InstrumentationRegistry {
+public:
+    // slot_names 须为静态存储（生成代码中的字符串字面量数组）
+    InstrumentationRegistry(const char* name, const char* const* slot_names, size_t slot_count)
+        : name_(name), slot_names_(slot_names), slot_count_(slot_count), shards_(nullptr) {
+        instrumentation_detail::TickClock::instance();
+    }
+
+    ~InstrumentationRegistry() {
+        InstrumentationShard* shard = shards_.load(std::memory_order_acquire);
+        while (shard != nullptr) {
+            InstrumentationShard* next = shard->next_;
+            delete shard;
+            shard = next;
+        }
+    }
+
+    const char* name() const { return name_; }
+    size_t slot_count() const { return slot_count_; }
+    const char* slot_name(size_t slot) const { return slot_names_[slot]; }
+
+    // 为当前线程取得分片：优先复用已退出线程释放的分片，否则新建并无锁插入链表头部
+    InstrumentationShard* acquire_shard() {
+        for (InstrumentationShard* shard = shards_.load(std::memory_order_acquire); shard != nullptr;
+             shard = shard->next_) {
+            bool expected = false;
+            if (!shard->in_use_.load(std::memory_order_relaxed) &&
+                shard->in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return shard;
+            }
+        }
+        InstrumentationShard* shard = new InstrumentationShard(slot_count_);
+        InstrumentationShard* head = shards_.load(std::memory_order_relaxed);
+        do {
+            shard->next_ = head;
+        } while (!shards_.compare_exchange_weak(head, shard, std::memory_order_release, std::memory_order_relaxed));
+        return shard;
+    }
+
+    static void release_shard(InstrumentationShard* shard) {
+        shard->in_use_.store(false, std::memory_order_release);
+    }
+
+    // 汇总全部线程的累计统计（可与热路径并发调用；各计数器分别读取，不保证彼此间的瞬时一致）
+    InstrumentationSnapshot snapshot() const {
+        InstrumentationSnapshot result;
+        result.name = name_;
+        result.ns_per_tick = instrumentation_detail::TickClock::instance().ns_per_tick();
+        result.timestamp_ns = instrumentation_detail::steady_ns();
+        result.slots.reserve(slot_count_);
+        for (size_t slot = 0; slot < slot_count_; ++slot) {
+            result.slots.push_back(InstrumentationSlotStats(slot_names_[slot]));
+        }
+        for (const InstrumentationShard* shard = shards_.load(std::memory_order_acquire); shard != nullptr;
+             shard = shard->next_) {
+            shard->accumulate(result.slots);
+        }
+        return result;
+    }
+
+private:
+    InstrumentationRegistry(const InstrumentationRegistry&);
+    InstrumentationRegistry& operator=(const InstrumentationRegistry&);
+
+    const char* name_;
+    const char* const* slot_names_;
+    size_t slot_count_;
+    std::atomic<InstrumentationShard*> shards_;
+};
+
+// 线程本地的分片句柄：首次使用时向注册表申请分片，线程退出时归还
+// 生成代码中每个注册表对应一个函数内 thread_local 实例
+class InstrumentationShardHandle {
+public:
+    InstrumentationShardHandle() : shard_(nullptr) {}
+
+    ~InstrumentationShardHandle() {
+        if (shard_ != nullptr) {
+            InstrumentationRegistry::release_shard(shard_);
+        }
+    }
+
+    InstrumentationShard& get(InstrumentationRegistry& registry) {
+        if (shard_ == nullptr) {
+            shard_ = registry.acquire_shard();
+        }
+        return *shard_;
+    }
+
+private:
+    InstrumentationShard* shard_;
+};
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_INSTRUMENTATION
+
+#endif // PROTOCOL_INSTRUMENTATION_H
@@ -0,0 +1,315 @@
+#ifndef PROTOCOL_MERGE_H
+#define PROTOCOL_MERGE_H
+
+#include "protocol_timestamp.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace protocol_parser {
+
+// ============================================================================
+// 多路输入按时间归并
+//
+// 同一协议从多条链路接收时，把各路已解码的报文按纳秒时间戳合并为一条有序序列：
+// - 每路一个有界重排窗口（预分配的环形缓冲区，容量 window 条，按时间有序），吸收链路内的局部乱序：
+//   新报文从尾部向前插入（链路基本有序，通常不需移动），从头部输出
+// - 每路维护低水位 = 该路已见最大时间戳 - max_delay，承诺此后不会再有更早的报文；
+//   全部未关闭输入的低水位最小值为安全时间，各路最早报文中不晚于安全时间的报文按时间顺序输出
+// - 各路最早报文与低水位分别由锦标赛树（胜者树）维护，任一路变化只需沿叶到根 O(log K) 重算
+// - 某路窗口满时强制输出全局最早的报文直到该路有空位（计入 forced）；
+//   早于已输出时间的报文立即输出并标记 late（计入 late），不丢弃
+// - time_of_day 输入的时间戳为当天纳秒数（day_millis / day_0_1_millis 换算结果），
+//   由每路的 protocol_timestamp::TimeOfDayPromoter 按跨零点规则提升为绝对时间
+// 构造后不再分配内存（T 本身的拷贝除外，建议使用定长的 _Raw / 结果结构或索引）
+//
+// 用法：
+//   MergeInputConfig config;
+//   config.window = 1024;
+//   config.max_delay = 2000000;                       // 各链路允许 2 ms 乱序
+//   StreamMerger<XxxResult> merger(link_count, config);
+//   auto sink = [](const MergedItem<XxxResult>& item) { ... };   // item.timestamp / item.input / item.item
+//   merger.push(link, result.timestamp, result, sink);            // 每条链路解码后调用
+//   merger.heartbeat(link, now_ns, sink);                          // 链路空闲时推进其时间（可选）
+//   merger.close(link, sink);                                      // 链路结束
+//   merger.flush(sink);                                            // 全部结束，输出剩余报文
+// ============================================================================
+
+struct MergeInputConfig {
+    size_t window;           // 重排窗口（条数），满时强制输出
+    uint64_t max_delay;      // 允许的乱序时间（纳秒），决定该路的低水位
+    bool time_of_day;        // 时间戳为当天纳秒数，按跨零点规则提升为绝对时间
+    uint64_t day_start;      // time_of_day 时起始日零点的绝对时间（纳秒）
+
+    MergeInputConfig() : window(1024), max_delay(1000000), time_of_day(false), day_start(0) {}
+};
+
+struct MergeStats {
+    uint64_t pushed;
+    uint64_t emitted;        // 含 late
+    uint64_t late;           // 到达时已早于输出进度的报文（立即输出，顺序无法保证）
+    uint64_t forced;         // 因窗口满而提前输出的报文
+    uint64_t rollovers;      // time_of_day 输入检测到的跨零点次数（各路合计）
+    size_t max_buffered;     // 同时缓存的最大报文数
+
+    MergeStats() : pushed(0), emitted(0), late(0), forced(0), rollovers(0), max_buffered(0) {}
+};
+
+// 输出给 sink 的一条报文；item 只在回调期间有效
+template<typename T>
+struct MergedItem {
+    uint64_t timestamp;      // 绝对时间（纳秒）
+    size_t input;
+    const T& item;
+    bool late;
+
+    MergedItem(uint64_t merged_timestamp, size_t input_index, const T& value, bool is_late)
+        : timestamp(merged_timestamp), input(input_index), item(value), late(is_late) {}
+};
+
+namespace merge_detail {
+
+const uint64_t NO_KEY = ~static_cast<uint64_t>(0);
+
+// 胜者树：叶子 i 的键为 keys[i]，内部结点保存子树中键最小（相同时编号最小）的叶子
+// 采用 2K 结点的隐式布局（叶子在 [K, 2K)），K 不必是 2 的幂
+class TournamentTree {
+public:
+    TournamentTree() : count_(0) {}
+
+    void reset(size_t count, const uint64_t* keys) {
+        count_ = count;
+        keys_ = keys;
+        nodes_.assign(count * 2, 0);
+        for (size_t i = 0; i < count; ++i) {
+            nodes_[count + i] = static_cast<uint32_t>(i);
+        }
+        for (size_t node = count > 1 ? count - 1 : 0; node >= 1; --node) {
+            nodes_[node] = better(nodes_[2 * node], nodes_[2 * node + 1]);
+        }
+    }
+
+    // 叶子 i 的键变化后调用
+    void update(size_t leaf) {
+        for (size_t node = (count_ + leaf) >> 1; node >= 1; node >>= 1) {
+            nodes_[node] = better(nodes_[2 * node], nodes_[2 * node + 1]);
+        }
+    }
+
+    size_t winner() const { return count_ == 1 ? 0 : nodes_[1]; }
+
+private:
+    size_t count_;
+    const uint64_t* keys_;
+    std::vector<uint32_t> nodes_;
+
+    uint32_t better(uint32_t a, uint32_t b) const {
+        return (keys_[b] < keys_[a] || (keys_[b] == keys_[a] && b < a)) ? b : a;
+    }
+};
+
+} // namespace merge_detail
+
+template<typename T>
+class StreamMerger {
+public:
+    typedef MergedItem<T> Item;
+
+    StreamMerger(size_t input_count, const MergeInputConfig& config)
+        : configs_(input_count, config) { init(); }
+
+    explicit StreamMerger(const std::vector<MergeInputConfig>& configs)
+        : configs_(configs) { init(); }
+
+    // 加入一条报文（timestamp 为绝对纳秒；time_of_day 输入为当天纳秒数），并输出已可确定顺序的报文
+    template<typename Sink>
+    void push(size_t input, uint64_t timestamp, const T& item, Sink& sink) {
+        Input& in = inputs_[input];
+        if (configs_[input].time_of_day) {
+            timestamp = in.promoter.promote(timestamp);
+        }
+        ++stats_.pushed;
+        // 窗口满：按全局顺序强制输出，直到本路有空位
+        while (in.count >= configs_[input].window) {
+            ++stats_.forced;
+            emit(head_tree_.winner(), sink);
+        }
+        if (emitted_any_ && timestamp < last_emitted_) {
+            ++stats_.late;
+            ++stats_.emitted;
+            sink(static_cast<const Item&>(Item(timestamp, input, item, true)));
+            observe(input, timestamp);
+            drain(sink);
+            return;
+        }
+        // 从尾部向前找插入位置（时间戳相同时保持到达顺序）
+        size_t position = in.head + in.count;
+        while (position != in.head && in.ring[(position - 1) & in.mask].timestamp > timestamp) {
+            in.ring[position & in.mask] = in.ring[(position - 1) & in.mask];
+            --position;
+        }
+        Entry& entry = in.ring[position & in.mask];
+        entry.timestamp = timestamp;
+        entry.item = item;
+        ++in.count;
+        ++buffered_;
+        if (buffered_ > stats_.max_buffered) {
+            stats_.max_buffered = buffered_;
+        }
+        if (position == in.head) {
+            head_keys_[input] = timestamp;   // 新的最早报文
+            head_tree_.update(input);
+        }
+        observe(input, timestamp);
+        drain(sink);
+    }
+
+    // 链路空闲时推进该路时间（无报文），使其他路的报文得以输出；time_of_day 输入同样传当天纳秒数
+    template<typename Sink>
+    void heartbeat(size_t input, uint64_t timestamp, Sink& sink) {
+        if (configs_[input].time_of_day) {
+            timestamp = inputs_[input].promoter.promote(timestamp);
+        }
+        observe(input, timestamp);
+        drain(sink);
+    }
+
+    // 该路不再有报文：不再等待它（已缓存的报文照常按顺序输出）；之后再 push 会重新打开
+    template<typename Sink>
+    void close(size_t input, Sink& sink) {
+        inputs_[input].closed = true;
+        bound_keys_[input] = merge_detail::NO_KEY;
+        bound_tree_.update(input);
+        drain(sink);
+    }
+
+    // 关闭全部输入并输出所有缓存的报文
+    template<typename Sink>
+    void flush(Sink& sink) {
+        for (size_t i = 0; i < inputs_.size(); ++i) {
+            inputs_[i].closed = true;
+            bound_keys_[i] = merge_detail::NO_KEY;
+        }
+        bound_tree_.reset(inputs_.size(), bound_keys_.data());
+        drain(sink);
+    }
+
+    size_t input_count() const { return inputs_.size(); }
+    size_t buffered() const { return buffered_; }
+
+    // 当前安全时间：不晚于它的报文都已输出（全部输入关闭时为 UINT64_MAX）
+    uint64_t watermark() const { return bound_keys_[bound_tree_.winner()]; }
+
+    MergeStats stats() const {
+        MergeStats stats = stats_;
+        for (size_t i = 0; i < inputs_.size(); ++i) {
+            stats.rollovers += inputs_[i].promoter.rollovers();
+        }
+        return stats;
+    }
+
+private:
+    struct Entry {
+        uint64_t timestamp;
+        T item;
+    };
+
+    struct Input {
+        std::vector<Entry> ring;   // 容量为 2 的幂，[head, head + count) 按时间有序
+        size_t mask;
+        size_t head;
+        size_t count;
+        uint64_t max_seen;
+        bool seen;
+        bool closed;
+        protocol_timestamp::TimeOfDayPromoter promoter;
+
+        Input() : mask(0), head(0), count(0), max_seen(0), seen(false), closed(false) {}
+    };
+
+    std::vector<MergeInputConfig> configs_;
+    std::vector<Input> inputs_;
+    std::vector<uint64_t> head_keys_;    // 各路最早报文的时间戳（空为 NO_KEY）
+    std::vector<uint64_t> bound_keys_;   // 各路低水位（未收到报文为 0，关闭为 NO_KEY）
+    merge_detail::TournamentTree head_tree_;
+    merge_detail::TournamentTree bound_tree_;
+    size_t buffered_;
+    uint64_t last_emitted_;
+    bool emitted_any_;
+    MergeStats stats_;
+
+    void init() {
+        if (configs_.empty()) {
+            configs_.resize(1);
+        }
+        inputs_.resize(configs_.size());
+        for (size_t i = 0; i < configs_.size(); ++i) {
+            if (configs_[i].window == 0) {
+                configs_[i].window = 1;
+            }
+            size_t capacity = 1;
+            while (capacity < configs_[i].window) {
+                capacity <<= 1;
+            }
+            inputs_[i].ring.resize(capacity);
+            inputs_[i].mask = capacity - 1;
+            inputs_[i].promoter.reset(configs_[i].day_start);
+        }
+        head_keys_.assign(configs_.size(), merge_detail::NO_KEY);
+        bound_keys_.assign(configs_.size(), 0);
+        head_tree_.reset(configs_.size(), head_keys_.data());
+        bound_tree_.reset(configs_.size(), bound_keys_.data());
+        buffered_ = 0;
+        last_emitted_ = 0;
+        emitted_any_ = false;
+    }
+
+    // 更新该路的最大时间戳与低水位
+    void observe(size_t input, uint64_t timestamp) {
+        Input& in = inputs_[input];
+        if (in.seen && timestamp <= in.max_seen && !in.closed) {
+            return;
+        }
+        if (!in.seen || timestamp > in.max_seen) {
+            in.max_seen = timestamp;
+        }
+        in.seen = true;
+        in.closed = false;
+        const uint64_t delay = configs_[input].max_delay;
+        bound_keys_[input] = in.max_seen > delay ? in.max_seen - delay : 0;
+        bound_tree_.update(input);
+    }
+
+    template<typename Sink>
+    void drain(Sink& sink) {
+        const uint64_t safe = bound_keys_[bound_tree_.winner()];
+        for (;;) {
+            const size_t input = head_tree_.winner();
+            const uint64_t timestamp = head_keys_[input];
+            if (timestamp == merge_detail::NO_KEY || timestamp > safe) {
+                return;
+            }
+            emit(input, sink);
+        }
+    }
+
+    template<typename Sink>
+    void emit(size_t input, Sink& sink) {
+        Input& in = inputs_[input];
+        const Entry& entry = in.ring[in.head & in.mask];
+        last_emitted_ = entry.timestamp;
+        emitted_any_ = true;
+        ++stats_.emitted;
+        sink(static_cast<const Item&>(Item(entry.timestamp, input, entry.item, false)));
+        ++in.head;
+        --in.count;
+        --buffered_;
+        head_keys_[input] = in.count == 0 ? merge_detail::NO_KEY : in.ring[in.head & in.mask].timestamp;
+        head_tree_.update(input);
+    }
+};
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_MERGE_H
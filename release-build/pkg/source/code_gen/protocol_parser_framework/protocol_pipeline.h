@@ -0,0 +1,639 @@
+#ifndef PROTOCOL_PIPELINE_H
+#define PROTOCOL_PIPELINE_H
+
+#include "protocol_common.h"
+#include "protocol_framer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROTOCOL_PIPELINE_PAUSE() _mm_pause()
+#else
+#define PROTOCOL_PIPELINE_PAUSE() ((void)0)
+#endif
+
+// 编译需要线程库：g++ -std=c++11 -pthread
+
+namespace protocol_parser {
+
+namespace pipeline_detail {
+
+// 缓存行大小（生产者 / 消费者各自修改的计数器分开放置，避免伪共享）
+const size_t CACHE_LINE = 64;
+
+inline size_t round_up_pow2(size_t n) {
+    size_t value = 1;
+    while (value < n) {
+        value <<= 1;
+    }
+    return value;
+}
+
+// 等待策略：先自旋（pause），再让出时间片；核数少于线程数时也不会长期空转
+class Backoff {
+public:
+    Backoff() : count_(0) {}
+
+    void wait() {
+        if (count_ < 64) {
+            PROTOCOL_PIPELINE_PAUSE();
+        } else {
+            std::this_thread::yield();
+        }
+        ++count_;
+    }
+
+    void reset() { count_ = 0; }
+
+private:
+    unsigned count_;
+};
+
+} // namespace pipeline_detail
+
+// ============================================================================
+// 有界无锁队列
+// SpscRing：单生产者单消费者，生产者 / 消费者各自缓存对方的位置，只在看似满 / 空时读取对方的原子变量
+// MpmcRing：多生产者多消费者（每个槽位带序号，CAS 抢占位置）
+// 容量向上取整为 2 的幂；T 须可默认构造和拷贝赋值
+// ============================================================================
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : mask_(pipeline_detail::round_up_pow2(capacity < 2 ? 2 : capacity) - 1)
+        , buffer_(mask_ + 1)
+        , tail_(0)
+        , cached_head_(0)
+        , head_(0)
+        , cached_tail_(0)
+    {}
+
+    // 生产者线程调用；队列满时返回 false
+    bool try_push(const T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用；队列空时返回 false
+    bool try_pop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        value = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 近似值，仅用于退出判断和统计
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    const size_t mask_;
+    std::vector<T> buffer_;
+
+    // 生产者侧
+    char pad0_[pipeline_detail::CACHE_LINE];
+    std::atomic<size_t> tail_;
+    size_t cached_head_;
+
+    // 消费者侧
+    char pad1_[pipeline_detail::CACHE_LINE];
+    std::atomic<size_t> head_;
+    size_t cached_tail_;
+    char pad2_[pipeline_detail::CACHE_LINE];
+
+    SpscRing(const SpscRing&);
+    SpscRing& operator=(const SpscRing&);
+};
+
+template<typename T>
+class MpmcRing {
+public:
+    explicit MpmcRing(size_t capacity)
+        : mask_(pipeline_detail::round_up_pow2(capacity < 2 ? 2 : capacity) - 1)
+        , cells_(new Cell[mask_ + 1])
+        , enqueue_pos_(0)
+        , dequeue_pos_(0)
+    {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(const T& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // 队列满
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // 队列空
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->value;
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return dequeue_pos_.load(std::memory_order_acquire) == enqueue_pos_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    char pad0_[pipeline_detail::CACHE_LINE];
+    std::atomic<size_t> enqueue_pos_;
+    char pad1_[pipeline_detail::CACHE_LINE];
+    std::atomic<size_t> dequeue_pos_;
+    char pad2_[pipeline_detail::CACHE_LINE];
+
+    MpmcRing(const MpmcRing&);
+    MpmcRing& operator=(const MpmcRing&);
+};
+
+// ============================================================================
+// CPU 绑定：把当前线程绑定到指定逻辑 CPU（cpu < 0 表示不绑定）
+// 仅 Linux 实现，其他平台返回 false
+// ============================================================================
+inline bool pin_current_thread(int cpu) {
+    if (cpu < 0) {
+        return false;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// ============================================================================
+// 字节源：流水线的输入（TCP 接收线程、抓包回放、文件或内存）
+// read() 返回读到的字节数，0 表示数据结束
+// ============================================================================
+class ByteSource {
+public:
+    virtual ~ByteSource() {}
+    virtual size_t read(uint8_t* buffer, size_t capacity) = 0;
+};
+
+// 内存字节源：按 chunk 大小分块返回（模拟网络分段），用于测试和基准
+class MemorySource : public ByteSource {
+public:
+    MemorySource(const uint8_t* data, size_t length, size_t chunk = 64 * 1024)
+        : data_(data), length_(length), position_(0), chunk_(chunk > 0 ? chunk : 1) {}
+
+    size_t read(uint8_t* buffer, size_t capacity) {
+        size_t n = length_ - position_;
+        if (n > capacity) n = capacity;
+        if (n > chunk_) n = chunk_;
+        std::memcpy(buffer, data_ + position_, n);
+        position_ += n;
+        return n;
+    }
+
+    void rewind() { position_ = 0; }
+
+private:
+    const uint8_t* data_;
+    size_t length_;
+    size_t position_;
+    size_t chunk_;
+};
+
+// 文件字节源：顺序读取文件（二进制流录制文件）
+class FileSource : public ByteSource {
+public:
+    explicit FileSource(const char* path) : file_(std::fopen(path, "rb")) {}
+    ~FileSource() {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    bool is_open() const { return file_ != nullptr; }
+
+    size_t read(uint8_t* buffer, size_t capacity) {
+        return file_ != nullptr ? std::fread(buffer, 1, capacity, file_) : 0;
+    }
+
+private:
+    std::FILE* file_;
+
+    FileSource(const FileSource&);
+    FileSource& operator=(const FileSource&);
+};
+
+// ============================================================================
+// 流水线配置与统计
+// ============================================================================
+enum WorkQueueMode {
+    WORK_QUEUE_SPSC = 0,  // 每个解码线程一个 SPSC 队列，接收线程轮询分配（默认）
+    WORK_QUEUE_MPMC = 1   // 所有解码线程共享一个 MPMC 队列（各帧解码耗时差异大时负载更均衡）
+};
+
+enum BackpressurePolicy {
+    BACKPRESSURE_BLOCK = 0,  // 在途帧达到上限时接收线程等待（不丢帧，默认）
+    BACKPRESSURE_DROP = 1    // 在途帧达到上限时丢弃新帧并计数（接收线程不阻塞）
+};
+
+struct PipelineConfig {
+    size_t workers;                  // 解码线程数
+    size_t slots;                    // 在途帧上限（帧缓冲池大小），决定内存占用和乱序窗口
+    size_t read_chunk;               // 接收线程每次从字节源读取的最大字节数
+    WorkQueueMode work_queue;
+    BackpressurePolicy backpressure;
+    bool ordered;                    // 是否按每个字节源（流）的到达顺序输出
+    int ingest_cpu;                  // 接收线程绑定的 CPU（-1 不绑定）
+    int output_cpu;                  // 输出线程（调用 run() 的线程）绑定的 CPU
+    std::vector<int> worker_cpus;    // 第 i 个解码线程绑定的 CPU（不足时不绑定）
+
+    PipelineConfig()
+        : workers(1)
+        , slots(1024)
+        , read_chunk(64 * 1024)
+        , work_queue(WORK_QUEUE_SPSC)
+        , backpressure(BACKPRESSURE_BLOCK)
+        , ordered(true)
+        , ingest_cpu(-1)
+        , output_cpu(-1)
+    {}
+};
+
+struct PipelineStats {
+    uint64_t frames;    // 分帧得到的帧数
+    uint64_t decoded;   // 解码成功
+    uint64_t failed;    // 解码失败
+    uint64_t dropped;   // 背压丢弃（BACKPRESSURE_DROP）
+    FramerStats framer; // 各字节源分帧统计之和
+};
+
+// 输出给回调的单帧结果；引用在回调返回后失效（槽位被回收复用）
+template<typename Result>
+struct PipelineItem {
+    uint32_t stream;            // 字节源编号
+    uint64_t sequence;          // 该流内的到达序号（从 0 开始，不含丢弃的帧）
+    DeserializeStatus status;   // 解码结果
+    Result result;              // 解码输出
+    std::vector<uint8_t> frame; // 帧原始字节（容量跨帧复用）
+};
+
+// ============================================================================
+// 多核解码流水线
+//
+//   字节源 ─→ 接收/分帧线程 ─→ 工作队列 ─→ N 个解码线程 ─→ 完成队列 ─→ 输出线程（调用方）─→ sink
+//                  ↑                                                            │
+//                  └───────────────────── 空闲槽位队列 ←────────────────────────┘
+//
+// - 每帧占用一个预分配槽位（帧字节 + Result），队列中只传递槽位编号；槽位跨帧复用，稳定后不分配内存
+// - 工作队列为每线程 SPSC 或共享 MPMC，完成队列为每线程 SPSC，空闲槽位队列为 SPSC
+// - ordered 时输出线程按流维护重排窗口（窗口 ≥ 槽位数，在途帧不会越界），保证每个流按到达顺序回调
+// - 解码在其他线程异步进行，解码失败无法再让分帧器回退重新同步（StreamFramer::reject），
+//   分帧器仍按同步字 / 长度字段重新同步
+//
+// 用法：
+//   DecodePipeline<XxxDispatcherResult> pipeline(Xxx_frame_spec(), config);
+//   pipeline.run(sources, source_count,
+//       [](const uint8_t* data, size_t length, XxxDispatcherResult& result) {
+//           return deserialize_XxxDispatcher(data, length, result);
+//       },
+//       [](const PipelineItem<XxxDispatcherResult>& item) { ... });
+// ============================================================================
+template<typename Result>
+class DecodePipeline {
+public:
+    typedef PipelineItem<Result> Item;
+
+    DecodePipeline(const FrameSpec& spec, const PipelineConfig& config)
+        : spec_(spec)
+        , config_(config)
+        , slot_count_(pipeline_detail::round_up_pow2(config.slots < 2 ? 2 : config.slots))
+    {
+        if (config_.workers == 0) {
+            config_.workers = 1;
+        }
+    }
+
+    // 运行到全部字节源结束且所有帧都已回调；decode 在解码线程中调用（每线程一份拷贝），
+    // sink 在调用 run() 的线程中调用
+    // decode: DeserializeStatus (const uint8_t* data, size_t length, Result& result)
+    // sink:   void (const PipelineItem<Result>& item)
+    template<typename Decoder, typename Sink>
+    PipelineStats run(ByteSource* const* sources, size_t source_count, Decoder decode, Sink sink) {
+        Shared shared(*this);
+
+        std::vector<std::thread> threads;
+        threads.reserve(config_.workers + 1);
+        for (size_t w = 0; w < config_.workers; ++w) {
+            threads.push_back(std::thread(&DecodePipeline::template worker_loop<Decoder>,
+                                          this, std::ref(shared), w, decode));
+        }
+        threads.push_back(std::thread(&DecodePipeline::ingest_loop,
+                                      this, std::ref(shared), sources, source_count));
+
+        pin_current_thread(config_.output_cpu);
+        output_loop(shared, sink);
+
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+        return shared.stats;
+    }
+
+    const PipelineConfig& config() const { return config_; }
+
+private:
+    static const uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    // 一次 run() 的全部共享状态
+    struct Shared {
+        std::vector<Item> slots;
+        SpscRing<uint32_t> free_slots;  // 输出线程 → 接收线程
+        std::vector<std::unique_ptr<SpscRing<uint32_t> > > work_spsc;  // 接收线程 → 解码线程 i
+        MpmcRing<uint32_t> work_mpmc;
+        std::vector<std::unique_ptr<SpscRing<uint32_t> > > done;        // 解码线程 i → 输出线程
+        std::atomic<bool> ingest_done;
+        std::atomic<size_t> workers_done;
+        PipelineStats stats;
+
+        explicit Shared(const DecodePipeline& owner)
+            : slots(owner.slot_count_)
+            , free_slots(owner.slot_count_)
+            , work_mpmc(owner.config_.work_queue == WORK_QUEUE_MPMC ? owner.slot_count_ : 2)
+            , ingest_done(false)
+            , workers_done(0)
+        {
+            std::memset(&stats, 0, sizeof(stats));
+            for (size_t i = 0; i < owner.slot_count_; ++i) {
+                free_slots.try_push(static_cast<uint32_t>(i));
+            }
+            for (size_t w = 0; w < owner.config_.workers; ++w) {
+                if (owner.config_.work_queue == WORK_QUEUE_SPSC) {
+                    work_spsc.push_back(std::unique_ptr<SpscRing<uint32_t> >(
+                        new SpscRing<uint32_t>(owner.slot_count_)));
+                }
+                done.push_back(std::unique_ptr<SpscRing<uint32_t> >(new SpscRing<uint32_t>(owner.slot_count_)));
+            }
+        }
+    };
+
+    FrameSpec spec_;
+    PipelineConfig config_;
+    size_t slot_count_;
+
+    // 接收/分帧线程：轮流从各字节源读取，分帧后复制到空闲槽位并投递到工作队列
+    void ingest_loop(Shared& shared, ByteSource* const* sources, size_t source_count) {
+        pin_current_thread(config_.ingest_cpu);
+
+        std::vector<std::unique_ptr<StreamFramer> > framers;
+        std::vector<uint64_t> sequences(source_count, 0);
+        std::vector<bool> finished(source_count, false);
+        for (size_t s = 0; s < source_count; ++s) {
+            framers.push_back(std::unique_ptr<StreamFramer>(new StreamFramer(spec_)));
+        }
+
+        size_t next_worker = 0;
+        size_t active = source_count;
+        while (active > 0) {
+            for (size_t s = 0; s < source_count; ++s) {
+                if (finished[s]) {
+                    continue;
+                }
+                StreamFramer& framer = *framers[s];
+                size_t available = 0;
+                uint8_t* area = framer.write_area(available);
+                const size_t n = sources[s]->read(area, available < config_.read_chunk ? available : config_.read_chunk);
+                if (n == 0) {
+                    finished[s] = true;
+                    --active;
+                    continue;
+                }
+                framer.commit(n);
+
+                FrameSpan frame;
+                while (framer.next(frame)) {
+                    ++shared.stats.frames;
+                    uint32_t slot;
+                    if (!acquire_slot(shared, slot)) {
+                        ++shared.stats.dropped;
+                        continue;
+                    }
+                    Item& item = shared.slots[slot];
+                    item.stream = static_cast<uint32_t>(s);
+                    item.sequence = sequences[s]++;
+                    item.frame.assign(frame.data, frame.data + frame.length);
+                    dispatch(shared, slot, next_worker);
+                }
+            }
+        }
+
+        for (size_t s = 0; s < source_count; ++s) {
+            const FramerStats& fs = framers[s]->stats();
+            shared.stats.framer.frames += fs.frames;
+            shared.stats.framer.bytes_in += fs.bytes_in;
+            shared.stats.framer.bytes_discarded += fs.bytes_discarded;
+            shared.stats.framer.resyncs += fs.resyncs;
+            shared.stats.framer.rejected += fs.rejected;
+        }
+        shared.ingest_done.store(true, std::memory_order_release);
+    }
+
+    bool acquire_slot(Shared& shared, uint32_t& slot) {
+        if (shared.free_slots.try_pop(slot)) {
+            return true;
+        }
+        if (config_.backpressure == BACKPRESSURE_DROP) {
+            return false;
+        }
+        pipeline_detail::Backoff backoff;
+        while (!shared.free_slots.try_pop(slot)) {
+            backoff.wait();
+        }
+        return true;
+    }
+
+    // 工作队列容量等于槽位数，在途帧不超过槽位数，投递不会失败
+    void dispatch(Shared& shared, uint32_t slot, size_t& next_worker) {
+        if (config_.work_queue == WORK_QUEUE_MPMC) {
+            shared.work_mpmc.try_push(slot);
+            return;
+        }
+        shared.work_spsc[next_worker]->try_push(slot);
+        next_worker = next_worker + 1 == config_.workers ? 0 : next_worker + 1;
+    }
+
+    template<typename Decoder>
+    void worker_loop(Shared& shared, size_t index, Decoder decode) {
+        if (index < config_.worker_cpus.size()) {
+            pin_current_thread(config_.worker_cpus[index]);
+        }
+
+        SpscRing<uint32_t>& done = *shared.done[index];
+        pipeline_detail::Backoff backoff;
+        for (;;) {
+            uint32_t slot;
+            const bool got = config_.work_queue == WORK_QUEUE_MPMC
+                ? shared.work_mpmc.try_pop(slot)
+                : shared.work_spsc[index]->try_pop(slot);
+            if (got) {
+                Item& item = shared.slots[slot];
+                item.status = decode(item.frame.data(), item.frame.size(), item.result);
+                done.try_push(slot);
+                backoff.reset();
+                continue;
+            }
+            // 接收线程结束后再确认一次队列为空，避免遗漏结束前投递的帧
+            if (shared.ingest_done.load(std::memory_order_acquire)) {
+                const bool empty = config_.work_queue == WORK_QUEUE_MPMC
+                    ? shared.work_mpmc.empty()
+                    : shared.work_spsc[index]->empty();
+                if (empty) {
+                    break;
+                }
+            }
+            backoff.wait();
+        }
+        shared.workers_done.fetch_add(1, std::memory_order_release);
+    }
+
+    template<typename Sink>
+    void output_loop(Shared& shared, Sink& sink) {
+        // 每个流一个重排窗口（按序号取模存放槽位编号），next_sequence 为下一个应输出的序号
+        std::vector<std::vector<uint32_t> > windows;
+        std::vector<uint64_t> next_sequence;
+        const uint64_t window_mask = slot_count_ - 1;
+
+        pipeline_detail::Backoff backoff;
+        size_t worker = 0;
+        for (;;) {
+            bool progressed = false;
+            for (size_t n = 0; n < config_.workers; ++n) {
+                uint32_t slot;
+                SpscRing<uint32_t>& done = *shared.done[worker];
+                worker = worker + 1 == config_.workers ? 0 : worker + 1;
+                while (done.try_pop(slot)) {
+                    progressed = true;
+                    if (!config_.ordered) {
+                        emit(shared, slot, sink);
+                        continue;
+                    }
+                    const uint32_t stream = shared.slots[slot].stream;
+                    if (stream >= windows.size()) {
+                        windows.resize(stream + 1, std::vector<uint32_t>(slot_count_, NO_SLOT));
+                        next_sequence.resize(stream + 1, 0);
+                    }
+                    std::vector<uint32_t>& window = windows[stream];
+                    window[shared.slots[slot].sequence & window_mask] = slot;
+                    uint64_t& next = next_sequence[stream];
+                    while (window[next & window_mask] != NO_SLOT) {
+                        const uint32_t ready = window[next & window_mask];
+                        window[next & window_mask] = NO_SLOT;
+                        ++next;
+                        emit(shared, ready, sink);
+                    }
+                }
+            }
+            if (progressed) {
+                backoff.reset();
+                continue;
+            }
+            if (shared.workers_done.load(std::memory_order_acquire) == config_.workers) {
+                bool empty = true;
+                for (size_t w = 0; w < config_.workers; ++w) {
+                    empty = empty && shared.done[w]->empty();
+                }
+                if (empty) {
+                    break;
+                }
+            }
+            backoff.wait();
+        }
+    }
+
+    template<typename Sink>
+    void emit(Shared& shared, uint32_t slot, Sink& sink) {
+        Item& item = shared.slots[slot];
+        if (item.status.is_success()) {
+            ++shared.stats.decoded;
+        } else {
+            ++shared.stats.failed;
+        }
+        sink(static_cast<const Item&>(item));
+        shared.free_slots.try_push(slot);
+    }
+};
+
+template<typename Result>
+const uint32_t DecodePipeline<Result>::NO_SLOT;
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_PIPELINE_H
@@ -0,0 +1,526 @@
+#ifndef PROTOCOL_REPLAY_H
+#define PROTOCOL_REPLAY_H
+
+// ============================================================================
+// 抓包回放与解码吞吐统计
+// 把录制文件（pcap / pcapng / 长度前缀）中的全部报文交给分发器解码，
+// 输出报文数/秒、字节/秒、按报文类型的分项计数和错误分布。
+// 生成的 <dispatcher>_replay.cpp 只提供解码器和报文类型名，命令行解析与统计都在本文件：
+//
+//   struct Decoder {                       // 每个线程一个实例（持有复用的结果对象）
+//       ParseError operator()(const uint8_t* data, size_t length, size_t& slot);
+//   };
+//   int main(int argc, char** argv) {
+//       return run_replay_tool<Decoder>(argc, argv, "Foo", slot_names, slot_count);
+//   }
+//
+// 计时只覆盖解码：文件映射与载荷提取在计时前完成，报文按连续区间分给各线程，
+// 各线程先做预热遍历，再在同一时刻开始计时遍历，统计写线程私有对象，结束后合并。
+// 编译需要线程库：g++ -std=c++11 -O2 -pthread
+// ============================================================================
+
+#include "protocol_common.h"
+#include "protocol_capture.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace protocol_parser {
+
+// ============================================================================
+// 回放配置（命令行）
+// ============================================================================
+struct ReplayOptions {
+    std::string path;
+    CaptureFormat format;
+    LengthPrefixSpec prefix;
+    PayloadOptions payload;
+    size_t threads;              // 0 表示使用全部硬件线程
+    size_t repeat;               // 计时遍历次数
+    size_t warmup;               // 预热遍历次数（不计入统计）
+    size_t limit;                // 只回放前 limit 条报文（0 不限）
+    bool json;                   // 输出 JSON（否则为文本报表）
+
+    ReplayOptions() : format(CAPTURE_AUTO), threads(1), repeat(1), warmup(1), limit(0), json(false) {}
+};
+
+inline void print_replay_usage(const char* program, std::FILE* out) {
+    std::fprintf(out,
+        "usage: %s [options] <capture-file>\n"
+        "  --format auto|pcap|pcapng|length-prefixed   capture format (default: auto)\n"
+        "  --prefix-bytes 1|2|4        length prefix width for length-prefixed files (default: 4)\n"
+        "  --prefix-order big|little   length prefix byte order (default: big)\n"
+        "  --prefix-inclusive          length value includes the prefix itself\n"
+        "  --payload auto|raw          auto: strip link/IP/UDP/TCP headers; raw: whole captured frame\n"
+        "  --port N                    keep only UDP/TCP packets with source or destination port N\n"
+        "  --skip N                    skip N bytes of application framing before each message\n"
+        "  --limit N                   replay only the first N messages\n"
+        "  --threads N                 decoder threads, 0 = all hardware threads (default: 1)\n"
+        "  --repeat N                  timed passes over the capture (default: 1)\n"
+        "  --warmup N                  untimed passes before timing (default: 1)\n"
+        "  --json                      print the report as JSON\n",
+        program);
+}
+
+namespace replay_detail {
+
+inline bool parse_count(const char* text, size_t& value) {
+    if (text == nullptr || *text == '\0') {
+        return false;
+    }
+    char* end = nullptr;
+    const unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (*end != '\0') {
+        return false;
+    }
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+inline void append_json_string(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text; *p != '\0'; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+inline void append_format(std::string& out, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    const int n = std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (n > 0) {
+        out.append(buffer, static_cast<size_t>(n) < sizeof(buffer) ? static_cast<size_t>(n) : sizeof(buffer) - 1);
+    }
+}
+
+} // namespace replay_detail
+
+// 解析命令行；失败时返回 false，error 为原因（--help 时 error 为空）
+inline bool parse_replay_options(int argc, char** argv, ReplayOptions& options, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        size_t number = 0;
+        if (arg == "-h" || arg == "--help") {
+            error.clear();
+            return false;
+        } else if (arg == "--json") {
+            options.json = true;
+        } else if (arg == "--prefix-inclusive") {
+            options.prefix.includes_prefix = true;
+        } else if (arg == "--format" && value != nullptr) {
+            const std::string v = value;
+            if (v == "auto") options.format = CAPTURE_AUTO;
+            else if (v == "pcap") options.format = CAPTURE_PCAP;
+            else if (v == "pcapng") options.format = CAPTURE_PCAPNG;
+            else if (v == "length-prefixed" || v == "raw") options.format = CAPTURE_LENGTH_PREFIXED;
+            else { error = "unknown --format " + v; return false; }
+            ++i;
+        } else if (arg == "--prefix-bytes" && value != nullptr) {
+            if (!replay_detail::parse_count(value, number) || (number != 1 && number != 2 && number != 4)) {
+                error = "--prefix-bytes must be 1, 2 or 4";
+                return false;
+            }
+            options.prefix.prefix_bytes = number;
+            ++i;
+        } else if (arg == "--prefix-order" && value != nullptr) {
+            const std::string v = value;
+            if (v == "big") options.prefix.byte_order = BIG_ENDIAN;
+            else if (v == "little") options.prefix.byte_order = LITTLE_ENDIAN;
+            else { error = "--prefix-order must be big or little"; return false; }
+            ++i;
+        } else if (arg == "--payload" && value != nullptr) {
+            const std::string v = value;
+            if (v == "auto") options.payload.mode = PAYLOAD_MODE_AUTO;
+            else if (v == "raw") options.payload.mode = PAYLOAD_MODE_RAW;
+            else { error = "--payload must be auto or raw"; return false; }
+            ++i;
+        } else if (arg == "--port" && value != nullptr) {
+            if (!replay_detail::parse_count(value, number) || number > 65535) {
+                error = "--port must be 0..65535";
+                return false;
+            }
+            options.payload.port = static_cast<int>(number);
+            ++i;
+        } else if ((arg == "--skip" || arg == "--limit" || arg == "--threads" ||
+                    arg == "--repeat" || arg == "--warmup") && value != nullptr) {
+            if (!replay_detail::parse_count(value, number)) {
+                error = arg + " expects a non-negative integer";
+                return false;
+            }
+            if (arg == "--skip") options.payload.skip = number;
+            else if (arg == "--limit") options.limit = number;
+            else if (arg == "--threads") options.threads = number;
+            else if (arg == "--repeat") options.repeat = number > 0 ? number : 1;
+            else options.warmup = number;
+            ++i;
+        } else if (!arg.empty() && arg[0] == '-') {
+            error = "unknown or incomplete option " + arg;
+            return false;
+        } else if (options.path.empty()) {
+            options.path = arg;
+        } else {
+            error = "more than one capture file given";
+            return false;
+        }
+    }
+    if (options.path.empty()) {
+        error = "no capture file given";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 报文装载（不计时）
+// ============================================================================
+struct ReplayMessage {
+    const uint8_t* data;         // 指向映射内存
+    size_t length;
+};
+
+struct ReplayCaptureStats {
+    CaptureFormat format;
+    size_t file_bytes;
+    size_t records;
+    size_t payload_status[PAYLOAD_STATUS_COUNT];   // 各条记录的载荷提取结果
+    size_t truncated_records;                       // 文件末尾不完整的记录
+    size_t skipped_blocks;                          // pcapng 非报文块
+    uint64_t payload_bytes;
+    uint64_t first_timestamp_ns;                    // 最早 / 最晚的记录时间戳（无时间戳时为 0）
+    uint64_t last_timestamp_ns;
+
+    ReplayCaptureStats()
+        : format(CAPTURE_AUTO), file_bytes(0), records(0), truncated_records(0), skipped_blocks(0)
+        , payload_bytes(0), first_timestamp_ns(0), last_timestamp_ns(0)
+    {
+        std::memset(payload_status, 0, sizeof(payload_status));
+    }
+};
+
+inline bool load_replay_messages(const uint8_t* data, size_t size, const ReplayOptions& options,
+                                 std::vector<ReplayMessage>& messages, ReplayCaptureStats& stats,
+                                 std::string& error) {
+    CaptureReader reader(data, size, options.format, options.prefix);
+    stats.format = reader.format();
+    stats.file_bytes = size;
+    CaptureRecord record;
+    while (reader.next(record)) {
+        ++stats.records;
+        if (record.timestamp_ns != 0) {
+            if (stats.first_timestamp_ns == 0 || record.timestamp_ns < stats.first_timestamp_ns) {
+                stats.first_timestamp_ns = record.timestamp_ns;
+            }
+            if (record.timestamp_ns > stats.last_timestamp_ns) {
+                stats.last_timestamp_ns = record.timestamp_ns;
+            }
+        }
+        ReplayMessage message;
+        const PayloadStatus status = extract_payload(record, options.payload, message.data, message.length);
+        ++stats.payload_status[status];
+        if (status != PAYLOAD_OK) {
+            continue;
+        }
+        messages.push_back(message);
+        stats.payload_bytes += message.length;
+        if (options.limit != 0 && messages.size() >= options.limit) {
+            break;
+        }
+    }
+    stats.truncated_records = reader.truncated();
+    stats.skipped_blocks = reader.skipped_blocks();
+    if (!reader.ok()) {
+        error = reader.error();
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 解码统计
+// ============================================================================
+struct ReplaySlotStats {
+    uint64_t messages;
+    uint64_t bytes;
+    uint64_t results[PARSE_ERROR_COUNT];   // 按解码结果（含 SUCCESS）计数
+
+    ReplaySlotStats() : messages(0), bytes(0) {
+        std::memset(results, 0, sizeof(results));
+    }
+
+    uint64_t errors() const { return messages - results[SUCCESS]; }
+
+    void add(const ReplaySlotStats& other) {
+        messages += other.messages;
+        bytes += other.bytes;
+        for (size_t e = 0; e < PARSE_ERROR_COUNT; ++e) {
+            results[e] += other.results[e];
+        }
+    }
+};
+
+struct ReplayReport {
+    std::string name;
+    std::vector<const char*> slot_names;
+    std::vector<ReplaySlotStats> slots;
+    size_t threads;
+    size_t passes;
+    double seconds;              // 计时遍历的墙钟时间
+    ReplaySlotStats total;
+
+    ReplayReport() : threads(0), passes(0), seconds(0.0) {}
+
+    double messages_per_second() const { return seconds > 0.0 ? static_cast<double>(total.messages) / seconds : 0.0; }
+    double bytes_per_second() const { return seconds > 0.0 ? static_cast<double>(total.bytes) / seconds : 0.0; }
+
+    std::string to_json(const ReplayOptions& options, const ReplayCaptureStats& capture) const {
+        std::string out;
+        out += "{\"dispatcher\":";
+        replay_detail::append_json_string(out, name.c_str());
+        out += ",\"capture\":{\"path\":";
+        replay_detail::append_json_string(out, options.path.c_str());
+        replay_detail::append_format(out, ",\"format\":\"%s\",\"file_bytes\":%zu,\"records\":%zu,\"messages\":%zu,"
+                                     "\"payload_bytes\":%llu,\"truncated_records\":%zu,\"duration_ns\":%llu,\"skipped\":{",
+                                     capture_format_name(capture.format), capture.file_bytes, capture.records,
+                                     capture.payload_status[PAYLOAD_OK],
+                                     static_cast<unsigned long long>(capture.payload_bytes), capture.truncated_records,
+                                     static_cast<unsigned long long>(capture.last_timestamp_ns - capture.first_timestamp_ns));
+        bool first = true;
+        for (size_t s = PAYLOAD_OK + 1; s < PAYLOAD_STATUS_COUNT; ++s) {
+            if (capture.payload_status[s] == 0) continue;
+            replay_detail::append_format(out, "%s\"%s\":%zu", first ? "" : ",",
+                                         payload_status_name(static_cast<PayloadStatus>(s)), capture.payload_status[s]);
+            first = false;
+        }
+        replay_detail::append_format(out, "}},\"threads\":%zu,\"passes\":%zu,\"seconds\":%.6f,"
+                                     "\"messages\":%llu,\"bytes\":%llu,\"messages_per_second\":%.1f,\"bytes_per_second\":%.1f,",
+                                     threads, passes, seconds,
+                                     static_cast<unsigned long long>(total.messages),
+                                     static_cast<unsigned long long>(total.bytes),
+                                     messages_per_second(), bytes_per_second());
+        out += "\"errors\":";
+        append_results(out, total);
+        out += ",\"types\":[";
+        first = true;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].messages == 0) continue;
+            out += first ? "{\"type\":" : ",{\"type\":";
+            first = false;
+            replay_detail::append_json_string(out, slot_names[i]);
+            replay_detail::append_format(out, ",\"messages\":%llu,\"bytes\":%llu,\"errors\":",
+                                         static_cast<unsigned long long>(slots[i].messages),
+                                         static_cast<unsigned long long>(slots[i].bytes));
+            append_results(out, slots[i]);
+            out += '}';
+        }
+        out += "]}";
+        return out;
+    }
+
+    void print(std::FILE* out, const ReplayOptions& options, const ReplayCaptureStats& capture) const {
+        std::fprintf(out, "capture   %s (%s, %zu bytes)\n", options.path.c_str(),
+                     capture_format_name(capture.format), capture.file_bytes);
+        std::fprintf(out, "          %zu records, %zu messages, %llu payload bytes",
+                     capture.records, capture.payload_status[PAYLOAD_OK],
+                     static_cast<unsigned long long>(capture.payload_bytes));
+        if (capture.last_timestamp_ns > capture.first_timestamp_ns) {
+            std::fprintf(out, ", %.3f s of traffic",
+                         static_cast<double>(capture.last_timestamp_ns - capture.first_timestamp_ns) / 1e9);
+        }
+        std::fprintf(out, "\n");
+        for (size_t s = PAYLOAD_OK + 1; s < PAYLOAD_STATUS_COUNT; ++s) {
+            if (capture.payload_status[s] != 0) {
+                std::fprintf(out, "          skipped %-14s %zu\n",
+                             payload_status_name(static_cast<PayloadStatus>(s)), capture.payload_status[s]);
+            }
+        }
+        if (capture.truncated_records != 0) {
+            std::fprintf(out, "          truncated record at end of file ignored\n");
+        }
+        std::fprintf(out, "decode    %s: %zu thread(s), %zu pass(es), %.3f s\n",
+                     name.c_str(), threads, passes, seconds);
+        std::fprintf(out, "          %.0f msg/s, %.1f MB/s, %.1f ns/msg per thread\n",
+                     messages_per_second(), bytes_per_second() / 1e6,
+                     total.messages > 0 ? seconds * 1e9 * static_cast<double>(threads) / static_cast<double>(total.messages) : 0.0);
+
+        std::fprintf(out, "\n%-32s %12s %7s %14s %12s\n", "message type", "messages", "share", "bytes", "errors");
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].messages == 0) continue;
+            std::fprintf(out, "%-32s %12llu %6.2f%% %14llu %12llu\n", slot_names[i],
+                         static_cast<unsigned long long>(slots[i].messages),
+                         100.0 * static_cast<double>(slots[i].messages) / static_cast<double>(total.messages),
+                         static_cast<unsigned long long>(slots[i].bytes),
+                         static_cast<unsigned long long>(slots[i].errors()));
+        }
+
+        std::fprintf(out, "\n%-32s %12s %7s\n", "result", "messages", "share");
+        for (size_t e = 0; e < PARSE_ERROR_COUNT; ++e) {
+            if (total.results[e] == 0) continue;
+            std::fprintf(out, "%-32s %12llu %6.2f%%\n", error_code_id(static_cast<ParseError>(e)),
+                         static_cast<unsigned long long>(total.results[e]),
+                         100.0 * static_cast<double>(total.results[e]) / static_cast<double>(total.messages));
+        }
+    }
+
+private:
+    static void append_results(std::string& out, const ReplaySlotStats& stats) {
+        out += '{';
+        bool first = true;
+        for (size_t e = SUCCESS + 1; e < PARSE_ERROR_COUNT; ++e) {
+            if (stats.results[e] == 0) continue;
+            replay_detail::append_format(out, "%s\"%s\":%llu", first ? "" : ",",
+                                         error_code_id(static_cast<ParseError>(e)),
+                                         static_cast<unsigned long long>(stats.results[e]));
+            first = false;
+        }
+        out += '}';
+    }
+};
+
+// 多线程解码全部报文。Decoder 需可默认构造，operator()(data, length, slot) 返回解码结果并给出槽位
+// （slot < slot_count；越界的槽位计入最后一个槽位）
+template<typename Decoder>
+ReplayReport replay_messages(const std::vector<ReplayMessage>& messages,
+                             const char* const* slot_names, size_t slot_count,
+                             size_t threads, size_t passes, size_t warmup) {
+    ReplayReport report;
+    report.slot_names.assign(slot_names, slot_names + slot_count);
+    report.slots.resize(slot_count);
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    if (threads > messages.size() && !messages.empty()) {
+        threads = messages.size();
+    }
+    report.threads = threads;
+    report.passes = passes;
+    if (messages.empty() || slot_count == 0) {
+        return report;
+    }
+
+    std::vector<std::vector<ReplaySlotStats> > per_thread(threads);
+    std::atomic<size_t> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+    const size_t count = messages.size();
+
+    for (size_t t = 0; t < threads; ++t) {
+        const size_t begin = count * t / threads;
+        const size_t end = count * (t + 1) / threads;
+        std::vector<ReplaySlotStats>& stats = per_thread[t];
+        workers.push_back(std::thread([&messages, &stats, &ready, &go, begin, end, slot_count, passes, warmup]() {
+            // 统计先写线程内的局部对象，结束后一次性交出（避免各线程统计相邻造成伪共享）
+            std::vector<ReplaySlotStats> local(slot_count);
+            Decoder decoder;
+            size_t slot = 0;
+            for (size_t pass = 0; pass < warmup; ++pass) {
+                for (size_t i = begin; i < end; ++i) {
+                    decoder(messages[i].data, messages[i].length, slot);
+                }
+            }
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t pass = 0; pass < passes; ++pass) {
+                for (size_t i = begin; i < end; ++i) {
+                    const ParseError result = decoder(messages[i].data, messages[i].length, slot);
+                    ReplaySlotStats& entry = local[slot < slot_count ? slot : slot_count - 1];
+                    ++entry.messages;
+                    entry.bytes += messages[i].length;
+                    ++entry.results[static_cast<size_t>(result) < PARSE_ERROR_COUNT ? result : UNKNOWN_ERROR];
+                }
+            }
+            stats.swap(local);
+        }));
+    }
+    while (ready.load() < threads) {
+        std::this_thread::yield();
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (size_t t = 0; t < threads; ++t) {
+        for (size_t s = 0; s < slot_count; ++s) {
+            report.slots[s].add(per_thread[t][s]);
+        }
+    }
+    for (size_t s = 0; s < slot_count; ++s) {
+        report.total.add(report.slots[s]);
+    }
+    return report;
+}
+
+// 命令行入口：解析参数 → 映射文件 → 提取报文 → 回放 → 输出报表。返回进程退出码
+template<typename Decoder>
+int run_replay_tool(int argc, char** argv, const char* name,
+                    const char* const* slot_names, size_t slot_count) {
+    ReplayOptions options;
+    std::string error;
+    if (!parse_replay_options(argc, argv, options, error)) {
+        if (!error.empty()) {
+            std::fprintf(stderr, "%s: %s\n", argv[0], error.c_str());
+        }
+        print_replay_usage(argv[0], error.empty() ? stdout : stderr);
+        return error.empty() ? 0 : 2;
+    }
+
+    MappedFile file;
+    if (!file.open(options.path.c_str(), error)) {
+        std::fprintf(stderr, "%s: %s\n", argv[0], error.c_str());
+        return 1;
+    }
+    std::vector<ReplayMessage> messages;
+    ReplayCaptureStats capture;
+    if (!load_replay_messages(file.data(), file.size(), options, messages, capture, error)) {
+        std::fprintf(stderr, "%s: %s\n", argv[0], error.c_str());
+        return 1;
+    }
+    if (messages.empty()) {
+        std::fprintf(stderr, "%s: no messages found in %s\n", argv[0], options.path.c_str());
+        return 1;
+    }
+
+    ReplayReport report = replay_messages<Decoder>(messages, slot_names, slot_count,
+                                                   options.threads, options.repeat, options.warmup);
+    report.name = name;
+    if (options.json) {
+        std::printf("%s\n", report.to_json(options, capture).c_str());
+    } else {
+        report.print(stdout, options, capture);
+    }
+    return 0;
+}
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_REPLAY_H
@@ -0,0 +1,724 @@
+#ifndef PROTOCOL_STORE_H
+#define PROTOCOL_STORE_H
+
+// ============================================================================
+// 解码结果存储（内存映射、只追加、按报文类型分段）
+//
+// 目录结构：<dir>/msg-<MessageID 8 位十六进制>-<段序号 8 位十六进制>.seg，另有 LOCK 文件保证单写入方
+// 每种报文类型一条段链，段文件创建时即为固定大小（稀疏文件），结构为：
+//   [段头 128B][稀疏时间索引][数据区：记录...]
+//   记录 = [时间戳 8B][载荷长度 4B][保留 4B][载荷][补齐到 8 字节]
+// - 时间戳为 uint64 纳秒（与 protocol_timestamp.h 的统一表示一致）
+// - 稀疏时间索引：数据区每隔 index_stride 字节记一项 {此前所有记录的最大时间戳, 记录偏移}，
+//   最大时间戳单调不减，查询 [begin, end] 时二分找到最后一个「此前最大时间戳 < begin」的位置，
+//   从该处顺序扫描；段内时间戳单调时遇到 > end 的记录即停止，否则扫描到段尾
+// - 按类型查询：MessageID → 段链（段头记录最小/最大时间戳，不相交的段直接跳过）
+// - 并发：一个写入方（可在另一进程）与任意多个读取方同时工作。写入方先写记录和索引，
+//   再以 release 语义更新段头的 committed（已发布字节数）；读取方 acquire 读取 committed，
+//   只访问其之前的数据。新段先以临时文件名创建并初始化段头，再 rename 为正式文件名
+// - 载荷为任意字节：全静态布局（fixed_layout）的 <协议名>_Raw 可直接按内存拷贝存取（append_record /
+//   read_as），含字符串/变长数组的报文存线上字节，读取时用 <协议名>_Raw::parse_from() 还原
+//
+// 仅支持 POSIX 平台（mmap MAP_SHARED）
+//
+// 用法：
+//   protocol_parser::SegmentStoreWriter writer;
+//   std::string error;
+//   if (!writer.open("store/", error)) { ... }
+//   writer.append_record(MSG_ID, timestamp_ns, raw);              // 或 append(MSG_ID, timestamp_ns, data, length)
+//
+//   protocol_parser::SegmentStoreReader reader;                    // 可在写入同时打开
+//   reader.open("store/", error);
+//   reader.query(MSG_ID, t1, t2, [](const protocol_parser::StoredRecord& record) {
+//       XxxProtocol_Raw raw;
+//       record.read_as(raw);
+//       return true;                                               // false 提前结束
+//   });
+//   reader.refresh();                                              // 发现写入方新建的段
+// ============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "protocol_store.h requires POSIX mmap"
+#endif
+
+namespace protocol_parser {
+
+struct SegmentStoreConfig {
+    uint64_t segment_size;   // 段文件大小（含段头和索引），单条记录需能放入一个段
+    uint32_t index_stride;   // 稀疏时间索引间隔（数据区字节数）
+
+    SegmentStoreConfig() : segment_size(16u << 20), index_stride(4096) {}
+};
+
+// 查询得到的一条记录；data 指向映射内存，在读取方 close() 之前有效
+struct StoredRecord {
+    uint32_t message_id;
+    uint64_t timestamp;      // 纳秒
+    const uint8_t* data;
+    uint32_t length;
+
+    // 按内存布局读出定长记录（与 append_record 对应），长度不符时返回 false
+    template<typename T>
+    bool read_as(T& out) const {
+        static_assert(std::is_trivially_copyable<T>::value, "read_as requires a trivially copyable type");
+        if (length != sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&out, data, sizeof(T));
+        return true;
+    }
+};
+
+// 单个报文类型的概况
+struct StoreTypeSummary {
+    uint32_t message_id;
+    size_t segments;
+    uint64_t records;
+    uint64_t bytes;            // 记录占用的数据区字节数（含记录头）
+    uint64_t min_timestamp;
+    uint64_t max_timestamp;
+};
+
+namespace store_detail {
+
+const char MAGIC[8] = { 'P', 'P', 'S', 'T', 'O', 'R', 'E', '1' };
+const uint32_t VERSION = 1;
+const uint64_t HEADER_SIZE = 128;
+const uint64_t RECORD_HEADER_SIZE = 16;
+const uint64_t SEGMENT_ALIGNMENT = 4096;
+const uint32_t FLAG_SEALED = 1;      // 段已写满，写入方转到下一段
+const uint32_t FLAG_UNORDERED = 2;   // 段内时间戳出现过回退（查询需扫描到段尾）
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && ATOMIC_LLONG_LOCK_FREE == 2,
+              "protocol_store.h requires lock-free 64-bit atomics in shared memory");
+
+// 段头：映射内存中的固定布局（写入方与读取方可在不同进程）
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t message_id;
+    uint64_t segment_seq;
+    uint64_t file_size;
+    uint64_t data_offset;              // 数据区起始（相对文件起始）
+    uint64_t index_capacity;           // 索引项上限
+    uint64_t index_stride;
+    std::atomic<uint64_t> committed;   // 已发布的数据区字节数
+    std::atomic<uint64_t> record_count;
+    std::atomic<uint64_t> index_count;
+    std::atomic<uint64_t> min_timestamp;
+    std::atomic<uint64_t> max_timestamp;
+    std::atomic<uint32_t> flags;
+    uint32_t reserved[7];
+};
+
+static_assert(sizeof(SegmentHeader) == HEADER_SIZE, "segment header layout");
+
+// 索引项：偏移 offset 之前所有记录的最大时间戳
+struct IndexEntry {
+    uint64_t max_before;
+    uint64_t offset;
+};
+
+inline uint64_t align8(uint64_t value) {
+    return (value + 7) & ~static_cast<uint64_t>(7);
+}
+
+inline uint64_t record_size(uint64_t payload) {
+    return align8(RECORD_HEADER_SIZE + payload);
+}
+
+inline uint64_t index_capacity_for(uint64_t segment_size, uint64_t stride) {
+    return segment_size / stride + 2;
+}
+
+inline uint64_t data_offset_for(uint64_t index_capacity) {
+    const uint64_t end = HEADER_SIZE + index_capacity * sizeof(IndexEntry);
+    return (end + SEGMENT_ALIGNMENT - 1) / SEGMENT_ALIGNMENT * SEGMENT_ALIGNMENT;
+}
+
+inline std::string segment_name(uint32_t message_id, uint32_t seq) {
+    char name[40];
+    std::snprintf(name, sizeof(name), "msg-%08x-%08x.seg", message_id, seq);
+    return name;
+}
+
+// 解析段文件名，非段文件返回 false
+inline bool parse_segment_name(const char* name, uint32_t& message_id, uint32_t& seq) {
+    unsigned id = 0;
+    unsigned n = 0;
+    char tail[8] = { 0 };
+    if (std::strlen(name) != 25 || std::sscanf(name, "msg-%8x-%8x%4s", &id, &n, tail) != 3 ||
+        std::strcmp(tail, ".seg") != 0) {
+        return false;
+    }
+    message_id = id;
+    seq = n;
+    return true;
+}
+
+// 一个已映射的段
+struct Segment {
+    uint8_t* base;
+    uint64_t size;
+    uint32_t seq;
+
+    Segment() : base(nullptr), size(0), seq(0) {}
+
+    SegmentHeader* header() const { return reinterpret_cast<SegmentHeader*>(base); }
+    IndexEntry* index() const { return reinterpret_cast<IndexEntry*>(base + HEADER_SIZE); }
+    uint8_t* data() const { return base + header()->data_offset; }
+    uint64_t data_capacity() const { return size - header()->data_offset; }
+};
+
+inline bool map_segment(const std::string& path, bool writable, Segment& segment, std::string& error) {
+    const int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < HEADER_SIZE) {
+        ::close(fd);
+        error = "invalid segment " + path;
+        return false;
+    }
+    const uint64_t size = static_cast<uint64_t>(info.st_size);
+    void* address = ::mmap(nullptr, static_cast<size_t>(size), writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                           MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        error = "cannot mmap " + path;
+        return false;
+    }
+    segment.base = static_cast<uint8_t*>(address);
+    segment.size = size;
+    const SegmentHeader* header = segment.header();
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+        header->file_size != size || header->data_offset >= size ||
+        HEADER_SIZE + header->index_capacity * sizeof(IndexEntry) > header->data_offset) {
+        ::munmap(address, static_cast<size_t>(size));
+        segment = Segment();
+        error = "invalid segment " + path;
+        return false;
+    }
+    return true;
+}
+
+inline void unmap_segment(Segment& segment) {
+    if (segment.base != nullptr) {
+        ::munmap(segment.base, static_cast<size_t>(segment.size));
+    }
+    segment = Segment();
+}
+
+} // namespace store_detail
+
+// ============================================================================
+// 写入方（每个目录同一时刻只允许一个，由 LOCK 文件上的 flock 保证）
+// ============================================================================
+class SegmentStoreWriter {
+public:
+    SegmentStoreWriter() : data_capacity_(0), lock_fd_(-1), records_(0), cached_(nullptr), cached_id_(0) {}
+    ~SegmentStoreWriter() { close(); }
+
+    // 打开（不存在时创建）存储目录；已有段的类型从最后一段的已发布位置继续追加
+    bool open(const std::string& directory, std::string& error,
+              const SegmentStoreConfig& config = SegmentStoreConfig()) {
+        close();
+        const uint64_t data_offset = config.index_stride == 0 ? 0 : store_detail::data_offset_for(
+            store_detail::index_capacity_for(config.segment_size, config.index_stride));
+        if (config.index_stride == 0 || config.segment_size < data_offset + store_detail::SEGMENT_ALIGNMENT) {
+            error = "segment size too small";
+            return false;
+        }
+        if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            error = "cannot create " + directory;
+            return false;
+        }
+        directory_ = directory;
+        if (directory_.empty() || directory_[directory_.size() - 1] != '/') {
+            directory_ += '/';
+        }
+        lock_fd_ = ::open((directory_ + "LOCK").c_str(), O_RDWR | O_CREAT, 0644);
+        if (lock_fd_ < 0 || ::flock(lock_fd_, LOCK_EX | LOCK_NB) != 0) {
+            error = "store is locked by another writer: " + directory_;
+            close();
+            return false;
+        }
+        config_ = config;
+        data_capacity_ = config.segment_size - data_offset;
+
+        // 记录每种类型的最后一段，首次追加时再映射
+        DIR* dir = ::opendir(directory_.c_str());
+        if (dir == nullptr) {
+            error = "cannot list " + directory_;
+            close();
+            return false;
+        }
+        while (struct dirent* entry = ::readdir(dir)) {
+            uint32_t message_id;
+            uint32_t seq;
+            if (!store_detail::parse_segment_name(entry->d_name, message_id, seq)) {
+                continue;
+            }
+            TypeState& state = types_[message_id];
+            if (!state.has_segment || seq > state.last_seq) {
+                state.has_segment = true;
+                state.last_seq = seq;
+            }
+        }
+        ::closedir(dir);
+        return true;
+    }
+
+    // 追加一条记录；失败时返回 false，原因见 error()
+    bool append(uint32_t message_id, uint64_t timestamp, const uint8_t* data, size_t length) {
+        if (lock_fd_ < 0) {
+            error_ = "store is not open";
+            return false;
+        }
+        TypeState* state = cached_;
+        if (state == nullptr || cached_id_ != message_id) {
+            state = &types_[message_id];
+            cached_ = state;
+            cached_id_ = message_id;
+        }
+        const uint64_t size = store_detail::record_size(length);
+        if (size > data_capacity_) {
+            error_ = "record larger than segment";
+            return false;
+        }
+        if (state->segment.base == nullptr && !open_tail(message_id, *state)) {
+            return false;
+        }
+        if (state->segment.header()->committed.load(std::memory_order_relaxed) + size >
+            state->segment.data_capacity()) {
+            seal(*state);
+            if (!create_segment(message_id, state->last_seq + 1, *state)) {
+                return false;
+            }
+        }
+
+        store_detail::Segment& segment = state->segment;
+        store_detail::SegmentHeader* header = segment.header();
+        const uint64_t offset = header->committed.load(std::memory_order_relaxed);
+        uint8_t* record = segment.data() + offset;
+        const uint32_t length32 = static_cast<uint32_t>(length);
+        const uint32_t reserved = 0;
+        std::memcpy(record, &timestamp, 8);
+        std::memcpy(record + 8, &length32, 4);
+        std::memcpy(record + 12, &reserved, 4);
+        if (length > 0) {
+            std::memcpy(record + store_detail::RECORD_HEADER_SIZE, data, length);
+        }
+
+        // 稀疏时间索引：记录此前的最大时间戳
+        const uint64_t count = header->record_count.load(std::memory_order_relaxed);
+        const uint64_t max_before = count == 0 ? 0 : header->max_timestamp.load(std::memory_order_relaxed);
+        if (offset >= state->next_index_offset) {
+            const uint64_t index_count = header->index_count.load(std::memory_order_relaxed);
+            if (index_count < header->index_capacity) {
+                store_detail::IndexEntry& entry = segment.index()[index_count];
+                entry.max_before = max_before;
+                entry.offset = offset;
+                header->index_count.store(index_count + 1, std::memory_order_release);
+            }
+            state->next_index_offset = offset + header->index_stride;
+        }
+
+        if (count == 0 || timestamp < header->min_timestamp.load(std::memory_order_relaxed)) {
+            header->min_timestamp.store(timestamp, std::memory_order_relaxed);
+        }
+        if (count == 0 || timestamp > max_before) {
+            header->max_timestamp.store(timestamp, std::memory_order_relaxed);
+        } else if (timestamp < max_before) {
+            header->flags.fetch_or(store_detail::FLAG_UNORDERED, std::memory_order_relaxed);
+        }
+        header->record_count.store(count + 1, std::memory_order_relaxed);
+        header->committed.store(offset + size, std::memory_order_release);   // 发布
+        ++records_;
+        return true;
+    }
+
+    // 定长记录（如全静态布局的 <协议名>_Raw）按内存布局写入
+    template<typename T>
+    bool append_record(uint32_t message_id, uint64_t timestamp, const T& record) {
+        static_assert(std::is_trivially_copyable<T>::value, "append_record requires a trivially copyable type");
+        return append(message_id, timestamp, reinterpret_cast<const uint8_t*>(&record), sizeof(T));
+    }
+
+    // 把已发布的数据刷到磁盘（msync 同步），进程崩溃不需要；掉电持久化时调用
+    bool sync() {
+        for (std::map<uint32_t, TypeState>::iterator it = types_.begin(); it != types_.end(); ++it) {
+            store_detail::Segment& segment = it->second.segment;
+            if (segment.base != nullptr && ::msync(segment.base, static_cast<size_t>(segment.size), MS_SYNC) != 0) {
+                error_ = "msync failed";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 关闭（不封存当前段，下次 open 后继续追加）
+    void close() {
+        for (std::map<uint32_t, TypeState>::iterator it = types_.begin(); it != types_.end(); ++it) {
+            store_detail::unmap_segment(it->second.segment);
+        }
+        types_.clear();
+        cached_ = nullptr;
+        if (lock_fd_ >= 0) {
+            ::close(lock_fd_);   // 同时释放 flock
+            lock_fd_ = -1;
+        }
+    }
+
+    bool is_open() const { return lock_fd_ >= 0; }
+    uint64_t records_written() const { return records_; }
+    const std::string& error() const { return error_; }
+    const std::string& directory() const { return directory_; }
+
+private:
+    struct TypeState {
+        bool has_segment;          // 目录中已有该类型的段
+        uint32_t last_seq;
+        uint64_t next_index_offset;
+        store_detail::Segment segment;
+
+        TypeState() : has_segment(false), last_seq(0), next_index_offset(0) {}
+    };
+
+    std::string directory_;
+    SegmentStoreConfig config_;
+    uint64_t data_capacity_;       // 新建段的数据区大小
+    int lock_fd_;
+    uint64_t records_;
+    std::map<uint32_t, TypeState> types_;
+    TypeState* cached_;            // 最近一次追加的类型（连续同类型追加时免查找）
+    uint32_t cached_id_;
+    std::string error_;
+
+    // 映射该类型的最后一段（已封存则新建下一段）
+    bool open_tail(uint32_t message_id, TypeState& state) {
+        if (!state.has_segment) {
+            return create_segment(message_id, 0, state);
+        }
+        if (!store_detail::map_segment(directory_ + store_detail::segment_name(message_id, state.last_seq),
+                                       true, state.segment, error_)) {
+            return false;
+        }
+        store_detail::SegmentHeader* header = state.segment.header();
+        if (header->message_id != message_id ||
+            (header->flags.load(std::memory_order_relaxed) & store_detail::FLAG_SEALED) != 0) {
+            store_detail::unmap_segment(state.segment);
+            return create_segment(message_id, state.last_seq + 1, state);
+        }
+        // 上次异常退出时可能已写入索引但未发布记录：丢弃指向未发布位置的索引项
+        const uint64_t committed = header->committed.load(std::memory_order_relaxed);
+        uint64_t index_count = header->index_count.load(std::memory_order_relaxed);
+        while (index_count > 0 && state.segment.index()[index_count - 1].offset >= committed) {
+            --index_count;
+        }
+        header->index_count.store(index_count, std::memory_order_release);
+        state.next_index_offset = index_count == 0 ? 0
+            : state.segment.index()[index_count - 1].offset + header->index_stride;
+        return true;
+    }
+
+    bool create_segment(uint32_t message_id, uint32_t seq, TypeState& state) {
+        const std::string name = store_detail::segment_name(message_id, seq);
+        const std::string temp_path = directory_ + name + ".tmp";
+        const int fd = ::open(temp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            error_ = "cannot create " + temp_path;
+            return false;
+        }
+        const uint64_t size = config_.segment_size;
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            ::unlink(temp_path.c_str());
+            error_ = "cannot resize " + temp_path;
+            return false;
+        }
+        void* address = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            ::unlink(temp_path.c_str());
+            error_ = "cannot mmap " + temp_path;
+            return false;
+        }
+        store_detail::Segment segment;
+        segment.base = static_cast<uint8_t*>(address);
+        segment.size = size;
+        segment.seq = seq;
+        store_detail::SegmentHeader* header = segment.header();
+        std::memcpy(header->magic, store_detail::MAGIC, sizeof(store_detail::MAGIC));
+        header->version = store_detail::VERSION;
+        header->message_id = message_id;
+        header->segment_seq = seq;
+        header->file_size = size;
+        header->index_stride = config_.index_stride;
+        header->index_capacity = store_detail::index_capacity_for(size, config_.index_stride);
+        header->data_offset = store_detail::data_offset_for(header->index_capacity);
+        // 其余字段为 ftruncate 后的 0
+        if (::rename(temp_path.c_str(), (directory_ + name).c_str()) != 0) {
+            store_detail::unmap_segment(segment);
+            ::unlink(temp_path.c_str());
+            error_ = "cannot rename " + temp_path;
+            return false;
+        }
+        state.segment = segment;
+        state.has_segment = true;
+        state.last_seq = seq;
+        state.next_index_offset = 0;
+        return true;
+    }
+
+    void seal(TypeState& state) {
+        state.segment.header()->flags.fetch_or(store_detail::FLAG_SEALED, std::memory_order_release);
+        store_detail::unmap_segment(state.segment);
+    }
+
+    SegmentStoreWriter(const SegmentStoreWriter&);
+    SegmentStoreWriter& operator=(const SegmentStoreWriter&);
+};
+
+// ============================================================================
+// 读取方（可与写入方同时工作；单个实例不可被多个线程同时使用）
+// ============================================================================
+class SegmentStoreReader {
+public:
+    SegmentStoreReader() {}
+    ~SegmentStoreReader() { close(); }
+
+    bool open(const std::string& directory, std::string& error) {
+        close();
+        directory_ = directory;
+        if (directory_.empty() || directory_[directory_.size() - 1] != '/') {
+            directory_ += '/';
+        }
+        DIR* dir = ::opendir(directory_.c_str());
+        if (dir == nullptr) {
+            error = "cannot list " + directory_;
+            return false;
+        }
+        ::closedir(dir);
+        refresh();
+        return true;
+    }
+
+    // 映射写入方新建的段，返回新发现的段数（无法映射的段跳过，计入 skipped_segments()）
+    size_t refresh() {
+        DIR* dir = ::opendir(directory_.c_str());
+        if (dir == nullptr) {
+            return 0;
+        }
+        size_t added = 0;
+        while (struct dirent* entry = ::readdir(dir)) {
+            uint32_t message_id;
+            uint32_t seq;
+            if (!store_detail::parse_segment_name(entry->d_name, message_id, seq)) {
+                continue;
+            }
+            std::vector<store_detail::Segment>& chain = types_[message_id];
+            bool known = false;
+            for (size_t i = 0; i < chain.size() && !known; ++i) {
+                known = chain[i].seq == seq;
+            }
+            if (known) {
+                continue;
+            }
+            store_detail::Segment segment;
+            std::string error;
+            if (!store_detail::map_segment(directory_ + entry->d_name, false, segment, error) ||
+                segment.header()->message_id != message_id) {
+                store_detail::unmap_segment(segment);
+                skipped_.push_back(entry->d_name);
+                continue;
+            }
+            segment.seq = seq;
+            chain.push_back(segment);
+            ++added;
+        }
+        ::closedir(dir);
+        for (std::map<uint32_t, std::vector<store_detail::Segment> >::iterator it = types_.begin();
+             it != types_.end(); ++it) {
+            std::sort(it->second.begin(), it->second.end(), segment_less);
+        }
+        return added;
+    }
+
+    void close() {
+        for (std::map<uint32_t, std::vector<store_detail::Segment> >::iterator it = types_.begin();
+             it != types_.end(); ++it) {
+            for (size_t i = 0; i < it->second.size(); ++i) {
+                store_detail::unmap_segment(it->second[i]);
+            }
+        }
+        types_.clear();
+        skipped_.clear();
+    }
+
+    // 已有的报文类型（升序）
+    std::vector<uint32_t> message_ids() const {
+        std::vector<uint32_t> ids;
+        for (std::map<uint32_t, std::vector<store_detail::Segment> >::const_iterator it = types_.begin();
+             it != types_.end(); ++it) {
+            if (!it->second.empty()) {
+                ids.push_back(it->first);
+            }
+        }
+        return ids;
+    }
+
+    std::vector<StoreTypeSummary> summary() const {
+        std::vector<StoreTypeSummary> result;
+        for (std::map<uint32_t, std::vector<store_detail::Segment> >::const_iterator it = types_.begin();
+             it != types_.end(); ++it) {
+            StoreTypeSummary item = { it->first, it->second.size(), 0, 0, 0, 0 };
+            for (size_t i = 0; i < it->second.size(); ++i) {
+                const store_detail::SegmentHeader* header = it->second[i].header();
+                const uint64_t committed = header->committed.load(std::memory_order_acquire);
+                const uint64_t records = header->record_count.load(std::memory_order_relaxed);
+                if (records == 0) {
+                    continue;
+                }
+                const uint64_t min_ts = header->min_timestamp.load(std::memory_order_relaxed);
+                const uint64_t max_ts = header->max_timestamp.load(std::memory_order_relaxed);
+                if (item.records == 0 || min_ts < item.min_timestamp) {
+                    item.min_timestamp = min_ts;
+                }
+                if (item.records == 0 || max_ts > item.max_timestamp) {
+                    item.max_timestamp = max_ts;
+                }
+                item.records += records;
+                item.bytes += committed;
+            }
+            if (!it->second.empty()) {
+                result.push_back(item);
+            }
+        }
+        return result;
+    }
+
+    // 按段顺序（同一段内按写入顺序）回调时间戳在 [begin, end] 内的记录：fn(const StoredRecord&) 返回 false 时停止
+    // 返回回调次数
+    template<typename Fn>
+    uint64_t query(uint32_t message_id, uint64_t begin, uint64_t end, Fn fn) const {
+        std::map<uint32_t, std::vector<store_detail::Segment> >::const_iterator it = types_.find(message_id);
+        if (it == types_.end() || begin > end) {
+            return 0;
+        }
+        uint64_t delivered = 0;
+        StoredRecord record;
+        record.message_id = message_id;
+        for (size_t i = 0; i < it->second.size(); ++i) {
+            if (!scan_segment(it->second[i], begin, end, record, fn, delivered)) {
+                break;
+            }
+        }
+        return delivered;
+    }
+
+    const std::vector<std::string>& skipped_segments() const { return skipped_; }
+
+private:
+    std::string directory_;
+    std::map<uint32_t, std::vector<store_detail::Segment> > types_;
+    std::vector<std::string> skipped_;
+
+    static bool segment_less(const store_detail::Segment& a, const store_detail::Segment& b) {
+        return a.seq < b.seq;
+    }
+
+    // 扫描一段；fn 要求停止时返回 false
+    template<typename Fn>
+    static bool scan_segment(const store_detail::Segment& segment, uint64_t begin, uint64_t end,
+                             StoredRecord& record, Fn& fn, uint64_t& delivered) {
+        const store_detail::SegmentHeader* header = segment.header();
+        uint64_t committed = header->committed.load(std::memory_order_acquire);
+        if (committed == 0) {
+            return true;
+        }
+        const uint64_t capacity = segment.data_capacity();
+        if (committed > capacity) {
+            committed = capacity;   // 损坏的段头：不越界
+        }
+        // 段头的最小/最大时间戳不早于 committed 读取，只会更宽，跳过判断是安全的
+        if (header->max_timestamp.load(std::memory_order_relaxed) < begin ||
+            header->min_timestamp.load(std::memory_order_relaxed) > end) {
+            return true;
+        }
+        const bool ordered = (header->flags.load(std::memory_order_relaxed) & store_detail::FLAG_UNORDERED) == 0;
+
+        // 二分：最后一个 max_before < begin 的索引项，其之前的记录都早于 begin
+        uint64_t index_count = header->index_count.load(std::memory_order_acquire);
+        if (index_count > header->index_capacity) {
+            index_count = header->index_capacity;
+        }
+        const store_detail::IndexEntry* index = segment.index();
+        uint64_t low = 0;
+        uint64_t high = index_count;
+        while (low < high) {
+            const uint64_t mid = low + (high - low) / 2;
+            if (index[mid].max_before < begin && index[mid].offset < committed) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        uint64_t offset = low == 0 ? 0 : index[low - 1].offset;
+
+        const uint8_t* data = segment.data();
+        while (offset + store_detail::RECORD_HEADER_SIZE <= committed) {
+            const uint8_t* entry = data + offset;
+            uint64_t timestamp;
+            uint32_t length;
+            std::memcpy(&timestamp, entry, 8);
+            std::memcpy(&length, entry + 8, 4);
+            const uint64_t size = store_detail::record_size(length);
+            if (size > committed - offset) {
+                break;   // 损坏的记录：不越界
+            }
+            if (timestamp > end && ordered) {
+                break;
+            }
+            if (timestamp >= begin && timestamp <= end) {
+                record.timestamp = timestamp;
+                record.data = entry + store_detail::RECORD_HEADER_SIZE;
+                record.length = length;
+                ++delivered;
+                if (!fn(static_cast<const StoredRecord&>(record))) {
+                    return false;
+                }
+            }
+            offset += size;
+        }
+        return true;
+    }
+
+    SegmentStoreReader(const SegmentStoreReader&);
+    SegmentStoreReader& operator=(const SegmentStoreReader&);
+};
+
+} // namespace protocol_parser
+
+#endif // PROTOCOL_STORE_H
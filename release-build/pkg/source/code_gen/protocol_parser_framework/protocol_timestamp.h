@@ -161,4 +161,82 @@ inline uint64_t nanos_to_day_0_1_millis(uint64_t nanos) {
     return nanos / 100000ULL;
 }
 
+// ============================================================================
+// 当天时间（day_millis / day_0_1_millis）提升为绝对时间
+// ============================================================================
+
+/// 一天的纳秒数
+const uint64_t NANOS_PER_DAY = 86400000000000ULL;
+
+/**
+ * @brief 取绝对时间所在日（UTC）零点
+ * @param nanos 绝对时间（纳秒）
+ * @return 当日零点的绝对时间（纳秒）
+ */
+inline uint64_t day_start_of(uint64_t nanos) {
+    return nanos - nanos % NANOS_PER_DAY;
+}
+
+/**
+ * @brief 跨零点感知的当天时间 → 绝对时间转换（每条输入链路一个实例）
+ *
+ * day_millis / day_0_1_millis 解析得到的是「当天纳秒数」，过零点时回绕到 0。
+ * 以当天已见到的最大时间为基准：
+ * - 新值比它小超过 threshold（默认半天）：判定为过了零点，日期加一天
+ * - 新值比它大超过 threshold：判定为零点前产生、零点后才到达的迟到报文，按前一天计算（不改变状态）
+ * - 其余情况视为同一天内的正常乱序
+ */
+class TimeOfDayPromoter {
+public:
+    /**
+     * @param day_start 起始日零点的绝对时间（纳秒），可用 day_start_of() 由抓包时间或系统时钟得到
+     * @param threshold 判定跨零点的回退幅度（纳秒）
+     */
+    explicit TimeOfDayPromoter(uint64_t day_start = 0, uint64_t threshold = NANOS_PER_DAY / 2)
+        : day_start_(day_start), threshold_(threshold), high_(0), started_(false), rollovers_(0) {}
+
+    /**
+     * @brief 将当天纳秒数提升为绝对时间
+     * @param time_of_day 当天纳秒数（day_millis_to_nanos / day_0_1_millis_to_nanos 的结果）
+     * @return 绝对时间（纳秒）
+     */
+    uint64_t promote(uint64_t time_of_day) {
+        if (!started_) {
+            started_ = true;
+            high_ = time_of_day;
+        } else if (time_of_day + threshold_ < high_) {
+            day_start_ += NANOS_PER_DAY;   // 过零点
+            ++rollovers_;
+            high_ = time_of_day;
+        } else if (time_of_day > high_ + threshold_) {
+            // 零点前的迟到报文
+            return day_start_ >= NANOS_PER_DAY ? day_start_ - NANOS_PER_DAY + time_of_day : time_of_day;
+        } else if (time_of_day > high_) {
+            high_ = time_of_day;
+        }
+        return day_start_ + time_of_day;
+    }
+
+    /// 当前日零点的绝对时间（纳秒）
+    uint64_t day_start() const { return day_start_; }
+
+    /// 已检测到的跨零点次数
+    uint64_t rollovers() const { return rollovers_; }
+
+    /// 重新指定起始日（如从另一来源得知日期）
+    void reset(uint64_t day_start) {
+        day_start_ = day_start;
+        high_ = 0;
+        started_ = false;
+        rollovers_ = 0;
+    }
+
+private:
+    uint64_t day_start_;
+    uint64_t threshold_;
+    uint64_t high_;        // 当天已见到的最大当天时间
+    bool started_;
+    uint64_t rollovers_;
+};
+
 } // namespace protocol_timestamp